@@ -0,0 +1,1843 @@
+/**
+ * @file benchParkingAssistant.cpp
+ * @brief Micro-benchmarks for the Autonomous Parking Assistant components
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ *
+ * This executable measures the throughput of performance-sensitive parts
+ * of the parking assistant. Each benchmark prints one line per
+ * configuration so results can be compared between builds.
+ *
+ * Usage:
+ *   ./bin/benchParkingAssistant            // run every benchmark
+ *   ./bin/benchParkingAssistant lotIndex   // run benchmarks whose name contains "lotIndex"
+ *   ./bin/benchParkingAssistant --perf status   // add hardware counters per operation
+ *   ./bin/benchParkingAssistant --history bench.txt regression   // record the core paths
+ *   ./bin/benchParkingAssistant --history bench.txt --compare abc123 regression
+ *
+ * With --perf (Linux only) each result line is followed by the cycles,
+ * instructions, branch misses and L1d/LLC misses per operation, counted
+ * in user space from the start of the measured loop to its report. The
+ * counts include threads the benchmark starts and joins. Counters that
+ * the kernel or the CPU does not provide are left out; virtual machines
+ * often expose none, and perf_event_paranoid above 2 blocks them all.
+ *
+ * With --history FILE the regression benchmarks append their runs to
+ * FILE, keyed by the current git commit (or --commit ID). --compare
+ * COMMIT then tests them against COMMIT's runs in the same file with
+ * Welch's t-test and exits with status 1 if any of them got
+ * significantly slower or allocates more (see BenchHistory.h). COMMIT
+ * may be any revision git resolves or an abbreviation of a recorded one;
+ * benchmarks without two runs on both sides are listed as skipped. Each
+ * regression benchmark runs --repeat times (default 5), interleaved.
+ * Heap allocations are counted by replacing the global operator new.
+ *
+ * Benchmarks:
+ * - lotIndex.mixed: snapshot reads against a concurrent writer, compared
+ *   with a mutex-protected bay vector, for 1..N reader threads
+ * - feed.fanout: change feed publish cost with 1..N polling subscribers
+ * - kinematics.feasibility: closed-form parallel parking feasibility for
+ *   every vehicle/slot pair of a lot
+ * - sensor.raycast: uniform-grid ray casting in a multi-vehicle lot,
+ *   compared with testing every segment, plus full sensor frames
+ * - collision.path: separating-axis checks of a 400-pose path against an
+ *   800-car lot, with and without the path-level broad phase
+ * - clearance.map: full distance transform of a 200 m x 120 m lot at
+ *   10 cm, single-bay incremental updates and O(1) clearance queries
+ * - plan.cache: trajectory requests for an 800-bay lot answered through the
+ *   plan cache, compared with planning every request
+ * - replan.obstruction: per-frame D* Lite repair while a pedestrian and a
+ *   trolley obstruct the aisle, compared with planning each frame from scratch
+ * - aisle.coordination: conflict-free routing of 8..48 simultaneous
+ *   arrivals to their bays on a shared 1 m lot grid
+ * - garage.route: contraction hierarchy gate-to-bay routes and nearest free
+ *   bay queries on a 4-level campus, compared with plain Dijkstra
+ * - status.classifier: status changes and throughput on a noisy approach,
+ *   hysteresis classifier compared with stateless checkSafety()
+ * - telemetry.stream: bytes per frame of a 50 Hz sensor stream, delta
+ *   encoded compared with fixed-size records, and encode/decode cost
+ * - schedule.replay: processor time of the beep/safety/guidance pipeline
+ *   on a replayed drive-and-park session, every frame vs adaptive
+ * - beep.cadence: lateness of proximity beeps against their schedule with
+ *   irregular frames, timer thread compared with beeping on frame arrival
+ * - sensor.health: per-frame cost of the status classifier with and without
+ *   the rolling-statistics health monitor in front of it
+ * - calibration.replay: recalibration of a recorded session, per-frame
+ *   calibrate() compared with the batched calibrateFrames()
+ * - watchdog.overhead: cost of timing every loop frame stage by stage
+ * - ingest.burst: decision latency when frames arrive 10x faster than
+ *   they are classified, FIFO queue compared with newest-frame-wins
+ * - safety.check: checkSafety() building a status string per reading,
+ *   compared with the plainStatus() enum classification
+ * - metrics.overhead: cost of one counter add and one latency histogram
+ *   record, alone and from four threads updating their own counters
+ * - regression: time and heap allocations per call of checkSafety(),
+ *   requiredSpace(), findParkingSpace() and the replay pipeline, over
+ *   repeated runs for the benchmark history
+ */
+
+#include "../include/AdaptiveScheduler.h"
+#include "../include/AisleCoordinator.h"
+#include "../include/BayChangeFeed.h"
+#include "../include/BeepCadence.h"
+#include "../include/BenchHistory.h"
+#include "../include/ClearanceMap.h"
+#include "../include/DeadlineWatchdog.h"
+#include "../include/FrameCoalescer.h"
+#include "../include/CollisionChecker.h"
+#include "../include/GarageGraph.h"
+#include "../include/GridReplanner.h"
+#include "../include/LotIndex.h"
+#include "../include/MetricsRegistry.h"
+#include "../include/ParkingUtils.h"
+#include "../include/PlanCache.h"
+#include "../include/SensorCalibration.h"
+#include "../include/SensorHealthMonitor.h"
+#include "../include/SensorSynthesizer.h"
+#include "../include/StatusClassifier.h"
+#include "../include/TelemetryCodec.h"
+#include "../include/VehicleCatalogue.h"
+#include "../include/VehicleKinematics.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <mutex>
+#include <new>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#define PARKING_NULL_DEVICE "NUL"
+#else
+#define PARKING_NULL_DEVICE "/dev/null"
+#endif
+
+#ifdef __linux__
+#include <cerrno>
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+/**
+ * @brief Heap allocations of the whole process, counted by the operator new below
+ */
+static atomic<size_t> heapAllocations(0);
+
+void* operator new(size_t size) {
+    heapAllocations.fetch_add(1, memory_order_relaxed);
+    if (void* p = malloc(size ? size : 1)) return p;
+    throw bad_alloc();
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+/**
+ * @brief Returns a block to malloc, out of line so GCC does not mistake an inlined pair for a mismatch
+ */
+#ifdef __GNUC__
+__attribute__((noinline))
+#endif
+static void releaseBlock(void* p) {
+    free(p);
+}
+
+void operator delete(void* p) noexcept {
+    releaseBlock(p);
+}
+
+void operator delete[](void* p) noexcept {
+    releaseBlock(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    releaseBlock(p);
+}
+
+void operator delete[](void* p, size_t) noexcept {
+    releaseBlock(p);
+}
+
+namespace {
+
+typedef chrono::steady_clock BenchClock;
+
+const chrono::milliseconds kRunDuration(200);  ///< Wall time per configuration
+
+/**
+ * @class PerfCounters
+ * @brief Hardware event counters of this process (Linux perf_event)
+ *
+ * Each event is opened on its own, so a CPU without LLC events still
+ * reports cycles and instructions. Multiplexed counts are scaled by the
+ * fraction of time the event was actually scheduled.
+ */
+class PerfCounters {
+public:
+    static const int kEvents = 5;
+
+    /**
+     * @brief Opens every event it can
+     * @return Empty on success, otherwise why no event could be opened
+     */
+    string open() {
+#ifdef __linux__
+        const uint64_t l1dReadMiss = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                     (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        const uint32_t types[kEvents] = {PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE,
+                                         PERF_TYPE_HW_CACHE, PERF_TYPE_HARDWARE};
+        const uint64_t configs[kEvents] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+                                           PERF_COUNT_HW_BRANCH_MISSES, l1dReadMiss, PERF_COUNT_HW_CACHE_MISSES};
+        string error;
+        for (int i = 0; i < kEvents; ++i) {
+            perf_event_attr attr;
+            memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = types[i];
+            attr.config = configs[i];
+            attr.disabled = 1;
+            attr.inherit = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            fds[i] = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+            if (fds[i] < 0 && error.empty()) error = strerror(errno);
+        }
+        return any() ? "" : "perf_event_open failed: " + error;
+#else
+        return "hardware counters need Linux perf_event";
+#endif
+    }
+
+    ~PerfCounters() {
+#ifdef __linux__
+        for (int fd : fds)
+            if (fd >= 0) close(fd);
+#endif
+    }
+
+    bool any() const {
+        for (int fd : fds)
+            if (fd >= 0) return true;
+        return false;
+    }
+
+    /**
+     * @brief Zeroes and enables every open counter
+     */
+    void start() {
+#ifdef __linux__
+        for (int fd : fds) {
+            if (fd < 0) continue;
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+        running = true;
+    }
+
+    /**
+     * @brief Disables the counters and reads them
+     * @param values Scaled counts, negative for events that are not available
+     * @return False if start() was not called since the last stop()
+     */
+    bool stop(double values[kEvents]) {
+        if (!running) return false;
+        running = false;
+        for (int i = 0; i < kEvents; ++i) {
+            values[i] = -1.0;
+#ifdef __linux__
+            if (fds[i] < 0) continue;
+            ioctl(fds[i], PERF_EVENT_IOC_DISABLE, 0);
+            uint64_t data[3];   // value, time enabled, time running
+            if (read(fds[i], data, sizeof(data)) == static_cast<ssize_t>(sizeof(data)) && data[2] > 0)
+                values[i] = static_cast<double>(data[0]) * static_cast<double>(data[1]) / static_cast<double>(data[2]);
+#endif
+        }
+        return true;
+    }
+
+private:
+    int fds[kEvents] = {-1, -1, -1, -1, -1};
+    bool running = false;
+};
+
+PerfCounters* perf = nullptr;   ///< Set by --perf
+
+/**
+ * @brief Starts a measured loop: resets the hardware counters and returns the time
+ */
+BenchClock::time_point startRun() {
+    if (perf) perf->start();
+    return BenchClock::now();
+}
+
+/**
+ * @brief Returns true if the benchmark should run for the given filter
+ */
+bool selected(const string& name, const string& filter) {
+    return filter.empty() || name.find(filter) != string::npos;
+}
+
+/**
+ * @brief Prints one formatted result line
+ * @param name Benchmark and configuration name
+ * @param ops Number of operations completed
+ * @param seconds Elapsed wall time
+ * @param extra Free-form suffix (e.g. secondary counters)
+ */
+void report(const string& name, double ops, double seconds, const string& extra = "") {
+    // Stop the counters before any output, so the figures per operation exclude iostream work
+    double counts[PerfCounters::kEvents];
+    const bool counted = perf && perf->stop(counts);
+
+    cout << left << setw(36) << name
+         << right << setw(14) << fixed << setprecision(0) << ops / seconds << " ops/s"
+         << setw(12) << setprecision(1) << (seconds * 1e9) / (ops > 0 ? ops : 1) << " ns/op"
+         << "  " << extra << "\n";
+    if (!counted) return;
+    const char* names[PerfCounters::kEvents] = {"cycles", "instructions", "branch-misses", "L1d-misses", "LLC-misses"};
+    const double perOp = ops > 0 ? ops : 1;
+    cout << "    perf/op:" << setprecision(2);
+    for (int i = 0; i < PerfCounters::kEvents; ++i) {
+        if (counts[i] < 0.0) continue;
+        cout << " " << names[i] << " " << counts[i] / perOp;
+        if (i == 1 && counts[0] > 0.0) cout << " (IPC " << counts[1] / counts[0] << ")";
+    }
+    cout << "\n";
+}
+
+/**
+ * @brief Builds a lot with alternating bay sizes, half of them occupied
+ */
+vector<ParkingBay> makeLot(int bays) {
+    vector<ParkingBay> lot;
+    for (int i = 0; i < bays; ++i)
+        lot.push_back({i, (i % 4 == 0) ? 6.0 : 4.5, i % 2 == 0});
+    return lot;
+}
+
+/**
+ * @brief Mutex-protected bay vector used as the baseline for lotIndex.mixed
+ */
+struct LockedLot {
+    mutex m;
+    vector<ParkingBay> bays;
+};
+
+/**
+ * @brief Mixed read/write workload on the snapshot index and the baseline
+ *
+ * One writer thread toggles bay occupancy continuously while N reader
+ * threads repeatedly search for a free 5.5 m bay. Reads per second are
+ * reported for the total and per reader; with lock-free snapshot reads
+ * the per-reader figure should stay flat as readers are added.
+ */
+void benchLotIndexMixed() {
+    const int kBays = 256;
+    unsigned hw = thread::hardware_concurrency();
+    if (hw == 0) hw = 2;
+
+    for (unsigned readers = 1; readers <= hw; readers *= 2) {
+        // Snapshot index
+        {
+            ParkingLotIndex index(makeLot(kBays));
+            atomic<bool> stop(false);
+            atomic<long long> reads(0);
+            long long writes = 0;
+
+            vector<thread> threads;
+            for (unsigned r = 0; r < readers; ++r) {
+                threads.emplace_back([&]() {
+                    LotReader reader(index);
+                    long long local = 0;
+                    while (!stop.load(memory_order_relaxed)) {
+                        LotReadGuard guard(reader);
+                        volatile const ParkingBay* bay = guard.snapshot().findFreeBay(5.5);
+                        (void)bay;
+                        local++;
+                    }
+                    reads += local;
+                });
+            }
+            BenchClock::time_point start = startRun();
+            while (BenchClock::now() - start < kRunDuration) {
+                index.setOccupied(static_cast<int>(writes % kBays), (writes / kBays) % 2 == 0);
+                writes++;
+            }
+            stop.store(true);
+            for (size_t t = 0; t < threads.size(); ++t) threads[t].join();
+            double secs = chrono::duration<double>(BenchClock::now() - start).count();
+
+            report("lotIndex.mixed.snapshot/r=" + to_string(readers), static_cast<double>(reads.load()), secs,
+                   "per-reader " + to_string(static_cast<long long>(reads.load() / secs / readers)) +
+                   " reads/s, writes " + to_string(static_cast<long long>(writes / secs)) + "/s");
+        }
+
+        // Mutex baseline
+        {
+            LockedLot lot;
+            lot.bays = makeLot(kBays);
+            double required = requiredSpace(true, 4.5, 1.8);
+            atomic<bool> stop(false);
+            atomic<long long> reads(0);
+            long long writes = 0;
+
+            vector<thread> threads;
+            for (unsigned r = 0; r < readers; ++r) {
+                threads.emplace_back([&]() {
+                    long long local = 0;
+                    while (!stop.load(memory_order_relaxed)) {
+                        lock_guard<mutex> lock(lot.m);
+                        volatile int found = -1;
+                        for (size_t i = 0; i < lot.bays.size(); ++i) {
+                            if (!lot.bays[i].occupied && lot.bays[i].size >= required) {
+                                found = lot.bays[i].id;
+                                break;
+                            }
+                        }
+                        (void)found;
+                        local++;
+                    }
+                    reads += local;
+                });
+            }
+            BenchClock::time_point start = startRun();
+            while (BenchClock::now() - start < kRunDuration) {
+                {
+                    lock_guard<mutex> lock(lot.m);
+                    lot.bays[writes % kBays].occupied = (writes / kBays) % 2 == 0;
+                }
+                writes++;
+            }
+            stop.store(true);
+            for (size_t t = 0; t < threads.size(); ++t) threads[t].join();
+            double secs = chrono::duration<double>(BenchClock::now() - start).count();
+
+            report("lotIndex.mixed.mutex/r=" + to_string(readers), static_cast<double>(reads.load()), secs,
+                   "per-reader " + to_string(static_cast<long long>(reads.load() / secs / readers)) +
+                   " reads/s, writes " + to_string(static_cast<long long>(writes / secs)) + "/s");
+        }
+    }
+}
+
+/**
+ * @brief Change feed fan-out: one producer, N subscribers polling concurrently
+ *
+ * The producer cost per event should not depend on the number of
+ * subscribers, since each change is one slot write. Subscribers report
+ * delivered and lost events (a lost event means the subscriber was lapped).
+ */
+void benchFeedFanout() {
+    const long long kEvents = 2000000;
+    unsigned hw = thread::hardware_concurrency();
+    if (hw == 0) hw = 2;
+
+    for (unsigned subscribers = 0; subscribers <= hw; subscribers = subscribers ? subscribers * 2 : 1) {
+        BayChangeFeed feed(BayChangeFeed::kDefaultCapacity);
+        atomic<bool> done(false);
+        atomic<long long> delivered(0);
+        atomic<long long> lost(0);
+
+        vector<thread> threads;
+        for (unsigned s = 0; s < subscribers; ++s) {
+            threads.emplace_back([&]() {
+                FeedSubscriber sub(feed, true);
+                BayEvent e;
+                long long local = 0;
+                while (true) {
+                    if (sub.poll(e)) {
+                        local++;
+                    } else if (done.load(memory_order_acquire)) {
+                        if (!sub.poll(e)) break;
+                        local++;
+                    }
+                }
+                delivered += local;
+                lost += static_cast<long long>(sub.lost());
+            });
+        }
+
+        BenchClock::time_point start = startRun();
+        for (long long i = 0; i < kEvents; ++i)
+            feed.publish(static_cast<int>(i & 1023), (i & 1) != 0);
+        double secs = chrono::duration<double>(BenchClock::now() - start).count();
+        done.store(true, memory_order_release);
+        for (size_t t = 0; t < threads.size(); ++t) threads[t].join();
+
+        report("feed.fanout/subs=" + to_string(subscribers), static_cast<double>(kEvents), secs,
+               "delivered " + to_string(delivered.load()) + ", lost " + to_string(lost.load()));
+    }
+}
+
+/**
+ * @brief Vehicle/slot feasibility matrix for a lot
+ *
+ * Evaluates 64 vehicle models against 512 kerbside slots (32768 pairs)
+ * and reports the time per full matrix and per pair.
+ */
+void benchKinematicsFeasibility() {
+    const int kVehicles = 64;
+    const int kSlots = 512;
+
+    VehicleFleet fleet;
+    for (int i = 0; i < kVehicles; ++i) {
+        double scale = 0.8 + 0.4 * i / kVehicles;
+        VehicleModel v = {1.7 * scale, 2.6 * scale, 0.85 * scale, 0.75 * scale, 5.3 * scale};
+        fleet.add(v);
+    }
+    vector<double> slots;
+    for (int i = 0; i < kSlots; ++i) slots.push_back(4.0 + 4.0 * i / kSlots);
+
+    vector<unsigned char> moves;
+    long long passes = 0;
+    long long feasible = 0;
+    BenchClock::time_point start = startRun();
+    while (BenchClock::now() - start < kRunDuration) {
+        parallelFeasibility(fleet, slots, 3, moves);
+        feasible += moves[moves.size() / 2] != 0;
+        passes++;
+    }
+    double secs = chrono::duration<double>(BenchClock::now() - start).count();
+
+    report("kinematics.feasibility/lot", static_cast<double>(passes), secs,
+           to_string(kVehicles * kSlots) + " pairs per lot");
+    report("kinematics.feasibility/pair", static_cast<double>(passes) * kVehicles * kSlots, secs,
+           "sample pair feasible in " + to_string(feasible) + "/" + to_string(passes) + " passes");
+}
+
+/**
+ * @brief Measures ray casting and sensor synthesis in a large lot
+ *
+ * Scene: 20 rows of 40 parked cars with jittered poses plus perimeter
+ * walls (3,204 segments over a 200 m x 120 m lot). Rays start at random
+ * aisle positions with random directions and 5 m range, like parking
+ * sensors. The brute-force baseline tests every segment per ray.
+ */
+void benchSensorRaycast() {
+    const double kPiValue = 3.14159265358979323846;
+    ObstacleMap map;
+    vector<Segment2D> segments;
+    unsigned seed = 12345;
+    auto jitter = [&seed](double amplitude) {
+        seed = seed * 1103515245u + 12345u;
+        return amplitude * (((seed >> 8) & 0xffff) / 65535.0 - 0.5);
+    };
+    auto addWall = [&](Vec2 a, Vec2 b) {
+        map.addSegment(a, b);
+        segments.push_back(Segment2D{a, b});
+    };
+    for (int row = 0; row < 20; ++row) {
+        for (int col = 0; col < 40; ++col) {
+            OrientedBox car = {Vec2{2.5 + col * 5.0 + jitter(0.4), 3.0 + row * 6.0 + jitter(0.4)},
+                               2.3, 0.9, jitter(0.2)};
+            map.addBox(car);
+            Vec2 c[4];
+            boxCorners(car, c);
+            for (int k = 0; k < 4; ++k) segments.push_back(Segment2D{c[k], c[(k + 1) % 4]});
+        }
+    }
+    addWall(Vec2{0, 0}, Vec2{200, 0});
+    addWall(Vec2{200, 0}, Vec2{200, 120});
+    addWall(Vec2{200, 120}, Vec2{0, 120});
+    addWall(Vec2{0, 120}, Vec2{0, 0});
+    map.build(1.0);
+
+    const int kRays = 4096;
+    vector<Vec2> origins(kRays), directions(kRays);
+    for (int i = 0; i < kRays; ++i) {
+        origins[i] = Vec2{100.0 + jitter(190.0), 6.0 * (i % 20) + 6.0 + jitter(0.5)};
+        double a = jitter(2.0 * kPiValue);
+        directions[i] = Vec2{cos(a), sin(a)};
+    }
+
+    long long rays = 0;
+    double checksum = 0.0;
+    BenchClock::time_point start = startRun();
+    while (BenchClock::now() - start < kRunDuration) {
+        for (int i = 0; i < kRays; ++i) checksum += map.castRay(origins[i], directions[i], 5.0);
+        rays += kRays;
+    }
+    double secs = chrono::duration<double>(BenchClock::now() - start).count();
+    report("sensor.raycast/grid", static_cast<double>(rays), secs,
+           to_string(segments.size()) + " segments");
+
+    long long bruteRays = 0;
+    double bruteChecksum = 0.0;
+    start = startRun();
+    while (BenchClock::now() - start < kRunDuration) {
+        for (int i = 0; i < kRays; i += 16) {
+            double best = 5.0;
+            for (const Segment2D& seg : segments) {
+                Vec2 e = seg.b - seg.a;
+                double denom = cross(directions[i], e);
+                if (fabs(denom) < 1e-12) continue;
+                Vec2 w = seg.a - origins[i];
+                double t = cross(w, e) / denom;
+                double u = cross(w, directions[i]) / denom;
+                if (t >= 0 && t < best && u >= 0 && u <= 1) best = t;
+            }
+            bruteChecksum += best;
+            bruteRays++;
+        }
+    }
+    secs = chrono::duration<double>(BenchClock::now() - start).count();
+    report("sensor.raycast/bruteforce", static_cast<double>(bruteRays), secs, "baseline");
+
+    const SensorLayout& layout = findVehicleProfile("SEDAN-04")->sensors;
+    SensorSynthesizer synth(map);
+    long long frames = 0;
+    start = startRun();
+    while (BenchClock::now() - start < kRunDuration) {
+        for (int i = 0; i < kRays; ++i) {
+            Pose2D pose = {origins[i].x, origins[i].y, atan2(directions[i].y, directions[i].x)};
+            SensorData s = synth.synthesize(pose, layout, (i & 1) != 0);
+            checksum += s.left + s.center + s.right;
+        }
+        frames += kRays;
+    }
+    secs = chrono::duration<double>(BenchClock::now() - start).count();
+    report("sensor.raycast/frame", static_cast<double>(frames), secs,
+           "15 rays per frame, checksum " + to_string(static_cast<long long>(checksum + bruteChecksum) % 1000));
+}
+
+/**
+ * @brief Measures whole-path collision checks in a large lot
+ *
+ * Scene: 20 rows of 40 parked cars (800 obstacles). The path is 400 poses
+ * weaving along an aisle without touching any car, so every check runs to
+ * completion. "path" uses firstPathCollision() with its broad phase;
+ * "allObstacles" tests every pose against every obstacle.
+ */
+void benchCollisionPath() {
+    CollisionWorld world;
+    for (int row = 0; row < 20; ++row)
+        for (int col = 0; col < 40; ++col)
+            world.addObstacle(OrientedBox{Vec2{2.5 + col * 5.0, 3.0 + row * 6.0}, 2.3, 0.9,
+                                          0.02 * ((row + col) % 5 - 2)});
+
+    const VehicleModel& car = findVehicleProfile("CITY-01")->model;
+    vector<Pose2D> path;
+    for (int i = 0; i < 400; ++i) {
+        double x = 10.0 + 0.45 * i;
+        path.push_back(Pose2D{x, 66.0 + 0.6 * sin(x / 7.0), 0.6 / 7.0 * cos(x / 7.0)});
+    }
+
+    long long paths = 0;
+    long long hits = 0;
+    BenchClock::time_point start = startRun();
+    while (BenchClock::now() - start < kRunDuration) {
+        hits += firstPathCollision(world, car, path, 0.1) >= 0;
+        paths++;
+    }
+    double secs = chrono::duration<double>(BenchClock::now() - start).count();
+    report("collision.path/path", static_cast<double>(paths), secs,
+           to_string(path.size()) + " poses x " + to_string(world.obstacleCount()) +
+           " obstacles, collisions " + to_string(hits));
+
+    vector<OrientedBox> footprints;
+    for (const Pose2D& pose : path) footprints.push_back(vehicleFootprint(car, pose, 0.1));
+    paths = 0;
+    hits = 0;
+    start = startRun();
+    while (BenchClock::now() - start < kRunDuration) {
+        for (const OrientedBox& f : footprints) hits += world.collides(f);
+        paths++;
+    }
+    secs = chrono::duration<double>(BenchClock::now() - start).count();
+    report("collision.path/allObstacles", static_cast<double>(paths), secs,
+           to_string(static_cast<long long>(paths * footprints.size() * world.obstacleCount() / secs / 1e6)) +
+           "M box tests/s, collisions " + to_string(hits));
+}
+
+/**
+ * @brief Measures clearance map construction, bay updates and queries
+ *
+ * Lot: 200 m x 120 m at 10 cm resolution (2.4M cells), perimeter walls
+ * and 800 bays of which half are occupied, 8 m clearance cap.
+ */
+void benchClearanceMap() {
+    ClearanceMap map(Vec2{0, 0}, 0.1, 2000, 1200);
+    map.addObstacle(OrientedBox{Vec2{100, 0.2}, 100, 0.2, 0});
+    map.addObstacle(OrientedBox{Vec2{100, 119.8}, 100, 0.2, 0});
+    map.addObstacle(OrientedBox{Vec2{0.2, 60}, 0.2, 60, 0});
+    map.addObstacle(OrientedBox{Vec2{199.8, 60}, 0.2, 60, 0});
+    for (int row = 0; row < 20; ++row)
+        for (int col = 0; col < 40; ++col)
+            map.addBay(row * 40 + col, OrientedBox{Vec2{2.5 + col * 5.0, 3.0 + row * 6.0}, 2.3, 0.9, 0.0},
+                       (row + col) % 2 == 0);
+
+    long long builds = 0;
+    BenchClock::time_point start = startRun();
+    while (BenchClock::now() - start < kRunDuration || builds == 0) {
+        map.compute();
+        builds++;
+    }
+    double secs = chrono::duration<double>(BenchClock::now() - start).count();
+    report("clearance.map/fullCompute", static_cast<double>(builds), secs,
+           to_string(map.cols() * map.rows()) + " cells");
+
+    long long updates = 0;
+    start = startRun();
+    while (BenchClock::now() - start < kRunDuration) {
+        int bay = static_cast<int>((updates * 7919) % 800);
+        map.setBayOccupied(bay, (updates / 800) % 2 == 0);
+        updates++;
+    }
+    secs = chrono::duration<double>(BenchClock::now() - start).count();
+    report("clearance.map/bayUpdate", static_cast<double>(updates), secs, "single bay toggles");
+
+    long long queries = 0;
+    double sum = 0.0;
+    start = startRun();
+    while (BenchClock::now() - start < kRunDuration) {
+        for (int i = 0; i < 4096; ++i) sum += map.clearance(Vec2{(i * 37) % 2000 * 0.1, (i * 53) % 1200 * 0.1});
+        queries += 4096;
+    }
+    secs = chrono::duration<double>(BenchClock::now() - start).count();
+    report("clearance.map/query", static_cast<double>(queries), secs,
+           "mean clearance " + to_string(sum / queries).substr(0, 5) + " m");
+}
+
+/**
+ * @brief Measures trajectory requests served through the plan cache
+ *
+ * Lot: 20 rows of 40 identical bays, every other one occupied. Requests
+ * pick a bay at random and approach it from one of 64 aisle positions
+ * with sub-quantum jitter, so after warm-up most requests repeat a
+ * bay-relative approach seen before at some other bay. The synthetic planner builds a 200-pose
+ * approach curve and checks it against the parked cars, so a miss costs
+ * roughly what a real path validation would.
+ */
+void benchPlanCache() {
+    CollisionWorld world;
+    vector<OrientedBox> bays;
+    for (int row = 0; row < 20; ++row)
+        for (int col = 0; col < 40; ++col) {
+            OrientedBox bay = {Vec2{2.5 + col * 5.0, 3.0 + row * 6.0}, 2.3, 0.9, 0.0};
+            bays.push_back(bay);
+            if ((row + col) % 2 == 0) world.addObstacle(bay);
+        }
+    const VehicleProfile& profile = *findVehicleProfile("CITY-01");
+    const VehicleModel& car = profile.model;
+
+    unsigned seed = 12345;
+    auto nextRandom = [&seed]() {
+        seed = seed * 1103515245u + 12345u;
+        return (seed >> 8) & 0xFFFF;
+    };
+    auto request = [&](OrientedBox& bay, Pose2D& start) {
+        bay = bays[nextRandom() % bays.size()];
+        double jitter = (nextRandom() % 100) / 100.0 * 0.04 - 0.02;
+        double offset = -8.0 + 0.25 * (nextRandom() % 64);
+        start = Pose2D{bay.center.x + offset + jitter, bay.center.y + 3.0, 0.0};
+    };
+    auto plan = [&](const OrientedBox& bay, const Pose2D& start) {
+        vector<Pose2D> path;
+        for (int i = 0; i < 200; ++i) {
+            double t = i / 199.0;
+            double s = t * t * (3.0 - 2.0 * t);
+            path.push_back(Pose2D{start.x + s * (bay.center.x - start.x), start.y + t * (bay.center.y - start.y),
+                                  s * (bay.heading - start.heading)});
+        }
+        if (firstPathCollision(world, car, path, 0.05) >= 0) path.back() = path.front();
+        return path;
+    };
+
+    OrientedBox bay;
+    Pose2D start;
+    long long requests = 0;
+    size_t poses = 0;
+    BenchClock::time_point begin = startRun();
+    while (BenchClock::now() - begin < kRunDuration) {
+        request(bay, start);
+        poses += plan(bay, start).size();
+        requests++;
+    }
+    double secs = chrono::duration<double>(BenchClock::now() - begin).count();
+    report("plan.cache/planEveryRequest", static_cast<double>(requests), secs,
+           to_string(poses / requests) + " poses per plan");
+
+    PlanCache cache(4 << 20);
+    requests = 0;
+    begin = startRun();
+    while (BenchClock::now() - begin < kRunDuration) {
+        request(bay, start);
+        poses += cache.getOrPlan(bay, profile.code, start, [&]() { return plan(bay, start); }).size();
+        requests++;
+    }
+    secs = chrono::duration<double>(BenchClock::now() - begin).count();
+    PlanCacheStats stats = cache.stats();
+    ostringstream extra;
+    extra << fixed << setprecision(1) << "hit rate " << stats.hitRate() * 100.0 << "%, hit "
+          << stats.meanHitLatencyUs << " us, miss " << stats.meanMissLatencyUs << " us, "
+          << stats.entries << " entries";
+    report("plan.cache/cached", static_cast<double>(requests), secs, extra.str());
+}
+
+/**
+ * @brief Replays an aisle obstruction scenario with incremental and full replanning
+ *
+ * Lot: the 800-bay layout at 25 cm (384k cells) inflated by 0.9 m. The
+ * vehicle drives from the aisle entry towards a free bay, advancing 1 m
+ * per frame for 80 frames. A pedestrian crosses the aisle ahead of it
+ * (frames 5-35) and a trolley is left in the aisle (frames 20-50). Each
+ * frame updates the obstacles, moves the start and replans; "incremental"
+ * repairs one D* Lite search, "fromScratch" resets it every frame.
+ */
+void benchReplanObstruction() {
+    ClearanceMap map(Vec2{0, 0}, 0.25, 800, 480);
+    for (int row = 0; row < 20; ++row)
+        for (int col = 0; col < 40; ++col)
+            if ((row + col) % 2 == 0 || col < 30)
+                map.addObstacle(OrientedBox{Vec2{2.5 + col * 5.0, 3.0 + row * 6.0}, 2.3, 0.9, 0.0});
+    map.compute();
+    const GridReplanner base = GridReplanner::fromClearanceMap(map, 0.9);
+    const Vec2 entry = {1.0, 66.0};
+    const Vec2 bay = {157.5, 63.0};   // row 10, column 31 is free
+
+    struct Frame {
+        bool pedestrian;
+        OrientedBox pedestrianBox;
+        bool trolley;
+    };
+    const OrientedBox trolley = {Vec2{120.0, 66.4}, 0.5, 0.4, 0.3};
+    vector<Frame> frames;
+    for (int f = 0; f < 80; ++f) {
+        Frame frame;
+        frame.pedestrian = f >= 5 && f < 35;
+        frame.pedestrianBox = OrientedBox{Vec2{80.0, 63.5 + 0.15 * (f - 5)}, 0.3, 0.3, 0.0};
+        frame.trolley = f >= 20 && f < 50;
+        frames.push_back(frame);
+    }
+
+    for (int mode = 0; mode < 2; ++mode) {
+        const bool incremental = mode == 0;
+        long long replans = 0;
+        size_t expansions = 0;
+        double worstUs = 0.0;
+        double busy = 0.0;
+        BenchClock::time_point start = startRun();
+        while (BenchClock::now() - start < kRunDuration) {
+            GridReplanner planner = base;
+            planner.setGoal(bay);
+            Vec2 position = entry;
+            planner.setStart(position);
+            planner.replan();
+            const Frame* previous = nullptr;
+            for (const Frame& frame : frames) {
+                vector<Vec2> path = planner.path();
+                if (path.size() > 4) position = path[4];
+
+                BenchClock::time_point t0 = BenchClock::now();
+                if (previous && previous->pedestrian) planner.removeObstacle(previous->pedestrianBox, 0.9);
+                if (frame.pedestrian) planner.addObstacle(frame.pedestrianBox, 0.9);
+                if (frame.trolley && !(previous && previous->trolley)) planner.addObstacle(trolley, 0.9);
+                if (!frame.trolley && previous && previous->trolley) planner.removeObstacle(trolley, 0.9);
+                if (!incremental) planner.setGoal(bay);
+                planner.setStart(position);
+                planner.replan();
+                double us = chrono::duration<double, micro>(BenchClock::now() - t0).count();
+
+                busy += us;
+                worstUs = max(worstUs, us);
+                expansions += planner.lastExpansions();
+                replans++;
+                previous = &frame;
+            }
+        }
+        ostringstream extra;
+        extra << fixed << setprecision(0) << "mean " << busy / replans << " us, worst " << worstUs
+              << " us, " << expansions / replans << " expansions/frame";
+        report(incremental ? "replan.obstruction/incremental" : "replan.obstruction/fromScratch",
+               static_cast<double>(replans), busy / 1e6, extra.str());
+    }
+}
+
+/**
+ * @brief Measures one coordination cycle for growing numbers of vehicles
+ *
+ * Lot: 100 m x 62 m at 1 m, ten rows of 2 m deep bays with 4 m aisles,
+ * one bay in three free. Vehicles queue in the two entrance columns and
+ * each one is routed to its own free bay.
+ */
+void benchAisleCoordination() {
+    GridReplanner grid(Vec2{0, 0}, 1.0, 100, 62);
+    vector<Vec2> freeBays;
+    for (int row = 0; row < 10; ++row)
+        for (int col = 4; col < 98; col += 2) {
+            Vec2 bay = {col + 0.5, 1.5 + row * 6.0};
+            if ((col / 2 + row) % 3 == 0)
+                freeBays.push_back(bay);
+            else
+                grid.addObstacle(OrientedBox{bay, 0.4, 0.9, 0.0});
+        }
+
+    const int counts[] = {8, 16, 32, 48};
+    for (int count : counts) {
+        vector<AisleVehicle> vehicles;
+        for (int i = 0; i < count; ++i)
+            vehicles.push_back(AisleVehicle{i, Vec2{0.5 + i % 2, 3.5 + (i / 2) * 2.0},
+                                            freeBays[(i * 37) % freeBays.size()]});
+        AisleCoordinator coordinator(grid);
+        long long cycles = 0;
+        size_t planned = 0;
+        BenchClock::time_point start = startRun();
+        while (BenchClock::now() - start < kRunDuration || cycles == 0) {
+            vector<AisleRoute> routes = coordinator.coordinate(vehicles);
+            planned = 0;
+            for (const AisleRoute& r : routes) planned += r.planned;
+            cycles++;
+        }
+        double secs = chrono::duration<double>(BenchClock::now() - start).count();
+        const CoordinatorStats& stats = coordinator.lastStats();
+        report("aisle.coordination/" + to_string(count) + "vehicles", static_cast<double>(cycles), secs,
+               to_string(planned) + "/" + to_string(count) + " routed, " + to_string(stats.expansions) +
+               " expansions" + (stats.usedConflictSearch ? ", CBS " + to_string(stats.conflictNodes) + " nodes" : ""));
+    }
+}
+
+/**
+ * @brief Measures garage route and nearest-free-bay queries
+ *
+ * Campus: 4 levels of 10 aisles x 30 junctions with a bay on each side of
+ * every junction (2400 bays), cross aisles at both ends, one-way ramps up
+ * and down, two gates. 95% of the bays are occupied. Baselines run plain
+ * Dijkstra over the original graph from the query origin.
+ */
+void benchGarageRoute() {
+    const int levels = 4, rows = 10, cols = 30;
+    GarageGraph garage;
+    vector<ParkingBay> bays;
+    vector<int> gates;
+    gates.push_back(garage.addNode(GarageNodeKind::Gate, Vec2{-10.0, 0.0}, 0));
+    gates.push_back(garage.addNode(GarageNodeKind::Gate, Vec2{cols * 6.0 + 10.0, rows * 12.0}, 0));
+    vector<int> upFrom(levels), downTo(levels);
+    for (int level = 0; level < levels; ++level) {
+        vector<int> junction(rows * cols);
+        for (int r = 0; r < rows; ++r)
+            for (int c = 0; c < cols; ++c) {
+                int j = garage.addNode(GarageNodeKind::Junction, Vec2{c * 6.0, r * 12.0}, level);
+                junction[r * cols + c] = j;
+                if (c > 0) garage.addEdge(junction[r * cols + c - 1], j, 6.0);
+                if (r > 0 && (c == 0 || c == cols - 1)) garage.addEdge(junction[(r - 1) * cols + c], j, 12.0);
+                for (int side = 0; side < 2; ++side) {
+                    int id = static_cast<int>(bays.size());
+                    int bay = garage.addNode(GarageNodeKind::Bay, Vec2{c * 6.0, r * 12.0 + (side ? 4.0 : -4.0)}, level, id);
+                    garage.addEdge(j, bay, 4.0);
+                    bays.push_back(ParkingBay{id, id % 7 == 0 ? 6.0 : 5.0, (id * 7919) % 100 >= 5});
+                }
+            }
+        upFrom[level] = junction[cols - 1];
+        downTo[level] = junction[(rows - 1) * cols];
+        if (level == 0) {
+            garage.addEdge(gates[0], junction[0], 10.0);
+            garage.addEdge(gates[1], junction[rows * cols - 1], 10.0);
+        }
+    }
+    for (int level = 0; level + 1 < levels; ++level) {
+        garage.addEdge(upFrom[level], upFrom[level + 1], 40.0, true);
+        garage.addEdge(downTo[level + 1], downTo[level], 40.0, true);
+    }
+
+    BenchClock::time_point begin = startRun();
+    garage.contract();
+    double contractMs = chrono::duration<double, milli>(BenchClock::now() - begin).count();
+    ParkingLotIndex index(bays);
+    LotReader reader(index);
+    {
+        LotReadGuard guard(reader);
+        garage.bindLot(guard.snapshot());
+    }
+    ostringstream info;
+    info << garage.nodeCount() << " nodes, " << garage.shortcutCount() << " shortcuts, contracted in "
+         << fixed << setprecision(0) << contractMs << " ms";
+
+    long long queries = 0;
+    double sum = 0.0;
+    begin = startRun();
+    while (BenchClock::now() - begin < kRunDuration) {
+        int bay = garage.bayNode(static_cast<int>((queries * 7919) % bays.size()));
+        sum += garage.route(gates[queries % 2], bay).distance;
+        queries++;
+    }
+    double secs = chrono::duration<double>(BenchClock::now() - begin).count();
+    report("garage.route/ch", static_cast<double>(queries), secs, info.str());
+
+    queries = 0;
+    begin = startRun();
+    while (BenchClock::now() - begin < kRunDuration) {
+        int bay = garage.bayNode(static_cast<int>((queries * 7919) % bays.size()));
+        sum += garage.distancesFrom(gates[queries % 2])[bay];
+        queries++;
+    }
+    secs = chrono::duration<double>(BenchClock::now() - begin).count();
+    report("garage.route/dijkstra", static_cast<double>(queries), secs, "distance only");
+
+    LotReadGuard guard(reader);
+    const LotSnapshot& lot = guard.snapshot();
+    queries = 0;
+    begin = startRun();
+    while (BenchClock::now() - begin < kRunDuration) {
+        sum += garage.nearestFreeBay(gates[queries % 2], lot, queries % 3 == 0 ? 5.5 : 4.5).distance;
+        queries++;
+    }
+    secs = chrono::duration<double>(BenchClock::now() - begin).count();
+    report("garage.route/nearestFreeBayCh", static_cast<double>(queries), secs,
+           to_string(lot.freeCount) + " free bays");
+
+    queries = 0;
+    begin = startRun();
+    while (BenchClock::now() - begin < kRunDuration) {
+        vector<double> distance = garage.distancesFrom(gates[queries % 2]);
+        double required = queries % 3 == 0 ? 5.5 : 4.5;
+        double best = numeric_limits<double>::infinity();
+        for (const ParkingBay& bay : lot.bays)
+            if (!bay.occupied && bay.size >= required) best = min(best, distance[garage.bayNode(bay.id)]);
+        sum += best;
+        queries++;
+    }
+    secs = chrono::duration<double>(BenchClock::now() - begin).count();
+    report("garage.route/nearestFreeBayDijkstra", static_cast<double>(queries), secs,
+           "checksum " + to_string(static_cast<long long>(sum) % 1000));
+}
+
+/**
+ * @brief Measures status changes and throughput of the status classifier
+ *
+ * Stream: a slow reverse approach sampled at 1 kHz that stops inside the
+ * parking range, with +/-2 cm of sensor noise, so the readings dwell
+ * around 0.5 m and 0.3 m for thousands of frames. A change is a frame
+ * whose status differs from the previous frame's (stateless) or a
+ * reported event (classifier); each one is a printed and recorded line
+ * in parkingAssistantLoop().
+ */
+void benchStatusClassifier() {
+    const int frameCount = 20000;
+    vector<SensorData> frames(frameCount);
+    unsigned seed = 12345;
+    auto noise = [&seed]() {
+        seed = seed * 1103515245u + 12345u;
+        return ((seed >> 8) % 4001) / 100000.0 - 0.02;
+    };
+    for (int i = 0; i < frameCount; ++i) {
+        double center = max(0.31, 0.9 - 0.6 * i / (frameCount * 0.75));
+        frames[i] = SensorData{0.48 + noise(), center + noise(), 0.45 + noise()};
+    }
+
+    long long processed = 0;
+    size_t changes = 0;
+    string previous;
+    BenchClock::time_point begin = startRun();
+    while (BenchClock::now() - begin < kRunDuration) {
+        changes = 0;
+        previous.clear();
+        for (const SensorData& s : frames) {
+            string status = checkSafety(s);
+            changes += status != previous;
+            previous.swap(status);
+        }
+        processed += frameCount;
+    }
+    double secs = chrono::duration<double>(BenchClock::now() - begin).count();
+    report("status.classifier/checkSafety", static_cast<double>(processed), secs,
+           to_string(changes) + " changes per " + to_string(frameCount) + " frames");
+
+    StatusClassifier classifier;
+    processed = 0;
+    begin = startRun();
+    while (BenchClock::now() - begin < kRunDuration) {
+        classifier.reset();
+        for (const SensorData& s : frames) classifier.update(s);
+        processed += frameCount;
+    }
+    secs = chrono::duration<double>(BenchClock::now() - begin).count();
+    report("status.classifier/hysteresis", static_cast<double>(processed), secs,
+           to_string(classifier.transitions()) + " changes per " + to_string(frameCount) + " frames");
+}
+
+/**
+ * @brief Measures telemetry volume and codec throughput
+ *
+ * Stream: 60 s at 50 Hz of a vehicle reversing into a bay over 40 s and
+ * then standing still, with +/-3 mm of sensor noise and the status from
+ * a StatusClassifier. The baseline sends every frame as a fixed record
+ * (timestamp, three doubles, status byte).
+ */
+void benchTelemetryStream() {
+    const int frameCount = 3000;
+    vector<TelemetryFrame> frames(frameCount);
+    StatusClassifier classifier;
+    unsigned seed = 777;
+    auto noise = [&seed]() {
+        seed = seed * 1103515245u + 12345u;
+        return ((seed >> 8) % 6001) / 1000000.0 - 0.003;
+    };
+    for (int i = 0; i < frameCount; ++i) {
+        double d = max(0.4, 2.0 - 1.6 * i / 2000.0);
+        SensorData s{d + 0.3 + noise(), d + noise(), d + 0.25 + noise()};
+        classifier.update(s);
+        frames[i] = TelemetryFrame{static_cast<uint64_t>(i) * 20u, s, classifier.current()};
+    }
+    const size_t rawBytes = static_cast<size_t>(frameCount) * (sizeof(uint64_t) + 3 * sizeof(double) + 1);
+
+    long long processed = 0;
+    vector<uint8_t> stream;
+    size_t sent = 0;
+    BenchClock::time_point begin = startRun();
+    while (BenchClock::now() - begin < kRunDuration) {
+        TelemetryEncoder encoder;
+        stream.clear();
+        for (const TelemetryFrame& frame : frames) encoder.encode(frame, stream);
+        sent = encoder.framesSent();
+        processed += frameCount;
+    }
+    double secs = chrono::duration<double>(BenchClock::now() - begin).count();
+    ostringstream info;
+    info << fixed << setprecision(2) << static_cast<double>(stream.size()) / frameCount << " B/frame vs "
+         << static_cast<double>(rawBytes) / frameCount << " raw (" << setprecision(1)
+         << 100.0 * stream.size() / rawBytes << "%), " << sent << " of " << frameCount << " frames sent";
+    report("telemetry.stream/encode", static_cast<double>(processed), secs, info.str());
+
+    processed = 0;
+    size_t decoded = 0;
+    begin = startRun();
+    while (BenchClock::now() - begin < kRunDuration) {
+        TelemetryDecoder decoder;
+        decoded = decoder.decodeAll(stream).size();
+        processed += static_cast<long long>(decoded);
+    }
+    secs = chrono::duration<double>(BenchClock::now() - begin).count();
+    report("telemetry.stream/decode", static_cast<double>(processed), secs, to_string(decoded) + " frames per stream");
+}
+
+/**
+ * @brief Stream buffer that discards everything written to it
+ */
+class NullBuffer : public streambuf {
+protected:
+    int overflow(int c) override { return c; }
+};
+
+/**
+ * @brief Per-frame work of a replayed session: beep, safety status and steering guidance
+ */
+void replayPipeline(const SensorData& s) {
+    beepAlert(s);
+    string status;
+    try {
+        status = checkSafety(s);
+    } catch (const UnsafeParkingException& e) {
+        status = e.what();
+    }
+    cout << "Status: " << status << "\n";
+    if (s.left < s.right) cout << "Left side closer → Steer RIGHT.\n";
+    else if (s.right < s.left) cout << "Right side closer → Steer LEFT.\n";
+    else cout << "Both sides equal → Keep centered.\n";
+}
+
+/**
+ * @brief Measures the processing pipeline on a replayed session, with and without decimation
+ *
+ * Session: a compact hatchback drives 80 m down an 8 m aisle lined with
+ * parked cars at 2 m/s, turns, and reverses into a free bay, sampled at
+ * 50 Hz by the sensor synthesizer. The frames are recorded with
+ * writeSensorFrame() and replayed from the recording. The pipeline is
+ * beepAlert(), checkSafety() and the guidance text, with console output
+ * discarded.
+ */
+void benchScheduleReplay() {
+    const double kPiValue = 3.14159265358979323846;
+    ObstacleMap map;
+    for (int i = 0; i < 32; ++i) {
+        if (i == 20) continue;   // the free bay
+        map.addBox(OrientedBox{Vec2{2.5 + i * 2.6, 6.5}, 1.2, 2.3, 0.0});
+        map.addBox(OrientedBox{Vec2{2.5 + i * 2.6, -6.5}, 1.2, 2.3, 0.0});
+    }
+    map.addSegment(Vec2{-5, 9}, Vec2{95, 9});
+    map.addSegment(Vec2{-5, -9}, Vec2{95, -9});
+    map.build(1.0);
+    SensorSynthesizer synth(map);
+    const VehicleProfile* car = findVehicleProfile("HATCH-02");
+
+    stringstream recording;
+    const double bayX = 2.5 + 20 * 2.6;
+    for (int i = 0; i < 2000; ++i) {   // cruise past the bay and stop beyond it
+        double x = min(-4.0 + i * 0.04, bayX + 3.0);
+        writeSensorFrame(recording, synth.synthesize(Pose2D{x, 0.0, 0.0}, car->sensors, false));
+    }
+    for (int i = 0; i <= 100; ++i)      // swing round to back in
+        writeSensorFrame(recording, synth.synthesize(Pose2D{bayX + 3.0 - 3.0 * i / 100.0, 1.0 * i / 100.0,
+                                                            -kPiValue / 2.0 * i / 100.0},
+                                                     car->sensors, true));
+    for (int i = 0; i < 150; ++i)       // reverse into the bay
+        writeSensorFrame(recording, synth.synthesize(Pose2D{bayX, 1.0 + i * 0.03, -kPiValue / 2.0},
+                                                     car->sensors, true));
+    vector<SensorData> frames = readSensorFrames(recording);
+
+    NullBuffer sink;
+    streambuf* console = cout.rdbuf(&sink);
+    const int repeat = 200;
+    ReplayStats full = replaySession(frames, replayPipeline, nullptr, repeat);
+    AdaptiveScheduler scheduler;
+    ReplayStats adaptive = replaySession(frames, replayPipeline, &scheduler, repeat);
+    cout.rdbuf(console);
+
+    const double driveMinutes = frames.size() / 50.0 / 60.0;
+    auto describe = [&](const ReplayStats& r) {
+        ostringstream info;
+        info << r.processed << "/" << r.frames << " frames processed, " << fixed << setprecision(2)
+             << 1000.0 * r.cpuSeconds / repeat / driveMinutes << " CPU ms per driving minute";
+        return info.str();
+    };
+    report("schedule.replay/everyFrame", static_cast<double>(frames.size()) * repeat, full.cpuSeconds, describe(full));
+    report("schedule.replay/adaptive", static_cast<double>(frames.size()) * repeat, adaptive.cpuSeconds,
+           describe(adaptive) + ", " + to_string(adaptive.nearSkipped) + " near frames skipped");
+}
+
+/**
+ * @brief Measures beep timing with irregularly arriving frames
+ *
+ * A 1.5 s reverse approach from 1.4 m to 0.3 m is reported in frames
+ * 5..150 ms apart. Frame-tied beeping plays a beep on the first frame
+ * after the previous beep's interval has passed, so its lateness is the
+ * wait for that frame; the cadence engine plays from its timer thread.
+ * This benchmark runs in real time.
+ */
+void benchBeepCadence() {
+    const int64_t durationNs = 1500000000;
+    BeepCadenceConfig config;
+    atomic<size_t> played(0);
+    BeepCadence cadence([&played](const BeepEvent&) { played.fetch_add(1); }, config);
+
+    unsigned seed = 99;
+    size_t tiedBeeps = 0;
+    double tiedSumUs = 0.0, tiedMaxUs = 0.0;
+    int64_t tiedDue = -1;
+    cadence.start();
+    const int64_t begin = BeepCadence::nowNs();
+    for (int64_t now = begin; now - begin < durationNs; now = BeepCadence::nowNs()) {
+        double t = static_cast<double>(now - begin) / durationNs;
+        SensorData s{1.6, 1.4 - 1.1 * t, 1.7};
+        cadence.update(s, now);
+
+        // Frame-tied baseline: a beep can only play when a frame arrives
+        double interval = beepInterval(s.center, 1.1 / (durationNs * 1e-9), config);
+        if (!std::isinf(interval)) {
+            if (tiedDue < 0) tiedDue = now;
+            if (now >= tiedDue) {
+                double lateUs = (now - tiedDue) * 1e-3;
+                tiedSumUs += lateUs;
+                tiedMaxUs = max(tiedMaxUs, lateUs);
+                ++tiedBeeps;
+                tiedDue += static_cast<int64_t>(interval * 1e9);
+            }
+        }
+        seed = seed * 1103515245u + 12345u;
+        this_thread::sleep_for(chrono::milliseconds(5 + (seed >> 8) % 146));
+    }
+    cadence.stop();
+    double secs = (BeepCadence::nowNs() - begin) * 1e-9;
+
+    CadenceStats stats = cadence.stats();
+    ostringstream timer, tied;
+    timer << fixed << setprecision(0) << "mean lateness " << stats.meanJitterUs << " us, max " << stats.maxJitterUs
+          << " us, " << played.load() << " beeps";
+    tied << fixed << setprecision(0) << "mean lateness " << (tiedBeeps ? tiedSumUs / tiedBeeps : 0.0) << " us, max "
+         << tiedMaxUs << " us, " << tiedBeeps << " beeps";
+    report("beep.cadence/timerThread", static_cast<double>(stats.beeps), secs, timer.str());
+    report("beep.cadence/frameTied", static_cast<double>(tiedBeeps), secs, tied.str());
+}
+
+/**
+ * @brief Measures the per-frame cost of sensor health monitoring
+ *
+ * 20000 frames of a car shunting back and forth with a little noise, in
+ * which the center sensor freezes for the second half. The classifier runs alone, then behind
+ * the health monitor in degraded mode.
+ */
+void benchSensorHealth() {
+    const int frameCount = 20000;
+    vector<SensorData> frames(frameCount);
+    unsigned seed = 4242;
+    auto noise = [&seed]() {
+        seed = seed * 1103515245u + 12345u;
+        return ((seed >> 8) % 1001) / 100000.0 - 0.005;
+    };
+    for (int i = 0; i < frameCount; ++i) {
+        double d = 1.5 + sin(i * 0.02);
+        frames[i] = SensorData{d + 0.2 + noise(), i < frameCount / 2 ? d + noise() : 1.7, d + 0.4 + noise()};
+    }
+
+    StatusClassifier classifier;
+    long long processed = 0;
+    BenchClock::time_point begin = startRun();
+    while (BenchClock::now() - begin < kRunDuration) {
+        classifier.reset();
+        for (const SensorData& s : frames) classifier.update(s);
+        processed += frameCount;
+    }
+    double secs = chrono::duration<double>(BenchClock::now() - begin).count();
+    report("sensor.health/classifier", static_cast<double>(processed), secs, "no health checks");
+
+    SensorHealthMonitor monitor;
+    size_t degradedFrames = 0;
+    processed = 0;
+    begin = startRun();
+    while (BenchClock::now() - begin < kRunDuration) {
+        classifier.reset();
+        monitor.reset();
+        degradedFrames = 0;
+        for (const SensorData& s : frames) {
+            unsigned mask = monitor.update(s);
+            degradedFrames += mask != 0;
+            classifier.setDegradedSensors(mask);
+            classifier.update(s);
+        }
+        processed += frameCount;
+    }
+    secs = chrono::duration<double>(BenchClock::now() - begin).count();
+    report("sensor.health/monitored", static_cast<double>(processed), secs,
+           to_string(degradedFrames) + " of " + to_string(frameCount) + " frames degraded");
+}
+
+/**
+ * @brief Measures recalibration of an archived session
+ *
+ * 200000 frames, about an hour at 50 Hz, are shifted back and forth by
+ * two calibrations so the values stay bounded over the repetitions.
+ */
+void benchCalibrationReplay() {
+    const size_t frameCount = 200000;
+    vector<SensorData> frames(frameCount);
+    for (size_t i = 0; i < frameCount; ++i) {
+        double d = 1.5 + sin(i * 0.01);
+        frames[i] = SensorData{d + 0.2, d, d + 0.4};
+    }
+    SensorCalibration forward, back;
+    forward.left.offset = forward.center.offset = forward.right.offset = 0.01f;
+    forward.center.tempCoeff = 0.0017f;
+    back.left.offset = back.center.offset = back.right.offset = -0.01f;
+
+    long long processed = 0;
+    BenchClock::time_point begin = startRun();
+    for (int pass = 0; BenchClock::now() - begin < kRunDuration; ++pass) {
+        const SensorCalibration& cal = pass % 2 ? back : forward;
+        for (SensorData& s : frames) s = calibrate(s, cal, 20.0);
+        processed += frameCount;
+    }
+    double secs = chrono::duration<double>(BenchClock::now() - begin).count();
+    report("calibration.replay/perFrame", static_cast<double>(processed), secs, "calibrate() on each frame");
+
+    processed = 0;
+    begin = startRun();
+    for (int pass = 0; BenchClock::now() - begin < kRunDuration; ++pass) {
+        calibrateFrames(frames, pass % 2 ? back : forward, 20.0);
+        processed += frameCount;
+    }
+    secs = chrono::duration<double>(BenchClock::now() - begin).count();
+    report("calibration.replay/batch", static_cast<double>(processed), secs, "calibrateFrames()");
+}
+
+/**
+ * @brief Measures the per-frame cost of the deadline watchdog
+ *
+ * Each frame passes through all four loop stages around an empty body,
+ * so the figure is the watchdog's own bookkeeping: five steady-clock
+ * reads and a few relaxed atomic stores.
+ */
+void benchWatchdogOverhead() {
+    DeadlineWatchdog watchdog;
+    long long frames = 0, overruns = 0;
+    BenchClock::time_point begin = startRun();
+    while (BenchClock::now() - begin < kRunDuration) {
+        for (int i = 0; i < 1000; ++i) {
+            watchdog.beginFrame(LoopStage::Alert);
+            watchdog.stage(LoopStage::Classify);
+            watchdog.stage(LoopStage::Guidance);
+            watchdog.stage(LoopStage::Record);
+            overruns += watchdog.endFrame();
+        }
+        frames += 1000;
+    }
+    double secs = chrono::duration<double>(BenchClock::now() - begin).count();
+    report("watchdog.overhead", static_cast<double>(frames), secs, to_string(overruns) + " overruns");
+}
+
+/**
+ * @brief Measures decision latency under an ingest burst
+ *
+ * A bus thread pushes frames of four vehicles every 2 us while the
+ * decision loop spends 20 us on each frame it classifies. A FIFO queue
+ * decides every frame, so its frames wait longer and longer; the
+ * coalescer decides only the newest frame of each vehicle. Latency is
+ * the age of a frame when its decision is made.
+ */
+void benchIngestBurst() {
+    const int vehicles = 4;
+    const int64_t pushEveryNs = 2000, decisionNs = 20000;
+    const string ids[vehicles] = {"CAR-0", "CAR-1", "CAR-2", "CAR-3"};
+
+    for (int coalesce = 0; coalesce < 2; ++coalesce) {
+        FrameCoalescer ingest;
+        mutex queueMutex;
+        deque<CoalescedFrame> queue;
+        atomic<bool> busy(true);
+        const int64_t begin = BeepCadence::nowNs();
+        const int64_t durationNs = chrono::duration_cast<chrono::nanoseconds>(kRunDuration).count();
+
+        thread bus([&]() {
+            for (int64_t i = 0;; ++i) {
+                const int64_t due = begin + i * pushEveryNs;
+                if (due - begin >= durationNs) break;
+                while (BeepCadence::nowNs() < due) {}
+                SensorData s{1.0, 0.5 + (i % 100) * 0.01, 1.0};
+                if (coalesce) {
+                    ingest.push(ids[i % vehicles], s);
+                } else {
+                    lock_guard<mutex> lock(queueMutex);
+                    queue.push_back(CoalescedFrame{static_cast<size_t>(i % vehicles), s, BeepCadence::nowNs(), 0, false});
+                }
+            }
+            busy = false;
+        });
+
+        StatusClassifier classifiers[vehicles];
+        vector<CoalescedFrame> frames;
+        long long decisions = 0;
+        double sumLatencyMs = 0.0, maxLatencyMs = 0.0;
+        while (busy) {
+            frames.clear();
+            if (coalesce) {
+                if (ingest.waitForFrames(0.001)) ingest.drain(frames);
+            } else {
+                lock_guard<mutex> lock(queueMutex);
+                if (!queue.empty()) {
+                    frames.push_back(queue.front());
+                    queue.pop_front();
+                }
+            }
+            for (const CoalescedFrame& f : frames) {
+                classifiers[f.vehicle].update(f.data);
+                const int64_t done = BeepCadence::nowNs() + decisionNs;
+                while (BeepCadence::nowNs() < done) {}
+                const double latencyMs = (BeepCadence::nowNs() - f.receivedNs) * 1e-6;
+                sumLatencyMs += latencyMs;
+                maxLatencyMs = max(maxLatencyMs, latencyMs);
+                ++decisions;
+            }
+        }
+        bus.join();
+        const double secs = (BeepCadence::nowNs() - begin) * 1e-9;
+
+        ostringstream extra;
+        extra << fixed << setprecision(2) << "mean latency " << sumLatencyMs / max(decisions, 1LL) << " ms, max "
+              << maxLatencyMs << " ms, ";
+        if (coalesce)
+            extra << ingest.stats().coalesced << " coalesced";
+        else
+            extra << queue.size() << " left queued";
+        report(coalesce ? "ingest.burst/coalesced" : "ingest.burst/fifo", static_cast<double>(decisions), secs,
+               extra.str());
+    }
+}
+
+/**
+ * @brief Measures per-reading status classification
+ *
+ * 4096 readings spread over every zone above the collision distance
+ * (checkSafety() throws on a collision), so the comparisons of both
+ * classifiers branch unpredictably. checkSafety() returns a freshly
+ * built string, while plainStatus() returns an enum.
+ */
+void benchSafetyCheck() {
+    const int frameCount = 4096;
+    vector<SensorData> frames(frameCount);
+    unsigned seed = 2024;
+    auto distance = [&seed]() {
+        seed = seed * 1103515245u + 12345u;
+        return 0.11 + ((seed >> 8) % 1000) / 1000.0;
+    };
+    for (SensorData& s : frames) s = SensorData{distance(), distance(), distance()};
+
+    long long processed = 0;
+    size_t parked = 0;
+    BenchClock::time_point begin = startRun();
+    while (BenchClock::now() - begin < kRunDuration) {
+        parked = 0;
+        for (const SensorData& s : frames) parked += checkSafety(s) == "Perfectly Parked ✅";
+        processed += frameCount;
+    }
+    double secs = chrono::duration<double>(BenchClock::now() - begin).count();
+    report("safety.check/checkSafety", static_cast<double>(processed), secs, to_string(parked) + " parked");
+
+    processed = 0;
+    begin = startRun();
+    while (BenchClock::now() - begin < kRunDuration) {
+        parked = 0;
+        for (const SensorData& s : frames) parked += plainStatus(s) == ParkingStatus::PerfectlyParked;
+        processed += frameCount;
+    }
+    secs = chrono::duration<double>(BenchClock::now() - begin).count();
+    report("safety.check/plainStatus", static_cast<double>(processed), secs, to_string(parked) + " parked");
+}
+
+/**
+ * @brief Measures the hot-path cost of live metrics
+ *
+ * A counter add and a histogram record are relaxed atomic adds on cache
+ * lines no other metric uses, so four threads updating their own
+ * counters should cost about as much per add as one thread.
+ */
+void benchMetricsOverhead() {
+    MetricsRegistry registry;
+    MetricCounter frames = registry.counter("bench_frames_total");
+    MetricHistogram latency = registry.histogram("bench_latency_seconds");
+
+    long long adds = 0;
+    BenchClock::time_point begin = startRun();
+    while (BenchClock::now() - begin < kRunDuration) {
+        for (int i = 0; i < 1000; ++i) frames.add();
+        adds += 1000;
+    }
+    double secs = chrono::duration<double>(BenchClock::now() - begin).count();
+    report("metrics.counter", static_cast<double>(adds), secs, "1 thread");
+
+    long long records = 0;
+    begin = startRun();
+    while (BenchClock::now() - begin < kRunDuration) {
+        for (int i = 0; i < 1000; ++i) latency.record(static_cast<uint64_t>(records + i) * 37 % 50000);
+        records += 1000;
+    }
+    secs = chrono::duration<double>(BenchClock::now() - begin).count();
+    report("metrics.histogram", static_cast<double>(records), secs, "1 thread");
+
+    const int threads = 4;
+    MetricCounter counters[threads];
+    for (int t = 0; t < threads; ++t) counters[t] = registry.counter("bench_worker_" + to_string(t) + "_total");
+    atomic<long long> total(0);
+    vector<thread> workers;
+    begin = startRun();
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]() {
+            long long local = 0;
+            while (BenchClock::now() - begin < kRunDuration) {
+                for (int i = 0; i < 1000; ++i) counters[t].add();
+                local += 1000;
+            }
+            total += local;
+        });
+    }
+    for (thread& w : workers) w.join();
+    secs = chrono::duration<double>(BenchClock::now() - begin).count();
+    report("metrics.counter", static_cast<double>(total.load()), secs, to_string(threads) + " threads, own counters");
+}
+
+/**
+ * @brief Runs a shell command and returns its standard output
+ * @return Output without trailing whitespace, or empty if the command cannot start
+ */
+string commandOutput(const string& command) {
+    string output;
+#ifdef _WIN32
+    FILE* pipe = _popen(command.c_str(), "r");
+#else
+    FILE* pipe = popen(command.c_str(), "r");
+#endif
+    if (!pipe) return output;
+    char buffer[128];
+    while (fgets(buffer, sizeof(buffer), pipe)) output += buffer;
+#ifdef _WIN32
+    _pclose(pipe);
+#else
+    pclose(pipe);
+#endif
+    while (!output.empty() && isspace(static_cast<unsigned char>(output.back()))) output.pop_back();
+    return output;
+}
+
+/**
+ * @brief Commit the benchmark is built from, for the history file
+ * @return Abbreviated hash of HEAD, with "-dirty" for modified tracked
+ *         files, or empty outside a git work tree
+ */
+string currentCommit() {
+    string commit = commandOutput("git rev-parse --short=12 HEAD 2>" PARKING_NULL_DEVICE);
+    if (!commit.empty() && !commandOutput("git status --porcelain --untracked-files=no 2>" PARKING_NULL_DEVICE).empty())
+        commit += "-dirty";
+    return commit;
+}
+
+/**
+ * @brief Names a --compare commit the way currentCommit() recorded it
+ * @param commit Any git revision, e.g. a full or short hash, a tag or HEAD~1,
+ *        optionally with "-dirty"
+ * @return The 12-character hash with the same suffix, or the argument as
+ *         given if git cannot resolve it, e.g. for a --commit label
+ */
+string resolveCommit(const string& commit) {
+    const string dirty = "-dirty";
+    const bool isDirty =
+        commit.size() > dirty.size() && commit.compare(commit.size() - dirty.size(), dirty.size(), dirty) == 0;
+    const string revision = isDirty ? commit.substr(0, commit.size() - dirty.size()) : commit;
+    // Only plain revision names reach the shell
+    if (revision.empty() || revision.find_first_not_of("ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz"
+                                                       "0123456789._/~^-@") != string::npos)
+        return commit;
+    const string hash = commandOutput("git rev-parse --verify --quiet --short=12 " + revision + "^{commit} 2>" +
+                                      PARKING_NULL_DEVICE);
+    return hash.empty() ? commit : hash + (isDirty ? dirty : "");
+}
+
+/**
+ * @brief Repeated runs of the core paths for the benchmark history
+ * @param repeat Runs per benchmark; the benchmarks take turns so drift hits all of them
+ * @return One sample per run and benchmark, with the commit left empty
+ *
+ * - checkSafety: 4096 readings in every zone above the collision distance
+ * - requiredSpace: both parking types for varying vehicle sizes
+ * - findParkingSpace: three spaces typed in, the last one fits
+ * - replay: 600-frame reverse approach through beep, safety and guidance
+ *
+ * Console output of findParkingSpace() and the pipeline is discarded.
+ */
+vector<BenchSample> benchRegression(int repeat) {
+    const chrono::milliseconds sampleDuration(50);
+
+    vector<SensorData> readings(4096);
+    unsigned seed = 2024;
+    auto distance = [&seed]() {
+        seed = seed * 1103515245u + 12345u;
+        return 0.11 + ((seed >> 8) % 1000) / 1000.0;
+    };
+    for (SensorData& s : readings) s = SensorData{distance(), distance(), distance()};
+
+    vector<SensorData> session;
+    for (int i = 0; i < 600; ++i) {
+        const double d = 3.0 - i * 0.0048;
+        session.push_back(SensorData{d + 0.05 * sin(i * 0.05), d, d + 0.05 * cos(i * 0.05)});
+    }
+
+    const int scansPerBatch = 256;
+    string scanInput;
+    for (int i = 0; i < scansPerBatch; ++i) scanInput += "3\n4.0\n5.0\n6.5\n";
+
+    volatile double sink = 0.0;
+    struct Case {
+        const char* name;
+        function<long long()> batch;   ///< Runs a batch, returns the operations done
+    };
+    const vector<Case> cases = {
+        {"regression/checkSafety", [&]() {
+             size_t length = 0;
+             for (const SensorData& s : readings) length += checkSafety(s).size();
+             sink = sink + length;
+             return static_cast<long long>(readings.size());
+         }},
+        {"regression/requiredSpace", [&]() {
+             double total = 0.0;
+             for (int i = 0; i < 4096; ++i) total += requiredSpace(i & 1, 3.5 + (i & 63) * 0.03, 1.6 + (i & 15) * 0.02);
+             sink = sink + total;
+             return 4096LL;
+         }},
+        {"regression/findParkingSpace", [&]() {
+             istringstream input(scanInput);
+             streambuf* keyboard = cin.rdbuf(input.rdbuf());
+             int found = 0;
+             for (int i = 0; i < scansPerBatch; ++i) found += findParkingSpace(true, 4.5, 1.8);
+             cin.rdbuf(keyboard);
+             sink = sink + found;
+             return static_cast<long long>(scansPerBatch);
+         }},
+        {"regression/replay", [&]() {
+             for (const SensorData& s : session) replayPipeline(s);
+             return static_cast<long long>(session.size());
+         }},
+    };
+
+    NullBuffer discard;
+    streambuf* console = cout.rdbuf(&discard);
+    vector<BenchSample> samples;
+    vector<vector<double>> nsPerOp(cases.size());
+    vector<double> totalOps(cases.size(), 0.0), totalSecs(cases.size(), 0.0), allocs(cases.size(), 0.0);
+    for (int r = 0; r < repeat; ++r) {
+        for (size_t c = 0; c < cases.size(); ++c) {
+            long long ops = 0;
+            const size_t allocationsBefore = heapAllocations.load(memory_order_relaxed);
+            BenchClock::time_point begin = BenchClock::now();
+            while (BenchClock::now() - begin < sampleDuration) ops += cases[c].batch();
+            const double secs = chrono::duration<double>(BenchClock::now() - begin).count();
+            const double allocsPerOp =
+                static_cast<double>(heapAllocations.load(memory_order_relaxed) - allocationsBefore) / ops;
+            samples.push_back(BenchSample{"", cases[c].name, secs * 1e9 / ops, allocsPerOp});
+            nsPerOp[c].push_back(secs * 1e9 / ops);
+            totalOps[c] += ops;
+            totalSecs[c] += secs;
+            allocs[c] += allocsPerOp / repeat;
+        }
+    }
+    cout.rdbuf(console);
+
+    for (size_t c = 0; c < cases.size(); ++c) {
+        double lowest = nsPerOp[c][0], highest = nsPerOp[c][0];
+        for (double ns : nsPerOp[c]) {
+            lowest = min(lowest, ns);
+            highest = max(highest, ns);
+        }
+        ostringstream extra;
+        extra << fixed << setprecision(2) << allocs[c] << " allocs/op, " << repeat << " runs, " << setprecision(1)
+              << lowest << ".." << highest << " ns/op";
+        report(cases[c].name, totalOps[c], totalSecs[c], extra.str());
+    }
+    return samples;
+}
+
+/**
+ * @brief Appends the regression runs to the history and compares them with an earlier commit
+ * @param samples Runs of this build, commit still empty
+ * @return Exit status: 0 if nothing regressed, 1 for a regression, 2 if the comparison is impossible
+ */
+int recordAndCompare(vector<BenchSample> samples, const string& historyPath, string commit,
+                     const string& baselineCommit, const RegressionConfig& config) {
+    if (commit.empty()) commit = currentCommit();
+    if (commit.empty()) {
+        cerr << "❌ Not in a git work tree; name the measured build with --commit ID\n";
+        return 2;
+    }
+    for (BenchSample& s : samples) s.commit = commit;
+
+    try {
+        // Read the baseline before appending, so a commit is never compared with its own fresh runs
+        vector<BenchSample> baseline;
+        if (!baselineCommit.empty())
+            baseline = commitRuns(loadBenchHistory(historyPath), resolveCommit(baselineCommit));
+        appendBenchHistory(historyPath, samples);
+        cout << "Appended " << samples.size() << " runs of " << commit << " to " << historyPath << "\n";
+        if (baselineCommit.empty()) return 0;
+        if (baseline.empty()) {
+            cerr << "❌ No runs of " << baselineCommit << " to compare with in " << historyPath << "\n";
+            return 2;
+        }
+
+        vector<RegressionCheck> checks = findRegressions(baseline, samples, config);
+        cout << "\n=== Regression check: " << commit << " vs " << baseline.front().commit << " ===\n";
+        bool regressed = false, compared = false;
+        for (const RegressionCheck& check : checks) {
+            if (!check.skipped.empty()) {
+                cout << left << setw(30) << check.benchmark << "SKIPPED (" << check.skipped << ")\n";
+                continue;
+            }
+            compared = true;
+            cout << left << setw(30) << check.benchmark << setw(10) << check.metric << right << fixed
+                 << setprecision(2) << setw(12) << check.baselineMean << " -> " << setw(12) << check.candidateMean
+                 << "  " << showpos << setprecision(1) << check.change * 100.0 << noshowpos << " %  p "
+                 << setprecision(4) << check.pValue << (check.regression ? "  REGRESSION" : "") << "\n";
+            regressed = regressed || check.regression;
+        }
+        if (!compared) {
+            cerr << "❌ No benchmark could be compared with " << baseline.front().commit << "\n";
+            return 2;
+        }
+        cout << (regressed ? "❌ FAIL" : "✅ PASS") << " (alpha " << config.alpha << ", minimum change "
+             << config.minChange * 100.0 << " %)\n";
+        return regressed ? 1 : 0;
+    } catch (const exception& e) {
+        cerr << "❌ " << e.what() << "\n";
+        return 2;
+    }
+}
+
+} // namespace
+
+/**
+ * @brief Benchmark entry point
+ * @param argc Argument count
+ * @param argv Optional --perf flag and benchmark name filter
+ * @return 0 on completion
+ */
+int main(int argc, char* argv[]) {
+    string filter, historyPath, commit, baselineCommit;
+    bool withPerf = false;
+    int repeat = 5;
+    RegressionConfig regression;
+    for (int i = 1; i < argc; ++i) {
+        const string arg = argv[i];
+        if (arg == "--perf") {
+            withPerf = true;
+        } else if (arg == "--history" && i + 1 < argc) {
+            historyPath = argv[++i];
+        } else if (arg == "--commit" && i + 1 < argc) {
+            commit = argv[++i];
+        } else if (arg == "--compare" && i + 1 < argc) {
+            baselineCommit = argv[++i];
+        } else if (arg == "--repeat" && i + 1 < argc) {
+            repeat = atoi(argv[++i]);
+        } else if (arg == "--min-change" && i + 1 < argc) {
+            regression.minChange = atof(argv[++i]);
+        } else {
+            filter = arg;
+        }
+    }
+    if (repeat < 2 || (!baselineCommit.empty() && historyPath.empty())) {
+        cerr << "Usage: " << argv[0] << " [--perf] [--history FILE [--compare COMMIT] [--commit ID]]"
+             << " [--repeat N>=2] [--min-change FRACTION] [FILTER]\n";
+        return 2;
+    }
+
+    cout << "=== Autonomous Parking Assistant Benchmarks ===\n";
+    PerfCounters counters;
+    if (withPerf) {
+        string error = counters.open();
+        if (error.empty())
+            perf = &counters;
+        else
+            cout << "Hardware counters unavailable (" << error << ")\n";
+    }
+    if (selected("lotIndex.mixed", filter)) benchLotIndexMixed();
+    if (selected("feed.fanout", filter)) benchFeedFanout();
+    if (selected("kinematics.feasibility", filter)) benchKinematicsFeasibility();
+    if (selected("sensor.raycast", filter)) benchSensorRaycast();
+    if (selected("collision.path", filter)) benchCollisionPath();
+    if (selected("clearance.map", filter)) benchClearanceMap();
+    if (selected("plan.cache", filter)) benchPlanCache();
+    if (selected("replan.obstruction", filter)) benchReplanObstruction();
+    if (selected("aisle.coordination", filter)) benchAisleCoordination();
+    if (selected("garage.route", filter)) benchGarageRoute();
+    if (selected("status.classifier", filter)) benchStatusClassifier();
+    if (selected("telemetry.stream", filter)) benchTelemetryStream();
+    if (selected("schedule.replay", filter)) benchScheduleReplay();
+    if (selected("beep.cadence", filter)) benchBeepCadence();
+    if (selected("sensor.health", filter)) benchSensorHealth();
+    if (selected("calibration.replay", filter)) benchCalibrationReplay();
+    if (selected("watchdog.overhead", filter)) benchWatchdogOverhead();
+    if (selected("ingest.burst", filter)) benchIngestBurst();
+    if (selected("safety.check", filter)) benchSafetyCheck();
+    if (selected("metrics.overhead", filter)) benchMetricsOverhead();
+
+    vector<BenchSample> samples;
+    if (selected("regression", filter)) samples = benchRegression(repeat);
+    if (historyPath.empty()) return 0;
+    if (samples.empty()) {
+        cerr << "❌ --history needs the regression benchmarks; the filter excludes them\n";
+        return 2;
+    }
+    return recordAndCompare(samples, historyPath, commit, baselineCommit, regression);
+}
@@ -8,6 +8,7 @@ REM and the unit test suite with proper linking and optimization.
 REM
 REM Features:
 REM - C++14 standard compliance
+REM - Core sources compiled once into bin/libparkingCore.a
 REM - Separate compilation of main application and tests
 REM - Automatic bin directory creation
 REM - Proper source file linking
@@ -21,8 +22,10 @@ REM Usage:
 REM   build.bat
 REM
 REM Output:
+REM   bin/libparkingCore.a - Core library linked by every executable
 REM   bin/AutonomousParkingAssistant.exe - Main application
-REM   bin/testParkingUtils.exe - Unit test suite
+REM   bin/test*.exe - Unit test suites (one per tests/*.cpp file)
+REM   bin/benchParkingAssistant.exe - Benchmarks
 REM
 REM Author: Autonomous Parking Assistant Team
 REM Version: 2.0
@@ -34,17 +37,69 @@ REM Create bin directory if it doesn't exist
 REM Ensures the output directory exists before compilation
 if not exist "bin" mkdir bin
 
-REM Compile main application (compile all source files together)
-REM Links ParkingUtils.cpp and main.cpp to create the main application executable
+REM Core library sources shared by every executable
+set CORE_SOURCES=src/ParkingUtils.cpp src/LotIndex.cpp src/BayChangeFeed.cpp src/VehicleKinematics.cpp src/VehicleCatalogue.cpp src/SensorSynthesizer.cpp src/CollisionChecker.cpp src/ClearanceMap.cpp src/PlanCache.cpp src/GridReplanner.cpp src/AisleCoordinator.cpp src/GarageGraph.cpp src/StatusClassifier.cpp src/TelemetryCodec.cpp src/AdaptiveScheduler.cpp src/BeepCadence.cpp src/SensorHealthMonitor.cpp src/SensorCalibration.cpp src/SessionSummary.cpp src/DeadlineWatchdog.cpp src/FrameCoalescer.cpp src/Tracer.cpp src/MetricsRegistry.cpp src/DecisionDiff.cpp src/BenchHistory.cpp
+
+REM Compile the core library once
+REM Every executable below links this one archive instead of recompiling the core
+REM (always optimized so benchmark and parkingDiff throughput stay meaningful)
+echo Compiling core library...
+if not exist "bin\obj" mkdir bin\obj
+setlocal enabledelayedexpansion
+set CORE_OBJECTS=
+for %%s in (%CORE_SOURCES%) do (
+    g++ -std=c++14 -O2 -Iinclude -pthread -c %%s -o bin/obj/%%~ns.o || exit /b 1
+    set CORE_OBJECTS=!CORE_OBJECTS! bin/obj/%%~ns.o
+)
+if exist "bin\libparkingCore.a" del bin\libparkingCore.a
+ar rcs bin/libparkingCore.a !CORE_OBJECTS!
+set CORE_LIB=bin/libparkingCore.a
+
+REM Compile main application
+REM Links main.cpp against the core library to create the main application executable
 echo Compiling main application...
-g++ -std=c++14 -Iinclude -o bin/AutonomousParkingAssistant.exe src/ParkingUtils.cpp src/main.cpp
+g++ -std=c++14 -Iinclude -pthread -o bin/AutonomousParkingAssistant.exe src/main.cpp %CORE_LIB%
 
-REM Compile unit tests (include ParkingUtils.cpp for function implementations)
-REM Links testParkingUtils.cpp and ParkingUtils.cpp to create the test suite executable
+REM Compile unit tests (linked against the core library)
+REM Each test file links against the core library to create its test suite executable
 echo Compiling unit tests...
-g++ -std=c++14 -Iinclude -o bin/testParkingUtils.exe tests/testParkingUtils.cpp src/ParkingUtils.cpp
+g++ -std=c++14 -Iinclude -pthread -o bin/testParkingUtils.exe tests/testParkingUtils.cpp %CORE_LIB%
+g++ -std=c++14 -Iinclude -pthread -o bin/testLotIndex.exe tests/testLotIndex.cpp %CORE_LIB%
+g++ -std=c++14 -Iinclude -pthread -o bin/testBayChangeFeed.exe tests/testBayChangeFeed.cpp %CORE_LIB%
+g++ -std=c++14 -Iinclude -pthread -o bin/testVehicleKinematics.exe tests/testVehicleKinematics.cpp %CORE_LIB%
+g++ -std=c++14 -Iinclude -pthread -o bin/testVehicleCatalogue.exe tests/testVehicleCatalogue.cpp %CORE_LIB%
+g++ -std=c++14 -Iinclude -pthread -o bin/testSensorSynthesizer.exe tests/testSensorSynthesizer.cpp %CORE_LIB%
+g++ -std=c++14 -Iinclude -pthread -o bin/testCollisionChecker.exe tests/testCollisionChecker.cpp %CORE_LIB%
+g++ -std=c++14 -Iinclude -pthread -o bin/testClearanceMap.exe tests/testClearanceMap.cpp %CORE_LIB%
+g++ -std=c++14 -Iinclude -pthread -o bin/testPlanCache.exe tests/testPlanCache.cpp %CORE_LIB%
+g++ -std=c++14 -Iinclude -pthread -o bin/testGridReplanner.exe tests/testGridReplanner.cpp %CORE_LIB%
+g++ -std=c++14 -Iinclude -pthread -o bin/testAisleCoordinator.exe tests/testAisleCoordinator.cpp %CORE_LIB%
+g++ -std=c++14 -Iinclude -pthread -o bin/testGarageGraph.exe tests/testGarageGraph.cpp %CORE_LIB%
+g++ -std=c++14 -Iinclude -pthread -o bin/testStatusClassifier.exe tests/testStatusClassifier.cpp %CORE_LIB%
+g++ -std=c++14 -Iinclude -pthread -o bin/testTelemetryCodec.exe tests/testTelemetryCodec.cpp %CORE_LIB%
+g++ -std=c++14 -Iinclude -pthread -o bin/testAdaptiveScheduler.exe tests/testAdaptiveScheduler.cpp %CORE_LIB%
+g++ -std=c++14 -Iinclude -pthread -o bin/testBeepCadence.exe tests/testBeepCadence.cpp %CORE_LIB%
+g++ -std=c++14 -Iinclude -pthread -o bin/testSensorHealthMonitor.exe tests/testSensorHealthMonitor.cpp %CORE_LIB%
+g++ -std=c++14 -Iinclude -pthread -o bin/testSensorCalibration.exe tests/testSensorCalibration.cpp %CORE_LIB%
+g++ -std=c++14 -Iinclude -pthread -o bin/testSessionSummary.exe tests/testSessionSummary.cpp %CORE_LIB%
+g++ -std=c++14 -Iinclude -pthread -o bin/testDeadlineWatchdog.exe tests/testDeadlineWatchdog.cpp %CORE_LIB%
+g++ -std=c++14 -Iinclude -pthread -o bin/testFrameCoalescer.exe tests/testFrameCoalescer.cpp %CORE_LIB%
+g++ -std=c++14 -Iinclude -pthread -o bin/testTracer.exe tests/testTracer.cpp %CORE_LIB%
+g++ -std=c++14 -Iinclude -pthread -o bin/testMetricsRegistry.exe tests/testMetricsRegistry.cpp %CORE_LIB%
+g++ -std=c++14 -Iinclude -pthread -o bin/testDecisionDiff.exe tests/testDecisionDiff.cpp %CORE_LIB%
+g++ -std=c++14 -Iinclude -pthread -o bin/testBenchHistory.exe tests/testBenchHistory.cpp %CORE_LIB%
+
+REM Compile benchmarks (always optimized)
+echo Compiling benchmarks...
+g++ -std=c++14 -O2 -Iinclude -pthread -o bin/benchParkingAssistant.exe benchmarks/benchParkingAssistant.cpp %CORE_LIB%
+
+REM Compile tools
+echo Compiling tools...
+g++ -std=c++14 -O2 -Iinclude -pthread -o bin/parkingMetrics.exe tools/parkingMetrics.cpp %CORE_LIB%
+g++ -std=c++14 -O2 -Iinclude -pthread -o bin/parkingDiff.exe tools/parkingDiff.cpp %CORE_LIB%
 
 echo Build complete!
 echo.
 echo To run the application: bin\AutonomousParkingAssistant.exe
-echo To run tests: bin\testParkingUtils.exe
+echo To run tests: for %%t in (bin\test*.exe) do %%t
+echo To run benchmarks: bin\benchParkingAssistant.exe
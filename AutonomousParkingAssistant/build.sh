@@ -8,6 +8,7 @@
 #
 # Features:
 # - C++14 standard compliance
+# - Core sources compiled once into bin/libparkingCore.a
 # - Separate compilation of main application and tests
 # - Automatic bin directory creation
 # - Proper source file linking
@@ -23,8 +24,10 @@
 #   ./build.sh
 #
 # Output:
+#   bin/libparkingCore.a - Core library linked by every executable
 #   bin/AutonomousParkingAssistant - Main application
-#   bin/testParkingUtils - Unit test suite
+#   bin/test* - Unit test suites (one per tests/*.cpp file)
+#   bin/benchParkingAssistant - Benchmarks
 #
 # Author: Autonomous Parking Assistant Team
 # Version: 2.0
@@ -36,17 +39,81 @@ echo "Building Autonomous Parking Assistant..."
 # Ensures the output directory exists before compilation
 mkdir -p bin
 
-# Compile main application (compile all source files together)
-# Links ParkingUtils.cpp and main.cpp to create the main application executable
+# Core library sources shared by every executable
+CORE_SOURCES="src/ParkingUtils.cpp src/LotIndex.cpp src/BayChangeFeed.cpp src/VehicleKinematics.cpp src/VehicleCatalogue.cpp src/SensorSynthesizer.cpp src/CollisionChecker.cpp src/ClearanceMap.cpp src/PlanCache.cpp src/GridReplanner.cpp src/AisleCoordinator.cpp src/GarageGraph.cpp src/StatusClassifier.cpp src/TelemetryCodec.cpp src/AdaptiveScheduler.cpp src/BeepCadence.cpp src/SensorHealthMonitor.cpp src/SensorCalibration.cpp src/SessionSummary.cpp src/DeadlineWatchdog.cpp src/FrameCoalescer.cpp src/Tracer.cpp src/MetricsRegistry.cpp src/DecisionDiff.cpp src/BenchHistory.cpp"
+
+# System libraries (POSIX shared memory lives in librt on Linux)
+SYSTEM_LIBS=""
+if [ "$(uname)" = "Linux" ]; then
+    SYSTEM_LIBS="-lrt"
+fi
+
+# Optional Chrome trace instrumentation: PARKING_ENABLE_TRACING=1 ./build.sh
+TRACE_FLAGS=""
+if [ "${PARKING_ENABLE_TRACING:-0}" = "1" ]; then
+    TRACE_FLAGS="-DPARKING_ENABLE_TRACING"
+fi
+
+# Compile the core library once
+# Every executable below links this one archive instead of recompiling the core
+# (always optimized so benchmark and parkingDiff throughput stay meaningful)
+echo "Compiling core library..."
+mkdir -p bin/obj
+CORE_OBJECTS=""
+for src in $CORE_SOURCES; do
+    obj="bin/obj/$(basename "$src" .cpp).o"
+    g++ -std=c++14 -O2 -Iinclude -pthread $TRACE_FLAGS -c "$src" -o "$obj" || exit 1
+    CORE_OBJECTS="$CORE_OBJECTS $obj"
+done
+rm -f bin/libparkingCore.a
+ar rcs bin/libparkingCore.a $CORE_OBJECTS
+CORE_LIB="bin/libparkingCore.a"
+
+# Compile main application
+# Links main.cpp against the core library to create the main application executable
 echo "Compiling main application..."
-g++ -std=c++14 -Iinclude -o bin/AutonomousParkingAssistant src/ParkingUtils.cpp src/main.cpp
+g++ -std=c++14 -Iinclude -pthread $TRACE_FLAGS -o bin/AutonomousParkingAssistant src/main.cpp $CORE_LIB $SYSTEM_LIBS
 
-# Compile unit tests (include ParkingUtils.cpp for function implementations)
-# Links testParkingUtils.cpp and ParkingUtils.cpp to create the test suite executable
+# Compile unit tests (linked against the core library)
+# Each test file links against the core library to create its test suite executable
 echo "Compiling unit tests..."
-g++ -std=c++14 -Iinclude -o bin/testParkingUtils tests/testParkingUtils.cpp src/ParkingUtils.cpp
+g++ -std=c++14 -Iinclude -pthread $TRACE_FLAGS -o bin/testParkingUtils tests/testParkingUtils.cpp $CORE_LIB $SYSTEM_LIBS
+g++ -std=c++14 -Iinclude -pthread $TRACE_FLAGS -o bin/testLotIndex tests/testLotIndex.cpp $CORE_LIB $SYSTEM_LIBS
+g++ -std=c++14 -Iinclude -pthread $TRACE_FLAGS -o bin/testBayChangeFeed tests/testBayChangeFeed.cpp $CORE_LIB $SYSTEM_LIBS
+g++ -std=c++14 -Iinclude -pthread $TRACE_FLAGS -o bin/testVehicleKinematics tests/testVehicleKinematics.cpp $CORE_LIB $SYSTEM_LIBS
+g++ -std=c++14 -Iinclude -pthread $TRACE_FLAGS -o bin/testVehicleCatalogue tests/testVehicleCatalogue.cpp $CORE_LIB $SYSTEM_LIBS
+g++ -std=c++14 -Iinclude -pthread $TRACE_FLAGS -o bin/testSensorSynthesizer tests/testSensorSynthesizer.cpp $CORE_LIB $SYSTEM_LIBS
+g++ -std=c++14 -Iinclude -pthread $TRACE_FLAGS -o bin/testCollisionChecker tests/testCollisionChecker.cpp $CORE_LIB $SYSTEM_LIBS
+g++ -std=c++14 -Iinclude -pthread $TRACE_FLAGS -o bin/testClearanceMap tests/testClearanceMap.cpp $CORE_LIB $SYSTEM_LIBS
+g++ -std=c++14 -Iinclude -pthread $TRACE_FLAGS -o bin/testPlanCache tests/testPlanCache.cpp $CORE_LIB $SYSTEM_LIBS
+g++ -std=c++14 -Iinclude -pthread $TRACE_FLAGS -o bin/testGridReplanner tests/testGridReplanner.cpp $CORE_LIB $SYSTEM_LIBS
+g++ -std=c++14 -Iinclude -pthread $TRACE_FLAGS -o bin/testAisleCoordinator tests/testAisleCoordinator.cpp $CORE_LIB $SYSTEM_LIBS
+g++ -std=c++14 -Iinclude -pthread $TRACE_FLAGS -o bin/testGarageGraph tests/testGarageGraph.cpp $CORE_LIB $SYSTEM_LIBS
+g++ -std=c++14 -Iinclude -pthread $TRACE_FLAGS -o bin/testStatusClassifier tests/testStatusClassifier.cpp $CORE_LIB $SYSTEM_LIBS
+g++ -std=c++14 -Iinclude -pthread $TRACE_FLAGS -o bin/testTelemetryCodec tests/testTelemetryCodec.cpp $CORE_LIB $SYSTEM_LIBS
+g++ -std=c++14 -Iinclude -pthread $TRACE_FLAGS -o bin/testAdaptiveScheduler tests/testAdaptiveScheduler.cpp $CORE_LIB $SYSTEM_LIBS
+g++ -std=c++14 -Iinclude -pthread $TRACE_FLAGS -o bin/testBeepCadence tests/testBeepCadence.cpp $CORE_LIB $SYSTEM_LIBS
+g++ -std=c++14 -Iinclude -pthread $TRACE_FLAGS -o bin/testSensorHealthMonitor tests/testSensorHealthMonitor.cpp $CORE_LIB $SYSTEM_LIBS
+g++ -std=c++14 -Iinclude -pthread $TRACE_FLAGS -o bin/testSensorCalibration tests/testSensorCalibration.cpp $CORE_LIB $SYSTEM_LIBS
+g++ -std=c++14 -Iinclude -pthread $TRACE_FLAGS -o bin/testSessionSummary tests/testSessionSummary.cpp $CORE_LIB $SYSTEM_LIBS
+g++ -std=c++14 -Iinclude -pthread $TRACE_FLAGS -o bin/testDeadlineWatchdog tests/testDeadlineWatchdog.cpp $CORE_LIB $SYSTEM_LIBS
+g++ -std=c++14 -Iinclude -pthread $TRACE_FLAGS -o bin/testFrameCoalescer tests/testFrameCoalescer.cpp $CORE_LIB $SYSTEM_LIBS
+g++ -std=c++14 -Iinclude -pthread $TRACE_FLAGS -o bin/testTracer tests/testTracer.cpp $CORE_LIB $SYSTEM_LIBS
+g++ -std=c++14 -Iinclude -pthread $TRACE_FLAGS -o bin/testMetricsRegistry tests/testMetricsRegistry.cpp $CORE_LIB $SYSTEM_LIBS
+g++ -std=c++14 -Iinclude -pthread $TRACE_FLAGS -o bin/testDecisionDiff tests/testDecisionDiff.cpp $CORE_LIB $SYSTEM_LIBS
+g++ -std=c++14 -Iinclude -pthread $TRACE_FLAGS -o bin/testBenchHistory tests/testBenchHistory.cpp $CORE_LIB $SYSTEM_LIBS
+
+# Compile benchmarks (always optimized)
+echo "Compiling benchmarks..."
+g++ -std=c++14 -O2 -Iinclude -pthread $TRACE_FLAGS -o bin/benchParkingAssistant benchmarks/benchParkingAssistant.cpp $CORE_LIB $SYSTEM_LIBS
+
+# Compile tools
+echo "Compiling tools..."
+g++ -std=c++14 -O2 -Iinclude -pthread $TRACE_FLAGS -o bin/parkingMetrics tools/parkingMetrics.cpp $CORE_LIB $SYSTEM_LIBS
+g++ -std=c++14 -O2 -Iinclude -pthread $TRACE_FLAGS -o bin/parkingDiff tools/parkingDiff.cpp $CORE_LIB $SYSTEM_LIBS
 
 echo "Build complete!"
 echo ""
 echo "To run the application: ./bin/AutonomousParkingAssistant"
-echo "To run tests: ./bin/testParkingUtils"
+echo "To run tests: for t in bin/test*; do ./$t || break; done"
+echo "To run benchmarks: ./bin/benchParkingAssistant"
@@ -0,0 +1,233 @@
+/**
+ * @file AisleCoordinator.h
+ * @brief Conflict-free routing of several automated vehicles through shared aisles
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ *
+ * This file declares a coordinator that plans simultaneous routes for
+ * vehicles heading to their allocated bays so that no two vehicles occupy
+ * the same grid cell at the same time step or swap cells head-on.
+ *
+ * Routes are planned one vehicle at a time in priority order with a
+ * space-time A* search against a hashed reservation table of the cells
+ * already claimed by higher-priority vehicles (prioritized planning).
+ * When a vehicle cannot be routed that way, for example because an
+ * earlier vehicle parks on the only way through, the coordinator falls
+ * back to conflict-based search (CBS) over all vehicles. Every search
+ * step is charged against a fixed expansion budget, so one coordination
+ * cycle has bounded compute regardless of how many vehicles are waiting.
+ */
+
+#ifndef AISLE_COORDINATOR_H
+#define AISLE_COORDINATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "Geometry2D.h"
+
+class GridReplanner;
+class ParkingLotIndex;
+
+/**
+ * @class ReservationTable
+ * @brief Hashed set of claimed (cell, time) pairs and forbidden moves
+ *
+ * Vehicles that reach their goal stay there, so the end of a reserved
+ * route claims its last cell for every later time step.
+ */
+class ReservationTable {
+public:
+    /**
+     * @brief Claims every cell of a route (cell per time step, starting at t = 0)
+     *
+     * Also forbids the reverse of each move, so later routes cannot swap
+     * cells with this one, and parks the route on its last cell.
+     */
+    void reserveRoute(const std::vector<int>& cells);
+
+    void forbidCell(int cell, int time) { cellTimes.insert(cellKey(cell, time)); noteTime(cell, time); }
+    void forbidMove(int from, int to, int time) { moves.insert(moveKey(from, to, time)); }
+
+    /**
+     * @brief Returns true if the cell is neither reserved nor parked on at the given time
+     */
+    bool cellFree(int cell, int time) const;
+
+    /**
+     * @brief Returns true if moving from one cell to another between time and time + 1 is allowed
+     */
+    bool moveFree(int from, int to, int time) const {
+        return moves.empty() || !moves.count(moveKey(from, to, time));
+    }
+
+    /**
+     * @brief Returns true if a route could be reserved without a conflict
+     *
+     * Every cell and move must be free, and nothing may pass its last cell
+     * after the route parks there.
+     */
+    bool routeFree(const std::vector<int>& cells) const;
+
+    /**
+     * @brief Returns the last time step at which the cell is reserved, or -1
+     *
+     * A vehicle may only finish on its goal after this time, since it
+     * stays there afterwards.
+     */
+    int lastReservedTime(int cell) const;
+
+    void clear();
+
+private:
+    static std::uint64_t cellKey(int cell, int time) {
+        return (static_cast<std::uint64_t>(time) << 32) | static_cast<std::uint32_t>(cell);
+    }
+    static std::uint64_t moveKey(int from, int to, int time) {
+        return (static_cast<std::uint64_t>(time) << 48) | (static_cast<std::uint64_t>(from) << 24) |
+               static_cast<std::uint64_t>(to);
+    }
+    void noteTime(int cell, int time);
+
+    std::unordered_set<std::uint64_t> cellTimes;   ///< Reserved (cell, time) pairs
+    std::unordered_set<std::uint64_t> moves;       ///< Forbidden (from, to, time) moves
+    std::unordered_map<int, int> parkedFrom;       ///< Cell -> time from which a vehicle stays there
+    std::unordered_map<int, int> lastTime;         ///< Cell -> last reserved time step
+};
+
+/**
+ * @struct AisleVehicle
+ * @brief One vehicle to route, in priority order
+ */
+struct AisleVehicle {
+    int vehicleId;  ///< Caller's vehicle identifier
+    Vec2 start;     ///< Current position (world coordinates)
+    Vec2 goal;      ///< Bay entry position (world coordinates)
+};
+
+/**
+ * @struct AisleArrival
+ * @brief A vehicle arriving at the lot that still needs a bay
+ */
+struct AisleArrival {
+    int vehicleId;        ///< Caller's vehicle identifier
+    Vec2 start;           ///< Current position (world coordinates)
+    double requiredSize;  ///< Required bay size, e.g. from requiredSpace()
+};
+
+/**
+ * @struct AisleRoute
+ * @brief Coordinated route of one vehicle
+ */
+struct AisleRoute {
+    int vehicleId;                ///< Vehicle identifier
+    int bayId;                    ///< Allocated bay (admitArrivals() only), -1 otherwise
+    bool planned;                 ///< false if no conflict-free route was found within budget
+    std::vector<Vec2> waypoints;  ///< Cell center per time step, starting at the start cell
+};
+
+/**
+ * @struct CoordinatorLimits
+ * @brief Compute bounds for one coordination cycle
+ */
+struct CoordinatorLimits {
+    int horizon = 512;                     ///< Maximum route duration in time steps
+    std::size_t maxExpansions = 2000000;   ///< Search states expanded per cycle, all searches included
+    std::size_t maxConflictNodes = 256;    ///< Constraint tree nodes per conflict-based search
+};
+
+/**
+ * @struct CoordinatorStats
+ * @brief What the last coordination cycle did
+ */
+struct CoordinatorStats {
+    std::size_t expansions = 0;         ///< Search states expanded
+    std::size_t prioritizedFailures = 0; ///< Vehicles prioritized planning could not route
+    bool usedConflictSearch = false;    ///< Whether the CBS fallback ran
+    std::size_t conflictNodes = 0;      ///< Constraint tree nodes expanded by CBS
+    bool budgetExhausted = false;       ///< Whether maxExpansions cut a search short
+};
+
+/**
+ * @class AisleCoordinator
+ * @brief Plans conflict-free routes for many vehicles on a shared grid
+ *
+ * Vehicles move between 4-connected free cells of the lot grid or wait,
+ * one cell per time step. The grid is copied from a GridReplanner, so
+ * the same occupancy (static obstacles, inflation) is used as for
+ * single-vehicle planning.
+ *
+ * @example
+ * AisleCoordinator coordinator(lotGrid);
+ * std::vector<AisleRoute> routes = coordinator.admitArrivals(index, bayEntries, arrivals);
+ * for (const AisleRoute& r : routes) if (r.planned) dispatch(r.vehicleId, r.waypoints);
+ */
+class AisleCoordinator {
+public:
+    /**
+     * @brief Creates a coordinator over the free cells of a grid
+     * @param grid Occupancy grid of the lot
+     * @param limits Per-cycle compute bounds
+     * @throws std::invalid_argument if the grid or horizon exceed the reservation key ranges
+     */
+    explicit AisleCoordinator(const GridReplanner& grid, const CoordinatorLimits& limits = CoordinatorLimits());
+
+    /**
+     * @brief Plans routes for vehicles whose goals are already known
+     * @param vehicles Vehicles in priority order (highest first)
+     * @return One route per vehicle, in the same order
+     * @throws std::out_of_range if a start or goal lies outside the grid
+     */
+    std::vector<AisleRoute> coordinate(const std::vector<AisleVehicle>& vehicles);
+
+    /**
+     * @brief Allocates bays to arriving vehicles and routes them
+     * @param index Lot index; allocated bays are marked occupied
+     * @param bayEntries Aisle position in front of each bay, by bay id
+     * @param arrivals Arriving vehicles in priority order
+     * @return One route per arrival, in the same order
+     * @throws std::invalid_argument if an allocated bay has no entry position
+     * @throws std::out_of_range if a start or bay entry lies outside the grid
+     *
+     * Bays claimed so far are released before either exception leaves.
+     * Each arrival gets the first free bay that fits, exactly as
+     * LotSnapshot::findFreeBay() chooses it. Arrivals that get no bay or
+     * no route come back unplanned and any bay claimed for them is released.
+     */
+    std::vector<AisleRoute> admitArrivals(ParkingLotIndex& index, const std::unordered_map<int, Vec2>& bayEntries,
+                                          const std::vector<AisleArrival>& arrivals);
+
+    /**
+     * @brief Returns statistics for the last coordinate() or admitArrivals() call
+     */
+    const CoordinatorStats& lastStats() const { return stats; }
+
+private:
+    struct Constraint {
+        int vehicle;
+        int from;   ///< -1 for a cell constraint
+        int cell;
+        int time;
+    };
+
+    int cellOf(Vec2 p) const;
+    Vec2 centerOf(int cell) const;
+    const std::vector<int>& distancesTo(int goal);
+    bool searchRoute(int start, int goal, const ReservationTable& table, std::vector<int>& route);
+    bool conflictSearch(const std::vector<int>& starts, const std::vector<int>& goals,
+                        std::vector<std::vector<int>>& routes);
+
+    Vec2 origin;
+    double resolution;
+    int cols;
+    int rows;
+    std::vector<std::uint8_t> blocked;
+    CoordinatorLimits limits;
+    CoordinatorStats stats;
+    std::unordered_map<int, std::vector<int>> distanceCache;  ///< Goal cell -> BFS distances on the static grid
+};
+
+#endif // AISLE_COORDINATOR_H
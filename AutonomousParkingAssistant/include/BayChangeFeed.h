@@ -0,0 +1,196 @@
+/**
+ * @file BayChangeFeed.h
+ * @brief Publish/subscribe ring buffer of bay occupancy changes
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ *
+ * This file declares the change feed used to fan out bay state changes
+ * to gates, signage and analytics. Every occupy/free event is written
+ * once into a fixed-size ring buffer; any number of subscribers read it
+ * at their own pace using sequence numbers. The ring can live in process
+ * memory or in a named shared-memory segment so that separate display
+ * processes can subscribe without querying the lot.
+ */
+
+#ifndef BAY_CHANGE_FEED_H
+#define BAY_CHANGE_FEED_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @struct BayEvent
+ * @brief One occupancy change as seen by a subscriber
+ *
+ * @var BayEvent::sequence
+ * Feed sequence number, starting at 1 and increasing by one per event
+ *
+ * @var BayEvent::bayId
+ * Bay whose state changed
+ *
+ * @var BayEvent::occupied
+ * New occupancy state (true = occupied, false = freed)
+ *
+ * @var BayEvent::timestampNs
+ * Publisher steady-clock timestamp in nanoseconds
+ */
+struct BayEvent {
+    std::uint64_t sequence;     ///< Feed sequence number (1-based)
+    int bayId;                  ///< Bay identifier
+    bool occupied;              ///< New occupancy state
+    std::int64_t timestampNs;   ///< Publish time (steady clock, ns)
+};
+
+/**
+ * @class BayChangeFeed
+ * @brief Single-producer, multi-consumer ring buffer of BayEvent records
+ *
+ * The producer never waits for subscribers: when the ring wraps, the
+ * oldest events are overwritten and slow subscribers are told how many
+ * events they lost. Each slot is protected by its own sequence number
+ * (a per-slot seqlock), so subscribers never block the producer and
+ * never observe a torn event.
+ *
+ * Only one thread may publish at a time. ParkingLotIndex satisfies this
+ * by publishing under its writer mutex.
+ *
+ * @note Capacity is rounded up to a power of two
+ * @note Shared-memory feeds are available on POSIX systems only
+ *
+ * @example
+ * BayChangeFeed feed(1024);
+ * FeedSubscriber display(feed);
+ * feed.publish(12, true);
+ * BayEvent e;
+ * while (display.poll(e)) updateSign(e.bayId, e.occupied);
+ */
+class BayChangeFeed {
+public:
+    static const std::size_t kDefaultCapacity = 4096;  ///< Default ring size (events)
+
+    /**
+     * @brief Creates an in-process feed
+     * @param capacity Ring size in events (rounded up to a power of two)
+     */
+    explicit BayChangeFeed(std::size_t capacity = kDefaultCapacity);
+
+    /**
+     * @brief Creates a named shared-memory feed for cross-process subscribers
+     * @param name Segment name (e.g. "/parking_lot_feed")
+     * @param capacity Ring size in events (rounded up to a power of two)
+     * @return The producer-side feed
+     * @throws std::runtime_error if the segment cannot be created or the
+     *         platform does not support shared memory
+     *
+     * An existing segment with the same name is replaced.
+     */
+    static BayChangeFeed createShared(const std::string& name, std::size_t capacity = kDefaultCapacity);
+
+    /**
+     * @brief Maps a shared-memory feed created by another process read-only
+     * @param name Segment name passed to createShared()
+     * @return A feed view suitable for FeedSubscriber; publish() on it throws
+     * @throws std::runtime_error if the segment does not exist or is not a feed
+     */
+    static BayChangeFeed attachShared(const std::string& name);
+
+    /**
+     * @brief Removes a named shared-memory feed
+     * @param name Segment name passed to createShared()
+     *
+     * Existing mappings stay valid until they are destroyed.
+     */
+    static void unlinkShared(const std::string& name);
+
+    BayChangeFeed(BayChangeFeed&& other);
+    ~BayChangeFeed();
+
+    BayChangeFeed(const BayChangeFeed&) = delete;
+    BayChangeFeed& operator=(const BayChangeFeed&) = delete;
+    BayChangeFeed& operator=(BayChangeFeed&&) = delete;
+
+    /**
+     * @brief Appends an occupancy change to the feed
+     * @param bayId Bay whose state changed
+     * @param occupied New occupancy state
+     * @return Sequence number assigned to the event
+     *
+     * Cost is one slot write regardless of the number of subscribers.
+     *
+     * @throws std::runtime_error on a feed returned by attachShared()
+     */
+    std::uint64_t publish(int bayId, bool occupied);
+
+    /**
+     * @brief Returns the sequence number of the most recent event (0 if none)
+     */
+    std::uint64_t lastSequence() const;
+
+    /**
+     * @brief Returns the ring size in events
+     */
+    std::size_t capacity() const;
+
+private:
+    friend class FeedSubscriber;
+
+    struct Header;
+    struct Slot;
+
+    BayChangeFeed(void* region, std::size_t regionBytes, bool shared, bool readOnly);
+    static std::size_t regionSize(std::size_t capacity);
+
+    Header* header;             ///< Feed metadata and head sequence
+    Slot* slots;                ///< Ring storage following the header
+    std::size_t regionBytes;    ///< Size of the mapped/allocated region
+    bool shared;                ///< Region is a shared-memory mapping
+    bool readOnly;              ///< Mapped for subscribing only
+};
+
+/**
+ * @class FeedSubscriber
+ * @brief Independent read cursor over a BayChangeFeed
+ *
+ * Each display or consumer thread owns a subscriber. Subscribers hold no
+ * state in the feed itself, so adding one costs the producer nothing.
+ */
+class FeedSubscriber {
+public:
+    /**
+     * @brief Subscribes to a feed
+     * @param feed Feed to read
+     * @param fromOldest Start at the oldest retained event instead of
+     *        only receiving events published after subscription
+     */
+    explicit FeedSubscriber(const BayChangeFeed& feed, bool fromOldest = false);
+
+    /**
+     * @brief Reads the next event if one is available
+     * @param out Receives the event
+     * @return true if an event was read, false if the subscriber is caught up
+     *
+     * If the producer lapped this subscriber, the cursor jumps to the oldest
+     * retained event and lost() is increased by the number of skipped events.
+     */
+    bool poll(BayEvent& out);
+
+    /**
+     * @brief Returns the total number of events skipped due to overruns
+     */
+    std::uint64_t lost() const { return lostEvents; }
+
+    /**
+     * @brief Returns the sequence number the next poll() will try to read
+     */
+    std::uint64_t nextSequence() const { return next; }
+
+private:
+    const BayChangeFeed& feed;
+    std::uint64_t next;
+    std::uint64_t lostEvents;
+};
+
+#endif // BAY_CHANGE_FEED_H
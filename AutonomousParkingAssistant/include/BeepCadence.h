@@ -0,0 +1,170 @@
+/**
+ * @file BeepCadence.h
+ * @brief Timer-driven proximity beep cadence independent of the frame loop
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ *
+ * beepAlert() beeps at most once per sensor frame, so the beep rate
+ * follows the rate at which frames arrive. This file declares a cadence
+ * engine that turns the closest distance and the time to collision into
+ * a continuous beep interval and plays the beeps from its own timer
+ * thread. The frame loop only reports readings; between frames the
+ * engine extrapolates the distance from the closing speed, so the beeps
+ * speed up smoothly even when frames arrive late or in bursts.
+ *
+ * On Linux the thread sleeps on a timerfd armed with absolute
+ * CLOCK_MONOTONIC deadlines, woken early through an eventfd when a
+ * reading changes the cadence. Other platforms use a condition variable
+ * with the same deadlines. Every beep records how late it fired.
+ */
+
+#ifndef BEEP_CADENCE_H
+#define BEEP_CADENCE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include "SensorData.h"
+
+/**
+ * @struct BeepCadenceConfig
+ * @brief Distance bands and beep intervals of the cadence engine
+ */
+struct BeepCadenceConfig {
+    double startDistance = 1.5;       ///< Silent at or beyond this distance (meters)
+    double continuousDistance = 0.3;  ///< Fastest cadence at or below this distance (meters)
+    double minInterval = 0.08;        ///< Interval of the fastest cadence (seconds)
+    double maxInterval = 0.8;         ///< Interval just inside startDistance (seconds)
+    double ttcHorizon = 1.5;          ///< Time to collision below which the cadence speeds up (seconds)
+    double maxExtrapolation = 0.25;   ///< Longest time a reading is extrapolated forward (seconds)
+};
+
+/**
+ * @struct BeepEvent
+ * @brief One beep as played by the timer thread
+ */
+struct BeepEvent {
+    std::int64_t scheduledNs;   ///< Steady-clock time the beep was due
+    std::int64_t firedNs;       ///< Steady-clock time it was played
+    double interval;            ///< Cadence interval in force (seconds)
+    double distance;            ///< Extrapolated closest distance (meters)
+    bool continuous;            ///< Closest distance is inside the continuous band
+};
+
+/**
+ * @struct CadenceStats
+ * @brief Timing quality of the beeps played so far
+ */
+struct CadenceStats {
+    std::size_t beeps = 0;        ///< Beeps played
+    double meanJitterUs = 0.0;    ///< Mean lateness against the schedule (microseconds)
+    double maxJitterUs = 0.0;     ///< Worst lateness (microseconds)
+};
+
+/**
+ * @brief Beep interval for a distance and closing speed
+ * @param distance Closest distance in meters
+ * @param closingSpeed Approach speed in m/s (positive when closing in)
+ * @param config Cadence settings
+ * @return Interval in seconds, or infinity for silence
+ *
+ * The interval falls linearly from maxInterval at startDistance to
+ * minInterval at continuousDistance. When the time to collision is
+ * below ttcHorizon, the interval is also capped at
+ * maxInterval * ttc / ttcHorizon, so fast approaches beep faster.
+ */
+double beepInterval(double distance, double closingSpeed, const BeepCadenceConfig& config);
+
+/**
+ * @class BeepCadence
+ * @brief Plays proximity beeps from a timer thread at a distance-driven cadence
+ *
+ * The sink runs on the timer thread and must not throw. It should be
+ * quick, since it delays the next beep. update() may be called from any
+ * thread, but not concurrently with start() or stop().
+ *
+ * @example
+ * BeepCadence cadence([](const BeepEvent& e) { speaker.click(e.continuous); });
+ * cadence.start();
+ * while (readFrame(s)) cadence.update(s);
+ * cadence.stop();
+ */
+class BeepCadence {
+public:
+    typedef std::function<void(const BeepEvent&)> Sink;
+
+    /**
+     * @brief Creates a stopped engine
+     * @throws std::invalid_argument for a missing sink or inconsistent settings
+     */
+    explicit BeepCadence(Sink sink, const BeepCadenceConfig& config = BeepCadenceConfig());
+    ~BeepCadence();
+
+    BeepCadence(const BeepCadence&) = delete;
+    BeepCadence& operator=(const BeepCadence&) = delete;
+
+    /**
+     * @brief Starts the timer thread
+     * @throws std::runtime_error if the timer cannot be created
+     */
+    void start();
+
+    /**
+     * @brief Stops and joins the timer thread (no-op if not running)
+     */
+    void stop();
+
+    /**
+     * @brief Reports a sensor frame received now
+     */
+    void update(const SensorData& s);
+
+    /**
+     * @brief Reports a sensor frame with its steady-clock timestamp
+     */
+    void update(const SensorData& s, std::int64_t timestampNs);
+
+    bool running() const { return active.load(); }
+    double closingSpeed() const;
+    CadenceStats stats() const;
+
+    /**
+     * @brief Current steady-clock time in nanoseconds
+     */
+    static std::int64_t nowNs();
+
+private:
+    void run();
+    void cadenceAt(std::int64_t now, double& interval, double& distance) const;
+    bool waitUntil(std::int64_t deadlineNs);
+    void wake();
+
+    Sink sink;
+    BeepCadenceConfig settings;
+    std::atomic<bool> active{false};
+    std::thread worker;
+
+    mutable std::mutex stateMutex;
+    bool haveReading = false;
+    double lastDistance = 0.0;
+    std::int64_t lastUpdateNs = 0;
+    double speed = 0.0;               ///< Smoothed closing speed (m/s)
+    double scheduledInterval = 0.0;   ///< Interval the timer was last armed with
+
+    std::size_t beeps = 0;
+    double jitterSumUs = 0.0;
+    double jitterMaxUs = 0.0;
+
+    // Wake-up channel of the timer thread
+    int timerFd = -1;
+    int eventFd = -1;
+    std::condition_variable wakeCondition;
+    bool wakeRequested = false;
+};
+
+#endif // BEEP_CADENCE_H
@@ -0,0 +1,130 @@
+/**
+ * @file BenchHistory.h
+ * @brief Benchmark history keyed by git commit and regression detection
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ *
+ * The benchmark executable appends its repeated measurements of the
+ * core paths (checkSafety(), requiredSpace(), findParkingSpace() and the
+ * replay pipeline) to a local history file, one line per run and
+ * benchmark, keyed by the commit that was measured. A later build can
+ * compare its own runs with those of an earlier commit.
+ *
+ * A benchmark regresses when its mean time or allocations per operation
+ * grew by more than a minimum relative change and Welch's t-test finds
+ * the growth significant. The minimum change keeps tiny but consistent
+ * differences from failing a build; the test keeps noisy ones from
+ * failing it.
+ */
+
+#ifndef BENCH_HISTORY_H
+#define BENCH_HISTORY_H
+
+#include <string>
+#include <vector>
+
+/**
+ * @struct BenchSample
+ * @brief One run of one benchmark
+ */
+struct BenchSample {
+    std::string commit;       ///< Commit the build was made from
+    std::string benchmark;    ///< Benchmark name, without spaces
+    double nsPerOp;           ///< Wall time per operation
+    double allocsPerOp;       ///< Heap allocations per operation
+};
+
+/**
+ * @brief Appends runs to a history file, creating it if needed
+ * @throws std::runtime_error if the file cannot be written
+ * @throws std::invalid_argument for a commit or benchmark name with whitespace
+ */
+void appendBenchHistory(const std::string& path, const std::vector<BenchSample>& samples);
+
+/**
+ * @brief Reads every run of a history file
+ * @return Runs in file order; empty if the file does not exist
+ * @throws std::runtime_error for a malformed line
+ */
+std::vector<BenchSample> loadBenchHistory(const std::string& path);
+
+/**
+ * @brief Runs of one commit in a history
+ * @param history Runs of any number of commits
+ * @param commit Commit as recorded, or an abbreviation or longer form of
+ *        its hash, e.g. a 7-character or full hash for a 12-character entry
+ * @return Runs of the exactly matching commit if there is one, otherwise
+ *         of the one commit the abbreviation or longer form matches
+ * @throws std::invalid_argument if the commit matches runs of several commits
+ */
+std::vector<BenchSample> commitRuns(const std::vector<BenchSample>& history, const std::string& commit);
+
+/**
+ * @struct WelchResult
+ * @brief Outcome of Welch's t-test for a larger candidate mean
+ */
+struct WelchResult {
+    double t = 0.0;                   ///< Test statistic, positive when the candidate mean is larger
+    double degreesOfFreedom = 0.0;    ///< Welch-Satterthwaite approximation
+    double pValue = 1.0;              ///< One-sided: chance of a t this large without a real increase
+};
+
+/**
+ * @brief Welch's unequal-variance t-test of candidate mean > baseline mean
+ * @throws std::invalid_argument unless both sides have at least two values
+ *
+ * With no variance on either side (e.g. allocation counts) the result is
+ * exact: p is 0 if the candidate mean is larger and 1 otherwise.
+ */
+WelchResult welchTest(const std::vector<double>& baseline, const std::vector<double>& candidate);
+
+/**
+ * @brief Upper tail probability P(T > t) of Student's t distribution
+ * @param t Statistic
+ * @param degreesOfFreedom Positive degrees of freedom (need not be whole)
+ */
+double studentTUpperTail(double t, double degreesOfFreedom);
+
+/**
+ * @struct RegressionConfig
+ * @brief When a slower or more allocating benchmark counts as a regression
+ */
+struct RegressionConfig {
+    double alpha = 0.01;        ///< Significance level of the one-sided test
+    double minChange = 0.05;    ///< Smallest relative increase of the mean that can fail
+};
+
+/**
+ * @struct RegressionCheck
+ * @brief Comparison of one metric of one benchmark between two commits
+ *
+ * A benchmark that cannot be compared gets a single check with an empty
+ * metric and the reason in skipped.
+ */
+struct RegressionCheck {
+    std::string benchmark;
+    std::string metric;           ///< "ns/op" or "allocs/op"; empty if skipped
+    std::string skipped;          ///< Why the benchmark was not compared; empty if it was
+    double baselineMean = 0.0;
+    double candidateMean = 0.0;
+    double change = 0.0;          ///< Relative change of the mean, 0.1 for 10 % more
+    double pValue = 1.0;
+    bool regression = false;
+};
+
+/**
+ * @brief Compares the runs of two commits benchmark by benchmark
+ * @param baseline Runs of the reference commit
+ * @param candidate Runs of the commit under test
+ * @return One check per metric for every benchmark with at least two
+ *         runs on both sides, and one skipped check for every other
+ *         benchmark of either side. Candidate benchmarks come first, in
+ *         order of first appearance, then those only the baseline ran.
+ * @throws std::invalid_argument for alpha outside (0, 1) or a negative minChange
+ */
+std::vector<RegressionCheck> findRegressions(const std::vector<BenchSample>& baseline,
+                                             const std::vector<BenchSample>& candidate,
+                                             const RegressionConfig& config = RegressionConfig());
+
+#endif // BENCH_HISTORY_H
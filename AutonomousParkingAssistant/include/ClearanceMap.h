@@ -0,0 +1,196 @@
+/**
+ * @file ClearanceMap.h
+ * @brief Precomputed obstacle clearance grid of a parking lot
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ *
+ * This file declares a grid map of the lot in which every cell stores the
+ * Euclidean distance from its center to the nearest obstacle cell. The
+ * field is computed with the linear-time exact distance transform of
+ * Felzenszwalb and Huttenlocher, so planning, simulation and safety logic
+ * answer clearance queries with a single array read.
+ *
+ * Distances saturate at a configurable maximum. This bounds how far an
+ * occupancy change can propagate, so flipping a single bay only recomputes
+ * a window around that bay instead of the whole lot.
+ *
+ * The grid lives in one contiguous region (header, clearance floats,
+ * occupancy counts) that is written to disk as-is, followed by the small
+ * table of registered bays, and memory-mapped back on load, so opening a
+ * precomputed map costs no grid parsing.
+ */
+
+#ifndef CLEARANCE_MAP_H
+#define CLEARANCE_MAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Geometry2D.h"
+
+/**
+ * @class ClearanceMap
+ * @brief Distance-to-nearest-obstacle grid with O(1) queries
+ *
+ * Usage: construct with the lot extent, add static obstacles and bays,
+ * call compute() once, then query clearance(). Bay occupancy changes are
+ * applied incrementally with setBayOccupied().
+ *
+ * @example
+ * ClearanceMap map(Vec2{0, 0}, 0.1, 2000, 1200);   // 200 m x 120 m at 10 cm
+ * map.addObstacle(wall);
+ * map.addBay(7, bayFootprint, true);
+ * map.compute();
+ * if (map.clearance(point) < 0.3) ... // closer than 30 cm to something
+ */
+class ClearanceMap {
+public:
+    static const double kDefaultMaxDistance;  ///< Default saturation distance (meters)
+
+    /**
+     * @brief Creates an empty (obstacle-free) map
+     * @param origin World position of the corner of cell (0, 0)
+     * @param resolution Cell edge length in meters
+     * @param cols Number of cells along x
+     * @param rows Number of cells along y
+     * @param maxDistance Clearances are capped at this value (meters)
+     * @throws std::invalid_argument for non-positive sizes
+     */
+    ClearanceMap(Vec2 origin, double resolution, int cols, int rows,
+                 double maxDistance = kDefaultMaxDistance);
+
+    /**
+     * @brief Opens a map previously written with save()
+     * @param path File path
+     * @return Map backed by a private (copy-on-write) mapping of the file
+     *         on POSIX systems, or by a copy of the file elsewhere
+     * @throws std::runtime_error if the file is missing or not a clearance map
+     *
+     * Registered bays and their occupancy are restored too, so
+     * setBayOccupied() works on a loaded map straight away.
+     */
+    static ClearanceMap load(const std::string& path);
+
+    ClearanceMap(ClearanceMap&& other);
+    ~ClearanceMap();
+
+    ClearanceMap(const ClearanceMap&) = delete;
+    ClearanceMap& operator=(const ClearanceMap&) = delete;
+    ClearanceMap& operator=(ClearanceMap&&) = delete;
+
+    /**
+     * @brief Marks the cells covered by a static obstacle (wall, pillar, curb)
+     *
+     * Takes effect on the next compute().
+     */
+    void addObstacle(const OrientedBox& box);
+
+    /**
+     * @brief Registers a bay footprint for incremental occupancy updates
+     * @param bayId Bay identifier (as in LotIndex)
+     * @param footprint Area covered by a vehicle parked in the bay
+     * @param occupied Initial occupancy (takes effect on the next compute())
+     * @throws std::invalid_argument if the bay is already registered
+     */
+    void addBay(int bayId, const OrientedBox& footprint, bool occupied);
+
+    /**
+     * @brief Computes the full clearance field
+     */
+    void compute();
+
+    /**
+     * @brief Changes a bay's occupancy and updates the field around it
+     * @param bayId Registered bay identifier
+     * @param occupied New occupancy
+     * @return true if the occupancy changed
+     * @throws std::out_of_range if the bay is not registered
+     *
+     * Only cells within maxDistance of the bay can change; they are
+     * recomputed exactly from a window of 2 * maxDistance around the bay.
+     */
+    bool setBayOccupied(int bayId, bool occupied);
+
+    /**
+     * @brief Returns the clearance at a world position
+     * @return Distance in meters to the nearest obstacle (capped at
+     *         maxDistance), or 0 outside the map
+     */
+    double clearance(Vec2 p) const {
+        int col = static_cast<int>((p.x - header->originX) * invResolution);
+        int row = static_cast<int>((p.y - header->originY) * invResolution);
+        if (p.x < header->originX || p.y < header->originY || col >= header->cols || row >= header->rows)
+            return 0.0;
+        return distances[static_cast<std::size_t>(row) * header->cols + col];
+    }
+
+    /**
+     * @brief Returns the clearance stored for a cell
+     */
+    float clearanceAt(int col, int row) const {
+        return distances[static_cast<std::size_t>(row) * header->cols + col];
+    }
+
+    /**
+     * @brief Returns true if a cell is covered by an obstacle or occupied bay
+     */
+    bool isObstacle(int col, int row) const {
+        return occupancy[static_cast<std::size_t>(row) * header->cols + col] != 0;
+    }
+
+    /**
+     * @brief Writes the map region and the registered bays to a file
+     * @throws std::runtime_error if the file cannot be written
+     */
+    void save(const std::string& path) const;
+
+    int cols() const { return header->cols; }
+    int rows() const { return header->rows; }
+    double resolution() const { return header->resolution; }
+    double maxDistance() const { return header->maxDistance; }
+    Vec2 origin() const { return Vec2{header->originX, header->originY}; }
+
+private:
+    /**
+     * @brief Fixed-size file/region header (64 bytes)
+     */
+    struct Header {
+        char magic[8];
+        std::uint32_t version;
+        std::int32_t cols;
+        std::int32_t rows;
+        std::uint32_t bayCount;     ///< Bay records following the grid (files only)
+        double originX;
+        double originY;
+        double resolution;
+        double maxDistance;
+        char padding[8];
+    };
+
+    struct Bay {
+        int id;
+        OrientedBox footprint;
+        bool occupied;
+    };
+
+    ClearanceMap(void* region, std::size_t bytes, bool mapped);
+    static std::size_t regionSize(int cols, int rows);
+    void bind();
+    void markBox(const OrientedBox& box, int delta);
+    void footprintCells(const OrientedBox& box, int bounds[4]) const;
+    void transformWindow(int col0, int row0, int col1, int row1, int margin);
+
+    Header* header;                 ///< Start of the region
+    float* distances;               ///< cols * rows clearances (meters)
+    std::uint8_t* occupancy;        ///< cols * rows obstacle counts
+    std::size_t regionBytes;        ///< Allocation or mapping size
+    bool mapped;                    ///< Region is a file mapping
+    double invResolution;           ///< 1 / resolution
+    std::vector<Bay> bays;          ///< Registered bays
+    std::unordered_map<int, std::size_t> bayIndex;  ///< Bay id to position in bays
+};
+
+#endif // CLEARANCE_MAP_H
@@ -0,0 +1,108 @@
+/**
+ * @file CollisionChecker.h
+ * @brief Batched separating-axis collision checks of vehicle footprints
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ *
+ * This file declares a geometric collision module for planning and
+ * simulation. Obstacles are oriented rectangles stored in structure-of-
+ * arrays layout; a vehicle footprint is tested against four obstacles at a
+ * time with the separating-axis theorem using SSE2 where available and an
+ * equivalent scalar loop elsewhere. Whole candidate paths are checked with
+ * a path-level broad phase followed by the batched narrow phase.
+ */
+
+#ifndef COLLISION_CHECKER_H
+#define COLLISION_CHECKER_H
+
+#include <cstddef>
+#include <vector>
+#include "Geometry2D.h"
+#include "VehicleKinematics.h"
+
+/**
+ * @brief Returns the footprint rectangle of a vehicle at a pose
+ * @param vehicle Vehicle model (overhangs, wheelbase, width)
+ * @param pose Rear axle pose
+ * @param margin Safety margin added on every side (meters, default: 0)
+ * @return Oriented box covering the vehicle body plus margin
+ */
+OrientedBox vehicleFootprint(const VehicleModel& vehicle, const Pose2D& pose, double margin = 0.0);
+
+/**
+ * @brief Exact separating-axis overlap test of two oriented boxes
+ * @return true if the boxes overlap or touch
+ */
+bool boxesOverlap(const OrientedBox& a, const OrientedBox& b);
+
+/**
+ * @class CollisionWorld
+ * @brief Static set of obstacle rectangles in SoA layout
+ *
+ * Coordinates are stored as single-precision floats relative to the first
+ * obstacle's position, giving four lanes per SSE2 register with sub-
+ * millimetre precision over lots several kilometres wide. Arrays are
+ * padded to a multiple of four with far-away empty boxes so the batched
+ * loop has no tail.
+ *
+ * @example
+ * CollisionWorld world;
+ * for (const OrientedBox& car : parkedCars) world.addObstacle(car);
+ * int hit = firstPathCollision(world, profile->model, path, 0.2);
+ */
+class CollisionWorld {
+public:
+    /**
+     * @brief Adds an obstacle rectangle
+     * @throws std::invalid_argument if an extent is negative
+     */
+    void addObstacle(const OrientedBox& box);
+
+    /**
+     * @brief Returns the number of obstacles added
+     */
+    std::size_t obstacleCount() const { return count; }
+
+    /**
+     * @brief Tests a single footprint against every obstacle
+     * @return true if the footprint overlaps any obstacle
+     */
+    bool collides(const OrientedBox& footprint) const;
+
+    /**
+     * @brief Finds the first footprint of a sequence that hits an obstacle
+     * @param footprints Footprints along a path, in travel order
+     * @return Index of the first colliding footprint, or -1 if all are free
+     *
+     * Obstacles outside the bounding box of the whole sequence are culled
+     * once up front; the survivors are tested against each footprint in
+     * batches of four.
+     */
+    int firstCollision(const std::vector<OrientedBox>& footprints) const;
+
+private:
+    struct Lanes {
+        std::vector<float> cx, cy, cosH, sinH, halfLength, halfWidth;
+        void push(float x, float y, float c, float s, float hl, float hw);
+        void pad();
+    };
+
+    Vec2 origin = {0.0, 0.0};   ///< Reference point subtracted before storing floats
+    std::size_t count = 0;      ///< Real (unpadded) obstacle count
+    Lanes lanes;                ///< Obstacles, padded to a multiple of four
+    std::vector<float> radius;  ///< Bounding circle radius per real obstacle
+};
+
+/**
+ * @brief Checks a vehicle path against a collision world
+ * @param world Obstacles
+ * @param vehicle Vehicle model
+ * @param path Rear axle poses in travel order
+ * @param margin Safety margin around the body (meters, default: 0)
+ * @return Index of the first colliding pose, or -1 if the path is free
+ */
+int firstPathCollision(const CollisionWorld& world, const VehicleModel& vehicle,
+                       const std::vector<Pose2D>& path, double margin = 0.0);
+
+#endif // COLLISION_CHECKER_H
@@ -0,0 +1,178 @@
+/**
+ * @file DeadlineWatchdog.h
+ * @brief Per-frame deadline accounting and stall protection for the control loop
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ *
+ * Nothing in parkingAssistantLoop() notices when processing a reading
+ * takes longer than the time between two readings. This file declares a
+ * watchdog that times each frame stage by stage. It counts the frames
+ * that miss their deadline, along with the stage that took longest in
+ * each, and it triggers a fallback action, such as forcing a STOP, when a
+ * frame stalls beyond a hard limit.
+ *
+ * The loop side stores a few steady-clock timestamps per frame and only
+ * touches the helper thread's mutex to wake it when a frame begins.
+ * Stalls are detected by that thread, which sleeps until the hard limit
+ * of the running frame, so it runs the fallback while the stalled stage
+ * still holds the loop. Between frames it sleeps until woken.
+ */
+
+#ifndef DEADLINE_WATCHDOG_H
+#define DEADLINE_WATCHDOG_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <ostream>
+#include <thread>
+
+/**
+ * @enum LoopStage
+ * @brief Processing stages of one parking loop frame
+ */
+enum class LoopStage {
+    Alert,      ///< Proximity beeps and opposite movement check
+    Classify,   ///< Status classification
+    Guidance,   ///< Steering and movement advice
+    Record      ///< History and summary bookkeeping
+};
+
+/**
+ * @brief Returns a display name for a stage
+ */
+const char* stageName(LoopStage stage);
+
+/**
+ * @struct WatchdogConfig
+ * @brief Deadlines of a DeadlineWatchdog
+ */
+struct WatchdogConfig {
+    double frameDeadline = 0.02;   ///< Processing budget of one frame (seconds; 50 Hz)
+    double hardLimit = 0.1;        ///< A frame running this long triggers the fallback (seconds)
+};
+
+/**
+ * @struct WatchdogStats
+ * @brief Overrun counters of a DeadlineWatchdog
+ */
+struct WatchdogStats {
+    std::size_t frames = 0;                    ///< Frames completed
+    std::size_t overruns = 0;                  ///< Frames that missed frameDeadline
+    std::size_t stalls = 0;                    ///< Frames that reached hardLimit
+    std::size_t overrunsByStage[4] = {0, 0, 0, 0};   ///< Overruns by their slowest stage
+    double worstFrameMs = 0.0;                 ///< Longest frame (milliseconds)
+    double meanFrameUs = 0.0;                  ///< Mean frame time (microseconds)
+
+    /**
+     * @brief Prints the counters as one summary block
+     */
+    void print(std::ostream& out, const WatchdogConfig& config) const;
+};
+
+/**
+ * @class DeadlineWatchdog
+ * @brief Times loop frames and stops the vehicle when a frame stalls
+ *
+ * Usage per frame: beginFrame(), stage() at every stage change, then
+ * endFrame(). Only the loop thread may call these. The fallback runs at
+ * most once per frame. It runs on the watchdog thread while the frame is
+ * still stalled, or from endFrame() if the frame reached the hard limit
+ * before the watchdog thread noticed. It must not throw.
+ *
+ * @example
+ * DeadlineWatchdog watchdog(WatchdogConfig(), [](LoopStage stage, double) { brakes.engage(); });
+ * watchdog.beginFrame(LoopStage::Alert);
+ * beepAlert(s);
+ * watchdog.stage(LoopStage::Classify);
+ * status = checkSafety(s);
+ * if (watchdog.endFrame()) log("deadline missed");
+ */
+class DeadlineWatchdog {
+public:
+    typedef std::function<void(LoopStage stage, double elapsedSeconds)> StallAction;
+    typedef std::function<std::int64_t()> Clock;   ///< Monotonic time in nanoseconds
+
+    /**
+     * @brief Creates the watchdog and starts its thread
+     * @param config Deadlines
+     * @param onStall Fallback action (may be empty to count stalls only)
+     * @param timeSource Time source (the steady clock if empty). The watchdog
+     *        thread sleeps in real time for as long as the clock says is
+     *        left before the hard limit, so a manual clock only has to be
+     *        advanced past the limit for the fallback to run.
+     * @throws std::invalid_argument unless 0 < frameDeadline <= hardLimit
+     */
+    explicit DeadlineWatchdog(const WatchdogConfig& config = WatchdogConfig(), StallAction onStall = StallAction(),
+                              Clock timeSource = Clock());
+    ~DeadlineWatchdog();
+
+    DeadlineWatchdog(const DeadlineWatchdog&) = delete;
+    DeadlineWatchdog& operator=(const DeadlineWatchdog&) = delete;
+
+    /**
+     * @brief Starts timing a frame
+     * @param first Stage the frame starts in
+     */
+    void beginFrame(LoopStage first);
+
+    /**
+     * @brief Moves the running frame to another stage
+     */
+    void stage(LoopStage next);
+
+    /**
+     * @brief Finishes the running frame
+     * @return True if it missed frameDeadline
+     */
+    bool endFrame();
+
+    /**
+     * @brief Whether the last finished frame reached the hard limit
+     */
+    bool stalled() const { return lastStalled; }
+
+    /**
+     * @brief Duration of the last finished frame (nanoseconds)
+     */
+    std::int64_t lastFrameNs() const { return lastTotalNs; }
+
+    WatchdogStats stats() const;
+    const WatchdogConfig& config() const { return settings; }
+
+private:
+    void run();
+    bool claimStall(std::uint64_t frame);
+
+    WatchdogConfig settings;
+    StallAction action;
+    Clock clock;
+    std::int64_t deadlineNs;
+    std::int64_t hardLimitNs;
+
+    // Loop-thread state
+    WatchdogStats counters;
+    double totalFrameUs = 0.0;
+    std::int64_t stageStartNs = 0;
+    std::int64_t stageNs[4] = {0, 0, 0, 0};
+    bool lastStalled = false;
+    std::int64_t lastTotalNs = 0;
+
+    // Shared with the watchdog thread
+    std::atomic<std::uint64_t> frameSeq{0};      ///< Odd while a frame runs
+    std::atomic<std::int64_t> frameStartNs{0};
+    std::atomic<int> currentStage{0};
+    std::atomic<std::uint64_t> stalledSeq{0};    ///< Frame whose stall was handled
+    std::atomic<std::size_t> stallCount{0};
+
+    std::mutex threadMutex;
+    std::condition_variable threadWake;
+    bool quit = false;
+    std::thread worker;
+};
+
+#endif // DEADLINE_WATCHDOG_H
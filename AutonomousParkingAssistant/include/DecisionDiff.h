@@ -0,0 +1,168 @@
+/**
+ * @file DecisionDiff.h
+ * @brief Differential comparison of parking decisions over recorded sessions
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ *
+ * Before a new build replaces an old one, it has to make the same
+ * decisions on the archived sessions: the same status, the same beep
+ * level and the same steering advice for every frame. This file declares
+ * the pieces of that check. A decision run replays a corpus of recorded
+ * sessions through a decision pipeline on several threads and measures
+ * its throughput. Runs are written to and read from decision logs, so a
+ * log recorded with the old build can be compared with a run of the new
+ * one, frame by frame.
+ *
+ * The parkingDiff tool drives this: "parkingDiff record" in the old
+ * build, "parkingDiff compare" in the new one.
+ */
+
+#ifndef DECISION_DIFF_H
+#define DECISION_DIFF_H
+
+#include <cstddef>
+#include <functional>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "ParkingUtils.h"
+#include "SensorData.h"
+
+/**
+ * @brief Whether two decisions tell the driver the same: status, beep and steering
+ */
+bool operator==(const FrameDecision& a, const FrameDecision& b);
+bool operator!=(const FrameDecision& a, const FrameDecision& b);
+
+/**
+ * @brief Decisions this build makes for a reading in a forward session
+ * @param s The SensorData structure containing distance readings
+ *
+ * Same as decideParkingFrame(s, false): what parkingAssistantLoop(false, ...)
+ * decides, with every reading classified by checkSafety().
+ */
+FrameDecision decideFrame(const SensorData& s);
+
+/**
+ * @brief Per-frame decision function of one session
+ */
+typedef std::function<FrameDecision(const SensorData&)> DecisionPipeline;
+
+/**
+ * @brief Creates the decision function of one session
+ *
+ * Called from the worker threads, once per session. Each pipeline is
+ * used by one thread only, so it may keep state across the frames of its
+ * session, like the classifier of a change-only session.
+ */
+typedef std::function<DecisionPipeline()> PipelineFactory;
+
+/**
+ * @brief Pipelines that decide like a parking session of this build
+ * @param reverseMode Driving mode of the recorded sessions
+ * @param statusConfig Classifier settings of a change-only session, or null
+ *        to classify every reading with checkSafety()
+ * @throws std::invalid_argument for an invalid statusConfig
+ *
+ * @example
+ * StatusClassifierConfig config;
+ * DecisionRun run = runDecisions(corpus, loopPipeline(true, &config), "v2.1", 4);
+ */
+PipelineFactory loopPipeline(bool reverseMode, const StatusClassifierConfig* statusConfig = nullptr);
+
+/**
+ * @struct RecordedSession
+ * @brief Sensor frames of one archived session
+ */
+struct RecordedSession {
+    std::string name;                  ///< Identifies the session in reports and decision logs
+    std::vector<SensorData> frames;
+};
+
+/**
+ * @brief Loads a session recorded with writeSensorFrame()
+ * @param path File of the recording; also used as the session name
+ * @throws std::runtime_error if the file cannot be read or is malformed
+ */
+RecordedSession loadRecordedSession(const std::string& path);
+
+/**
+ * @struct DecisionRun
+ * @brief Decisions of one build over a corpus
+ */
+struct DecisionRun {
+    std::string build;                                    ///< Label of the build that made them
+    std::vector<std::string> sessions;                    ///< Session names, in corpus order
+    std::vector<std::vector<FrameDecision>> decisions;    ///< Per session, per frame
+    std::size_t frames = 0;                               ///< Frames decided
+    double seconds = 0.0;                                 ///< Wall time of the run
+
+    double framesPerSecond() const { return seconds > 0.0 ? frames / seconds : 0.0; }
+};
+
+/**
+ * @brief Runs a decision pipeline over every frame of a corpus
+ * @param corpus Recorded sessions
+ * @param pipeline Stateless decision function, e.g. decideFrame; must be
+ *        safe to call from several threads
+ * @param build Label stored with the run
+ * @param threads Worker threads; sessions are handed out one at a time
+ * @return Decisions in corpus order and the throughput of the run
+ * @throws std::invalid_argument if threads is 0
+ */
+DecisionRun runDecisions(const std::vector<RecordedSession>& corpus, const DecisionPipeline& pipeline,
+                         const std::string& build, unsigned threads);
+
+/**
+ * @brief Runs a fresh pipeline per session over every frame of a corpus
+ * @param makePipeline Creates the pipeline of each session, e.g. loopPipeline()
+ *
+ * Otherwise the same as the DecisionPipeline overload.
+ */
+DecisionRun runDecisions(const std::vector<RecordedSession>& corpus, const PipelineFactory& makePipeline,
+                         const std::string& build, unsigned threads);
+
+/**
+ * @brief Writes a decision run as a decision log
+ *
+ * Text format: a header with the build label, frame count and run time,
+ * then per session a "session NAME FRAMES" line followed by one
+ * "BEEP STEERING STATUS" line per frame. The status is empty for frames
+ * of change-only sessions without news. The stream's format flags and
+ * precision are left as they were.
+ */
+void writeDecisionLog(std::ostream& out, const DecisionRun& run);
+
+/**
+ * @brief Reads a decision log written by writeDecisionLog()
+ * @throws std::runtime_error for a malformed log
+ */
+DecisionRun readDecisionLog(std::istream& in);
+
+/**
+ * @struct Divergence
+ * @brief A frame where two builds decided differently
+ */
+struct Divergence {
+    std::size_t session;          ///< Index into the corpus
+    std::size_t frame;            ///< Index into the session
+    FrameDecision baseline;
+    FrameDecision candidate;
+};
+
+/**
+ * @brief Compares two runs frame by frame
+ * @return Every divergent frame, in corpus order
+ * @throws std::invalid_argument unless both runs cover the same sessions
+ *         with the same number of frames
+ */
+std::vector<Divergence> compareDecisions(const DecisionRun& baseline, const DecisionRun& candidate);
+
+/**
+ * @brief Text form of a steering advice ("RIGHT", "LEFT", "CENTER", "NONE")
+ */
+const char* steeringName(SteeringAdvice advice);
+
+#endif // DECISION_DIFF_H
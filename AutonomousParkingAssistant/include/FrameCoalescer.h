@@ -0,0 +1,154 @@
+/**
+ * @file FrameCoalescer.h
+ * @brief Newest-frame-wins ingest of sensor frames under overload
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ *
+ * When frames arrive faster than they can be classified, for example in
+ * a burst from the sensor bus or a replay at full speed, a plain queue
+ * makes every decision older than the last one. This file declares an
+ * ingest buffer that keeps only the latest frame of each vehicle between
+ * two decision iterations. The work per iteration is therefore bounded
+ * by the number of vehicles, not by the arrival rate.
+ *
+ * Frames that show a collision are kept. A superseded frame with any
+ * reading at or below the collision distance, or a failed reading (NaN,
+ * infinite or negative), is still delivered, ahead of the newer frame
+ * that replaced it. Only a bounded number of them is kept per vehicle
+ * between two drains, so a stalled decision loop cannot make the buffer
+ * grow without limit; the first collision is always among them. Every
+ * dropped frame is counted.
+ */
+
+#ifndef FRAME_COALESCER_H
+#define FRAME_COALESCER_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "SensorData.h"
+
+/**
+ * @struct CoalescedFrame
+ * @brief One frame handed to the decision loop
+ */
+struct CoalescedFrame {
+    std::size_t vehicle;        ///< Vehicle index, see FrameCoalescer::vehicleId()
+    SensorData data;            ///< The reading
+    std::int64_t receivedNs;    ///< Steady-clock time push() received it
+    std::size_t superseded;     ///< Older frames of the vehicle dropped in its favour
+    bool collision;             ///< Some reading is at or below the collision distance or failed
+};
+
+/**
+ * @struct CoalescerStats
+ * @brief Frame counters of a FrameCoalescer
+ */
+struct CoalescerStats {
+    std::size_t received = 0;            ///< Frames pushed
+    std::size_t delivered = 0;           ///< Frames handed out by drain()
+    std::size_t coalesced = 0;           ///< Frames dropped for a newer frame of the same vehicle
+    std::size_t collisionsKept = 0;      ///< Superseded collision frames delivered anyway
+    std::size_t collisionsDropped = 0;   ///< Superseded collision frames over the limit, part of coalesced
+};
+
+/**
+ * @class FrameCoalescer
+ * @brief Keeps the newest frame per vehicle until the decision loop drains it
+ *
+ * push() may be called from any number of ingest threads and drain()
+ * from the decision thread. A drain returns the vehicles in the order
+ * their first pending frame arrived. Each vehicle contributes its kept
+ * collision frames, oldest first, and then its newest frame. Vehicle
+ * slots are reused, so once every vehicle has been seen, only kept
+ * collision frames and a growing drain() output allocate. Pending frames
+ * never exceed maxKeptCollisions + 1 per vehicle.
+ *
+ * @example
+ * FrameCoalescer ingest;
+ * busThread = std::thread([&] { while (readBus(id, s)) ingest.push(id, s); });
+ * std::vector<CoalescedFrame> frames;
+ * while (ingest.waitForFrames(0.1)) {
+ *     ingest.drain(frames);
+ *     for (const CoalescedFrame& f : frames) classifiers[f.vehicle].update(f.data);
+ * }
+ */
+class FrameCoalescer {
+public:
+    /**
+     * @brief Creates an empty buffer
+     * @param collisionDistance Frames with a reading at or below this, or a failed one, are kept (meters)
+     * @param maxKeptCollisions Superseded collision frames kept per vehicle
+     *        until the next drain; later ones are dropped like ordinary frames
+     * @throws std::invalid_argument unless collisionDistance is positive and
+     *         finite and maxKeptCollisions is at least 1
+     */
+    explicit FrameCoalescer(double collisionDistance = 0.1, std::size_t maxKeptCollisions = 16);
+
+    /**
+     * @brief Stores a frame received now, replacing the vehicle's pending frame
+     */
+    void push(const std::string& vehicleId, const SensorData& s);
+
+    /**
+     * @brief Takes every pending frame
+     * @param out Replaced with the frames, oldest vehicle first
+     * @return Number of frames taken
+     */
+    std::size_t drain(std::vector<CoalescedFrame>& out);
+
+    /**
+     * @brief Waits until a frame is pending
+     * @param timeoutSeconds Longest wait
+     * @return True if frames are pending; false on timeout, or at once
+     *         when the buffer is closed and empty
+     */
+    bool waitForFrames(double timeoutSeconds);
+
+    /**
+     * @brief Wakes every waiter; later waits no longer block
+     *
+     * Frames still pending, or pushed after close(), can be drained.
+     */
+    void close();
+
+    /**
+     * @brief Id of a vehicle index reported in CoalescedFrame
+     * @throws std::out_of_range for an unknown index
+     */
+    std::string vehicleId(std::size_t vehicle) const;
+
+    std::size_t vehicles() const;
+    std::size_t pending() const;
+    CoalescerStats stats() const;
+
+private:
+    struct Slot {
+        std::string id;
+        SensorData latest;
+        std::int64_t latestNs = 0;
+        std::size_t superseded = 0;
+        bool pending = false;
+        std::vector<CoalescedFrame> collisions;   ///< Superseded collision frames, oldest first
+    };
+
+    bool isCollision(const SensorData& s) const;
+
+    const double collisionDistance;
+    const std::size_t maxKeptCollisions;
+    mutable std::mutex stateMutex;
+    std::condition_variable frameArrived;
+    std::unordered_map<std::string, std::size_t> index;
+    std::vector<Slot> slots;
+    std::vector<std::size_t> order;   ///< Vehicles with a pending frame, by first arrival
+    std::size_t pendingFrames = 0;
+    bool closed = false;
+    CoalescerStats counters;
+};
+
+#endif // FRAME_COALESCER_H
@@ -0,0 +1,207 @@
+/**
+ * @file GarageGraph.h
+ * @brief Driving-route graph of a multi-level garage with contraction hierarchies
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ *
+ * This file declares a road graph of gates, aisle junctions, ramps and
+ * bays. After the graph is built it is preprocessed into a contraction
+ * hierarchy (Geisberger et al.): nodes are contracted in order of
+ * importance and shortcut edges preserve shortest distances, so a query
+ * only runs two small upward Dijkstra searches that meet in the middle.
+ * Route queries from any gate to any bay then settle a few dozen nodes
+ * instead of the whole campus.
+ *
+ * The backward search spaces of all bays are also stored in per-node
+ * buckets, which turns "nearest free bay by driving distance" into a
+ * single upward search from the vehicle's position.
+ */
+
+#ifndef GARAGE_GRAPH_H
+#define GARAGE_GRAPH_H
+
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+#include "Geometry2D.h"
+
+class LotSnapshot;
+
+/**
+ * @enum GarageNodeKind
+ * @brief Role of a node in the garage graph
+ */
+enum class GarageNodeKind {
+    Gate,      ///< Entrance or exit barrier
+    Junction,  ///< Aisle intersection or bend
+    Ramp,      ///< Ramp end connecting two levels
+    Bay        ///< Parking bay (linked to a ParkingBay id)
+};
+
+/**
+ * @struct GarageNode
+ * @brief One node of the garage graph
+ */
+struct GarageNode {
+    GarageNodeKind kind;  ///< Node role
+    Vec2 position;        ///< Position on its level (meters)
+    int level;            ///< Floor number
+    int bayId;            ///< ParkingBay id for bays, -1 otherwise
+};
+
+/**
+ * @struct GarageRoute
+ * @brief Result of a route query
+ */
+struct GarageRoute {
+    double distance;         ///< Driving distance in meters, infinity if unreachable
+    std::vector<int> nodes;  ///< Nodes from origin to destination, empty if unreachable
+
+    bool found() const { return !nodes.empty(); }
+};
+
+/**
+ * @struct BayChoice
+ * @brief Result of a nearest-free-bay query
+ */
+struct BayChoice {
+    int bayId;        ///< Chosen bay, -1 if none is free and large enough
+    int node;         ///< Graph node of the bay, -1 if none
+    double distance;  ///< Driving distance in meters, infinity if none
+};
+
+/**
+ * @class GarageGraph
+ * @brief Garage road graph answering shortest-route queries with contraction hierarchies
+ *
+ * Usage: add nodes and edges, call contract() once, then query. Queries
+ * are const and may run concurrently. The graph cannot be changed after
+ * contract().
+ *
+ * @example
+ * GarageGraph garage;
+ * int gate = garage.addNode(GarageNodeKind::Gate, Vec2{0, 0}, 0);
+ * int aisle = garage.addNode(GarageNodeKind::Junction, Vec2{20, 0}, 0);
+ * int bay = garage.addNode(GarageNodeKind::Bay, Vec2{20, 3}, 0, 42);
+ * garage.addEdge(gate, aisle, 20.0);
+ * garage.addEdge(aisle, bay, 3.0);
+ * garage.contract();
+ * GarageRoute route = garage.route(gate, garage.bayNode(42));
+ */
+class GarageGraph {
+public:
+    /**
+     * @brief Adds a node
+     * @param kind Node role
+     * @param position Position on its level
+     * @param level Floor number
+     * @param bayId ParkingBay id (required for bays, ignored otherwise)
+     * @return Index of the new node
+     * @throws std::invalid_argument if a bay has no id or reuses one
+     * @throws std::logic_error after contract()
+     */
+    int addNode(GarageNodeKind kind, Vec2 position, int level, int bayId = -1);
+
+    /**
+     * @brief Adds a road segment
+     * @param from Start node
+     * @param to End node
+     * @param length Driving distance in meters
+     * @param oneWay If true only from -> to may be driven
+     * @throws std::out_of_range for unknown nodes
+     * @throws std::invalid_argument for negative lengths
+     * @throws std::logic_error after contract()
+     */
+    void addEdge(int from, int to, double length, bool oneWay = false);
+
+    /**
+     * @brief Builds the contraction hierarchy and the bay buckets
+     */
+    void contract();
+
+    /**
+     * @brief Returns the shortest route between two nodes
+     * @throws std::logic_error before contract()
+     * @throws std::out_of_range for unknown nodes
+     */
+    GarageRoute route(int from, int to) const;
+
+    /**
+     * @brief Records where each bay sits in a lot snapshot
+     * @param lot Any snapshot of the lot index holding the garage's bays
+     * @throws std::invalid_argument if a bay of the graph is missing from the lot
+     *
+     * The bay set of a ParkingLotIndex never changes, so binding once is
+     * enough for every later snapshot of the same index.
+     */
+    void bindLot(const LotSnapshot& lot);
+
+    /**
+     * @brief Finds the free bay with the shortest driving distance
+     * @param from Vehicle position (node)
+     * @param lot Current snapshot of the bound lot
+     * @param requiredSize Minimum bay size, e.g. from requiredSpace()
+     * @throws std::logic_error before contract() or bindLot(), or for a snapshot of another lot
+     */
+    BayChoice nearestFreeBay(int from, const LotSnapshot& lot, double requiredSize) const;
+
+    /**
+     * @brief Plain Dijkstra distances from a node over the original edges (reference)
+     */
+    std::vector<double> distancesFrom(int from) const;
+
+    /**
+     * @brief Returns the node of a bay, or -1 if the bay is not in the graph
+     */
+    int bayNode(int bayId) const;
+
+    const GarageNode& node(int index) const { return nodes.at(index); }
+    std::size_t nodeCount() const { return nodes.size(); }
+    std::size_t shortcutCount() const { return shortcuts; }
+    bool contracted() const { return !rank.empty(); }
+
+private:
+    struct Arc {
+        int node;       ///< Head (outgoing lists) or tail (incoming lists)
+        double weight;  ///< Length in meters
+        int middle;     ///< Contracted node a shortcut bypasses, -1 for original edges
+    };
+    struct Shortcut {
+        int from;
+        int to;
+        double weight;
+    };
+    struct BucketEntry {
+        int bay;         ///< Bay node
+        double distance; ///< Distance from the bucket's node to the bay
+    };
+
+    void checkNode(int index) const;
+    void addArc(int from, int to, double weight, int middle);
+    int contractionCost(int v, std::vector<Shortcut>* created);
+    int findMiddle(int from, int to) const;
+    void unpack(int from, int to, int middle, std::vector<int>& out) const;
+
+    std::vector<GarageNode> nodes;
+    std::unordered_map<int, int> bayNodes;           ///< Bay id -> node
+    std::vector<std::vector<Arc>> original;          ///< Original outgoing edges
+
+    // Contraction working state
+    std::vector<std::vector<Arc>> outArcs;
+    std::vector<std::vector<Arc>> inArcs;
+    std::vector<double> witnessDistance;
+    std::vector<int> witnessTouched;
+
+    // Hierarchy
+    std::vector<int> rank;                           ///< Contraction order of each node
+    std::vector<std::vector<Arc>> upward;            ///< u -> v with rank[v] > rank[u]
+    std::vector<std::vector<Arc>> downward;          ///< At u: v with v -> u and rank[v] > rank[u]
+    std::vector<std::vector<BucketEntry>> buckets;   ///< Backward search spaces of all bays
+    std::size_t shortcuts = 0;
+
+    std::vector<int> lotPosition;                    ///< Node -> index in LotSnapshot::bays, -1 for non-bays
+    std::size_t boundBayCount = 0;
+};
+
+#endif // GARAGE_GRAPH_H
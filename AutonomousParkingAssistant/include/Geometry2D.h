@@ -0,0 +1,114 @@
+/**
+ * @file Geometry2D.h
+ * @brief Planar geometry primitives shared by simulation and planning code
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ *
+ * This file defines the small value types used to describe vehicle poses
+ * and obstacles on the ground plane: 2D vectors, poses, line segments and
+ * oriented boxes. All operations are inline and allocation-free.
+ *
+ * Conventions: world coordinates in meters, headings in radians measured
+ * counter-clockwise from the +x axis.
+ */
+
+#ifndef GEOMETRY_2D_H
+#define GEOMETRY_2D_H
+
+#include <cmath>
+
+/**
+ * @struct Vec2
+ * @brief 2D vector or point in meters
+ */
+struct Vec2 {
+    double x;  ///< X component
+    double y;  ///< Y component
+};
+
+inline Vec2 operator+(Vec2 a, Vec2 b) { return Vec2{a.x + b.x, a.y + b.y}; }
+inline Vec2 operator-(Vec2 a, Vec2 b) { return Vec2{a.x - b.x, a.y - b.y}; }
+inline Vec2 operator*(Vec2 a, double k) { return Vec2{a.x * k, a.y * k}; }
+
+/**
+ * @brief Dot product
+ */
+inline double dot(Vec2 a, Vec2 b) { return a.x * b.x + a.y * b.y; }
+
+/**
+ * @brief 2D cross product (z component of the 3D cross product)
+ */
+inline double cross(Vec2 a, Vec2 b) { return a.x * b.y - a.y * b.x; }
+
+/**
+ * @brief Rotates a vector counter-clockwise by an angle
+ * @param v Vector to rotate
+ * @param angle Rotation in radians
+ */
+inline Vec2 rotate(Vec2 v, double angle) {
+    double c = std::cos(angle), s = std::sin(angle);
+    return Vec2{c * v.x - s * v.y, s * v.x + c * v.y};
+}
+
+/**
+ * @struct Pose2D
+ * @brief Position and heading of a vehicle on the ground plane
+ *
+ * For vehicles the position is the rear axle midpoint, matching the
+ * vehicle frame used by SensorMount and VehicleModel.
+ */
+struct Pose2D {
+    double x;        ///< X position (meters)
+    double y;        ///< Y position (meters)
+    double heading;  ///< Heading (radians, CCW from +x)
+};
+
+/**
+ * @brief Transforms a point from a pose's local frame to the world frame
+ * @param pose Frame origin and orientation
+ * @param local Point in the local frame (x forward, y left)
+ */
+inline Vec2 toWorld(const Pose2D& pose, Vec2 local) {
+    Vec2 r = rotate(local, pose.heading);
+    return Vec2{pose.x + r.x, pose.y + r.y};
+}
+
+/**
+ * @struct Segment2D
+ * @brief Line segment obstacle edge (curb, wall or box side)
+ */
+struct Segment2D {
+    Vec2 a;  ///< First endpoint
+    Vec2 b;  ///< Second endpoint
+};
+
+/**
+ * @struct OrientedBox
+ * @brief Rectangle with arbitrary orientation (vehicle or obstacle footprint)
+ *
+ * @example
+ * OrientedBox parked = {{10.0, 2.0}, 2.3, 0.9, 0.0}; // 4.6 m x 1.8 m along +x
+ */
+struct OrientedBox {
+    Vec2 center;        ///< Box center (meters)
+    double halfLength;  ///< Half extent along the heading (meters)
+    double halfWidth;   ///< Half extent across the heading (meters)
+    double heading;     ///< Orientation (radians, CCW from +x)
+};
+
+/**
+ * @brief Returns the four corners of a box in counter-clockwise order
+ * @param box Box to evaluate
+ * @param corners Receives front-left, rear-left, rear-right, front-right
+ */
+inline void boxCorners(const OrientedBox& box, Vec2 corners[4]) {
+    Vec2 ax = rotate(Vec2{box.halfLength, 0.0}, box.heading);
+    Vec2 ay = rotate(Vec2{0.0, box.halfWidth}, box.heading);
+    corners[0] = box.center + ax + ay;
+    corners[1] = box.center - ax + ay;
+    corners[2] = box.center - ax - ay;
+    corners[3] = box.center + ax - ay;
+}
+
+#endif // GEOMETRY_2D_H
@@ -0,0 +1,164 @@
+/**
+ * @file GridReplanner.h
+ * @brief Incremental grid path replanning with D* Lite
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ *
+ * This file declares a planner that finds shortest 8-connected paths over
+ * an occupancy grid of the lot and repairs them when obstacles appear,
+ * move or disappear during a manoeuvre (a pedestrian stepping into the
+ * bay, a trolley left in the aisle). It implements D* Lite (Koenig and
+ * Likhachev): the search runs backwards from the goal and keeps its
+ * g/rhs values between calls, so a replan only revisits the cells whose
+ * cost-to-goal was actually changed by the new obstacles and the vehicle
+ * can keep moving its start cell without restarting the search.
+ */
+
+#ifndef GRID_REPLANNER_H
+#define GRID_REPLANNER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Geometry2D.h"
+
+class ClearanceMap;
+
+/**
+ * @class GridReplanner
+ * @brief D* Lite shortest paths on an occupancy grid with incremental repair
+ *
+ * Moves go to the 8 neighbouring cells (cost 1 straight, sqrt(2) diagonal)
+ * and diagonal moves may not cut the corner of a blocked cell. Obstacles
+ * are reference counted per cell, so overlapping obstacles can be added
+ * and removed independently.
+ *
+ * @example
+ * GridReplanner planner = GridReplanner::fromClearanceMap(map, 1.0);
+ * planner.setGoal(bayEntry);
+ * planner.setStart(vehiclePosition);
+ * planner.replan();
+ * // ... each frame:
+ * planner.addObstacle(pedestrian, 1.0);
+ * planner.setStart(vehiclePosition);
+ * if (planner.replan()) follow(planner.path());
+ */
+class GridReplanner {
+public:
+    /**
+     * @brief Creates an obstacle-free grid
+     * @param origin World position of the corner of cell (0, 0)
+     * @param resolution Cell edge length in meters
+     * @param cols Number of cells along x
+     * @param rows Number of cells along y
+     * @throws std::invalid_argument for non-positive sizes
+     */
+    GridReplanner(Vec2 origin, double resolution, int cols, int rows);
+
+    /**
+     * @brief Creates a grid matching a clearance map, blocking cells too close to obstacles
+     * @param map Computed clearance map of the lot
+     * @param inflation Cells with a clearance below this value are blocked (meters),
+     *                  typically the vehicle's half width plus a margin
+     */
+    static GridReplanner fromClearanceMap(const ClearanceMap& map, double inflation);
+
+    /**
+     * @brief Blocks every cell whose center lies in the box grown by inflation
+     */
+    void addObstacle(const OrientedBox& box, double inflation = 0.0);
+
+    /**
+     * @brief Releases an obstacle previously added with the same arguments
+     */
+    void removeObstacle(const OrientedBox& box, double inflation = 0.0);
+
+    /**
+     * @brief Sets the goal and resets the search
+     * @throws std::out_of_range if the point is outside the grid
+     */
+    void setGoal(Vec2 goal);
+
+    /**
+     * @brief Moves the start (vehicle) position; search effort is kept
+     * @throws std::out_of_range if the point is outside the grid
+     */
+    void setStart(Vec2 start);
+
+    /**
+     * @brief Applies pending obstacle changes and repairs the shortest path
+     * @return true if the goal is reachable from the start
+     * @throws std::logic_error if the start or goal has not been set
+     */
+    bool replan();
+
+    /**
+     * @brief Returns the current path as cell centers, start first
+     *
+     * Empty if the last replan() found no path.
+     */
+    std::vector<Vec2> path() const;
+
+    /**
+     * @brief Returns the length of the current path in meters (infinity if none)
+     */
+    double pathLength() const;
+
+    /**
+     * @brief Returns the number of cells expanded by the last replan()
+     */
+    std::size_t lastExpansions() const { return expansions; }
+
+    bool isBlocked(int col, int row) const { return blockCount[index(col, row)] != 0; }
+    Vec2 origin() const { return gridOrigin; }
+    int cols() const { return gridCols; }
+    int rows() const { return gridRows; }
+    double resolution() const { return cellSize; }
+
+private:
+    struct Key {
+        double primary;
+        double secondary;
+    };
+
+    int index(int col, int row) const { return row * gridCols + col; }
+    int cellOf(Vec2 p) const;
+    void markBox(const OrientedBox& box, double inflation, int delta);
+    void setBlockCount(int cell, int count);
+    double heuristic(int a, int b) const;
+    double cost(int from, int to) const;
+    Key calculateKey(int cell) const;
+    void updateVertex(int cell);
+    void computeShortestPath();
+
+    void heapPush(int cell, Key key);
+    void heapRemove(int cell);
+    void heapUpdate(int cell, Key key);
+    void siftUp(std::size_t pos);
+    void siftDown(std::size_t pos);
+    void heapSwap(std::size_t a, std::size_t b);
+
+    Vec2 gridOrigin;
+    double cellSize;
+    int gridCols;
+    int gridRows;
+
+    std::vector<std::uint16_t> blockCount;  ///< Obstacles covering each cell
+    std::vector<int> changedCells;           ///< Cells whose blocked state flipped since the last replan
+    std::vector<std::uint8_t> changedFlag;
+
+    std::vector<double> g;       ///< Current cost-to-goal estimates (cells)
+    std::vector<double> rhs;     ///< One-step lookahead cost-to-goal (cells)
+    std::vector<int> heap;       ///< Binary min-heap of inconsistent cells
+    std::vector<int> heapPos;    ///< Position of each cell in heap, -1 if absent
+    std::vector<Key> heapKey;    ///< Key of each cell while it is in heap
+
+    int start = -1;
+    int goal = -1;
+    int lastStart = -1;          ///< Start at the time km was last updated
+    double km = 0.0;             ///< Accumulated heuristic offset from start moves
+    std::size_t expansions = 0;
+};
+
+#endif // GRID_REPLANNER_H
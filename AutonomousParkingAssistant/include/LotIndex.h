@@ -0,0 +1,256 @@
+/**
+ * @file LotIndex.h
+ * @brief Concurrent parking lot bay index with lock-free snapshot reads
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ *
+ * This file declares the bay index that backs lot-wide space searches
+ * (the multi-bay counterpart of findParkingSpace()). Readers such as
+ * display boards, gates and analytics obtain immutable snapshots of the
+ * lot without taking any lock, while writers publish new versions using
+ * copy-on-write. Retired snapshots are reclaimed with epoch-based
+ * reclamation once no reader can still observe them.
+ */
+
+#ifndef LOT_INDEX_H
+#define LOT_INDEX_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @struct ParkingBay
+ * @brief A single bay in the parking lot
+ *
+ * @var ParkingBay::id
+ * Unique bay identifier (as painted on the ground / used by signage)
+ *
+ * @var ParkingBay::size
+ * Usable bay size in meters, compared against requiredSpace()
+ *
+ * @var ParkingBay::occupied
+ * Whether a vehicle currently occupies the bay
+ *
+ * @example
+ * ParkingBay bay = {12, 5.8, false}; // Bay 12, 5.8 m, free
+ */
+struct ParkingBay {
+    int id;         ///< Bay identifier
+    double size;    ///< Usable bay size (meters)
+    bool occupied;  ///< Occupancy flag
+};
+
+/**
+ * @struct BayUpdate
+ * @brief A single occupancy change applied to the index
+ */
+struct BayUpdate {
+    int bayId;      ///< Bay whose state changes
+    bool occupied;  ///< New occupancy state
+};
+
+/**
+ * @class LotSnapshot
+ * @brief Immutable, internally consistent view of the whole lot
+ *
+ * A snapshot is never modified after it has been published, so readers
+ * may scan it freely while writers prepare the next version.
+ */
+class LotSnapshot {
+public:
+    std::uint64_t version;          ///< Monotonic version, incremented per publish
+    std::vector<ParkingBay> bays;   ///< All bays in index order
+    std::size_t freeCount;          ///< Number of unoccupied bays
+
+    /**
+     * @brief Finds the first free bay at least as large as required
+     * @param required Minimum bay size in meters
+     * @return Pointer to the bay inside this snapshot, or nullptr if none fits
+     *
+     * @note The pointer is only valid while the snapshot is pinned by a LotReadGuard
+     */
+    const ParkingBay* findFreeBay(double required) const;
+
+    /**
+     * @brief Finds a free bay for a vehicle using requiredSpace()
+     * @param parallel Whether the parking is parallel (true) or perpendicular (false)
+     * @param carLength The length of the vehicle in meters
+     * @param carWidth The width of the vehicle in meters
+     * @return Pointer to a suitable bay, or nullptr if none fits
+     */
+    const ParkingBay* findFreeBay(bool parallel, double carLength, double carWidth) const;
+};
+
+class LotReader;
+class BayChangeFeed;
+
+/**
+ * @class ParkingLotIndex
+ * @brief Copy-on-write bay index with epoch-based reclamation
+ *
+ * Writers are serialized by an internal mutex, copy the current snapshot,
+ * apply their changes and publish the copy with a single atomic pointer
+ * store. Readers never take the mutex: they announce the epoch they are
+ * reading in a private, cache-line aligned slot and load the current
+ * snapshot pointer. A retired snapshot is freed only when every announced
+ * reader epoch is newer than the epoch in which it was retired.
+ *
+ * Read cost is independent of the number of readers and writers, so read
+ * throughput scales with the number of cores.
+ *
+ * @note The set of bays is fixed at construction; only occupancy changes
+ * @note At most kMaxReaders LotReader objects may exist at the same time
+ *
+ * @example
+ * ParkingLotIndex index({{1, 5.0, false}, {2, 6.0, true}});
+ * LotReader reader(index);
+ * {
+ *     LotReadGuard guard(reader);
+ *     const ParkingBay* bay = guard.snapshot().findFreeBay(5.5);
+ * }
+ * index.setOccupied(2, false);
+ */
+class ParkingLotIndex {
+public:
+    static const std::size_t kMaxReaders = 64;  ///< Maximum concurrent LotReader objects
+
+    /**
+     * @brief Builds the index with an initial set of bays
+     * @param bays Initial bay list; bay ids must be unique
+     * @throws std::invalid_argument if two bays share an id
+     */
+    explicit ParkingLotIndex(const std::vector<ParkingBay>& bays);
+
+    /**
+     * @brief Frees the current and all retired snapshots
+     * @note All LotReader objects must be destroyed before the index
+     */
+    ~ParkingLotIndex();
+
+    ParkingLotIndex(const ParkingLotIndex&) = delete;
+    ParkingLotIndex& operator=(const ParkingLotIndex&) = delete;
+
+    /**
+     * @brief Changes the occupancy of a single bay
+     * @param bayId Bay to update
+     * @param occupied New occupancy state
+     * @return true if a new snapshot was published, false if the bay is
+     *         unknown or already in the requested state
+     */
+    bool setOccupied(int bayId, bool occupied);
+
+    /**
+     * @brief Applies several occupancy changes as one atomic publish
+     * @param updates Changes to apply, in order
+     * @return Number of bays whose state actually changed
+     *
+     * Batching amortizes the copy-on-write cost: readers observe either
+     * none or all of the updates.
+     */
+    std::size_t applyUpdates(const std::vector<BayUpdate>& updates);
+
+    /**
+     * @brief Attaches a change feed that receives every occupancy change
+     * @param feed Feed to publish to, or nullptr to detach
+     *
+     * Events are published under the writer mutex in the same order as
+     * snapshots, so feed sequence order matches snapshot version order.
+     * The feed must outlive the index or be detached first.
+     */
+    void setChangeFeed(BayChangeFeed* feed);
+
+    /**
+     * @brief Returns the number of bays in the lot
+     */
+    std::size_t bayCount() const { return idToIndex.size(); }
+
+    /**
+     * @brief Returns the number of retired snapshots not yet freed
+     *
+     * Mainly useful for tests and monitoring: a steadily growing value
+     * indicates a reader that never releases its guard.
+     */
+    std::size_t pendingReclaim() const;
+
+private:
+    friend class LotReader;
+    friend class LotReadGuard;
+
+    /**
+     * @brief Per-reader epoch announcement, padded to its own cache line
+     */
+    struct alignas(64) ReaderSlot {
+        std::atomic<std::uint64_t> epoch;  ///< Announced epoch, or kIdle
+        std::atomic<bool> inUse;           ///< Claimed by a LotReader
+    };
+
+    static const std::uint64_t kIdle = ~static_cast<std::uint64_t>(0);
+
+    void publishLocked(LotSnapshot* next);
+    void reclaimLocked();
+
+    std::atomic<const LotSnapshot*> current;  ///< Currently published snapshot
+    std::atomic<std::uint64_t> globalEpoch;   ///< Advanced on every publish
+    ReaderSlot slots[kMaxReaders];            ///< Reader epoch announcements
+
+    mutable std::mutex writerMutex;                                  ///< Serializes writers
+    std::vector<std::pair<std::uint64_t, const LotSnapshot*>> retired; ///< (retire epoch, snapshot)
+    std::unordered_map<int, std::size_t> idToIndex;                  ///< Bay id to snapshot index
+    BayChangeFeed* changeFeed;                                       ///< Optional change feed
+};
+
+/**
+ * @class LotReader
+ * @brief Registration of one reader thread with a ParkingLotIndex
+ *
+ * Each thread that reads the index owns one LotReader for its lifetime.
+ * Creating the reader claims an epoch slot; destroying it releases the slot.
+ *
+ * @throws std::runtime_error from the constructor when all slots are in use
+ */
+class LotReader {
+public:
+    explicit LotReader(ParkingLotIndex& index);
+    ~LotReader();
+
+    LotReader(const LotReader&) = delete;
+    LotReader& operator=(const LotReader&) = delete;
+
+private:
+    friend class LotReadGuard;
+    ParkingLotIndex& index;
+    ParkingLotIndex::ReaderSlot& slot;
+};
+
+/**
+ * @class LotReadGuard
+ * @brief RAII pin of the current snapshot for the duration of a read
+ *
+ * While the guard lives the snapshot it returns cannot be reclaimed.
+ * Guards must not be nested on the same LotReader.
+ */
+class LotReadGuard {
+public:
+    explicit LotReadGuard(LotReader& reader);
+    ~LotReadGuard();
+
+    LotReadGuard(const LotReadGuard&) = delete;
+    LotReadGuard& operator=(const LotReadGuard&) = delete;
+
+    /**
+     * @brief Returns the pinned snapshot
+     */
+    const LotSnapshot& snapshot() const { return *pinned; }
+
+private:
+    LotReader& reader;
+    const LotSnapshot* pinned;
+};
+
+#endif // LOT_INDEX_H
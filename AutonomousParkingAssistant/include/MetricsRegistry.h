@@ -0,0 +1,229 @@
+/**
+ * @file MetricsRegistry.h
+ * @brief Live counters and latency histograms in shared memory
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ *
+ * A headless assistant only reports its statistics when a session ends.
+ * This file declares a registry of named counters and latency histograms
+ * that the control loop updates as it runs. The registry can live in a
+ * named shared-memory segment, so the parkingMetrics tool can sample
+ * throughput, latency percentiles, collisions and the status
+ * distribution from another process at any time.
+ *
+ * Every counter and histogram owns whole cache lines, so updating one
+ * costs a relaxed atomic add and never contends with another metric.
+ * Readers map the segment read-only and never write to it, so sampling
+ * has no effect on the writer.
+ */
+
+#ifndef METRICS_REGISTRY_H
+#define METRICS_REGISTRY_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @class MetricCounter
+ * @brief Handle to a monotonically increasing counter
+ *
+ * A default-constructed handle ignores updates, so code paths can hold
+ * handles whether or not metrics are collected.
+ */
+class MetricCounter {
+public:
+    MetricCounter() : cell(nullptr) {}
+    explicit MetricCounter(std::atomic<std::uint64_t>* cell) : cell(cell) {}
+
+    void add(std::uint64_t n = 1) const {
+        if (cell) cell->fetch_add(n, std::memory_order_relaxed);
+    }
+
+    std::uint64_t value() const { return cell ? cell->load(std::memory_order_relaxed) : 0; }
+
+private:
+    std::atomic<std::uint64_t>* cell;
+};
+
+/**
+ * @class MetricHistogram
+ * @brief Handle to a latency histogram
+ *
+ * Durations in nanoseconds go into log-linear buckets: four per power of
+ * two, so a percentile read back is at most 25 % above the true value.
+ * Durations beyond about 36 minutes share the last bucket.
+ */
+class MetricHistogram {
+public:
+    static const int kBuckets = 160;
+
+    MetricHistogram() : cells(nullptr) {}
+    explicit MetricHistogram(std::atomic<std::uint64_t>* cells) : cells(cells) {}
+
+    /**
+     * @brief Records one duration
+     */
+    void record(std::uint64_t nanoseconds) const;
+
+    /**
+     * @brief Bucket a duration falls into
+     */
+    static int bucketOf(std::uint64_t nanoseconds);
+
+    /**
+     * @brief Largest duration counted in a bucket (nanoseconds)
+     */
+    static std::uint64_t bucketUpperBound(int bucket);
+
+private:
+    std::atomic<std::uint64_t>* cells;   ///< count, sum, then kBuckets buckets
+};
+
+/**
+ * @struct CounterSample
+ * @brief Value of one counter at sampling time
+ */
+struct CounterSample {
+    std::string name;
+    std::uint64_t value;
+};
+
+/**
+ * @struct HistogramSample
+ * @brief Contents of one histogram at sampling time
+ */
+struct HistogramSample {
+    std::string name;
+    std::uint64_t count = 0;                 ///< Durations recorded
+    std::uint64_t sumNs = 0;                 ///< Their total (nanoseconds)
+    std::vector<std::uint64_t> buckets;      ///< MetricHistogram::kBuckets counts
+
+    /**
+     * @brief Duration below which a fraction of the recorded durations fall
+     * @param q Fraction in [0, 1], e.g. 0.99
+     * @return Upper bound of the bucket holding that rank (nanoseconds), 0 if empty
+     */
+    double percentile(double q) const;
+};
+
+/**
+ * @struct MetricsSnapshot
+ * @brief Every metric of a registry at one point in time
+ *
+ * Metrics are read one after another without stopping the writer, so
+ * values of different metrics may be a few updates apart.
+ */
+struct MetricsSnapshot {
+    std::vector<CounterSample> counters;
+    std::vector<HistogramSample> histograms;
+
+    /**
+     * @brief Writes the snapshot in the Prometheus text exposition format
+     *
+     * Counters become counter families and histograms become histogram
+     * families in seconds, with cumulative buckets up to the largest
+     * non-empty one.
+     */
+    void writePrometheus(std::ostream& out) const;
+};
+
+/**
+ * @class MetricsRegistry
+ * @brief Fixed-capacity registry of counters and histograms
+ *
+ * Metric names follow Prometheus rules ([a-zA-Z_:][a-zA-Z0-9_:]*, at
+ * most 55 characters). Registering an existing name returns the same
+ * metric. Metrics are never removed. Registration takes a lock and
+ * handles stay valid as long as the registry, so look metrics up once
+ * and keep the handles.
+ *
+ * @note Shared-memory registries are available on POSIX systems only
+ *
+ * @example
+ * MetricsRegistry metrics = MetricsRegistry::createShared("/parking_metrics");
+ * MetricCounter frames = metrics.counter("parking_frames_total");
+ * MetricHistogram latency = metrics.histogram("parking_frame_latency_seconds");
+ * frames.add();
+ * latency.record(elapsedNs);
+ */
+class MetricsRegistry {
+public:
+    static const std::size_t kMaxCounters = 64;
+    static const std::size_t kMaxHistograms = 8;
+    static const std::size_t kMaxNameLength = 55;
+
+    /**
+     * @brief Creates an in-process registry
+     */
+    MetricsRegistry();
+
+    /**
+     * @brief Creates a named shared-memory registry
+     * @param name Segment name (e.g. "/parking_metrics"); an existing segment is replaced
+     * @throws std::runtime_error if the segment cannot be created or the
+     *         platform does not support shared memory
+     */
+    static MetricsRegistry createShared(const std::string& name);
+
+    /**
+     * @brief Maps a shared-memory registry read-only for sampling
+     * @throws std::runtime_error if the segment does not exist or is not a registry
+     */
+    static MetricsRegistry attachShared(const std::string& name);
+
+    /**
+     * @brief Removes a named shared-memory registry; existing mappings stay valid
+     */
+    static void unlinkShared(const std::string& name);
+
+    MetricsRegistry(MetricsRegistry&& other);
+    ~MetricsRegistry();
+
+    MetricsRegistry(const MetricsRegistry&) = delete;
+    MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+    MetricsRegistry& operator=(MetricsRegistry&&) = delete;
+
+    /**
+     * @brief Finds or creates a counter
+     * @throws std::invalid_argument for an invalid name
+     * @throws std::runtime_error when the registry is full or read-only
+     */
+    MetricCounter counter(const std::string& name);
+
+    /**
+     * @brief Finds or creates a latency histogram
+     * @throws std::invalid_argument for an invalid name
+     * @throws std::runtime_error when the registry is full or read-only
+     */
+    MetricHistogram histogram(const std::string& name);
+
+    /**
+     * @brief Reads every metric
+     */
+    MetricsSnapshot snapshot() const;
+
+private:
+    struct Header;
+    struct CounterSlot;
+    struct HistogramSlot;
+
+    MetricsRegistry(void* region, void* allocation, bool shared, bool readOnly);
+    static std::size_t regionSize();
+    static void validateName(const std::string& name);
+    CounterSlot* counterSlots() const;
+    HistogramSlot* histogramSlots() const;
+
+    Header* header;        ///< Start of the cache-line aligned region
+    void* allocation;      ///< Heap block holding an in-process region
+    bool shared;           ///< Region is a shared-memory mapping
+    bool readOnly;         ///< Mapped for sampling only
+    std::mutex registration;
+};
+
+#endif // METRICS_REGISTRY_H
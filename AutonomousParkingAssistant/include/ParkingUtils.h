@@ -15,7 +15,12 @@
 
 #include <string>
 #include <vector>
+#include "DeadlineWatchdog.h"
+#include "MetricsRegistry.h"
 #include "SensorData.h"
+#include "SessionSummary.h"
+#include "StatusClassifier.h"
+#include "VehicleKinematics.h"
 
 /**
  * @brief Validates and retrieves double input from user with error handling
@@ -79,6 +84,66 @@ std::string checkSafety(const SensorData& s);
  */
 void beepAlert(const SensorData& s);
 
+/**
+ * @brief Proximity beep level of a reading, as played by beepAlert()
+ * @param s The SensorData structure containing distance readings
+ * @return 0 for silence, 1 for a single beep (any sensor < 0.5m),
+ *         2 for a double beep (any sensor < 0.3m)
+ */
+int beepLevel(const SensorData& s);
+
+/**
+ * @enum SteeringAdvice
+ * @brief Steering guidance given for a reading
+ */
+enum class SteeringAdvice {
+    SteerRight,     ///< Left side closer
+    SteerLeft,      ///< Right side closer
+    KeepCentered,   ///< Both sides equal, within the tolerance
+    None            ///< No steering advice is given for the reading
+};
+
+/**
+ * @brief Steering guidance of the parking loop for a reading
+ * @param s The SensorData structure containing distance readings
+ * @param tolerance Side difference still treated as centered (meters)
+ * @return Side to steer away from the closer obstacle, or KeepCentered
+ */
+SteeringAdvice steeringAdvice(const SensorData& s, double tolerance = 0.0);
+
+/**
+ * @struct FrameDecision
+ * @brief Everything the parking loop decides for one reading
+ */
+struct FrameDecision {
+    std::string status;                               ///< Status line, opposite-movement prompt or collision
+                                                      ///< message; empty if a change-only session has no news
+    int beep = 0;                                     ///< beepLevel()
+    SteeringAdvice steering = SteeringAdvice::None;   ///< None after an opposite-movement prompt or a collision
+    ParkingStatus zone = ParkingStatus::Unknown;      ///< Zone the session summary counts the reading in
+    bool oppositeMovement = false;                    ///< Every sensor under 0.3 m; the driver backs off
+};
+
+/**
+ * @brief Decides one reading exactly as parkingAssistantLoop() does
+ * @param s The SensorData structure containing distance readings
+ * @param reverseMode Whether the vehicle is in reverse mode (true) or forward mode (false)
+ * @param classifier Status classifier of a change-only session, or null to
+ *        classify every reading with checkSafety()
+ * @return Beep level, status and steering advice of the reading
+ *
+ * When every sensor is under 0.3 m the reading gets the opposite-movement
+ * prompt instead of a status and no steering advice, and the classifier
+ * is not updated. A collision is reported in the status, not thrown.
+ * Otherwise the steering advice treats sides within the classifier's
+ * hysteresis band as equal.
+ *
+ * @example
+ * FrameDecision d = decideParkingFrame(SensorData{0.2, 0.25, 0.2}, false);
+ * // d.oppositeMovement, d.status == "Opposite Movement: FORWARD mode sensors close → Move BACKWARD"
+ */
+FrameDecision decideParkingFrame(const SensorData& s, bool reverseMode, StatusClassifier* classifier = nullptr);
+
 /**
  * @brief Calculates the minimum parking space required for a vehicle
  * @param parallel Whether the parking is parallel (true) or perpendicular (false)
@@ -99,6 +164,30 @@ void beepAlert(const SensorData& s);
  */
 double requiredSpace(bool parallel, double carLength, double carWidth);
 
+/**
+ * @brief Calculates the minimum parking space required for a modelled vehicle
+ * @param parallel Whether the parking is parallel (true) or perpendicular (false)
+ * @param vehicle Kinematic vehicle model (wheelbase, overhangs, turning radius)
+ * @param moves Number of moves allowed for parallel parking (default: 1)
+ * @return The minimum required parking space in meters
+ * @throws std::invalid_argument if the vehicle model is inconsistent
+ *
+ * Unlike the fixed carLength + 1.0 heuristic, parallel parking uses the
+ * closed-form minimum slot length from minParallelSlotLength(), so tight-
+ * turning cars are accepted in shorter slots and long-wheelbase vans
+ * require longer ones.
+ *
+ * Space requirements:
+ * - Parallel parking: minParallelSlotLength(vehicle, moves)
+ * - Perpendicular parking: width + 0.5m
+ *
+ * @example
+ * VehicleModel van = {2.0, 3.66, 1.0, 1.2, 6.6};
+ * double space = requiredSpace(true, van);     // single-move slot length
+ * double space = requiredSpace(true, van, 3);  // three-move slot length
+ */
+double requiredSpace(bool parallel, const VehicleModel& vehicle, int moves = 1);
+
 /**
  * @brief Scans available parking spaces and finds a suitable one
  * @param parallel Whether the parking is parallel (true) or perpendicular (false)
@@ -124,6 +213,54 @@ double requiredSpace(bool parallel, double carLength, double carWidth);
  */
 bool findParkingSpace(bool parallel, double carLength, double carWidth);
 
+/**
+ * @brief Scans available parking spaces for a modelled vehicle
+ * @param parallel Whether the parking is parallel (true) or perpendicular (false)
+ * @param vehicle Kinematic vehicle model (e.g. VehicleProfile::model)
+ * @return true if a suitable space is found, false otherwise
+ * @throws std::invalid_argument if the vehicle model is inconsistent
+ *
+ * Behaves like the dimension-based overload but compares each space
+ * against requiredSpace(parallel, vehicle).
+ *
+ * @example
+ * const VehicleProfile* p = findVehicleProfile("SUV-07");
+ * if (p && findParkingSpace(true, p->model)) { ... }
+ */
+bool findParkingSpace(bool parallel, const VehicleModel& vehicle);
+
+/**
+ * @enum SessionReport
+ * @brief What a parking session keeps for its final summary
+ */
+enum class SessionReport {
+    FullHistory,   ///< Every recorded step, printed as the Parking Summary table
+    SummaryOnly    ///< Streaming aggregates only; memory does not grow with the session
+};
+
+/**
+ * @struct SessionMetrics
+ * @brief Live metrics a parking session updates while it runs
+ *
+ * A default-constructed set collects nothing. Constructed from a
+ * registry, it registers (or finds) these metrics:
+ * - parking_frames_total, parking_frame_latency_seconds
+ * - parking_deadline_overruns_total, parking_watchdog_stops_total (sessions with a watchdog)
+ * - parking_collisions_total
+ * - parking_status_<status>_total, one per classified status
+ */
+struct SessionMetrics {
+    MetricCounter frames;                  ///< Readings processed
+    MetricHistogram frameLatency;          ///< Processing time of each reading
+    MetricCounter deadlineOverruns;        ///< Readings that missed the frame deadline
+    MetricCounter watchdogStops;           ///< Readings that reached the stall limit
+    MetricCounter collisions;              ///< Sessions ended by a collision
+    MetricCounter statuses[5];             ///< Readings per ParkingStatus
+
+    SessionMetrics() = default;
+    explicit SessionMetrics(MetricsRegistry& registry);
+};
+
 /**
  * @brief Main parking assistant loop that guides the user through parking
  * @param reverseMode Whether the vehicle is in reverse mode (true) or forward mode (false)
@@ -132,13 +269,14 @@ bool findParkingSpace(bool parallel, double carLength, double carWidth);
  * This function implements the main parking assistance algorithm. It:
  * 1. Continuously reads sensor data from the user
  * 2. Analyzes safety conditions and provides warnings
- * 3. Gives steering and movement guidance
+ * 3. Gives steering and movement guidance whenever the advice changes
  * 4. Tracks parking history and provides a summary
  * 5. Handles collision detection and emergency stops
  * 6. Detects perfect parking conditions
  * 
  * The function maintains a history of all parking steps and provides
- * a detailed summary table at the end of the parking session.
+ * a detailed summary table at the end of the parking session, followed
+ * by the session statistics of a SessionSummary.
  * 
  * Special features:
  * - Opposite movement detection when all sensors are too close
@@ -152,4 +290,86 @@ bool findParkingSpace(bool parallel, double carLength, double carWidth);
  */
 void parkingAssistantLoop(bool reverseMode, bool parallel);
 
+/**
+ * @brief Main parking assistant loop with a choice of summary
+ * @param reverseMode Whether the vehicle is in reverse mode (true) or forward mode (false)
+ * @param parallel Whether the parking is parallel (true) or perpendicular (false)
+ * @param report FullHistory behaves like parkingAssistantLoop(reverseMode, parallel);
+ *        SummaryOnly keeps no step history
+ *
+ * In summary-only mode the step table is left out. The session ends
+ * with the per-sensor minimum, mean and maximum, the frames and time
+ * spent in each zone and the steps taken to park, all updated in
+ * constant time per frame. Memory use stays the same however long the
+ * session runs.
+ *
+ * @example
+ * parkingAssistantLoop(true, false, SessionReport::SummaryOnly);
+ */
+void parkingAssistantLoop(bool reverseMode, bool parallel, SessionReport report);
+
+/**
+ * @brief Parking assistant loop that publishes live metrics
+ * @param reverseMode Whether the vehicle is in reverse mode (true) or forward mode (false)
+ * @param parallel Whether the parking is parallel (true) or perpendicular (false)
+ * @param report Whether to keep the step history or streaming aggregates only
+ * @param metrics Live metrics to update after every reading
+ *
+ * Same session as parkingAssistantLoop(reverseMode, parallel, report).
+ * Frame counts, processing times, collisions and the status of every
+ * reading go to the metrics, so another process can follow the session
+ * through a shared MetricsRegistry. No frame deadline is enforced.
+ */
+void parkingAssistantLoop(bool reverseMode, bool parallel, SessionReport report, const SessionMetrics& metrics);
+
+/**
+ * @brief Parking assistant loop with a frame deadline watchdog
+ * @param reverseMode Whether the vehicle is in reverse mode (true) or forward mode (false)
+ * @param parallel Whether the parking is parallel (true) or perpendicular (false)
+ * @param report Whether to keep the step history or streaming aggregates only
+ * @param watchdog Processing deadline of one reading and the stall limit
+ * @param metrics Live metrics to update after every reading (none by default)
+ * @throws std::invalid_argument unless 0 < frameDeadline <= hardLimit
+ *
+ * Only this overload arms a DeadlineWatchdog. It times the processing of
+ * each reading, from the proximity alert to the bookkeeping, but not the
+ * wait for input. The session summary reports how many readings missed
+ * the deadline and the stage that took longest in them. A reading that
+ * takes longer than the stall limit prints a STOP warning as soon as the
+ * limit passes, and the session ends after that reading.
+ *
+ * The metrics are those of the SessionMetrics overload plus the deadline
+ * overruns and watchdog stops.
+ *
+ * @example
+ * WatchdogConfig deadline;
+ * deadline.frameDeadline = 0.01;   // 100 Hz sensors
+ * parkingAssistantLoop(true, false, SessionReport::SummaryOnly, deadline);
+ */
+void parkingAssistantLoop(bool reverseMode, bool parallel, SessionReport report, const WatchdogConfig& watchdog,
+                          const SessionMetrics& metrics = SessionMetrics());
+
+/**
+ * @brief Parking assistant loop that reports status changes only
+ * @param reverseMode Whether the vehicle is in reverse mode (true) or forward mode (false)
+ * @param parallel Whether the parking is parallel (true) or perpendicular (false)
+ * @param statusConfig Hysteresis and dwell time of the status classifier
+ * @param report Whether to keep the step history (default) or streaming aggregates only
+ * @throws std::invalid_argument for an invalid statusConfig
+ *
+ * Same session as parkingAssistantLoop(reverseMode, parallel), but each
+ * reading goes through a StatusClassifier instead of checkSafety(). The
+ * status is printed and recorded only when it changes. Readings that
+ * hover around a threshold therefore produce no output beyond the
+ * proximity beeps, and a change to perfect parking has to hold for the
+ * dwell time. Steering within the hysteresis band counts as centered.
+ *
+ * @example
+ * StatusClassifierConfig config;
+ * config.minDwellFrames = 5;
+ * parkingAssistantLoop(true, false, config);
+ */
+void parkingAssistantLoop(bool reverseMode, bool parallel, const StatusClassifierConfig& statusConfig,
+                          SessionReport report = SessionReport::FullHistory);
+
 #endif // PARKING_UTILS_H
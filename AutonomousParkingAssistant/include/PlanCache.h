@@ -0,0 +1,188 @@
+/**
+ * @file PlanCache.h
+ * @brief Memory-bounded LRU cache of parking trajectories
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ *
+ * This file declares a cache that returns a stored trajectory when a
+ * vehicle class approaches a bay of the same shape from nearly the same
+ * pose relative to that bay. Keys are quantized and expressed in the bay's
+ * own frame, and trajectories are stored in that frame, so one cached plan
+ * serves every identical bay in the lot. Entries are evicted in
+ * least-recently-used order to stay within a byte budget, and hit rate and
+ * latency statistics are kept for tuning.
+ */
+
+#ifndef PLAN_CACHE_H
+#define PLAN_CACHE_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Geometry2D.h"
+
+/**
+ * @struct PlanKey
+ * @brief Quantized bay shape, vehicle class and bay-relative start pose
+ */
+struct PlanKey {
+    std::int32_t bayLength;     ///< Bay length in size steps
+    std::int32_t bayWidth;      ///< Bay width in size steps
+    std::int32_t startX;        ///< Start x in the bay frame, in position steps
+    std::int32_t startY;        ///< Start y in the bay frame, in position steps
+    std::int32_t startHeading;  ///< Start heading relative to the bay, in heading steps
+    std::string vehicleClass;   ///< Vehicle class (e.g. catalogue code)
+
+    bool operator==(const PlanKey& other) const {
+        return bayLength == other.bayLength && bayWidth == other.bayWidth && startX == other.startX &&
+               startY == other.startY && startHeading == other.startHeading &&
+               vehicleClass == other.vehicleClass;
+    }
+};
+
+/**
+ * @struct PlanKeyHash
+ * @brief Hash functor for PlanKey
+ */
+struct PlanKeyHash {
+    std::size_t operator()(const PlanKey& key) const;
+};
+
+/**
+ * @struct PlanCacheStats
+ * @brief Counters reported by PlanCache::stats()
+ */
+struct PlanCacheStats {
+    std::uint64_t hits;           ///< Lookups answered from the cache
+    std::uint64_t misses;         ///< Lookups that required planning
+    std::uint64_t insertions;     ///< Trajectories stored
+    std::uint64_t evictions;      ///< Entries dropped to respect the budget
+    std::size_t entries;          ///< Entries currently held
+    std::size_t bytes;            ///< Estimated memory currently held
+    double meanHitLatencyUs;      ///< Mean getOrPlan() time on hits (microseconds)
+    double meanMissLatencyUs;     ///< Mean getOrPlan() time on misses, planning included (microseconds)
+
+    /**
+     * @brief Returns hits / (hits + misses), or 0 before any lookup
+     */
+    double hitRate() const {
+        return hits + misses == 0 ? 0.0 : static_cast<double>(hits) / (hits + misses);
+    }
+};
+
+/**
+ * @class PlanCache
+ * @brief Thread-safe LRU trajectory cache bounded in bytes
+ *
+ * @example
+ * PlanCache cache(16 << 20);   // 16 MiB
+ * std::vector<Pose2D> path = cache.getOrPlan(bay, "SEDAN-04", start,
+ *     [&]() { return planner.plan(start, bay); });
+ */
+class PlanCache {
+public:
+    typedef std::function<std::vector<Pose2D>()> Planner;
+
+    static const double kDefaultPositionStep;  ///< Default start position quantum (meters)
+    static const double kDefaultHeadingStep;   ///< Default start heading quantum (radians)
+    static const double kDefaultSizeStep;      ///< Default bay dimension quantum (meters)
+
+    /**
+     * @brief Creates an empty cache
+     * @param maxBytes Memory budget for stored entries
+     * @param positionStep Start position quantum (meters)
+     * @param headingStep Start heading quantum (radians)
+     * @param sizeStep Bay length/width quantum (meters)
+     * @throws std::invalid_argument if a step is not positive
+     */
+    explicit PlanCache(std::size_t maxBytes, double positionStep = kDefaultPositionStep,
+                       double headingStep = kDefaultHeadingStep, double sizeStep = kDefaultSizeStep);
+
+    /**
+     * @brief Builds the quantized key for a request
+     * @param bay Bay rectangle (center, half extents, heading) in world coordinates
+     * @param vehicleClass Vehicle class identifier
+     * @param start Vehicle start pose in world coordinates
+     */
+    PlanKey makeKey(const OrientedBox& bay, const std::string& vehicleClass, const Pose2D& start) const;
+
+    /**
+     * @brief Looks up a trajectory
+     * @param bay Bay rectangle in world coordinates
+     * @param vehicleClass Vehicle class identifier
+     * @param start Start pose in world coordinates
+     * @param out Receives the trajectory in world coordinates on a hit
+     * @return true on a hit (the entry becomes most recently used)
+     */
+    bool lookup(const OrientedBox& bay, const std::string& vehicleClass, const Pose2D& start,
+                std::vector<Pose2D>& out);
+
+    /**
+     * @brief Stores a trajectory, evicting least recently used entries as needed
+     * @param bay Bay rectangle in world coordinates
+     * @param vehicleClass Vehicle class identifier
+     * @param start Start pose in world coordinates
+     * @param trajectory Trajectory in world coordinates
+     *
+     * Trajectories larger than the whole budget are not stored.
+     */
+    void insert(const OrientedBox& bay, const std::string& vehicleClass, const Pose2D& start,
+                const std::vector<Pose2D>& trajectory);
+
+    /**
+     * @brief Returns the cached trajectory or plans, stores and returns a new one
+     * @param bay Bay rectangle in world coordinates
+     * @param vehicleClass Vehicle class identifier
+     * @param start Start pose in world coordinates
+     * @param planner Called on a miss (outside the cache lock)
+     * @return Trajectory in world coordinates
+     *
+     * Empty trajectories (planning failures) are returned but not cached.
+     */
+    std::vector<Pose2D> getOrPlan(const OrientedBox& bay, const std::string& vehicleClass,
+                                  const Pose2D& start, const Planner& planner);
+
+    /**
+     * @brief Returns a snapshot of the cache statistics
+     */
+    PlanCacheStats stats() const;
+
+    /**
+     * @brief Drops every entry (statistics are kept)
+     */
+    void clear();
+
+private:
+    struct Entry {
+        PlanKey key;
+        std::vector<Pose2D> trajectory;  ///< In the bay frame
+        std::size_t bytes;
+    };
+    typedef std::list<Entry> EntryList;
+
+    void evictLocked();
+
+    const std::size_t maxBytes;
+    const double positionStep;
+    const double headingStep;
+    const double sizeStep;
+
+    mutable std::mutex cacheMutex;
+    EntryList entries;  ///< Most recently used first
+    std::unordered_map<PlanKey, EntryList::iterator, PlanKeyHash> index;
+    std::size_t bytes = 0;
+    PlanCacheStats counters = {};
+    std::chrono::nanoseconds hitTime{0};   ///< Total getOrPlan() time on hits
+    std::chrono::nanoseconds missTime{0};  ///< Total getOrPlan() time on misses
+    std::uint64_t timedHits = 0;           ///< getOrPlan() hits
+    std::uint64_t timedMisses = 0;         ///< getOrPlan() misses
+};
+
+#endif // PLAN_CACHE_H
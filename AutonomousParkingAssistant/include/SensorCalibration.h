@@ -0,0 +1,146 @@
+/**
+ * @file SensorCalibration.h
+ * @brief Per-sensor offset, gain and temperature calibration of raw readings
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ *
+ * checkSafety() and the status classifier compare readings with fixed
+ * 0.1/0.3/0.5 m thresholds, so a sensor unit that reads 4 cm long makes
+ * a car look parked when it is not. This file declares the calibration
+ * applied to every reading before it is classified: an offset and gain
+ * per sensor, plus a linear temperature term for ultrasonic sensors,
+ * whose echo time depends on the speed of sound.
+ *
+ * Calibrations are kept in a compact table keyed by vehicle id, with a
+ * fixed-size binary record per vehicle. calibrateFrames() corrects a
+ * whole recorded session in place with an SSE2 kernel, so archived
+ * sessions can be recalibrated cheaply when a vehicle's table entry
+ * changes.
+ */
+
+#ifndef SENSOR_CALIBRATION_H
+#define SENSOR_CALIBRATION_H
+
+#include <cstddef>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "SensorData.h"
+
+/**
+ * @struct ChannelCalibration
+ * @brief Correction of one sensor
+ *
+ * corrected = (gain * raw + offset) * (1 + tempCoeff * (T - referenceTemp))
+ *
+ * For an ultrasonic sensor calibrated at referenceTemp, tempCoeff is
+ * about 0.0017 per °C: the speed of sound grows by 0.6 m/s per °C from
+ * about 343 m/s at 20 °C.
+ */
+struct ChannelCalibration {
+    float offset = 0.0f;      ///< Added after the gain (meters)
+    float gain = 1.0f;        ///< Scale factor of the raw reading
+    float tempCoeff = 0.0f;   ///< Relative change per °C away from the reference temperature
+};
+
+/**
+ * @struct SensorCalibration
+ * @brief Calibration of the three sensors of one vehicle
+ *
+ * The default-constructed calibration leaves readings unchanged.
+ */
+struct SensorCalibration {
+    ChannelCalibration left;      ///< Applied to SensorData::left
+    ChannelCalibration center;    ///< Applied to SensorData::center
+    ChannelCalibration right;     ///< Applied to SensorData::right
+    float referenceTemp = 20.0f;  ///< Temperature the offsets and gains were measured at (°C)
+};
+
+/**
+ * @brief Calibrates one reading
+ * @param raw Reading as reported by the sensors
+ * @param calibration Vehicle calibration
+ * @param temperatureC Ambient temperature (°C)
+ * @return Corrected reading
+ */
+SensorData calibrate(const SensorData& raw, const SensorCalibration& calibration, double temperatureC);
+
+/**
+ * @brief Calibrates a recorded session in place
+ * @param frames Readings to correct
+ * @param calibration Vehicle calibration
+ * @param temperatureC Ambient temperature of the session (°C)
+ *
+ * Gives the same results as calibrate() on every frame. The temperature
+ * is fixed for the session, so each sensor's correction becomes
+ * a * raw + b. Two frames (six values) are corrected per iteration with
+ * three SSE2 multiply-adds.
+ */
+void calibrateFrames(std::vector<SensorData>& frames, const SensorCalibration& calibration, double temperatureC);
+
+/**
+ * @class CalibrationTable
+ * @brief Sensor calibrations of a fleet, keyed by vehicle id
+ *
+ * Entries are kept sorted by id in one contiguous array of 56-byte
+ * records (16-byte id, ten floats), so a lookup is a binary search and
+ * save() writes the array as it is. Vehicle ids are 1 to 15 characters.
+ *
+ * @example
+ * CalibrationTable table = CalibrationTable::load(file);
+ * const SensorCalibration* cal = table.find("FLEET-0042");
+ * SensorData s = calibrate(raw, cal ? *cal : SensorCalibration(), ambientC);
+ */
+class CalibrationTable {
+public:
+    /**
+     * @brief Adds or replaces the calibration of a vehicle
+     * @throws std::invalid_argument for an empty or over-long id, or a gain that is not positive and finite
+     */
+    void set(const std::string& vehicleId, const SensorCalibration& calibration);
+
+    /**
+     * @brief Removes a vehicle
+     * @return True if it was present
+     */
+    bool erase(const std::string& vehicleId);
+
+    /**
+     * @brief Looks up a vehicle
+     * @return The calibration, or nullptr if the vehicle has none; valid until the table is modified
+     */
+    const SensorCalibration* find(const std::string& vehicleId) const;
+
+    std::size_t size() const { return records.size(); }
+
+    /**
+     * @brief Writes the table in its binary form
+     * @throws std::runtime_error if the stream fails
+     */
+    void save(std::ostream& out) const;
+
+    /**
+     * @brief Reads a table written by save()
+     * @throws std::runtime_error for a truncated or foreign stream, or a
+     *         record set() would reject; the message names the record
+     *         number (from 1) and vehicle id
+     */
+    static CalibrationTable load(std::istream& in);
+
+    static const std::size_t kMaxIdLength = 15;   ///< Longest vehicle id
+
+private:
+    struct Record {
+        char id[kMaxIdLength + 1];      ///< Zero-padded vehicle id
+        SensorCalibration calibration;
+    };
+
+    std::vector<Record>::iterator lowerBound(const std::string& vehicleId);
+    std::vector<Record>::const_iterator lowerBound(const std::string& vehicleId) const;
+
+    std::vector<Record> records;   ///< Sorted by id
+};
+
+#endif // SENSOR_CALIBRATION_H
@@ -40,6 +40,40 @@ struct SensorData {
     double right;   ///< Distance from right sensor (meters)
 };
 
+/**
+ * @struct SensorMount
+ * @brief Mounting position and field of a single distance sensor
+ *
+ * Positions are expressed in the vehicle frame: the origin is the rear
+ * axle midpoint, x points forward and y points to the left. Headings are
+ * in radians relative to the vehicle's forward direction (counter-clockwise
+ * positive).
+ *
+ * @example
+ * SensorMount front = {3.4, 0.0, 0.0, 4.0}; // Front bumper, looking ahead, 4 m range
+ */
+struct SensorMount {
+    double x;         ///< Longitudinal position (meters, forward positive)
+    double y;         ///< Lateral position (meters, left positive)
+    double heading;   ///< Boresight direction (radians, CCW from forward)
+    double maxRange;  ///< Maximum measurable distance (meters)
+};
+
+/**
+ * @struct SensorLayout
+ * @brief Placement of the parking sensors on a vehicle
+ *
+ * The left and right sensors feed SensorData::left and SensorData::right.
+ * SensorData::center is fed by the front sensor when driving forward and
+ * by the rear sensor in reverse mode.
+ */
+struct SensorLayout {
+    SensorMount left;   ///< Left side sensor
+    SensorMount front;  ///< Front center sensor (forward mode)
+    SensorMount right;  ///< Right side sensor
+    SensorMount rear;   ///< Rear center sensor (reverse mode)
+};
+
 /**
  * @class UnsafeParkingException
  * @brief Custom exception class for collision and unsafe parking conditions
@@ -0,0 +1,162 @@
+/**
+ * @file SensorHealthMonitor.h
+ * @brief Online detection of stuck, erratic and failed parking sensors
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ *
+ * checkSafety() trusts every reading, so a sensor frozen at 0.4 m looks
+ * like a perfectly parked car. This file declares a monitor that keeps
+ * rolling statistics of each sensor over a short window of frames. It
+ * flags a sensor that stops moving while its neighbours move, one that
+ * keeps jumping by implausible amounts, and one that returns no usable
+ * value. The fault mask it returns switches a StatusClassifier to its
+ * degraded mode.
+ *
+ * The windowed mean and variance are updated with Welford's method:
+ * each frame adds the new sample and removes the one leaving the window.
+ * The cost per frame is constant and does not depend on the window size.
+ */
+
+#ifndef SENSOR_HEALTH_MONITOR_H
+#define SENSOR_HEALTH_MONITOR_H
+
+#include <cstddef>
+#include <vector>
+#include "SensorData.h"
+
+/**
+ * @enum SensorChannel
+ * @brief The three sensors of a SensorData reading
+ */
+enum class SensorChannel {
+    Left,     ///< SensorData::left
+    Center,   ///< SensorData::center
+    Right     ///< SensorData::right
+};
+
+/**
+ * @brief Bit of a sensor in a fault mask (Left = 1, Center = 2, Right = 4)
+ */
+inline unsigned sensorBit(SensorChannel channel) {
+    return 1u << static_cast<unsigned>(channel);
+}
+
+/**
+ * @enum SensorFault
+ * @brief Health verdict for one sensor
+ */
+enum class SensorFault {
+    None,      ///< Readings look plausible
+    Stuck,     ///< Frozen over a full window while another sensor moves
+    Erratic,   ///< Too many implausible jumps within the window
+    Invalid    ///< Latest reading is NaN, infinite or negative
+};
+
+/**
+ * @brief Returns a display name for a fault
+ */
+const char* faultName(SensorFault fault);
+
+/**
+ * @struct SensorHealthConfig
+ * @brief Window and thresholds of a SensorHealthMonitor
+ */
+struct SensorHealthConfig {
+    std::size_t window = 16;          ///< Frames in the rolling window
+    double stuckVariance = 1e-8;      ///< A sensor is frozen at or below this variance (m², below real sensor noise)
+    double movingVariance = 1e-3;     ///< A neighbour moves at or above this variance (m²)
+    double maxStep = 0.5;             ///< Change between two frames that counts as a jump (meters)
+    std::size_t maxJumps = 3;         ///< Jumps within the window that make a sensor erratic
+};
+
+/**
+ * @struct SensorHealth
+ * @brief Statistics and verdict of one sensor over the current window
+ */
+struct SensorHealth {
+    SensorFault fault;   ///< Current verdict
+    double mean;         ///< Mean over the window (meters)
+    double variance;     ///< Population variance over the window (m²)
+    double rate;         ///< Change since the previous frame (meters per frame)
+    std::size_t jumps;   ///< Jumps within the window
+};
+
+/**
+ * @class SensorHealthMonitor
+ * @brief Tracks rolling statistics of each sensor and flags faults
+ *
+ * Rules, checked each frame:
+ * - Invalid: the reading is NaN, infinite or negative. Such samples are
+ *   kept out of the statistics.
+ * - Erratic: at least maxJumps changes larger than maxStep within the
+ *   window. A single jump, such as an obstacle appearing, is fine.
+ * - Stuck: the window is full, the variance is at or below stuckVariance,
+ *   and some other sensor has a variance of at least movingVariance. When
+ *   the whole car stands still nothing is flagged, because every sensor
+ *   is frozen for a good reason. A stuck sensor stays flagged, even after
+ *   the car stops, until its own readings move again.
+ *
+ * @example
+ * SensorHealthMonitor monitor;
+ * StatusClassifier classifier;
+ * for (const SensorData& s : frames) {
+ *     classifier.setDegradedSensors(monitor.update(s));
+ *     classifier.update(s, &event);
+ * }
+ */
+class SensorHealthMonitor {
+public:
+    /**
+     * @brief Creates a monitor
+     * @throws std::invalid_argument for a window below two frames, maxJumps of zero,
+     *         a negative step, or stuckVariance not below movingVariance
+     */
+    explicit SensorHealthMonitor(const SensorHealthConfig& config = SensorHealthConfig());
+
+    /**
+     * @brief Adds a frame and re-evaluates every sensor
+     * @param s Sensor reading
+     * @return Fault mask of the sensors currently flagged (see sensorBit())
+     */
+    unsigned update(const SensorData& s);
+
+    /**
+     * @brief Forgets all frames
+     */
+    void reset();
+
+    SensorHealth health(SensorChannel channel) const;
+    unsigned faultMask() const { return mask; }
+    bool degraded() const { return mask != 0; }
+    std::size_t frames() const { return frameCount; }
+    const SensorHealthConfig& config() const { return settings; }
+
+private:
+    /**
+     * @brief Ring buffer and running moments of one sensor
+     */
+    struct Channel {
+        std::vector<double> samples;      ///< Last window samples
+        std::vector<unsigned char> jumped; ///< Whether each sample was a jump
+        std::size_t next = 0;             ///< Ring position of the next sample
+        std::size_t count = 0;            ///< Valid samples held (up to window)
+        double mean = 0.0;
+        double m2 = 0.0;                  ///< Sum of squared deviations from the mean
+        double last = 0.0;
+        double rate = 0.0;
+        std::size_t jumps = 0;
+        bool invalid = false;
+        SensorFault fault = SensorFault::None;
+    };
+
+    void addSample(Channel& c, double x);
+    double variance(const Channel& c) const;
+
+    SensorHealthConfig settings;
+    Channel channels[3];
+    unsigned mask = 0;
+    std::size_t frameCount = 0;
+};
+
+#endif // SENSOR_HEALTH_MONITOR_H
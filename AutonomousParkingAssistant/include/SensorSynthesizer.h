@@ -0,0 +1,160 @@
+/**
+ * @file SensorSynthesizer.h
+ * @brief Ray-cast synthesis of parking sensor readings from a 2D obstacle map
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ *
+ * This file declares an obstacle map of line segments (curbs, walls and the
+ * outlines of other vehicles) accelerated by a uniform grid, and a
+ * synthesizer that turns a vehicle pose and sensor layout into SensorData
+ * by casting rays. It lets parkingAssistantLoop() and the rest of the
+ * system run in closed-loop simulation without hand-typed distances.
+ */
+
+#ifndef SENSOR_SYNTHESIZER_H
+#define SENSOR_SYNTHESIZER_H
+
+#include <cstddef>
+#include <istream>
+#include <ostream>
+#include <vector>
+#include "Geometry2D.h"
+#include "SensorData.h"
+
+/**
+ * @class ObstacleMap
+ * @brief Static 2D obstacle scene with uniform-grid ray casting
+ *
+ * Usage: add segments and boxes, call build(), then cast rays. Rays walk
+ * the grid cell by cell (Amanatides-Woo traversal) and only test the
+ * segments binned in the cells they cross, so cost depends on the ray's
+ * length in cells rather than on the size of the scene. castRay() is
+ * const and safe to call from many threads once the map is built.
+ */
+class ObstacleMap {
+public:
+    /**
+     * @brief Adds a line segment obstacle (e.g. a curb or wall)
+     */
+    void addSegment(Vec2 a, Vec2 b);
+
+    /**
+     * @brief Adds the four edges of an oriented box (e.g. a parked car)
+     */
+    void addBox(const OrientedBox& box);
+
+    /**
+     * @brief Builds the acceleration grid; must be called after adding obstacles
+     * @param cellSize Grid cell edge length in meters (default: 1.0)
+     * @throws std::invalid_argument if cellSize is not positive
+     *
+     * Adding obstacles after build() invalidates the grid until build()
+     * is called again.
+     */
+    void build(double cellSize = 1.0);
+
+    /**
+     * @brief Casts a ray against the scene
+     * @param origin Ray origin in world coordinates
+     * @param direction Unit direction vector
+     * @param maxRange Maximum distance to search (meters)
+     * @return Distance to the nearest hit, or maxRange if nothing is hit
+     * @throws std::logic_error if build() has not been called
+     */
+    double castRay(Vec2 origin, Vec2 direction, double maxRange) const;
+
+    /**
+     * @brief Returns the number of obstacle segments
+     */
+    std::size_t segmentCount() const { return segments.size(); }
+
+private:
+    double hitInCell(std::size_t cell, Vec2 origin, Vec2 direction, double best) const;
+
+    std::vector<Segment2D> segments;     ///< All obstacle edges
+    Vec2 gridOrigin = {0.0, 0.0};        ///< World position of cell (0, 0)
+    double cellSize = 1.0;               ///< Cell edge length
+    double invCellSize = 1.0;            ///< 1 / cellSize
+    int cols = 0;                        ///< Grid columns (x)
+    int rows = 0;                        ///< Grid rows (y)
+    bool built = false;                  ///< Grid matches segments
+    std::vector<unsigned> cellStart;     ///< CSR offsets into cellItems (cols*rows + 1)
+    std::vector<unsigned> cellItems;     ///< Segment indices binned per cell
+};
+
+/**
+ * @class SensorSynthesizer
+ * @brief Computes left/center/right SensorData for a vehicle pose
+ *
+ * Each sensor is modelled as a fan of rays spread over its beam; the
+ * reading is the nearest hit of the fan, capped at the sensor's range.
+ * The center reading comes from the front sensor in forward mode and from
+ * the rear sensor in reverse mode, matching parkingAssistantLoop().
+ *
+ * @example
+ * ObstacleMap map;
+ * map.addBox({{6.0, 0.0}, 2.3, 0.9, 0.0});
+ * map.build();
+ * SensorSynthesizer synth(map);
+ * SensorData s = synth.synthesize({0.0, 0.0, 0.0}, profile->sensors, false);
+ */
+class SensorSynthesizer {
+public:
+    /**
+     * @brief Creates a synthesizer over a built map
+     * @param map Obstacle map (must outlive the synthesizer)
+     * @param raysPerSensor Rays in each sensor's fan (default: 5)
+     * @param beamHalfAngle Half opening angle of each beam in radians (default: ~15 degrees)
+     * @throws std::invalid_argument if raysPerSensor < 1 or beamHalfAngle < 0
+     */
+    explicit SensorSynthesizer(const ObstacleMap& map, int raysPerSensor = 5,
+                               double beamHalfAngle = 0.26);
+
+    /**
+     * @brief Synthesizes one sensor reading
+     * @param pose Vehicle pose (rear axle midpoint)
+     * @param mount Sensor mounting in the vehicle frame
+     * @return Distance in meters, at most mount.maxRange
+     */
+    double readSensor(const Pose2D& pose, const SensorMount& mount) const;
+
+    /**
+     * @brief Synthesizes a full sensor frame
+     * @param pose Vehicle pose (rear axle midpoint)
+     * @param layout Sensor layout of the vehicle
+     * @param reverseMode Whether the center reading uses the rear sensor
+     * @return Left, center and right distances
+     */
+    SensorData synthesize(const Pose2D& pose, const SensorLayout& layout, bool reverseMode) const;
+
+private:
+    const ObstacleMap& map;
+    std::vector<double> fanOffsets;  ///< Ray angle offsets within a beam
+};
+
+/**
+ * @brief Writes a sensor frame in the order parkingAssistantLoop() prompts for it
+ * @param out Stream feeding the loop's input (e.g. a stringstream bound to cin)
+ * @param s Sensor frame to write
+ *
+ * Readings are written with enough digits to read back exactly; the
+ * stream's format flags and precision are left as they were.
+ *
+ * @example
+ * std::stringstream input;
+ * writeSensorFrame(input, synth.synthesize(pose, layout, false));
+ * std::cin.rdbuf(input.rdbuf());
+ */
+void writeSensorFrame(std::ostream& out, const SensorData& s);
+
+/**
+ * @brief Reads back frames written with writeSensorFrame(), e.g. a recorded session
+ * @param in Stream of left, center and right distances, three per frame
+ * @return All complete frames in order
+ * @throws std::runtime_error if the stream holds something other than numbers
+ *         or ends in the middle of a frame
+ */
+std::vector<SensorData> readSensorFrames(std::istream& in);
+
+#endif // SENSOR_SYNTHESIZER_H
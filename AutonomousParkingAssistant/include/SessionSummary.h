@@ -0,0 +1,99 @@
+/**
+ * @file SessionSummary.h
+ * @brief Constant-memory aggregates of a parking session
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ *
+ * The Parking Summary table of parkingAssistantLoop() is printed from
+ * history vectors that grow with every recorded step. This file declares
+ * a summary that is updated in constant time per frame and has a fixed
+ * size: per-sensor minimum, mean and maximum, frames and time spent in
+ * each status zone, and the step on which the car was parked. A
+ * summary-only session keeps nothing else, however long it runs.
+ */
+
+#ifndef SESSION_SUMMARY_H
+#define SESSION_SUMMARY_H
+
+#include <cstddef>
+#include <ostream>
+#include "SensorData.h"
+#include "StatusClassifier.h"
+
+/**
+ * @struct SensorAggregate
+ * @brief Running statistics of one sensor
+ */
+struct SensorAggregate {
+    double min = 0.0;    ///< Smallest reading (meters)
+    double mean = 0.0;   ///< Mean reading (meters)
+    double max = 0.0;    ///< Largest reading (meters)
+};
+
+/**
+ * @class SessionSummary
+ * @brief Streaming per-sensor and per-zone statistics of a session
+ *
+ * Each frame is added with the status it was classified as. When frames
+ * carry timestamps, the time until the next frame is credited to the
+ * zone of the earlier frame, so the last frame adds no time. NaN readings
+ * count towards the frame totals but not towards the sensor statistics.
+ *
+ * @example
+ * SessionSummary summary;
+ * for (const SensorData& s : frames) summary.add(s, classifier.current());
+ * summary.print(std::cout);
+ */
+class SessionSummary {
+public:
+    /**
+     * @brief Adds a frame without timing information
+     */
+    void add(const SensorData& s, ParkingStatus status);
+
+    /**
+     * @brief Adds a frame received at a given time
+     * @param timestampSeconds Seconds since any fixed origin, not decreasing
+     */
+    void add(const SensorData& s, ParkingStatus status, double timestampSeconds);
+
+    /**
+     * @brief Forgets every frame
+     */
+    void reset();
+
+    std::size_t frames() const { return frameCount; }
+    SensorAggregate left() const { return sensors[0]; }
+    SensorAggregate center() const { return sensors[1]; }
+    SensorAggregate right() const { return sensors[2]; }
+    std::size_t framesIn(ParkingStatus status) const { return zoneFrames[static_cast<int>(status)]; }
+    double secondsIn(ParkingStatus status) const { return zoneSeconds[static_cast<int>(status)]; }
+
+    /**
+     * @brief One-based frame on which the car was first perfectly parked, 0 if never
+     */
+    std::size_t stepsToPark() const { return parkedStep; }
+
+    /**
+     * @brief Prints the aggregates as tables
+     * @param out Output stream
+     * @param centerLabel Name of the center sensor (FRONT or REAR)
+     */
+    void print(std::ostream& out, const char* centerLabel = "CENTER") const;
+
+private:
+    static const int kZones = 5;   ///< Values of ParkingStatus
+
+    std::size_t frameCount = 0;
+    std::size_t samples[3] = {0, 0, 0};
+    SensorAggregate sensors[3];
+    std::size_t zoneFrames[kZones] = {0, 0, 0, 0, 0};
+    double zoneSeconds[kZones] = {0.0, 0.0, 0.0, 0.0, 0.0};
+    std::size_t parkedStep = 0;
+    ParkingStatus lastStatus = ParkingStatus::Unknown;
+    bool lastTimed = false;        ///< The previous frame carried a timestamp
+    double lastTimestamp = 0.0;
+};
+
+#endif // SESSION_SUMMARY_H
@@ -0,0 +1,158 @@
+/**
+ * @file StatusClassifier.h
+ * @brief Stateful parking status classifier with hysteresis and dwell time
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ *
+ * checkSafety() classifies every reading on its own, so a sensor hovering
+ * around 0.3 m or 0.5 m flips the status on every frame. This file declares
+ * a classifier that remembers its state: a reading must cross a threshold
+ * by a hysteresis band, and stay across it for a minimum number of frames,
+ * before the status changes. Only changes are reported, which keeps the
+ * guidance output and the recorded history small at high frame rates.
+ */
+
+#ifndef STATUS_CLASSIFIER_H
+#define STATUS_CLASSIFIER_H
+
+#include <cstddef>
+#include <string>
+#include "SensorData.h"
+
+/**
+ * @enum ParkingStatus
+ * @brief Status zones of checkSafety()
+ */
+enum class ParkingStatus {
+    Unknown,          ///< No reading classified yet
+    Safe,             ///< Nothing close, some sensor beyond the parking range
+    TooClose,         ///< Some sensor closer than the parking range
+    PerfectlyParked,  ///< All sensors within the parking range
+    Collision         ///< Some sensor at or below the collision distance
+};
+
+/**
+ * @struct StatusClassifierConfig
+ * @brief Thresholds, hysteresis and dwell time of a StatusClassifier
+ *
+ * The defaults use the thresholds of checkSafety().
+ */
+struct StatusClassifierConfig {
+    double collisionDistance = 0.1;   ///< Collision at or below this distance (meters)
+    double closeDistance = 0.3;       ///< Too close below this distance (meters)
+    double parkedDistance = 0.5;      ///< Parked when all sensors are within [closeDistance, parkedDistance]
+    double hysteresis = 0.03;         ///< A threshold must be crossed by this much to leave a status (meters)
+    std::size_t minDwellFrames = 3;   ///< Frames a new status must persist before it is reported
+};
+
+/**
+ * @struct StatusEvent
+ * @brief A reported status change
+ */
+struct StatusEvent {
+    ParkingStatus from;   ///< Previous status
+    ParkingStatus to;     ///< New status
+    std::size_t frame;    ///< Zero-based frame that completed the change
+    SensorData reading;   ///< Reading of that frame
+    std::string label;    ///< Text in the style of checkSafety()
+};
+
+/**
+ * @brief Returns the checkSafety()-style name of a status
+ */
+const char* statusName(ParkingStatus status);
+
+/**
+ * @brief Status of a single reading with the plain checkSafety() thresholds
+ *
+ * No hysteresis, no dwell and no exception: a collision is returned as
+ * ParkingStatus::Collision.
+ */
+ParkingStatus plainStatus(const SensorData& s);
+
+/**
+ * @class StatusClassifier
+ * @brief Classifies a stream of sensor readings and reports status changes only
+ *
+ * Rules:
+ * - Collision is reported on the first reading at or below the collision
+ *   distance, without hysteresis or dwell.
+ * - Entering TooClose needs the closest sensor below closeDistance - hysteresis
+ *   and is reported at once: warnings rise immediately.
+ * - Leaving TooClose needs the closest sensor at or above closeDistance + hysteresis.
+ * - Safe -> PerfectlyParked needs the farthest sensor at or below
+ *   parkedDistance - hysteresis, the reverse needs it beyond parkedDistance + hysteresis.
+ * - Every change except the two above immediate ones must hold for
+ *   minDwellFrames consecutive frames; any other reading restarts the count.
+ *
+ * The first reading is classified with the plain thresholds and reported
+ * at once.
+ *
+ * Degraded mode: sensors flagged with setDegradedSensors(), usually by a
+ * SensorHealthMonitor, are not trusted to show that the way is clear,
+ * but they still warn. Their valid readings count for the closest
+ * distance, so they raise and hold Collision and TooClose like working
+ * sensors do; a flagged sensor reading a steady 0.2 m keeps TooClose.
+ * Negative and NaN readings of flagged sensors are ignored. Perfect
+ * parking needs every sensor, so it cannot be confirmed while degraded.
+ * With no trustworthy sensor left the status is TooClose unless a
+ * flagged sensor shows a collision. Labels of changes reported in
+ * degraded mode end with " [DEGRADED]".
+ *
+ * @example
+ * StatusClassifier classifier;
+ * StatusEvent event;
+ * for (const SensorData& s : frames)
+ *     if (classifier.update(s, &event))
+ *         cout << "Status: " << event.label << "\n";
+ */
+class StatusClassifier {
+public:
+    /**
+     * @brief Creates a classifier
+     * @throws std::invalid_argument unless 0 <= collisionDistance < closeDistance < parkedDistance,
+     *         the hysteresis is non-negative and smaller than half of each gap, and minDwellFrames >= 1
+     */
+    explicit StatusClassifier(const StatusClassifierConfig& config = StatusClassifierConfig());
+
+    /**
+     * @brief Classifies the next reading
+     * @param s Sensor reading
+     * @param event Receives the change, if one is reported (may be null)
+     * @return True if the status changed
+     */
+    bool update(const SensorData& s, StatusEvent* event = nullptr);
+
+    /**
+     * @brief Sets the sensors to ignore
+     * @param mask Bit 0 left, bit 1 center, bit 2 right (see sensorBit()); 0 leaves degraded mode
+     */
+    void setDegradedSensors(unsigned mask) { degradedMask = mask & 7u; }
+
+    /**
+     * @brief Forgets the status, all counters and the degraded sensors
+     */
+    void reset();
+
+    ParkingStatus current() const { return status; }
+    std::size_t frames() const { return frameCount; }
+    std::size_t transitions() const { return transitionCount; }
+    unsigned degradedSensors() const { return degradedMask; }
+    const StatusClassifierConfig& config() const { return settings; }
+
+private:
+    ParkingStatus target(double nearest, double farthest) const;
+    std::string label(ParkingStatus to, const SensorData& s) const;
+    std::string plainLabel(ParkingStatus to, const SensorData& s) const;
+
+    StatusClassifierConfig settings;
+    ParkingStatus status = ParkingStatus::Unknown;
+    ParkingStatus pending = ParkingStatus::Unknown;   ///< Candidate waiting out its dwell time
+    std::size_t pendingFrames = 0;
+    std::size_t frameCount = 0;
+    std::size_t transitionCount = 0;
+    unsigned degradedMask = 0;
+};
+
+#endif // STATUS_CLASSIFIER_H
@@ -0,0 +1,156 @@
+/**
+ * @file TelemetryCodec.h
+ * @brief Delta encoding of sensor telemetry frames
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ *
+ * This file declares a compact wire format for streaming sensor readings
+ * and parking status from a vehicle. Readings are quantized to a fixed
+ * resolution and each frame only carries the fields that moved by more
+ * than a dead band since the last frame sent. Frames with no change are
+ * not sent at all until a heartbeat is due. Periodic key frames carry
+ * every field so a receiver can join or resynchronise mid-stream.
+ *
+ * Wire format (all integers are LEB128 varints):
+ * - Header byte: bit 7 key frame, bits 0..2 left/center/right present,
+ *   bit 3 status present
+ * - Timestamp: absolute milliseconds in key frames, elapsed milliseconds
+ *   since the previous frame otherwise
+ * - Each present sensor: count of resolution steps in key frames,
+ *   zigzag-encoded change otherwise
+ * - Status byte, if present
+ */
+
+#ifndef TELEMETRY_CODEC_H
+#define TELEMETRY_CODEC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "SensorData.h"
+#include "StatusClassifier.h"
+
+/**
+ * @struct TelemetryFrame
+ * @brief One sample of the vehicle's sensors and status
+ */
+struct TelemetryFrame {
+    std::uint64_t timestampMs;   ///< Sample time in milliseconds (non-decreasing)
+    SensorData reading;          ///< Sensor distances (meters)
+    ParkingStatus status;        ///< Status at that time
+};
+
+/**
+ * @struct TelemetryConfig
+ * @brief Quantization and pacing of a telemetry stream
+ */
+struct TelemetryConfig {
+    double resolution = 0.001;          ///< Meters per transmitted step
+    double deadband = 0.01;             ///< Smallest sensor change that is sent (meters)
+    std::size_t keyframeInterval = 50;  ///< Input frames between key frames (1 s at 50 Hz)
+    std::size_t heartbeatInterval = 10; ///< Input frames without change before an empty frame is sent
+};
+
+/**
+ * @class TelemetryEncoder
+ * @brief Turns a stream of frames into delta-encoded bytes
+ *
+ * The encoder compares against the values it last sent, not the last
+ * input, so slow drift is sent once it adds up to the dead band and the
+ * receiver never lags the vehicle by more than the dead band.
+ *
+ * @example
+ * TelemetryEncoder encoder;
+ * std::vector<std::uint8_t> packet;
+ * if (encoder.encode(frame, packet) > 0) link.send(packet);
+ */
+class TelemetryEncoder {
+public:
+    /**
+     * @brief Creates an encoder
+     * @throws std::invalid_argument for a non-positive resolution, a negative
+     *         dead band or zero intervals
+     */
+    explicit TelemetryEncoder(const TelemetryConfig& config = TelemetryConfig());
+
+    /**
+     * @brief Encodes the next frame
+     * @param frame Sample to send
+     * @param out Receives the encoded bytes (appended)
+     * @return Number of bytes appended, 0 if the frame was suppressed
+     * @throws std::invalid_argument if the timestamp goes backwards or a reading is not finite
+     */
+    std::size_t encode(const TelemetryFrame& frame, std::vector<std::uint8_t>& out);
+
+    /**
+     * @brief Makes the next frame a key frame, e.g. after the link reconnects
+     */
+    void forceKeyframe() { keyframeDue = true; }
+
+    std::size_t framesIn() const { return inputCount; }
+    std::size_t framesSent() const { return sentCount; }
+    std::size_t bytesSent() const { return byteCount; }
+    const TelemetryConfig& config() const { return settings; }
+
+private:
+    TelemetryConfig settings;
+    std::int64_t deadbandSteps;
+    bool keyframeDue = true;
+    std::size_t sinceKeyframe = 0;
+    std::size_t sinceSent = 0;
+    std::uint64_t lastTimestamp = 0;        ///< Of the last frame sent
+    std::uint64_t lastInputTimestamp = 0;
+    std::int64_t lastSteps[3] = {0, 0, 0};
+    ParkingStatus lastStatus = ParkingStatus::Unknown;
+    std::size_t inputCount = 0;
+    std::size_t sentCount = 0;
+    std::size_t byteCount = 0;
+};
+
+/**
+ * @class TelemetryDecoder
+ * @brief Rebuilds frames from the bytes of a TelemetryEncoder
+ *
+ * Both sides must use the same resolution. Decoded readings are the
+ * quantized values last sent; fields that were not sent keep their
+ * previous value.
+ */
+class TelemetryDecoder {
+public:
+    /**
+     * @param resolution Meters per transmitted step, as configured on the encoder
+     * @throws std::invalid_argument for a non-positive resolution
+     */
+    explicit TelemetryDecoder(double resolution = TelemetryConfig().resolution);
+
+    /**
+     * @brief Decodes one frame
+     * @param data Start of the frame
+     * @param size Bytes available
+     * @param frame Receives the frame
+     * @return Bytes consumed
+     * @throws std::runtime_error for truncated or malformed input, or a delta
+     *         frame before the first key frame
+     */
+    std::size_t decode(const std::uint8_t* data, std::size_t size, TelemetryFrame& frame);
+
+    /**
+     * @brief Decodes every frame of a buffer
+     * @throws std::runtime_error as decode()
+     */
+    std::vector<TelemetryFrame> decodeAll(const std::vector<std::uint8_t>& bytes);
+
+    /**
+     * @brief Discards the stream state; the next frame must be a key frame
+     */
+    void reset() { synced = false; }
+
+private:
+    double resolution;
+    bool synced = false;
+    TelemetryFrame current = TelemetryFrame();
+    std::int64_t steps[3] = {0, 0, 0};
+};
+
+#endif // TELEMETRY_CODEC_H
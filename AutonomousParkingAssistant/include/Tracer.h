@@ -0,0 +1,198 @@
+/**
+ * @file Tracer.h
+ * @brief Opt-in Chrome trace event recording of parking sessions
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ *
+ * This file declares a tracer that records begin and end events of the
+ * loop stages, the parking space search and the worker threads. The
+ * events are written as a Chrome trace JSON file, which chrome://tracing
+ * or Perfetto display as one timeline row per thread.
+ *
+ * Instrumentation uses the PARKING_TRACE_* macros. They expand to
+ * nothing unless PARKING_ENABLE_TRACING is defined (CMake option
+ * PARKING_ENABLE_TRACING), so a default build carries no tracing code
+ * at the call sites. When compiled in, recording still only starts once
+ * the tracer is enabled, e.g. with the --trace FILE option.
+ *
+ * Every thread appends to its own fixed-size buffer without locking.
+ * A thread gets its buffer when it first records while the tracer is
+ * enabled, so threads that never record allocate nothing. When a thread
+ * exits, its buffer goes to the next new thread, which appends after the
+ * events already in it. A lock is only taken when a thread gets or hands
+ * back its buffer.
+ */
+
+#ifndef TRACER_H
+#define TRACER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @struct TraceEvent
+ * @brief One recorded begin or end event
+ */
+struct TraceEvent {
+    const char* name;            ///< Event name, a string literal
+    std::int64_t timestampNs;    ///< Steady-clock time
+    std::uint32_t tid;           ///< Trace row of the recording thread; buffers outlive threads
+    char phase;                  ///< 'B' for begin, 'E' for end
+};
+
+/**
+ * @class Tracer
+ * @brief Process-wide recorder of per-thread trace events
+ *
+ * Names passed to begin(), end() and setThreadName() are stored as
+ * pointers and must stay valid until the trace is written; string
+ * literals are the intended use. A thread that fills its buffer drops
+ * further events and counts them.
+ *
+ * @example
+ * Tracer::instance().writeAtExit("session.json");
+ * {
+ *     PARKING_TRACE_SCOPE("findParkingSpace");
+ *     findParkingSpace(true, 4.5, 1.8);
+ * }
+ */
+class Tracer {
+public:
+    static const std::size_t kBufferEvents = 1 << 16;   ///< Events kept per thread
+
+    /**
+     * @brief The process-wide tracer
+     */
+    static Tracer& instance();
+
+    /**
+     * @brief Starts recording
+     */
+    void enable();
+
+    /**
+     * @brief Stops recording; recorded events are kept
+     */
+    void disable();
+
+    bool enabled() const { return active.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Records the start of a span on the calling thread (no-op while disabled)
+     */
+    void begin(const char* name) { if (enabled()) record(name, 'B'); }
+
+    /**
+     * @brief Records the end of the innermost span on the calling thread
+     */
+    void end(const char* name) { if (enabled()) record(name, 'E'); }
+
+    /**
+     * @brief Names the calling thread's row in the trace viewer
+     *
+     * Kept with the thread until it records its first event, so naming a
+     * thread allocates nothing while the tracer is disabled.
+     */
+    void setThreadName(const char* name);
+
+    /**
+     * @brief Writes every recorded event as Chrome trace JSON
+     *
+     * Safe while other threads keep recording; their newest events may
+     * be missing from the output.
+     */
+    void writeJson(std::ostream& out) const;
+
+    /**
+     * @brief Enables recording and writes the trace to a file when the program exits
+     * @throws std::runtime_error if the file cannot be created
+     */
+    void writeAtExit(const std::string& path);
+
+    /**
+     * @brief Total events recorded so far
+     */
+    std::size_t events() const;
+
+    /**
+     * @brief Events dropped because a thread buffer was full
+     */
+    std::size_t dropped() const;
+
+    /**
+     * @brief Thread buffers allocated so far, in use or waiting for a new thread
+     */
+    std::size_t bufferCount() const;
+
+    /**
+     * @brief Forgets every recorded event
+     *
+     * Must not run while another thread records.
+     */
+    void clear();
+
+private:
+    struct ThreadBuffer {
+        std::uint32_t tid = 0;                  ///< Row of the thread using it
+        std::atomic<std::size_t> count{0};      ///< Published events
+        std::atomic<std::size_t> dropped{0};
+        TraceEvent events[kBufferEvents];
+    };
+    struct ThreadState;
+
+    Tracer();
+    static void writeExitTrace();
+    static ThreadState& threadState();
+    void record(const char* name, char phase);
+    ThreadBuffer* localBuffer();
+    void releaseBuffer(ThreadBuffer* buffer);
+
+    std::atomic<bool> active{false};
+    std::int64_t originNs;
+    mutable std::mutex registryMutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+    std::vector<ThreadBuffer*> freeBuffers;                           ///< Left by exited threads, not full
+    std::vector<std::pair<std::uint32_t, const char*>> threadNames;   ///< Row names by tid
+    std::uint32_t threadCount = 0;
+    std::string exitPath;
+};
+
+/**
+ * @class TraceScope
+ * @brief Records a span from construction to destruction
+ */
+class TraceScope {
+public:
+    explicit TraceScope(const char* name) : name(name) { Tracer::instance().begin(name); }
+    ~TraceScope() { Tracer::instance().end(name); }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* name;
+};
+
+#ifdef PARKING_ENABLE_TRACING
+#define PARKING_TRACE_JOIN2(a, b) a##b
+#define PARKING_TRACE_JOIN(a, b) PARKING_TRACE_JOIN2(a, b)
+#define PARKING_TRACE_SCOPE(name) TraceScope PARKING_TRACE_JOIN(parkingTraceScope, __LINE__)(name)
+#define PARKING_TRACE_BEGIN(name) Tracer::instance().begin(name)
+#define PARKING_TRACE_END(name) Tracer::instance().end(name)
+#define PARKING_TRACE_THREAD(name) Tracer::instance().setThreadName(name)
+#else
+#define PARKING_TRACE_SCOPE(name)
+#define PARKING_TRACE_BEGIN(name)
+#define PARKING_TRACE_END(name)
+#define PARKING_TRACE_THREAD(name)
+#endif
+
+#endif // TRACER_H
@@ -0,0 +1,82 @@
+/**
+ * @file VehicleCatalogue.h
+ * @brief Built-in catalogue of vehicle profiles keyed by model code
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ *
+ * This file declares the read-only vehicle profile catalogue. Each profile
+ * bundles the kinematic model used by requiredSpace() with the sensor
+ * layout used by the sensor logic, so drivers can select their vehicle by
+ * model code instead of typing dimensions on every run.
+ *
+ * The catalogue and its perfect-hash lookup table are computed entirely at
+ * compile time: there is no startup parsing, and a lookup is one hash plus
+ * a single table probe.
+ */
+
+#ifndef VEHICLE_CATALOGUE_H
+#define VEHICLE_CATALOGUE_H
+
+#include <cstddef>
+#include <string>
+#include "SensorData.h"
+#include "VehicleKinematics.h"
+
+/**
+ * @struct VehicleProfile
+ * @brief Dimensions, kinematics and sensor layout of a catalogued vehicle
+ *
+ * @var VehicleProfile::code
+ * Upper-case model code used as the lookup key (e.g. "HATCH-02")
+ *
+ * @var VehicleProfile::name
+ * Human-readable description
+ *
+ * @var VehicleProfile::model
+ * Kinematic model for requiredSpace() and feasibility checks
+ *
+ * @var VehicleProfile::sensors
+ * Parking sensor placement in the vehicle frame
+ */
+struct VehicleProfile {
+    const char* code;       ///< Model code (lookup key)
+    const char* name;       ///< Description
+    VehicleModel model;     ///< Kinematic model
+    SensorLayout sensors;   ///< Sensor placement
+};
+
+/**
+ * @brief Looks up a vehicle profile by model code
+ * @param code Model code (case-sensitive, upper case)
+ * @return Pointer to the profile, or nullptr if the code is unknown
+ *
+ * Performs exactly one hash computation and one table probe.
+ *
+ * @example
+ * const VehicleProfile* p = findVehicleProfile("SEDAN-04");
+ * if (p) double space = requiredSpace(true, p->model);
+ */
+const VehicleProfile* findVehicleProfile(const char* code);
+
+/**
+ * @brief Looks up a vehicle profile by model code
+ * @param code Model code (case-sensitive, upper case)
+ * @return Pointer to the profile, or nullptr if the code is unknown
+ */
+const VehicleProfile* findVehicleProfile(const std::string& code);
+
+/**
+ * @brief Returns the number of profiles in the catalogue
+ */
+std::size_t vehicleProfileCount();
+
+/**
+ * @brief Returns a profile by catalogue position (for listing)
+ * @param index Position in [0, vehicleProfileCount())
+ * @return Reference to the profile
+ * @throws std::out_of_range if index is out of range
+ */
+const VehicleProfile& vehicleProfileAt(std::size_t index);
+
+#endif // VEHICLE_CATALOGUE_H
@@ -0,0 +1,173 @@
+/**
+ * @file VehicleKinematics.h
+ * @brief Vehicle geometry model and closed-form parallel parking feasibility
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ *
+ * This file declares a kinematic vehicle model (wheelbase, overhangs,
+ * width and minimum turning radius) and closed-form computations of the
+ * minimum kerbside slot length needed to parallel park it in one or more
+ * moves. A structure-of-arrays fleet representation allows evaluating
+ * every vehicle/bay pair of a lot in a single vectorizable pass.
+ */
+
+#ifndef VEHICLE_KINEMATICS_H
+#define VEHICLE_KINEMATICS_H
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @struct VehicleModel
+ * @brief Geometric description of a car-like vehicle
+ *
+ * @var VehicleModel::width
+ * Overall body width in meters (mirrors folded)
+ *
+ * @var VehicleModel::wheelbase
+ * Distance between front and rear axles in meters
+ *
+ * @var VehicleModel::frontOverhang
+ * Distance from the front axle to the front bumper in meters
+ *
+ * @var VehicleModel::rearOverhang
+ * Distance from the rear axle to the rear bumper in meters
+ *
+ * @var VehicleModel::minTurningRadius
+ * Kerb-to-kerb turning radius in meters as quoted by manufacturers
+ * (radius of the circle traced by the outer front wheel at full lock)
+ *
+ * @example
+ * VehicleModel hatchback = {1.75, 2.55, 0.85, 0.65, 5.2}; // 4.05 m long
+ */
+struct VehicleModel {
+    double width;             ///< Body width (meters)
+    double wheelbase;         ///< Axle-to-axle distance (meters)
+    double frontOverhang;     ///< Front axle to front bumper (meters)
+    double rearOverhang;      ///< Rear axle to rear bumper (meters)
+    double minTurningRadius;  ///< Kerb-to-kerb turning radius (meters)
+};
+
+/**
+ * @brief Minimum longitudinal gap kept free when shuffling in many moves
+ *
+ * Lower bound on (slot length - vehicle length) regardless of the number
+ * of moves, covering sensor stand-off and driver precision.
+ */
+const double kMinShuffleGap = 0.25;
+
+/**
+ * @brief Returns the overall length of a vehicle
+ * @param v Vehicle model
+ * @return frontOverhang + wheelbase + rearOverhang in meters
+ */
+double vehicleLength(const VehicleModel& v);
+
+/**
+ * @brief Returns the full-lock turning radius of the rear axle midpoint
+ * @param v Vehicle model
+ * @return Radius in meters
+ * @throws std::invalid_argument if the model is not physically consistent
+ *         (non-positive dimensions or turning radius not exceeding the wheelbase)
+ *
+ * Converts the kerb-to-kerb radius R to the rear-axle radius
+ * r = sqrt(R^2 - wheelbase^2) - width / 2.
+ */
+double rearAxleTurningRadius(const VehicleModel& v);
+
+/**
+ * @brief Computes the minimum kerbside slot length for parallel parking
+ * @param v Vehicle model
+ * @param moves Number of moves allowed (1 = single reverse manoeuvre)
+ * @return Minimum slot length in meters
+ * @throws std::invalid_argument for an invalid model or moves < 1
+ *
+ * Single move: reversing into the slot is the time reverse of driving
+ * out at full lock. The kerb-side front corner then sweeps a circle of
+ * radius sqrt((r + w/2)^2 + (b + f)^2) around the turning centre and must
+ * clear the neighbouring vehicle's corner at lateral offset w, giving
+ *
+ *   L1 = rearOverhang + sqrt(2 r w + (b + f)^2)
+ *
+ * with r the rear-axle radius, w the width, b the wheelbase and f the
+ * front overhang.
+ *
+ * Multiple moves: the manoeuvre is modelled as n shuffles that each
+ * achieve w/n of the lateral offset, so the binding corner clearance is
+ *
+ *   Ln = max(rearOverhang + sqrt(2 r w / n + (b + f)^2), length + kMinShuffleGap)
+ *
+ * @example
+ * double single = minParallelSlotLength(hatchback);     // ~5.6 m
+ * double three  = minParallelSlotLength(hatchback, 3);  // ~4.6 m
+ */
+double minParallelSlotLength(const VehicleModel& v, int moves = 1);
+
+/**
+ * @brief Computes the fewest moves needed to parallel park in a slot
+ * @param v Vehicle model
+ * @param slotLength Available kerbside slot length in meters
+ * @param maxMoves Largest number of moves the driver/controller accepts
+ * @return Minimum number of moves (1..maxMoves), or 0 if the slot is too short
+ * @throws std::invalid_argument unless 1 <= maxMoves <= 255
+ *
+ * Equivalent to the smallest n with minParallelSlotLength(v, n) <= slotLength.
+ */
+int minParallelMoves(const VehicleModel& v, double slotLength, int maxMoves);
+
+/**
+ * @class VehicleFleet
+ * @brief Structure-of-arrays view of many vehicle models
+ *
+ * Derived quantities (rear-axle radius, front reach, lateral term 2 r w)
+ * are precomputed on insertion so batch evaluation is a branch-free loop
+ * of multiplies, square roots and compares that compilers auto-vectorize.
+ */
+class VehicleFleet {
+public:
+    /**
+     * @brief Adds a vehicle to the fleet
+     * @param v Vehicle model
+     * @throws std::invalid_argument for an invalid model
+     */
+    void add(const VehicleModel& v);
+
+    /**
+     * @brief Returns the number of vehicles in the fleet
+     */
+    std::size_t size() const { return rearOverhang.size(); }
+
+    std::vector<double> rearOverhang;   ///< Rear overhang per vehicle
+    std::vector<double> frontReachSq;   ///< (wheelbase + frontOverhang)^2 per vehicle
+    std::vector<double> lateralTerm;    ///< 2 * rearAxleRadius * width per vehicle
+    std::vector<double> length;         ///< Overall length per vehicle
+};
+
+/**
+ * @brief Computes the minimum slot length of every vehicle in a fleet
+ * @param fleet Vehicles to evaluate
+ * @param moves Number of moves allowed (>= 1)
+ * @param out Receives fleet.size() slot lengths
+ */
+void minParallelSlotLengths(const VehicleFleet& fleet, int moves, std::vector<double>& out);
+
+/**
+ * @brief Evaluates every vehicle/slot pair of a lot in one pass
+ * @param fleet Vehicles to evaluate
+ * @param slotLengths Kerbside slot lengths of the lot in meters
+ * @param maxMoves Largest number of moves accepted (1..255, so every count fits a byte)
+ * @param out Receives fleet.size() * slotLengths.size() entries in
+ *        vehicle-major order: the minimum number of moves (1..maxMoves)
+ *        for that pair, or 0 if the vehicle does not fit
+ * @throws std::invalid_argument unless 1 <= maxMoves <= 255
+ *
+ * @example
+ * std::vector<unsigned char> moves;
+ * parallelFeasibility(fleet, slots, 3, moves);
+ * bool fits = moves[vehicle * slots.size() + slot] != 0;
+ */
+void parallelFeasibility(const VehicleFleet& fleet, const std::vector<double>& slotLengths,
+                         int maxMoves, std::vector<unsigned char>& out);
+
+#endif // VEHICLE_KINEMATICS_H
@@ -0,0 +1,434 @@
+/**
+ * @file AisleCoordinator.cpp
+ * @brief Implementation of multi-vehicle aisle coordination
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ *
+ * Prioritized planning runs first because it costs one space-time search
+ * per vehicle. Only when it leaves vehicles unrouted does conflict-based
+ * search run, and if that also fails within its limits the unrouted
+ * vehicles hold their position while the others are replanned around them.
+ */
+
+#include "../include/AisleCoordinator.h"
+#include "../include/GridReplanner.h"
+#include "../include/LotIndex.h"
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <limits>
+#include <queue>
+#include <stdexcept>
+#include <string>
+
+using namespace std;
+
+namespace {
+
+const int kMoveCols[5] = {0, 1, -1, 0, 0};  ///< Wait, then the 4 neighbours
+const int kMoveRows[5] = {0, 0, 0, 1, -1};
+const int kParked = numeric_limits<int>::max();
+const size_t kMaxCachedGoals = 1024;
+
+/**
+ * @brief Position of a route at a time step (vehicles stay on their last cell)
+ */
+int cellAt(const vector<int>& route, int time) {
+    return route[min(static_cast<size_t>(time), route.size() - 1)];
+}
+
+} // namespace
+
+// ============================================================================
+// ReservationTable
+// ============================================================================
+
+void ReservationTable::reserveRoute(const vector<int>& cells) {
+    for (size_t t = 0; t < cells.size(); ++t) {
+        forbidCell(cells[t], static_cast<int>(t));
+        if (t > 0 && cells[t] != cells[t - 1]) forbidMove(cells[t], cells[t - 1], static_cast<int>(t) - 1);
+    }
+    if (!cells.empty()) {
+        int last = static_cast<int>(cells.size()) - 1;
+        auto it = parkedFrom.find(cells.back());
+        if (it == parkedFrom.end() || it->second > last) parkedFrom[cells.back()] = last;
+    }
+}
+
+bool ReservationTable::cellFree(int cell, int time) const {
+    if (!parkedFrom.empty()) {
+        auto it = parkedFrom.find(cell);
+        if (it != parkedFrom.end() && time >= it->second) return false;
+    }
+    return !cellTimes.count(cellKey(cell, time));
+}
+
+bool ReservationTable::routeFree(const vector<int>& cells) const {
+    for (size_t t = 0; t < cells.size(); ++t) {
+        if (!cellFree(cells[t], static_cast<int>(t))) return false;
+        if (t > 0 && !moveFree(cells[t - 1], cells[t], static_cast<int>(t) - 1)) return false;
+    }
+    return cells.empty() || lastReservedTime(cells.back()) < static_cast<int>(cells.size()) - 1;
+}
+
+int ReservationTable::lastReservedTime(int cell) const {
+    if (parkedFrom.count(cell)) return kParked;
+    auto it = lastTime.find(cell);
+    return it == lastTime.end() ? -1 : it->second;
+}
+
+void ReservationTable::noteTime(int cell, int time) {
+    auto it = lastTime.find(cell);
+    if (it == lastTime.end())
+        lastTime[cell] = time;
+    else
+        it->second = max(it->second, time);
+}
+
+void ReservationTable::clear() {
+    cellTimes.clear();
+    moves.clear();
+    parkedFrom.clear();
+    lastTime.clear();
+}
+
+// ============================================================================
+// AisleCoordinator
+// ============================================================================
+
+AisleCoordinator::AisleCoordinator(const GridReplanner& grid, const CoordinatorLimits& bounds)
+    : origin(grid.origin()), resolution(grid.resolution()), cols(grid.cols()), rows(grid.rows()), limits(bounds) {
+    if (static_cast<long long>(cols) * rows >= (1LL << 24))
+        throw invalid_argument("AisleCoordinator: grid exceeds 2^24 cells");
+    if (limits.horizon <= 0 || limits.horizon >= (1 << 16))
+        throw invalid_argument("AisleCoordinator: horizon must be in [1, 65535]");
+    blocked.resize(static_cast<size_t>(cols) * rows);
+    for (int row = 0; row < rows; ++row)
+        for (int col = 0; col < cols; ++col) blocked[row * cols + col] = grid.isBlocked(col, row) ? 1 : 0;
+}
+
+int AisleCoordinator::cellOf(Vec2 p) const {
+    int col = static_cast<int>(floor((p.x - origin.x) / resolution));
+    int row = static_cast<int>(floor((p.y - origin.y) / resolution));
+    if (col < 0 || row < 0 || col >= cols || row >= rows)
+        throw out_of_range("AisleCoordinator: point outside the grid");
+    return row * cols + col;
+}
+
+Vec2 AisleCoordinator::centerOf(int cell) const {
+    return Vec2{origin.x + (cell % cols + 0.5) * resolution, origin.y + (cell / cols + 0.5) * resolution};
+}
+
+/**
+ * @brief Breadth-first distances to a goal over free cells, ignoring other vehicles
+ *
+ * Used as the exact heuristic of the space-time searches; -1 marks cells
+ * that cannot reach the goal at all.
+ */
+const vector<int>& AisleCoordinator::distancesTo(int goal) {
+    auto cached = distanceCache.find(goal);
+    if (cached != distanceCache.end()) return cached->second;
+    if (distanceCache.size() >= kMaxCachedGoals) distanceCache.clear();
+
+    vector<int>& dist = distanceCache[goal];
+    dist.assign(blocked.size(), -1);
+    if (blocked[goal]) return dist;
+    deque<int> frontier;
+    dist[goal] = 0;
+    frontier.push_back(goal);
+    while (!frontier.empty()) {
+        int cell = frontier.front();
+        frontier.pop_front();
+        int col = cell % cols, row = cell / cols;
+        for (int k = 1; k < 5; ++k) {
+            int c = col + kMoveCols[k], r = row + kMoveRows[k];
+            if (c < 0 || r < 0 || c >= cols || r >= rows) continue;
+            int next = r * cols + c;
+            if (blocked[next] || dist[next] >= 0) continue;
+            dist[next] = dist[cell] + 1;
+            frontier.push_back(next);
+        }
+    }
+    return dist;
+}
+
+/**
+ * @brief Space-time A* from start to goal avoiding the table's reservations
+ * @param route Receives one cell per time step on success
+ * @return true if a route that can stay on the goal was found
+ */
+bool AisleCoordinator::searchRoute(int start, int goal, const ReservationTable& table, vector<int>& route) {
+    route.clear();
+    const vector<int>& dist = distancesTo(goal);
+    if (dist[start] < 0 || !table.cellFree(start, 0)) return false;
+    int hold = table.lastReservedTime(goal);
+    if (hold >= limits.horizon) return false;
+
+    struct Node {
+        int f;
+        int time;
+        int cell;
+        bool operator<(const Node& other) const {
+            return f != other.f ? f > other.f : time < other.time;   // min f, then deepest first
+        }
+    };
+    auto key = [](int cell, int time) { return (static_cast<uint64_t>(time) << 32) | static_cast<uint32_t>(cell); };
+
+    priority_queue<Node> open;
+    unordered_map<uint64_t, uint64_t> parent;
+    parent[key(start, 0)] = ~static_cast<uint64_t>(0);
+    open.push(Node{dist[start], 0, start});
+    while (!open.empty()) {
+        Node node = open.top();
+        open.pop();
+        if (node.cell == goal && node.time > hold) {
+            route.resize(node.time + 1);
+            uint64_t k = key(node.cell, node.time);
+            for (int t = node.time; t >= 0; --t) {
+                route[t] = static_cast<int>(k & 0xFFFFFFFFu);
+                k = parent[k];
+            }
+            return true;
+        }
+        if (stats.expansions >= limits.maxExpansions) {
+            stats.budgetExhausted = true;
+            return false;
+        }
+        stats.expansions++;
+        if (node.time >= limits.horizon) continue;
+
+        int col = node.cell % cols, row = node.cell / cols;
+        int time = node.time + 1;
+        for (int k = 0; k < 5; ++k) {
+            int c = col + kMoveCols[k], r = row + kMoveRows[k];
+            if (c < 0 || r < 0 || c >= cols || r >= rows) continue;
+            int next = r * cols + c;
+            if (blocked[next] || dist[next] < 0) continue;
+            if (!table.cellFree(next, time) || !table.moveFree(node.cell, next, node.time)) continue;
+            uint64_t nextKey = key(next, time);
+            if (parent.count(nextKey)) continue;
+            parent[nextKey] = key(node.cell, node.time);
+            open.push(Node{time + dist[next], time, next});
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Conflict-based search over all vehicles (Sharon et al.)
+ *
+ * The constraint tree is explored in order of total route duration. Each
+ * node replans only the vehicle that received the new constraint.
+ */
+bool AisleCoordinator::conflictSearch(const vector<int>& starts, const vector<int>& goals,
+                                      vector<vector<int>>& routes) {
+    struct TreeNode {
+        vector<Constraint> constraints;
+        vector<vector<int>> routes;
+        size_t cost;
+    };
+    auto totalCost = [](const vector<vector<int>>& r) {
+        size_t sum = 0;
+        for (const vector<int>& route : r) sum += route.size() - 1;
+        return sum;
+    };
+    auto replan = [&](const vector<Constraint>& constraints, int vehicle, vector<int>& route) {
+        ReservationTable table;
+        for (const Constraint& c : constraints) {
+            if (c.vehicle != vehicle) continue;
+            if (c.from < 0)
+                table.forbidCell(c.cell, c.time);
+            else
+                table.forbidMove(c.from, c.cell, c.time);
+        }
+        return searchRoute(starts[vehicle], goals[vehicle], table, route);
+    };
+
+    const int n = static_cast<int>(starts.size());
+    vector<TreeNode> tree(1);
+    tree[0].routes.resize(n);
+    for (int i = 0; i < n; ++i)
+        if (!replan(tree[0].constraints, i, tree[0].routes[i])) return false;
+    tree[0].cost = totalCost(tree[0].routes);
+
+    typedef pair<size_t, size_t> OpenEntry;   // (cost, tree index)
+    priority_queue<OpenEntry, vector<OpenEntry>, greater<OpenEntry>> open;
+    open.push(OpenEntry(tree[0].cost, 0));
+    while (!open.empty() && stats.conflictNodes < limits.maxConflictNodes && !stats.budgetExhausted) {
+        size_t current = open.top().second;
+        open.pop();
+        stats.conflictNodes++;
+
+        // Find the earliest conflict: two vehicles on one cell, or swapping cells
+        const vector<vector<int>>& r = tree[current].routes;
+        size_t duration = 0;
+        for (const vector<int>& route : r) duration = max(duration, route.size());
+        Constraint first = {-1, -1, -1, -1}, second = {-1, -1, -1, -1};
+        unordered_map<int, int> occupant;
+        unordered_map<uint64_t, int> movesAt;
+        for (int t = 0; t < static_cast<int>(duration) && first.vehicle < 0; ++t) {
+            occupant.clear();
+            movesAt.clear();
+            for (int i = 0; i < n && first.vehicle < 0; ++i) {
+                int cell = cellAt(r[i], t);
+                auto hit = occupant.find(cell);
+                if (hit != occupant.end()) {
+                    first = Constraint{hit->second, -1, cell, t};
+                    second = Constraint{i, -1, cell, t};
+                    break;
+                }
+                occupant[cell] = i;
+                if (t == 0) continue;
+                int from = cellAt(r[i], t - 1);
+                if (from == cell) continue;
+                auto swapped = movesAt.find((static_cast<uint64_t>(cell) << 32) | static_cast<uint32_t>(from));
+                if (swapped != movesAt.end()) {
+                    first = Constraint{swapped->second, cell, from, t - 1};
+                    second = Constraint{i, from, cell, t - 1};
+                    break;
+                }
+                movesAt[(static_cast<uint64_t>(from) << 32) | static_cast<uint32_t>(cell)] = i;
+            }
+        }
+        if (first.vehicle < 0) {
+            routes = r;
+            return true;
+        }
+
+        for (const Constraint& added : {first, second}) {
+            TreeNode child;
+            child.constraints = tree[current].constraints;
+            child.constraints.push_back(added);
+            child.routes = tree[current].routes;
+            if (!replan(child.constraints, added.vehicle, child.routes[added.vehicle])) continue;
+            child.cost = totalCost(child.routes);
+            tree.push_back(move(child));
+            open.push(OpenEntry(tree.back().cost, tree.size() - 1));
+        }
+    }
+    return false;
+}
+
+vector<AisleRoute> AisleCoordinator::coordinate(const vector<AisleVehicle>& vehicles) {
+    stats = CoordinatorStats();
+    const size_t n = vehicles.size();
+    vector<int> starts(n), goals(n);
+    for (size_t i = 0; i < n; ++i) {
+        starts[i] = cellOf(vehicles[i].start);
+        goals[i] = cellOf(vehicles[i].goal);
+    }
+
+    vector<vector<int>> routes(n);
+    vector<bool> holding(n, false);
+    ReservationTable table;
+    for (size_t i = 0; i < n; ++i) {
+        if (searchRoute(starts[i], goals[i], table, routes[i]))
+            table.reserveRoute(routes[i]);
+        else
+            stats.prioritizedFailures++;
+    }
+
+    if (stats.prioritizedFailures > 0 && !stats.budgetExhausted) {
+        stats.usedConflictSearch = true;
+        vector<vector<int>> solved;
+        if (conflictSearch(starts, goals, solved)) {
+            routes.swap(solved);
+            stats.prioritizedFailures = 0;
+        }
+    }
+
+    // Still unsolved: unrouted vehicles hold position and the rest replan around them. A
+    // vehicle whose replan fails, e.g. once the budget is spent, keeps its prioritized route
+    // if that route does not run into a holding vehicle.
+    if (stats.prioritizedFailures > 0) {
+        const vector<vector<int>> prioritized = routes;
+        for (size_t i = 0; i < n; ++i) holding[i] = routes[i].empty();
+        bool changed = true;
+        while (changed) {
+            changed = false;
+            table.clear();
+            for (size_t i = 0; i < n; ++i)
+                if (holding[i]) table.reserveRoute(vector<int>(1, starts[i]));
+            for (size_t i = 0; i < n && !changed; ++i) {
+                if (holding[i]) continue;
+                if (searchRoute(starts[i], goals[i], table, routes[i])) {
+                    table.reserveRoute(routes[i]);
+                } else if (!prioritized[i].empty() && table.routeFree(prioritized[i])) {
+                    routes[i] = prioritized[i];
+                    table.reserveRoute(routes[i]);
+                } else {
+                    holding[i] = true;
+                    changed = true;
+                }
+            }
+        }
+    }
+
+    vector<AisleRoute> result(n);
+    for (size_t i = 0; i < n; ++i) {
+        result[i].vehicleId = vehicles[i].vehicleId;
+        result[i].bayId = -1;
+        result[i].planned = !holding[i] && !routes[i].empty();
+        if (result[i].planned)
+            for (int cell : routes[i]) result[i].waypoints.push_back(centerOf(cell));
+    }
+    return result;
+}
+
+vector<AisleRoute> AisleCoordinator::admitArrivals(ParkingLotIndex& index, const unordered_map<int, Vec2>& bayEntries,
+                                                   const vector<AisleArrival>& arrivals) {
+    vector<int> bays(arrivals.size(), -1);
+    vector<AisleVehicle> vehicles;
+    vector<size_t> arrivalOf;
+    {
+        LotReader reader(index);
+        for (size_t i = 0; i < arrivals.size(); ++i) {
+            // Claim the first fitting free bay; retry if another writer takes it first
+            while (true) {
+                int bayId = -1;
+                {
+                    LotReadGuard guard(reader);
+                    const ParkingBay* bay = guard.snapshot().findFreeBay(arrivals[i].requiredSize);
+                    if (bay) bayId = bay->id;
+                }
+                if (bayId < 0) break;
+                auto entry = bayEntries.find(bayId);
+                if (entry == bayEntries.end()) {
+                    for (int claimed : bays)
+                        if (claimed >= 0) index.setOccupied(claimed, false);
+                    throw invalid_argument("AisleCoordinator: no entry position for bay " + to_string(bayId));
+                }
+                if (!index.setOccupied(bayId, true)) continue;
+                bays[i] = bayId;
+                vehicles.push_back(AisleVehicle{arrivals[i].vehicleId, arrivals[i].start, entry->second});
+                arrivalOf.push_back(i);
+                break;
+            }
+        }
+    }
+
+    vector<AisleRoute> routes;
+    try {
+        routes = coordinate(vehicles);
+    } catch (...) {
+        for (int claimed : bays)
+            if (claimed >= 0) index.setOccupied(claimed, false);
+        throw;
+    }
+    vector<AisleRoute> result(arrivals.size());
+    for (size_t i = 0; i < arrivals.size(); ++i) {
+        result[i].vehicleId = arrivals[i].vehicleId;
+        result[i].bayId = -1;
+        result[i].planned = false;
+    }
+    for (size_t k = 0; k < routes.size(); ++k) {
+        size_t i = arrivalOf[k];
+        result[i] = routes[k];
+        if (routes[k].planned)
+            result[i].bayId = bays[i];
+        else
+            index.setOccupied(bays[i], false);
+    }
+    return result;
+}
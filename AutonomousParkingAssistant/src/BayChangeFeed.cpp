@@ -0,0 +1,285 @@
+/**
+ * @file BayChangeFeed.cpp
+ * @brief Implementation of the bay change feed ring buffer
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ *
+ * Memory layout (identical in process memory and shared memory):
+ *
+ *   [Header][Slot 0][Slot 1]...[Slot capacity-1]
+ *
+ * Slot protocol for sequence s (1-based), slot index (s - 1) & mask:
+ * - Producer: mark slot busy (sequence = 0), write payload, then store s
+ *   with release semantics, then advance head to s.
+ * - Subscriber: load slot sequence (acquire), copy payload, re-check the
+ *   sequence. The copy is valid only if both loads returned s.
+ *
+ * All shared fields are lock-free atomics so the layout is usable across
+ * processes.
+ */
+
+#include "../include/BayChangeFeed.h"
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define PARKING_HAVE_SHM 1
+#endif
+
+using namespace std;
+
+const size_t BayChangeFeed::kDefaultCapacity;
+
+namespace {
+
+const uint32_t kFeedMagic = 0x42415946;  // "BAYF"
+const uint32_t kFeedLayoutVersion = 1;
+
+/**
+ * @brief Rounds a requested capacity up to a power of two (minimum 2)
+ */
+size_t roundCapacity(size_t requested) {
+    size_t cap = 2;
+    while (cap < requested) cap <<= 1;
+    return cap;
+}
+
+int64_t nowNs() {
+    return chrono::duration_cast<chrono::nanoseconds>(
+        chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+/**
+ * @brief Feed metadata at the start of the region
+ *
+ * The head sequence is padded onto its own cache line so that subscribers
+ * polling it do not contend with the read-only metadata. Padding is explicit
+ * (rather than alignas) because heap regions are only 16-byte aligned in C++14.
+ */
+struct BayChangeFeed::Header {
+    uint32_t magic;                 ///< kFeedMagic once initialized
+    uint32_t layoutVersion;         ///< kFeedLayoutVersion
+    uint64_t capacity;              ///< Ring size (power of two)
+    uint8_t reserved[48];           ///< Pads head to offset 64
+    atomic<uint64_t> head;          ///< Last published sequence
+    uint8_t reserved2[56];          ///< Keeps slots off the head's cache line
+};
+
+/**
+ * @brief One ring entry guarded by its sequence number
+ */
+struct BayChangeFeed::Slot {
+    atomic<uint64_t> sequence;   ///< Sequence stored here, 0 while being written
+    atomic<uint64_t> payload;    ///< Bay id (low 32 bits) and occupied flag (bit 32)
+    atomic<int64_t> timestamp;   ///< Publish time (ns)
+    uint64_t padding;            ///< Keeps slots at 32 bytes
+};
+
+/**
+ * @brief Returns the bytes needed for a header plus `capacity` slots
+ */
+size_t BayChangeFeed::regionSize(size_t capacity) {
+    return sizeof(Header) + capacity * sizeof(Slot);
+}
+
+/**
+ * @brief Initializes an in-process feed on the heap
+ * @param capacity Requested ring size
+ */
+BayChangeFeed::BayChangeFeed(size_t capacity)
+    : header(nullptr), slots(nullptr), regionBytes(0), shared(false), readOnly(false) {
+    size_t cap = roundCapacity(capacity);
+    regionBytes = regionSize(cap);
+    void* region = ::operator new(regionBytes);
+
+    header = new (region) Header();
+    header->magic = kFeedMagic;
+    header->layoutVersion = kFeedLayoutVersion;
+    header->capacity = cap;
+    header->head.store(0);
+    slots = reinterpret_cast<Slot*>(static_cast<char*>(region) + sizeof(Header));
+    for (size_t i = 0; i < cap; ++i) {
+        new (&slots[i]) Slot();
+        slots[i].sequence.store(0);
+    }
+}
+
+/**
+ * @brief Wraps an already-initialized region (shared-memory mapping)
+ */
+BayChangeFeed::BayChangeFeed(void* region, size_t bytes, bool isShared, bool isReadOnly)
+    : header(static_cast<Header*>(region)),
+      slots(reinterpret_cast<Slot*>(static_cast<char*>(region) + sizeof(Header))),
+      regionBytes(bytes), shared(isShared), readOnly(isReadOnly) {}
+
+BayChangeFeed::BayChangeFeed(BayChangeFeed&& other)
+    : header(other.header), slots(other.slots), regionBytes(other.regionBytes), shared(other.shared),
+      readOnly(other.readOnly) {
+    other.header = nullptr;
+    other.slots = nullptr;
+}
+
+BayChangeFeed::~BayChangeFeed() {
+    if (!header) return;
+#ifdef PARKING_HAVE_SHM
+    if (shared) {
+        munmap(header, regionBytes);
+        return;
+    }
+#endif
+    ::operator delete(header);
+}
+
+BayChangeFeed BayChangeFeed::createShared(const string& name, size_t capacity) {
+#ifdef PARKING_HAVE_SHM
+    size_t cap = roundCapacity(capacity);
+    size_t bytes = regionSize(cap);
+
+    shm_unlink(name.c_str());
+    int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0) throw runtime_error("BayChangeFeed: cannot create shared segment " + name);
+    if (ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+        close(fd);
+        shm_unlink(name.c_str());
+        throw runtime_error("BayChangeFeed: cannot size shared segment " + name);
+    }
+    void* region = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (region == MAP_FAILED) {
+        shm_unlink(name.c_str());
+        throw runtime_error("BayChangeFeed: cannot map shared segment " + name);
+    }
+
+    // ftruncate zero-fills the segment, so every slot sequence starts at 0.
+    // The magic is written last so attachers never see a half-built header.
+    Header* h = new (region) Header();
+    h->layoutVersion = kFeedLayoutVersion;
+    h->capacity = cap;
+    h->head.store(0);
+    if (!h->head.is_lock_free()) {
+        munmap(region, bytes);
+        shm_unlink(name.c_str());
+        throw runtime_error("BayChangeFeed: 64-bit atomics are not lock-free on this platform");
+    }
+    atomic_thread_fence(memory_order_release);
+    h->magic = kFeedMagic;
+    return BayChangeFeed(region, bytes, true, false);
+#else
+    (void)name;
+    (void)capacity;
+    throw runtime_error("BayChangeFeed: shared memory feeds are not supported on this platform");
+#endif
+}
+
+BayChangeFeed BayChangeFeed::attachShared(const string& name) {
+#ifdef PARKING_HAVE_SHM
+    int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0) throw runtime_error("BayChangeFeed: no shared segment named " + name);
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(Header)) {
+        close(fd);
+        throw runtime_error("BayChangeFeed: segment " + name + " is not a bay change feed");
+    }
+    size_t bytes = static_cast<size_t>(st.st_size);
+    void* region = mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (region == MAP_FAILED) throw runtime_error("BayChangeFeed: cannot map shared segment " + name);
+
+    Header* h = static_cast<Header*>(region);
+    if (h->magic != kFeedMagic || h->layoutVersion != kFeedLayoutVersion ||
+        regionSize(static_cast<size_t>(h->capacity)) != bytes) {
+        munmap(region, bytes);
+        throw runtime_error("BayChangeFeed: segment " + name + " is not a bay change feed");
+    }
+    return BayChangeFeed(region, bytes, true, true);
+#else
+    (void)name;
+    throw runtime_error("BayChangeFeed: shared memory feeds are not supported on this platform");
+#endif
+}
+
+void BayChangeFeed::unlinkShared(const string& name) {
+#ifdef PARKING_HAVE_SHM
+    shm_unlink(name.c_str());
+#else
+    (void)name;
+#endif
+}
+
+uint64_t BayChangeFeed::publish(int bayId, bool occupied) {
+    if (readOnly) throw runtime_error("BayChangeFeed: cannot publish to a read-only mapping");
+    uint64_t seq = header->head.load(memory_order_relaxed) + 1;
+    Slot& slot = slots[(seq - 1) & (header->capacity - 1)];
+
+    slot.sequence.store(0, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    slot.payload.store(static_cast<uint64_t>(static_cast<uint32_t>(bayId)) |
+                       (occupied ? (static_cast<uint64_t>(1) << 32) : 0),
+                       memory_order_relaxed);
+    slot.timestamp.store(nowNs(), memory_order_relaxed);
+    slot.sequence.store(seq, memory_order_release);
+    header->head.store(seq, memory_order_release);
+    return seq;
+}
+
+uint64_t BayChangeFeed::lastSequence() const {
+    return header->head.load(memory_order_acquire);
+}
+
+size_t BayChangeFeed::capacity() const {
+    return static_cast<size_t>(header->capacity);
+}
+
+FeedSubscriber::FeedSubscriber(const BayChangeFeed& f, bool fromOldest)
+    : feed(f), next(0), lostEvents(0) {
+    uint64_t head = feed.lastSequence();
+    uint64_t cap = feed.header->capacity;
+    if (fromOldest)
+        next = head > cap ? head - cap + 1 : 1;
+    else
+        next = head + 1;
+}
+
+bool FeedSubscriber::poll(BayEvent& out) {
+    const uint64_t cap = feed.header->capacity;
+    while (true) {
+        uint64_t head = feed.header->head.load(memory_order_acquire);
+        if (next > head) return false;
+
+        // Lapped: skip to the oldest event that can still be intact
+        if (head - next >= cap) {
+            uint64_t oldest = head - cap + 1;
+            lostEvents += oldest - next;
+            next = oldest;
+        }
+
+        const BayChangeFeed::Slot& slot = feed.slots[(next - 1) & (cap - 1)];
+        uint64_t s1 = slot.sequence.load(memory_order_acquire);
+        uint64_t payload = slot.payload.load(memory_order_relaxed);
+        int64_t ts = slot.timestamp.load(memory_order_relaxed);
+        atomic_thread_fence(memory_order_acquire);
+        uint64_t s2 = slot.sequence.load(memory_order_relaxed);
+
+        if (s1 == next && s2 == next) {
+            out.sequence = next;
+            out.bayId = static_cast<int>(static_cast<uint32_t>(payload & 0xffffffffu));
+            out.occupied = (payload >> 32) & 1;
+            out.timestampNs = ts;
+            next++;
+            return true;
+        }
+        // The producer overwrote the slot while we were reading it, so this
+        // event is gone; the lap check on the next iteration catches up.
+        lostEvents++;
+        next++;
+    }
+}
@@ -0,0 +1,255 @@
+/**
+ * @file BeepCadence.cpp
+ * @brief Implementation of the timer-driven beep cadence engine
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ */
+
+#include "../include/BeepCadence.h"
+#include "../include/Tracer.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#ifdef __linux__
+#include <cerrno>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+#define PARKING_HAVE_TIMERFD 1
+#endif
+
+using namespace std;
+
+namespace {
+
+const double kSmoothing = 0.5;   ///< Weight of the newest closing speed sample
+
+} // namespace
+
+double beepInterval(double distance, double closingSpeed, const BeepCadenceConfig& config) {
+    if (!(distance < config.startDistance)) return numeric_limits<double>::infinity();
+    double interval = config.minInterval;
+    if (distance > config.continuousDistance)
+        interval += (config.maxInterval - config.minInterval) * (distance - config.continuousDistance) /
+                    (config.startDistance - config.continuousDistance);
+    if (closingSpeed > 0.0) {
+        double ttc = max(0.0, distance) / closingSpeed;
+        if (ttc < config.ttcHorizon)
+            interval = min(interval, max(config.minInterval, config.maxInterval * ttc / config.ttcHorizon));
+    }
+    return interval;
+}
+
+BeepCadence::BeepCadence(Sink sink, const BeepCadenceConfig& config)
+    : sink(std::move(sink)), settings(config), scheduledInterval(numeric_limits<double>::infinity()) {
+    if (!this->sink) throw invalid_argument("Beep cadence needs a sink");
+    if (!(config.continuousDistance >= 0.0 && config.continuousDistance < config.startDistance))
+        throw invalid_argument("Beep distances must satisfy 0 <= continuous < start");
+    if (!(config.minInterval > 0.0 && config.minInterval <= config.maxInterval))
+        throw invalid_argument("Beep intervals must satisfy 0 < min <= max");
+    if (!(config.ttcHorizon > 0.0 && config.maxExtrapolation >= 0.0))
+        throw invalid_argument("Beep time horizons must be positive");
+}
+
+BeepCadence::~BeepCadence() {
+    stop();
+}
+
+int64_t BeepCadence::nowNs() {
+    return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void BeepCadence::start() {
+    if (active.load()) return;
+#ifdef PARKING_HAVE_TIMERFD
+    // steady_clock is CLOCK_MONOTONIC, so deadlines can be passed to the timer as they are
+    timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+    eventFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (timerFd < 0 || eventFd < 0) {
+        if (timerFd >= 0) close(timerFd);
+        if (eventFd >= 0) close(eventFd);
+        timerFd = eventFd = -1;
+        throw runtime_error("Cannot create the beep timer");
+    }
+#endif
+    {
+        lock_guard<mutex> lock(stateMutex);
+        wakeRequested = false;
+    }
+    active.store(true);
+    worker = thread(&BeepCadence::run, this);
+}
+
+void BeepCadence::stop() {
+    if (!active.exchange(false)) return;
+    wake();
+    worker.join();
+#ifdef PARKING_HAVE_TIMERFD
+    close(timerFd);
+    close(eventFd);
+    timerFd = eventFd = -1;
+#endif
+}
+
+void BeepCadence::update(const SensorData& s) {
+    update(s, nowNs());
+}
+
+void BeepCadence::update(const SensorData& s, int64_t timestampNs) {
+    double nearest = min(s.left, min(s.center, s.right));
+    if (std::isnan(s.left + s.center + s.right)) nearest = 0.0;   // a failed sensor counts as close
+
+    bool needWake;
+    {
+        lock_guard<mutex> lock(stateMutex);
+        if (haveReading && timestampNs > lastUpdateNs) {
+            double raw = (lastDistance - nearest) / ((timestampNs - lastUpdateNs) * 1e-9);
+            speed = kSmoothing * raw + (1.0 - kSmoothing) * speed;
+        } else if (!haveReading) {
+            speed = 0.0;
+        }
+        haveReading = true;
+        lastDistance = nearest;
+        lastUpdateNs = max(lastUpdateNs, timestampNs);
+
+        // Only disturb the timer thread if the cadence moved noticeably
+        double interval, distance;
+        cadenceAt(timestampNs, interval, distance);
+        bool wasSilent = std::isinf(scheduledInterval), silent = std::isinf(interval);
+        needWake = wasSilent != silent ||
+                   (!silent && fabs(interval - scheduledInterval) > 0.1 * scheduledInterval);
+    }
+    if (needWake && active.load()) wake();
+}
+
+double BeepCadence::closingSpeed() const {
+    lock_guard<mutex> lock(stateMutex);
+    return speed;
+}
+
+CadenceStats BeepCadence::stats() const {
+    lock_guard<mutex> lock(stateMutex);
+    CadenceStats result;
+    result.beeps = beeps;
+    result.meanJitterUs = beeps ? jitterSumUs / beeps : 0.0;
+    result.maxJitterUs = jitterMaxUs;
+    return result;
+}
+
+/**
+ * @brief Interval and distance at a given time, extrapolating the last reading
+ * @note Caller holds stateMutex
+ */
+void BeepCadence::cadenceAt(int64_t now, double& interval, double& distance) const {
+    if (!haveReading) {
+        distance = numeric_limits<double>::infinity();
+        interval = distance;
+        return;
+    }
+    double elapsed = min(max(0.0, (now - lastUpdateNs) * 1e-9), settings.maxExtrapolation);
+    distance = max(0.0, lastDistance - speed * elapsed);
+    interval = beepInterval(distance, speed, settings);
+}
+
+void BeepCadence::run() {
+    PARKING_TRACE_THREAD("beep cadence");
+    int64_t lastBeep = -1;   // scheduled time of the previous beep, -1 after silence
+    while (active.load()) {
+        int64_t now = nowNs();
+        double interval, distance;
+        {
+            lock_guard<mutex> lock(stateMutex);
+            cadenceAt(now, interval, distance);
+            scheduledInterval = interval;
+        }
+
+        // Keep beeps on the schedule of the previous one so the cadence does not drift
+        int64_t deadline = -1;
+        if (std::isinf(interval)) {
+            lastBeep = -1;
+        } else {
+            deadline = lastBeep < 0 ? now : lastBeep + static_cast<int64_t>(interval * 1e9);
+            deadline = max(deadline, now);
+        }
+        if (!waitUntil(deadline) || !active.load()) continue;
+
+        int64_t fired = nowNs();
+        bool continuous;
+        {
+            lock_guard<mutex> lock(stateMutex);
+            cadenceAt(fired, interval, distance);
+            if (std::isinf(interval)) {
+                lastBeep = -1;
+                continue;
+            }
+            double jitterUs = (fired - deadline) * 1e-3;
+            ++beeps;
+            jitterSumUs += jitterUs;
+            jitterMaxUs = max(jitterMaxUs, jitterUs);
+            continuous = distance <= settings.continuousDistance;
+        }
+        {
+            PARKING_TRACE_SCOPE("beep");
+            sink(BeepEvent{deadline, fired, interval, distance, continuous});
+        }
+        lastBeep = deadline;
+    }
+}
+
+/**
+ * @brief Sleeps until a deadline or a wake-up
+ * @param deadlineNs Steady-clock deadline, or -1 to sleep until woken
+ * @return True if the deadline was reached, false if woken early
+ */
+bool BeepCadence::waitUntil(int64_t deadlineNs) {
+#ifdef PARKING_HAVE_TIMERFD
+    itimerspec spec = {};
+    if (deadlineNs >= 0) {
+        deadlineNs = max<int64_t>(deadlineNs, 1);   // an all-zero value would disarm the timer
+        spec.it_value.tv_sec = static_cast<time_t>(deadlineNs / 1000000000);
+        spec.it_value.tv_nsec = static_cast<long>(deadlineNs % 1000000000);
+    }
+    timerfd_settime(timerFd, TFD_TIMER_ABSTIME, &spec, nullptr);
+
+    pollfd fds[2] = {{timerFd, POLLIN, 0}, {eventFd, POLLIN, 0}};
+    while (poll(fds, 2, -1) < 0)
+        if (errno != EINTR) return false;
+    uint64_t count;
+    if (fds[1].revents & POLLIN) {
+        if (read(eventFd, &count, sizeof(count)) < 0) { /* already drained */ }
+        return false;
+    }
+    return read(timerFd, &count, sizeof(count)) == static_cast<ssize_t>(sizeof(count));
+#else
+    unique_lock<mutex> lock(stateMutex);
+    auto woken = [this] { return wakeRequested; };
+    bool early;
+    if (deadlineNs < 0) {
+        wakeCondition.wait(lock, woken);
+        early = true;
+    } else {
+        chrono::steady_clock::time_point deadline{chrono::nanoseconds(deadlineNs)};
+        early = wakeCondition.wait_until(lock, deadline, woken);
+    }
+    wakeRequested = false;
+    return !early;
+#endif
+}
+
+void BeepCadence::wake() {
+#ifdef PARKING_HAVE_TIMERFD
+    uint64_t one = 1;
+    if (write(eventFd, &one, sizeof(one)) < 0) { /* counter saturated: a wake-up is pending anyway */ }
+#else
+    {
+        lock_guard<mutex> lock(stateMutex);
+        wakeRequested = true;
+    }
+    wakeCondition.notify_one();
+#endif
+}
@@ -0,0 +1,240 @@
+/**
+ * @file BenchHistory.cpp
+ * @brief Implementation of the benchmark history and regression test
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ *
+ * History file format, one run per line:
+ *
+ *   COMMIT BENCHMARK NS_PER_OP ALLOCS_PER_OP
+ *
+ * Lines starting with '#' are comments.
+ */
+
+#include "../include/BenchHistory.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+using namespace std;
+
+namespace {
+
+bool hasWhitespace(const string& text) {
+    return text.empty() || text.find_first_of(" \t\r\n") != string::npos;
+}
+
+double mean(const vector<double>& values) {
+    double sum = 0.0;
+    for (double v : values) sum += v;
+    return sum / values.size();
+}
+
+double variance(const vector<double>& values, double m) {
+    double sum = 0.0;
+    for (double v : values) sum += (v - m) * (v - m);
+    return sum / (values.size() - 1);
+}
+
+/**
+ * @brief Continued fraction of the regularized incomplete beta function (modified Lentz)
+ */
+double betaContinuedFraction(double a, double b, double x) {
+    const double tiny = 1e-300;
+    double c = 1.0;
+    double d = 1.0 - (a + b) * x / (a + 1.0);
+    if (fabs(d) < tiny) d = tiny;
+    d = 1.0 / d;
+    double h = d;
+    for (int m = 1; m <= 300; ++m) {
+        const double m2 = 2.0 * m;
+        double aa = m * (b - m) * x / ((a + m2 - 1.0) * (a + m2));
+        d = 1.0 + aa * d;
+        if (fabs(d) < tiny) d = tiny;
+        c = 1.0 + aa / c;
+        if (fabs(c) < tiny) c = tiny;
+        d = 1.0 / d;
+        h *= d * c;
+        aa = -(a + m) * (a + b + m) * x / ((a + m2) * (a + m2 + 1.0));
+        d = 1.0 + aa * d;
+        if (fabs(d) < tiny) d = tiny;
+        c = 1.0 + aa / c;
+        if (fabs(c) < tiny) c = tiny;
+        d = 1.0 / d;
+        const double step = d * c;
+        h *= step;
+        if (fabs(step - 1.0) < 1e-15) break;
+    }
+    return h;
+}
+
+/**
+ * @brief Regularized incomplete beta function I_x(a, b)
+ */
+double incompleteBeta(double a, double b, double x) {
+    if (x <= 0.0) return 0.0;
+    if (x >= 1.0) return 1.0;
+    const double front = exp(lgamma(a + b) - lgamma(a) - lgamma(b) + a * log(x) + b * log(1.0 - x));
+    if (x < (a + 1.0) / (a + b + 2.0)) return front * betaContinuedFraction(a, b, x) / a;
+    return 1.0 - front * betaContinuedFraction(b, a, 1.0 - x) / b;
+}
+
+/**
+ * @brief Groups one metric of the runs by benchmark, keeping first-appearance order
+ */
+void collect(const vector<BenchSample>& samples, bool allocations, vector<string>& order,
+             vector<vector<double>>& values) {
+    for (const BenchSample& s : samples) {
+        size_t i = 0;
+        while (i < order.size() && order[i] != s.benchmark) ++i;
+        if (i == order.size()) {
+            order.push_back(s.benchmark);
+            values.emplace_back();
+        }
+        values[i].push_back(allocations ? s.allocsPerOp : s.nsPerOp);
+    }
+}
+
+} // namespace
+
+void appendBenchHistory(const string& path, const vector<BenchSample>& samples) {
+    for (const BenchSample& s : samples)
+        if (hasWhitespace(s.commit) || hasWhitespace(s.benchmark))
+            throw invalid_argument("Benchmark history: commit and benchmark names must be non-empty without spaces");
+
+    ofstream file(path, ios::app);
+    if (!file) throw runtime_error("Cannot open benchmark history " + path);
+    file << setprecision(9);
+    for (const BenchSample& s : samples)
+        file << s.commit << " " << s.benchmark << " " << s.nsPerOp << " " << s.allocsPerOp << "\n";
+    if (!file) throw runtime_error("Cannot write benchmark history " + path);
+}
+
+vector<BenchSample> loadBenchHistory(const string& path) {
+    vector<BenchSample> samples;
+    ifstream file(path);
+    if (!file) return samples;
+
+    string line;
+    size_t number = 0;
+    while (getline(file, line)) {
+        ++number;
+        if (line.empty() || line[0] == '#') continue;
+        istringstream fields(line);
+        BenchSample s;
+        string rest;
+        if (!(fields >> s.commit >> s.benchmark >> s.nsPerOp >> s.allocsPerOp) || (fields >> rest))
+            throw runtime_error("Benchmark history " + path + ": malformed line " + to_string(number));
+        samples.push_back(s);
+    }
+    return samples;
+}
+
+vector<BenchSample> commitRuns(const vector<BenchSample>& history, const string& commit) {
+    vector<BenchSample> exact, similar;
+    string matched;
+    for (const BenchSample& s : history) {
+        if (s.commit == commit) {
+            exact.push_back(s);
+            continue;
+        }
+        // An abbreviation of the recorded hash, or a longer hash it abbreviates
+        const bool abbreviation = s.commit.compare(0, commit.size(), commit) == 0;
+        const bool longer = commit.compare(0, s.commit.size(), s.commit) == 0 &&
+                            commit.find_first_not_of("0123456789abcdef", s.commit.size()) == string::npos;
+        if (commit.empty() || !(abbreviation || longer)) continue;
+        if (!matched.empty() && matched != s.commit)
+            throw invalid_argument("Commit " + commit + " matches both " + matched + " and " + s.commit);
+        matched = s.commit;
+        similar.push_back(s);
+    }
+    return exact.empty() ? similar : exact;
+}
+
+double studentTUpperTail(double t, double degreesOfFreedom) {
+    if (isinf(t)) return t > 0 ? 0.0 : 1.0;
+    const double tail = 0.5 * incompleteBeta(degreesOfFreedom / 2.0, 0.5, degreesOfFreedom / (degreesOfFreedom + t * t));
+    return t >= 0.0 ? tail : 1.0 - tail;
+}
+
+WelchResult welchTest(const vector<double>& baseline, const vector<double>& candidate) {
+    if (baseline.size() < 2 || candidate.size() < 2)
+        throw invalid_argument("Welch's t-test needs at least two values on each side");
+
+    const double m1 = mean(baseline), m2 = mean(candidate);
+    const double e1 = variance(baseline, m1) / baseline.size();
+    const double e2 = variance(candidate, m2) / candidate.size();
+
+    WelchResult result;
+    if (e1 + e2 == 0.0) {
+        // Both sides are constant: the difference is exact
+        result.t = m2 > m1 ? numeric_limits<double>::infinity() : (m2 < m1 ? -numeric_limits<double>::infinity() : 0.0);
+        result.degreesOfFreedom = static_cast<double>(baseline.size() + candidate.size() - 2);
+        result.pValue = m2 > m1 ? 0.0 : 1.0;
+        return result;
+    }
+    result.t = (m2 - m1) / sqrt(e1 + e2);
+    result.degreesOfFreedom = (e1 + e2) * (e1 + e2) /
+                              (e1 * e1 / (baseline.size() - 1) + e2 * e2 / (candidate.size() - 1));
+    result.pValue = studentTUpperTail(result.t, result.degreesOfFreedom);
+    return result;
+}
+
+vector<RegressionCheck> findRegressions(const vector<BenchSample>& baseline, const vector<BenchSample>& candidate,
+                                        const RegressionConfig& config) {
+    if (!(config.alpha > 0.0 && config.alpha < 1.0) || config.minChange < 0.0)
+        throw invalid_argument("RegressionConfig needs 0 < alpha < 1 and minChange >= 0");
+
+    vector<RegressionCheck> checks;
+    // Both metrics are grouped in the same order, so one name list serves both
+    vector<string> names, baseNames, repeated;
+    vector<vector<double>> values[2], baseValues[2];
+    collect(candidate, false, names, values[0]);
+    collect(candidate, true, repeated, values[1]);
+    repeated.clear();
+    collect(baseline, false, baseNames, baseValues[0]);
+    collect(baseline, true, repeated, baseValues[1]);
+
+    auto skip = [&checks](const string& benchmark, const string& reason) {
+        RegressionCheck check;
+        check.benchmark = benchmark;
+        check.skipped = reason;
+        checks.push_back(check);
+    };
+    for (size_t i = 0; i < names.size(); ++i) {
+        size_t j = 0;
+        while (j < baseNames.size() && baseNames[j] != names[i]) ++j;
+        if (j == baseNames.size()) {
+            skip(names[i], "no baseline runs");
+            continue;
+        }
+        if (values[0][i].size() < 2 || baseValues[0][j].size() < 2) {
+            skip(names[i], to_string(baseValues[0][j].size()) + " baseline and " + to_string(values[0][i].size()) +
+                               " candidate runs, at least 2 each needed");
+            continue;
+        }
+
+        for (int metric = 0; metric < 2; ++metric) {
+            const vector<double>& before = baseValues[metric][j];
+            const vector<double>& after = values[metric][i];
+            RegressionCheck check;
+            check.benchmark = names[i];
+            check.metric = metric == 0 ? "ns/op" : "allocs/op";
+            check.baselineMean = mean(before);
+            check.candidateMean = mean(after);
+            if (check.baselineMean > 0.0) check.change = check.candidateMean / check.baselineMean - 1.0;
+            else check.change = check.candidateMean > 0.0 ? numeric_limits<double>::infinity() : 0.0;
+            check.pValue = welchTest(before, after).pValue;
+            check.regression = check.change > config.minChange && check.pValue < config.alpha;
+            checks.push_back(check);
+        }
+    }
+    for (const string& name : baseNames)
+        if (find(names.begin(), names.end(), name) == names.end()) skip(name, "no candidate runs");
+    return checks;
+}
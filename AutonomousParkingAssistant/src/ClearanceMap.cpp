@@ -0,0 +1,352 @@
+/**
+ * @file ClearanceMap.cpp
+ * @brief Implementation of the distance-transform clearance map
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ *
+ * The exact squared Euclidean distance transform is separable: a column
+ * pass computes, for every cell, the squared vertical distance g to the
+ * nearest obstacle in its column; a row pass then computes
+ * min over x' of (x - x')^2 + g(x') with the lower envelope of parabolas
+ * (Felzenszwalb & Huttenlocher, "Distance Transforms of Sampled
+ * Functions"). Both passes are linear in the number of cells.
+ *
+ * Incremental updates use the distance cap D: a cell's capped clearance
+ * depends only on obstacles within D of it, so after a bay changes, cells
+ * within D of the bay are recomputed from a window extending 2D around
+ * it and every other cell keeps its value.
+ */
+
+#include "../include/ClearanceMap.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <new>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define PARKING_HAVE_MMAP 1
+#endif
+
+using namespace std;
+
+const double ClearanceMap::kDefaultMaxDistance = 8.0;
+
+namespace {
+
+const char kMagic[8] = {'A', 'P', 'A', 'C', 'L', 'R', 'M', 'P'};
+const uint32_t kVersion = 1;
+const double kFar = 1e12;  ///< Squared distance (cells) standing in for "no obstacle"
+
+/**
+ * @brief On-disk record of a registered bay, stored after the grid
+ */
+struct BayRecord {
+    int32_t id;
+    int32_t occupied;
+    double centerX, centerY, halfLength, halfWidth, heading;
+};
+
+/**
+ * @brief 1D squared distance transform of a sampled function
+ * @param f Input samples (squared column distances, kFar where a column is empty)
+ * @param n Number of samples
+ * @param d Output: d[q] = min_p (q - p)^2 + f[p]
+ * @param v Scratch: parabola vertices (n entries)
+ * @param z Scratch: envelope boundaries (n + 1 entries)
+ */
+void distanceTransform1D(const double* f, int n, double* d, int* v, double* z) {
+    const double inf = numeric_limits<double>::infinity();
+    int k = 0;
+    v[0] = 0;
+    z[0] = -inf;
+    z[1] = inf;
+    for (int q = 1; q < n; ++q) {
+        double s;
+        while (true) {
+            int p = v[k];
+            s = ((f[q] + static_cast<double>(q) * q) - (f[p] + static_cast<double>(p) * p)) / (2.0 * (q - p));
+            if (s > z[k]) break;
+            --k;
+        }
+        ++k;
+        v[k] = q;
+        z[k] = s;
+        z[k + 1] = inf;
+    }
+    k = 0;
+    for (int q = 0; q < n; ++q) {
+        while (z[k + 1] < q) ++k;
+        double dq = q - v[k];
+        d[q] = dq * dq + f[v[k]];
+    }
+}
+
+} // namespace
+
+size_t ClearanceMap::regionSize(int cols, int rows) {
+    size_t cells = static_cast<size_t>(cols) * rows;
+    // Rounded to 8 bytes so the bay records that follow in files stay aligned
+    return sizeof(Header) + ((cells * (sizeof(float) + 1) + 7) & ~static_cast<size_t>(7));
+}
+
+ClearanceMap::ClearanceMap(Vec2 origin, double resolution, int cols, int rows, double maxDistance)
+    : header(nullptr), distances(nullptr), occupancy(nullptr), regionBytes(0), mapped(false),
+      invResolution(0.0) {
+    if (!(resolution > 0) || cols <= 0 || rows <= 0 || !(maxDistance > 0))
+        throw invalid_argument("ClearanceMap: resolution, size and maximum distance must be positive");
+
+    regionBytes = regionSize(cols, rows);
+    header = static_cast<Header*>(::operator new(regionBytes));
+    memset(header, 0, sizeof(Header));
+    memcpy(header->magic, kMagic, sizeof(kMagic));
+    header->version = kVersion;
+    header->cols = cols;
+    header->rows = rows;
+    header->originX = origin.x;
+    header->originY = origin.y;
+    header->resolution = resolution;
+    header->maxDistance = maxDistance;
+    bind();
+
+    size_t cells = static_cast<size_t>(cols) * rows;
+    fill(distances, distances + cells, static_cast<float>(maxDistance));
+    memset(occupancy, 0, cells);
+}
+
+ClearanceMap::ClearanceMap(void* region, size_t bytes, bool isMapped)
+    : header(static_cast<Header*>(region)), distances(nullptr), occupancy(nullptr), regionBytes(bytes),
+      mapped(isMapped), invResolution(0.0) {}
+
+ClearanceMap::ClearanceMap(ClearanceMap&& other)
+    : header(other.header), distances(other.distances), occupancy(other.occupancy),
+      regionBytes(other.regionBytes), mapped(other.mapped), invResolution(other.invResolution),
+      bays(move(other.bays)), bayIndex(move(other.bayIndex)) {
+    other.header = nullptr;
+    other.distances = nullptr;
+    other.occupancy = nullptr;
+}
+
+ClearanceMap::~ClearanceMap() {
+    if (!header) return;
+#ifdef PARKING_HAVE_MMAP
+    if (mapped) {
+        munmap(header, regionBytes);
+        return;
+    }
+#endif
+    ::operator delete(header);
+}
+
+void ClearanceMap::bind() {
+    distances = reinterpret_cast<float*>(reinterpret_cast<char*>(header) + sizeof(Header));
+    occupancy = reinterpret_cast<uint8_t*>(distances + static_cast<size_t>(header->cols) * header->rows);
+    invResolution = 1.0 / header->resolution;
+}
+
+ClearanceMap ClearanceMap::load(const string& path) {
+    const string notAMap = "ClearanceMap: " + path + " is not a clearance map";
+    void* region = nullptr;
+    size_t bytes = 0;
+    bool isMapped = false;
+#ifdef PARKING_HAVE_MMAP
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) throw runtime_error("ClearanceMap: cannot open " + path);
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(Header)) {
+        close(fd);
+        throw runtime_error(notAMap);
+    }
+    bytes = static_cast<size_t>(st.st_size);
+    // Private writable mapping: pages are shared with the page cache until
+    // an incremental update touches them, and the file is never modified
+    region = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (region == MAP_FAILED) throw runtime_error("ClearanceMap: cannot map " + path);
+    isMapped = true;
+#else
+    ifstream in(path.c_str(), ios::binary | ios::ate);
+    if (!in) throw runtime_error("ClearanceMap: cannot open " + path);
+    bytes = static_cast<size_t>(in.tellg());
+    if (bytes < sizeof(Header)) throw runtime_error(notAMap);
+    region = ::operator new(bytes);
+    in.seekg(0);
+    if (!in.read(static_cast<char*>(region), bytes)) {
+        ::operator delete(region);
+        throw runtime_error(notAMap);
+    }
+#endif
+    // Taking ownership first releases the region if validation fails
+    ClearanceMap map(region, bytes, isMapped);
+    const Header* h = map.header;
+    if (memcmp(h->magic, kMagic, sizeof(kMagic)) != 0 || h->version != kVersion || h->cols <= 0 ||
+        h->rows <= 0 || bytes != regionSize(h->cols, h->rows) + h->bayCount * sizeof(BayRecord))
+        throw runtime_error(notAMap);
+    map.bind();
+
+    const BayRecord* records = reinterpret_cast<const BayRecord*>(
+        static_cast<const char*>(region) + regionSize(h->cols, h->rows));
+    for (uint32_t i = 0; i < h->bayCount; ++i) {
+        const BayRecord& r = records[i];
+        map.bayIndex[r.id] = map.bays.size();
+        map.bays.push_back(Bay{r.id, OrientedBox{Vec2{r.centerX, r.centerY}, r.halfLength, r.halfWidth, r.heading},
+                               r.occupied != 0});
+    }
+    return map;
+}
+
+void ClearanceMap::save(const string& path) const {
+    ofstream out(path.c_str(), ios::binary | ios::trunc);
+    Header h = *header;
+    h.bayCount = static_cast<uint32_t>(bays.size());
+    size_t gridBytes = regionSize(header->cols, header->rows);
+    out.write(reinterpret_cast<const char*>(&h), sizeof(Header));
+    out.write(reinterpret_cast<const char*>(header) + sizeof(Header), gridBytes - sizeof(Header));
+    for (const Bay& bay : bays) {
+        BayRecord r = {bay.id, bay.occupied ? 1 : 0, bay.footprint.center.x, bay.footprint.center.y,
+                       bay.footprint.halfLength, bay.footprint.halfWidth, bay.footprint.heading};
+        out.write(reinterpret_cast<const char*>(&r), sizeof(r));
+    }
+    if (!out) throw runtime_error("ClearanceMap: cannot write " + path);
+}
+
+/**
+ * @brief Computes the clipped cell range of a box's axis-aligned bounds
+ * @param bounds Receives col0, row0, col1, row1 (inclusive; empty if col0 > col1)
+ */
+void ClearanceMap::footprintCells(const OrientedBox& box, int bounds[4]) const {
+    Vec2 c[4];
+    boxCorners(box, c);
+    double minX = c[0].x, maxX = c[0].x, minY = c[0].y, maxY = c[0].y;
+    for (int i = 1; i < 4; ++i) {
+        minX = min(minX, c[i].x);
+        maxX = max(maxX, c[i].x);
+        minY = min(minY, c[i].y);
+        maxY = max(maxY, c[i].y);
+    }
+    bounds[0] = max(0, static_cast<int>(floor((minX - header->originX) * invResolution)));
+    bounds[1] = max(0, static_cast<int>(floor((minY - header->originY) * invResolution)));
+    bounds[2] = min(header->cols - 1, static_cast<int>(floor((maxX - header->originX) * invResolution)));
+    bounds[3] = min(header->rows - 1, static_cast<int>(floor((maxY - header->originY) * invResolution)));
+}
+
+/**
+ * @brief Adds delta to the occupancy count of every cell whose center lies in the box
+ *
+ * A box smaller than a cell that covers no cell center marks the cell
+ * containing its center instead, so thin obstacles are never lost.
+ */
+void ClearanceMap::markBox(const OrientedBox& box, int delta) {
+    int b[4];
+    footprintCells(box, b);
+    Vec2 axisU = {cos(box.heading), sin(box.heading)};
+    Vec2 axisV = {-axisU.y, axisU.x};
+    bool marked = false;
+    for (int row = b[1]; row <= b[3]; ++row) {
+        for (int col = b[0]; col <= b[2]; ++col) {
+            Vec2 center = {header->originX + (col + 0.5) * header->resolution,
+                           header->originY + (row + 0.5) * header->resolution};
+            Vec2 d = center - box.center;
+            if (fabs(dot(d, axisU)) <= box.halfLength && fabs(dot(d, axisV)) <= box.halfWidth) {
+                occupancy[static_cast<size_t>(row) * header->cols + col] += delta;
+                marked = true;
+            }
+        }
+    }
+    if (!marked) {
+        int col = static_cast<int>(floor((box.center.x - header->originX) * invResolution));
+        int row = static_cast<int>(floor((box.center.y - header->originY) * invResolution));
+        if (col >= 0 && row >= 0 && col < header->cols && row < header->rows)
+            occupancy[static_cast<size_t>(row) * header->cols + col] += delta;
+    }
+}
+
+void ClearanceMap::addObstacle(const OrientedBox& box) {
+    markBox(box, 1);
+}
+
+void ClearanceMap::addBay(int bayId, const OrientedBox& footprint, bool occupied) {
+    if (bayIndex.count(bayId)) throw invalid_argument("ClearanceMap: bay " + to_string(bayId) + " already registered");
+    bayIndex[bayId] = bays.size();
+    bays.push_back(Bay{bayId, footprint, occupied});
+    if (occupied) markBox(footprint, 1);
+}
+
+void ClearanceMap::compute() {
+    transformWindow(0, 0, header->cols - 1, header->rows - 1, 0);
+}
+
+bool ClearanceMap::setBayOccupied(int bayId, bool occupied) {
+    unordered_map<int, size_t>::const_iterator it = bayIndex.find(bayId);
+    if (it == bayIndex.end()) throw out_of_range("ClearanceMap: unknown bay " + to_string(bayId));
+    Bay& bay = bays[it->second];
+    if (bay.occupied == occupied) return false;
+
+    bay.occupied = occupied;
+    markBox(bay.footprint, occupied ? 1 : -1);
+    int b[4];
+    footprintCells(bay.footprint, b);
+    int margin = static_cast<int>(ceil(header->maxDistance * invResolution)) + 1;
+    transformWindow(b[0], b[1], b[2], b[3], margin);
+    return true;
+}
+
+/**
+ * @brief Recomputes clearances for the cells of a window grown by margin
+ * @param col0,row0,col1,row1 Inclusive cell bounds of the changed area
+ * @param margin Cells around the changed area whose values may change
+ *
+ * The transform runs over the window grown by twice the margin so every
+ * obstacle within maxDistance of an output cell is included; results are
+ * written only for the window grown once. With margin 0 the whole map is
+ * passed in and recomputed.
+ */
+void ClearanceMap::transformWindow(int col0, int row0, int col1, int row1, int margin) {
+    const int cols = header->cols, rows = header->rows;
+    const int outC0 = max(0, col0 - margin), outC1 = min(cols - 1, col1 + margin);
+    const int outR0 = max(0, row0 - margin), outR1 = min(rows - 1, row1 + margin);
+    const int inC0 = max(0, outC0 - margin), inC1 = min(cols - 1, outC1 + margin);
+    const int inR0 = max(0, outR0 - margin), inR1 = min(rows - 1, outR1 + margin);
+    const int w = inC1 - inC0 + 1, h = inR1 - inR0 + 1;
+    if (w <= 0 || h <= 0) return;
+
+    // Column pass: squared vertical distance to the nearest obstacle in the column
+    vector<double> g(static_cast<size_t>(w) * h);
+    for (int x = 0; x < w; ++x) {
+        const uint8_t* column = occupancy + inC0 + x;
+        int last = -1;
+        for (int y = 0; y < h; ++y) {
+            if (column[static_cast<size_t>(inR0 + y) * cols]) last = y;
+            double dy = y - last;
+            g[static_cast<size_t>(y) * w + x] = last < 0 ? kFar : dy * dy;
+        }
+        last = -1;
+        for (int y = h - 1; y >= 0; --y) {
+            if (column[static_cast<size_t>(inR0 + y) * cols]) last = y;
+            if (last < 0) continue;
+            double dy = last - y;
+            double& cell = g[static_cast<size_t>(y) * w + x];
+            cell = min(cell, dy * dy);
+        }
+    }
+
+    // Row pass over the output rows only
+    vector<double> d(w);
+    vector<int> v(w);
+    vector<double> z(w + 1);
+    const double res = header->resolution;
+    const float cap = static_cast<float>(header->maxDistance);
+    for (int row = outR0; row <= outR1; ++row) {
+        distanceTransform1D(&g[static_cast<size_t>(row - inR0) * w], w, d.data(), v.data(), z.data());
+        float* out = distances + static_cast<size_t>(row) * cols;
+        for (int col = outC0; col <= outC1; ++col)
+            out[col] = min(cap, static_cast<float>(sqrt(d[col - inC0]) * res));
+    }
+}
@@ -0,0 +1,202 @@
+/**
+ * @file CollisionChecker.cpp
+ * @brief Implementation of the batched separating-axis collision checks
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ *
+ * For two rectangles A and B with unit axes (uA, vA) and (uB, vB), the
+ * only candidate separating axes are those four directions. With
+ * c = |cos(thetaB - thetaA)| and s = |sin(thetaB - thetaA)| and T the
+ * center offset, the boxes are disjoint iff any of
+ *
+ *   |T.uA| > hlA + hlB c + hwB s      |T.vA| > hwA + hlB s + hwB c
+ *   |T.uB| > hlB + hlA c + hwA s      |T.vB| > hwB + hlA s + hwA c
+ *
+ * holds. The batched kernel evaluates all four tests for four obstacles
+ * at once and ORs them, with no per-obstacle branches.
+ */
+
+#include "../include/CollisionChecker.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PARKING_COLLISION_SSE2 1
+#endif
+
+using namespace std;
+
+namespace {
+
+const size_t kLaneWidth = 4;        ///< Obstacles per batch
+const float kPaddingOffset = 1e18f; ///< Position of padding boxes (never overlap)
+
+/**
+ * @brief Footprint parameters prepared for the kernel (relative, single precision)
+ */
+struct Probe {
+    float cx, cy, c, s, hl, hw;
+};
+
+Probe makeProbe(const OrientedBox& box, Vec2 origin) {
+    return Probe{static_cast<float>(box.center.x - origin.x), static_cast<float>(box.center.y - origin.y),
+                 static_cast<float>(cos(box.heading)), static_cast<float>(sin(box.heading)),
+                 static_cast<float>(box.halfLength), static_cast<float>(box.halfWidth)};
+}
+
+/**
+ * @brief Returns true if the probe overlaps any of n (multiple of four) obstacles
+ */
+bool anyOverlap(const Probe& p, const float* cx, const float* cy, const float* bc, const float* bs,
+                const float* bhl, const float* bhw, size_t n) {
+#ifdef PARKING_COLLISION_SSE2
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+    const __m128 pcx = _mm_set1_ps(p.cx), pcy = _mm_set1_ps(p.cy);
+    const __m128 pc = _mm_set1_ps(p.c), ps = _mm_set1_ps(p.s);
+    const __m128 phl = _mm_set1_ps(p.hl), phw = _mm_set1_ps(p.hw);
+
+    for (size_t i = 0; i < n; i += kLaneWidth) {
+        __m128 tx = _mm_sub_ps(_mm_loadu_ps(cx + i), pcx);
+        __m128 ty = _mm_sub_ps(_mm_loadu_ps(cy + i), pcy);
+        __m128 c = _mm_loadu_ps(bc + i), s = _mm_loadu_ps(bs + i);
+        __m128 hl = _mm_loadu_ps(bhl + i), hw = _mm_loadu_ps(bhw + i);
+
+        __m128 relC = _mm_and_ps(_mm_add_ps(_mm_mul_ps(pc, c), _mm_mul_ps(ps, s)), absMask);
+        __m128 relS = _mm_and_ps(_mm_sub_ps(_mm_mul_ps(pc, s), _mm_mul_ps(ps, c)), absMask);
+
+        __m128 tuA = _mm_and_ps(_mm_add_ps(_mm_mul_ps(tx, pc), _mm_mul_ps(ty, ps)), absMask);
+        __m128 tvA = _mm_and_ps(_mm_sub_ps(_mm_mul_ps(ty, pc), _mm_mul_ps(tx, ps)), absMask);
+        __m128 tuB = _mm_and_ps(_mm_add_ps(_mm_mul_ps(tx, c), _mm_mul_ps(ty, s)), absMask);
+        __m128 tvB = _mm_and_ps(_mm_sub_ps(_mm_mul_ps(ty, c), _mm_mul_ps(tx, s)), absMask);
+
+        __m128 sep = _mm_cmpgt_ps(tuA, _mm_add_ps(phl, _mm_add_ps(_mm_mul_ps(hl, relC), _mm_mul_ps(hw, relS))));
+        sep = _mm_or_ps(sep, _mm_cmpgt_ps(tvA, _mm_add_ps(phw, _mm_add_ps(_mm_mul_ps(hl, relS), _mm_mul_ps(hw, relC)))));
+        sep = _mm_or_ps(sep, _mm_cmpgt_ps(tuB, _mm_add_ps(hl, _mm_add_ps(_mm_mul_ps(phl, relC), _mm_mul_ps(phw, relS)))));
+        sep = _mm_or_ps(sep, _mm_cmpgt_ps(tvB, _mm_add_ps(hw, _mm_add_ps(_mm_mul_ps(phl, relS), _mm_mul_ps(phw, relC)))));
+        if (_mm_movemask_ps(sep) != 0xf) return true;
+    }
+    return false;
+#else
+    for (size_t i = 0; i < n; i += kLaneWidth) {
+        bool hit = false;
+        for (size_t j = i; j < i + kLaneWidth; ++j) {
+            float tx = cx[j] - p.cx, ty = cy[j] - p.cy;
+            float relC = fabs(p.c * bc[j] + p.s * bs[j]);
+            float relS = fabs(p.c * bs[j] - p.s * bc[j]);
+            bool sep = fabs(tx * p.c + ty * p.s) > p.hl + bhl[j] * relC + bhw[j] * relS;
+            sep |= fabs(ty * p.c - tx * p.s) > p.hw + bhl[j] * relS + bhw[j] * relC;
+            sep |= fabs(tx * bc[j] + ty * bs[j]) > bhl[j] + p.hl * relC + p.hw * relS;
+            sep |= fabs(ty * bc[j] - tx * bs[j]) > bhw[j] + p.hl * relS + p.hw * relC;
+            hit |= !sep;
+        }
+        if (hit) return true;
+    }
+    return false;
+#endif
+}
+
+} // namespace
+
+OrientedBox vehicleFootprint(const VehicleModel& vehicle, const Pose2D& pose, double margin) {
+    double front = vehicle.wheelbase + vehicle.frontOverhang;
+    Vec2 center = toWorld(pose, Vec2{(front - vehicle.rearOverhang) / 2.0, 0.0});
+    return OrientedBox{center, vehicleLength(vehicle) / 2.0 + margin, vehicle.width / 2.0 + margin,
+                       pose.heading};
+}
+
+bool boxesOverlap(const OrientedBox& a, const OrientedBox& b) {
+    Vec2 t = b.center - a.center;
+    double ca = cos(a.heading), sa = sin(a.heading);
+    double cb = cos(b.heading), sb = sin(b.heading);
+    double relC = fabs(ca * cb + sa * sb);
+    double relS = fabs(ca * sb - sa * cb);
+    if (fabs(t.x * ca + t.y * sa) > a.halfLength + b.halfLength * relC + b.halfWidth * relS) return false;
+    if (fabs(t.y * ca - t.x * sa) > a.halfWidth + b.halfLength * relS + b.halfWidth * relC) return false;
+    if (fabs(t.x * cb + t.y * sb) > b.halfLength + a.halfLength * relC + a.halfWidth * relS) return false;
+    if (fabs(t.y * cb - t.x * sb) > b.halfWidth + a.halfLength * relS + a.halfWidth * relC) return false;
+    return true;
+}
+
+void CollisionWorld::Lanes::push(float x, float y, float c, float s, float hl, float hw) {
+    cx.push_back(x);
+    cy.push_back(y);
+    cosH.push_back(c);
+    sinH.push_back(s);
+    halfLength.push_back(hl);
+    halfWidth.push_back(hw);
+}
+
+void CollisionWorld::Lanes::pad() {
+    while (cx.size() % kLaneWidth != 0) push(kPaddingOffset, kPaddingOffset, 1.0f, 0.0f, 0.0f, 0.0f);
+}
+
+void CollisionWorld::addObstacle(const OrientedBox& box) {
+    if (box.halfLength < 0 || box.halfWidth < 0)
+        throw invalid_argument("CollisionWorld: obstacle extents must not be negative");
+    if (count == 0) origin = box.center;
+
+    // Drop the padding, append, re-pad
+    lanes.cx.resize(count);
+    lanes.cy.resize(count);
+    lanes.cosH.resize(count);
+    lanes.sinH.resize(count);
+    lanes.halfLength.resize(count);
+    lanes.halfWidth.resize(count);
+    Probe p = makeProbe(box, origin);
+    lanes.push(p.cx, p.cy, p.c, p.s, p.hl, p.hw);
+    lanes.pad();
+    radius.push_back(static_cast<float>(sqrt(box.halfLength * box.halfLength + box.halfWidth * box.halfWidth)));
+    count++;
+}
+
+bool CollisionWorld::collides(const OrientedBox& footprint) const {
+    return anyOverlap(makeProbe(footprint, origin), lanes.cx.data(), lanes.cy.data(), lanes.cosH.data(),
+                      lanes.sinH.data(), lanes.halfLength.data(), lanes.halfWidth.data(), lanes.cx.size());
+}
+
+int CollisionWorld::firstCollision(const vector<OrientedBox>& footprints) const {
+    if (footprints.empty() || count == 0) return -1;
+
+    // Broad phase: bounding box of every footprint's bounding circle
+    double minX = 1e300, minY = 1e300, maxX = -1e300, maxY = -1e300;
+    for (const OrientedBox& f : footprints) {
+        double r = sqrt(f.halfLength * f.halfLength + f.halfWidth * f.halfWidth);
+        minX = min(minX, f.center.x - r);
+        maxX = max(maxX, f.center.x + r);
+        minY = min(minY, f.center.y - r);
+        maxY = max(maxY, f.center.y + r);
+    }
+    const float loX = static_cast<float>(minX - origin.x), hiX = static_cast<float>(maxX - origin.x);
+    const float loY = static_cast<float>(minY - origin.y), hiY = static_cast<float>(maxY - origin.y);
+
+    Lanes candidates;
+    for (size_t i = 0; i < count; ++i) {
+        float r = radius[i];
+        if (lanes.cx[i] + r < loX || lanes.cx[i] - r > hiX || lanes.cy[i] + r < loY || lanes.cy[i] - r > hiY)
+            continue;
+        candidates.push(lanes.cx[i], lanes.cy[i], lanes.cosH[i], lanes.sinH[i], lanes.halfLength[i],
+                        lanes.halfWidth[i]);
+    }
+    if (candidates.cx.empty()) return -1;
+    candidates.pad();
+
+    // Narrow phase: each footprint against the surviving obstacles
+    for (size_t k = 0; k < footprints.size(); ++k) {
+        if (anyOverlap(makeProbe(footprints[k], origin), candidates.cx.data(), candidates.cy.data(),
+                       candidates.cosH.data(), candidates.sinH.data(), candidates.halfLength.data(),
+                       candidates.halfWidth.data(), candidates.cx.size()))
+            return static_cast<int>(k);
+    }
+    return -1;
+}
+
+int firstPathCollision(const CollisionWorld& world, const VehicleModel& vehicle,
+                       const vector<Pose2D>& path, double margin) {
+    vector<OrientedBox> footprints;
+    footprints.reserve(path.size());
+    for (const Pose2D& pose : path) footprints.push_back(vehicleFootprint(vehicle, pose, margin));
+    return world.firstCollision(footprints);
+}
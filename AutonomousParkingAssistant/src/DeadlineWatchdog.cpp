@@ -0,0 +1,169 @@
+/**
+ * @file DeadlineWatchdog.cpp
+ * @brief Implementation of the control loop deadline watchdog
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ */
+
+#include "../include/DeadlineWatchdog.h"
+#include "../include/Tracer.h"
+#include <chrono>
+#include <iomanip>
+#include <stdexcept>
+
+using namespace std;
+
+namespace {
+
+int64_t nowNs() {
+    return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+const LoopStage kStages[4] = {LoopStage::Alert, LoopStage::Classify, LoopStage::Guidance, LoopStage::Record};
+
+} // namespace
+
+const char* stageName(LoopStage stage) {
+    switch (stage) {
+    case LoopStage::Alert:    return "alert";
+    case LoopStage::Classify: return "classify";
+    case LoopStage::Guidance: return "guidance";
+    default:                  return "record";
+    }
+}
+
+void WatchdogStats::print(ostream& out, const WatchdogConfig& config) const {
+    ios::fmtflags flags = out.flags();
+    streamsize precision = out.precision();
+    out << fixed << setprecision(2);
+    out << "⏱️ Deadline overruns: " << overruns << " of " << frames << " frames (deadline "
+        << config.frameDeadline * 1e3 << " ms, worst " << worstFrameMs << " ms, mean " << meanFrameUs << " us)\n";
+    if (overruns > 0) {
+        out << "   Slowest stage:";
+        for (LoopStage s : kStages)
+            if (overrunsByStage[static_cast<int>(s)] > 0)
+                out << " " << stageName(s) << " " << overrunsByStage[static_cast<int>(s)];
+        out << "\n";
+    }
+    if (stalls > 0) out << "🛑 Watchdog stops: " << stalls << "\n";
+    out.flags(flags);
+    out.precision(precision);
+}
+
+DeadlineWatchdog::DeadlineWatchdog(const WatchdogConfig& config, StallAction onStall, Clock timeSource)
+    : settings(config), action(std::move(onStall)), clock(timeSource ? std::move(timeSource) : Clock(nowNs)),
+      deadlineNs(static_cast<int64_t>(config.frameDeadline * 1e9)),
+      hardLimitNs(static_cast<int64_t>(config.hardLimit * 1e9)) {
+    if (!(config.frameDeadline > 0.0 && config.frameDeadline <= config.hardLimit))
+        throw invalid_argument("Watchdog deadlines must satisfy 0 < frameDeadline <= hardLimit");
+    worker = thread(&DeadlineWatchdog::run, this);
+}
+
+DeadlineWatchdog::~DeadlineWatchdog() {
+    {
+        lock_guard<mutex> lock(threadMutex);
+        quit = true;
+    }
+    threadWake.notify_one();
+    worker.join();
+}
+
+void DeadlineWatchdog::beginFrame(LoopStage first) {
+    const int64_t now = clock();
+    for (int64_t& ns : stageNs) ns = 0;
+    stageStartNs = now;
+    currentStage.store(static_cast<int>(first), memory_order_relaxed);
+    frameStartNs.store(now, memory_order_relaxed);
+    frameSeq.store(frameSeq.load(memory_order_relaxed) + 1, memory_order_release);
+    {
+        // Taking the mutex orders the store before the thread's next check
+        lock_guard<mutex> lock(threadMutex);
+    }
+    threadWake.notify_one();
+}
+
+void DeadlineWatchdog::stage(LoopStage next) {
+    const int64_t now = clock();
+    const int current = currentStage.load(memory_order_relaxed);
+    stageNs[current] += now - stageStartNs;
+    stageStartNs = now;
+    currentStage.store(static_cast<int>(next), memory_order_relaxed);
+}
+
+bool DeadlineWatchdog::endFrame() {
+    const int64_t now = clock();
+    const int current = currentStage.load(memory_order_relaxed);
+    stageNs[current] += now - stageStartNs;
+    const int64_t total = now - frameStartNs.load(memory_order_relaxed);
+    const uint64_t seq = frameSeq.load(memory_order_relaxed);
+    frameSeq.store(seq + 1, memory_order_release);
+
+    // The watchdog thread may not have woken up in time; the fallback still runs once
+    if (total >= hardLimitNs && claimStall(seq) && action)
+        action(static_cast<LoopStage>(current), total * 1e-9);
+    lastStalled = stalledSeq.load(memory_order_acquire) == seq;
+    lastTotalNs = total;
+
+    const double frameUs = total * 1e-3;
+    ++counters.frames;
+    totalFrameUs += frameUs;
+    counters.meanFrameUs = totalFrameUs / static_cast<double>(counters.frames);
+    if (frameUs * 1e-3 > counters.worstFrameMs) counters.worstFrameMs = frameUs * 1e-3;
+
+    if (total <= deadlineNs) return false;
+    int slowest = 0;
+    for (int i = 1; i < 4; ++i)
+        if (stageNs[i] > stageNs[slowest]) slowest = i;
+    ++counters.overruns;
+    ++counters.overrunsByStage[slowest];
+    return true;
+}
+
+WatchdogStats DeadlineWatchdog::stats() const {
+    WatchdogStats result = counters;
+    result.stalls = stallCount.load();
+    return result;
+}
+
+/**
+ * @brief Marks a frame's stall as handled
+ * @return True for the caller that gets to run the fallback
+ */
+bool DeadlineWatchdog::claimStall(uint64_t frame) {
+    uint64_t previous = stalledSeq.load();
+    while (previous != frame)
+        if (stalledSeq.compare_exchange_weak(previous, frame)) {
+            stallCount.fetch_add(1);
+            return true;
+        }
+    return false;
+}
+
+void DeadlineWatchdog::run() {
+    PARKING_TRACE_THREAD("deadline watchdog");
+    unique_lock<mutex> lock(threadMutex);
+    while (!quit) {
+        const uint64_t seq = frameSeq.load(memory_order_acquire);
+        if (!(seq & 1)) {
+            // Between frames: beginFrame() wakes the thread
+            threadWake.wait(lock);
+            continue;
+        }
+        const int64_t start = frameStartNs.load(memory_order_relaxed);
+        const int64_t now = clock();
+        if (now < start + hardLimitNs) {
+            threadWake.wait_for(lock, chrono::nanoseconds(start + hardLimitNs - now));
+            continue;
+        }
+        if (frameSeq.load(memory_order_acquire) == seq && claimStall(seq) && action) {
+            const LoopStage stalledIn = static_cast<LoopStage>(currentStage.load(memory_order_relaxed));
+            lock.unlock();
+            PARKING_TRACE_SCOPE("stall fallback");
+            action(stalledIn, (now - start) * 1e-9);
+            lock.lock();
+        }
+        // The stall is handled; wait for the next frame
+        while (!quit && frameSeq.load(memory_order_acquire) == seq) threadWake.wait(lock);
+    }
+}
@@ -0,0 +1,195 @@
+/**
+ * @file DecisionDiff.cpp
+ * @brief Implementation of the differential decision runner
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ */
+
+#include "../include/DecisionDiff.h"
+#include "../include/SensorSynthesizer.h"
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+using namespace std;
+
+namespace {
+
+const char* const kLogHeader = "# parking decision log v1";
+
+/**
+ * @brief Reads the rest of a line after a keyword, e.g. "build release-2.0"
+ */
+string expectLine(istream& in, const string& keyword) {
+    string line;
+    if (!getline(in, line) || line.compare(0, keyword.size() + 1, keyword + " ") != 0)
+        throw runtime_error("Decision log: expected a '" + keyword + "' line");
+    return line.substr(keyword.size() + 1);
+}
+
+} // namespace
+
+bool operator==(const FrameDecision& a, const FrameDecision& b) {
+    return a.beep == b.beep && a.steering == b.steering && a.status == b.status;
+}
+
+bool operator!=(const FrameDecision& a, const FrameDecision& b) {
+    return !(a == b);
+}
+
+const char* steeringName(SteeringAdvice advice) {
+    switch (advice) {
+    case SteeringAdvice::SteerRight: return "RIGHT";
+    case SteeringAdvice::SteerLeft:  return "LEFT";
+    case SteeringAdvice::None:       return "NONE";
+    default:                         return "CENTER";
+    }
+}
+
+FrameDecision decideFrame(const SensorData& s) {
+    return decideParkingFrame(s, false);
+}
+
+PipelineFactory loopPipeline(bool reverseMode, const StatusClassifierConfig* statusConfig) {
+    if (!statusConfig)
+        return [reverseMode]() -> DecisionPipeline {
+            return [reverseMode](const SensorData& s) { return decideParkingFrame(s, reverseMode); };
+        };
+    StatusClassifier validated(*statusConfig);   // rejects an invalid configuration up front
+    const StatusClassifierConfig config = *statusConfig;
+    return [reverseMode, config]() -> DecisionPipeline {
+        shared_ptr<StatusClassifier> classifier = make_shared<StatusClassifier>(config);
+        return [reverseMode, classifier](const SensorData& s) {
+            return decideParkingFrame(s, reverseMode, classifier.get());
+        };
+    };
+}
+
+RecordedSession loadRecordedSession(const string& path) {
+    ifstream file(path);
+    if (!file) throw runtime_error("Cannot open recorded session " + path);
+    RecordedSession session;
+    session.name = path;
+    try {
+        session.frames = readSensorFrames(file);
+    } catch (const runtime_error& e) {
+        throw runtime_error(path + ": " + e.what());
+    }
+    return session;
+}
+
+DecisionRun runDecisions(const vector<RecordedSession>& corpus, const DecisionPipeline& pipeline, const string& build,
+                         unsigned threads) {
+    return runDecisions(corpus, [&pipeline]() { return pipeline; }, build, threads);
+}
+
+DecisionRun runDecisions(const vector<RecordedSession>& corpus, const PipelineFactory& makePipeline,
+                         const string& build, unsigned threads) {
+    if (threads == 0) throw invalid_argument("runDecisions needs at least one thread");
+
+    DecisionRun run;
+    run.build = build;
+    run.decisions.resize(corpus.size());
+    for (const RecordedSession& session : corpus) {
+        run.sessions.push_back(session.name);
+        run.frames += session.frames.size();
+    }
+
+    // Sessions are handed out one at a time, so long sessions do not hold up a whole share
+    atomic<size_t> next(0);
+    auto worker = [&]() {
+        for (size_t i = next.fetch_add(1); i < corpus.size(); i = next.fetch_add(1)) {
+            vector<FrameDecision>& out = run.decisions[i];
+            out.reserve(corpus[i].frames.size());
+            DecisionPipeline pipeline = makePipeline();
+            for (const SensorData& s : corpus[i].frames) out.push_back(pipeline(s));
+        }
+    };
+
+    const chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    vector<thread> workers;
+    for (unsigned t = 1; t < threads; ++t) workers.emplace_back(worker);
+    worker();
+    for (thread& w : workers) w.join();
+    run.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return run;
+}
+
+void writeDecisionLog(ostream& out, const DecisionRun& run) {
+    ios::fmtflags flags = out.flags();
+    streamsize precision = out.precision();
+    out << kLogHeader << "\n";
+    out << "build " << run.build << "\n";
+    out << "frames " << run.frames << " seconds " << setprecision(9) << run.seconds << "\n";
+    for (size_t i = 0; i < run.sessions.size(); ++i) {
+        out << "session " << run.decisions[i].size() << " " << run.sessions[i] << "\n";
+        for (const FrameDecision& d : run.decisions[i])
+            out << d.beep << " " << steeringName(d.steering) << " " << d.status << "\n";
+    }
+    out.flags(flags);
+    out.precision(precision);
+}
+
+DecisionRun readDecisionLog(istream& in) {
+    string line;
+    if (!getline(in, line) || line != kLogHeader) throw runtime_error("Not a parking decision log");
+
+    DecisionRun run;
+    run.build = expectLine(in, "build");
+    istringstream totals(expectLine(in, "frames"));
+    string secondsKeyword;
+    if (!(totals >> run.frames >> secondsKeyword >> run.seconds) || secondsKeyword != "seconds")
+        throw runtime_error("Decision log: malformed 'frames' line");
+
+    size_t decided = 0;
+    while (in.peek() != char_traits<char>::eof()) {
+        istringstream header(expectLine(in, "session"));
+        size_t count = 0;
+        if (!(header >> count) || header.get() != ' ') throw runtime_error("Decision log: malformed 'session' line");
+        string name;
+        getline(header, name);
+        run.sessions.push_back(name);
+        run.decisions.emplace_back();
+        vector<FrameDecision>& decisions = run.decisions.back();
+        decisions.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            if (!getline(in, line)) throw runtime_error("Decision log: session " + name + " is truncated");
+            istringstream fields(line);
+            FrameDecision d;
+            string steering;
+            if (!(fields >> d.beep >> steering) || fields.get() != ' ')
+                throw runtime_error("Decision log: malformed decision in session " + name);
+            if (steering == "RIGHT") d.steering = SteeringAdvice::SteerRight;
+            else if (steering == "LEFT") d.steering = SteeringAdvice::SteerLeft;
+            else if (steering == "CENTER") d.steering = SteeringAdvice::KeepCentered;
+            else if (steering == "NONE") d.steering = SteeringAdvice::None;
+            else throw runtime_error("Decision log: unknown steering " + steering);
+            getline(fields, d.status);
+            decisions.push_back(d);
+        }
+        decided += count;
+    }
+    if (decided != run.frames) throw runtime_error("Decision log: frame count does not match its sessions");
+    return run;
+}
+
+vector<Divergence> compareDecisions(const DecisionRun& baseline, const DecisionRun& candidate) {
+    if (baseline.sessions != candidate.sessions)
+        throw invalid_argument("compareDecisions: the runs cover different sessions");
+    vector<Divergence> divergences;
+    for (size_t i = 0; i < baseline.decisions.size(); ++i) {
+        const vector<FrameDecision>& a = baseline.decisions[i];
+        const vector<FrameDecision>& b = candidate.decisions[i];
+        if (a.size() != b.size())
+            throw invalid_argument("compareDecisions: session " + baseline.sessions[i] + " has a different length");
+        for (size_t f = 0; f < a.size(); ++f)
+            if (a[f] != b[f]) divergences.push_back(Divergence{i, f, a[f], b[f]});
+    }
+    return divergences;
+}
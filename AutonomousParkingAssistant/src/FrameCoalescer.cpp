@@ -0,0 +1,122 @@
+/**
+ * @file FrameCoalescer.cpp
+ * @brief Implementation of newest-frame-wins sensor ingest
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ */
+
+#include "../include/FrameCoalescer.h"
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+
+using namespace std;
+
+namespace {
+
+int64_t nowNs() {
+    return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+FrameCoalescer::FrameCoalescer(double collisionDistance, size_t maxKeptCollisions)
+    : collisionDistance(collisionDistance), maxKeptCollisions(maxKeptCollisions) {
+    if (!(collisionDistance > 0.0) || !std::isfinite(collisionDistance))
+        throw invalid_argument("Collision distance must be positive and finite");
+    if (maxKeptCollisions == 0) throw invalid_argument("At least one collision frame must be kept");
+}
+
+bool FrameCoalescer::isCollision(const SensorData& s) const {
+    // A failed sensor (NaN, infinite or negative) counts as a collision, as in BeepCadence
+    const auto close = [this](double r) { return !(r > collisionDistance) || !std::isfinite(r); };
+    return close(s.left) || close(s.center) || close(s.right);
+}
+
+void FrameCoalescer::push(const string& vehicleId, const SensorData& s) {
+    const int64_t now = nowNs();
+    {
+        lock_guard<mutex> lock(stateMutex);
+        auto it = index.find(vehicleId);
+        if (it == index.end()) {
+            it = index.emplace(vehicleId, slots.size()).first;
+            slots.emplace_back();
+            slots.back().id = vehicleId;
+        }
+        const size_t vehicle = it->second;
+        Slot& slot = slots[vehicle];
+        ++counters.received;
+
+        if (!slot.pending) {
+            slot.pending = true;
+            slot.superseded = 0;
+            order.push_back(vehicle);
+            ++pendingFrames;
+        } else if (isCollision(slot.latest) && slot.collisions.size() < maxKeptCollisions) {
+            slot.collisions.push_back(CoalescedFrame{vehicle, slot.latest, slot.latestNs, slot.superseded, true});
+            slot.superseded = 0;
+            ++counters.collisionsKept;
+            ++pendingFrames;
+        } else {
+            if (isCollision(slot.latest)) ++counters.collisionsDropped;
+            ++slot.superseded;
+            ++counters.coalesced;
+        }
+        slot.latest = s;
+        slot.latestNs = now;
+    }
+    frameArrived.notify_one();
+}
+
+size_t FrameCoalescer::drain(vector<CoalescedFrame>& out) {
+    out.clear();
+    lock_guard<mutex> lock(stateMutex);
+    out.reserve(pendingFrames);
+    for (size_t vehicle : order) {
+        Slot& slot = slots[vehicle];
+        out.insert(out.end(), slot.collisions.begin(), slot.collisions.end());
+        out.push_back(CoalescedFrame{vehicle, slot.latest, slot.latestNs, slot.superseded, isCollision(slot.latest)});
+        slot.collisions.clear();
+        slot.pending = false;
+    }
+    order.clear();
+    pendingFrames = 0;
+    counters.delivered += out.size();
+    return out.size();
+}
+
+bool FrameCoalescer::waitForFrames(double timeoutSeconds) {
+    unique_lock<mutex> lock(stateMutex);
+    frameArrived.wait_for(lock, chrono::duration<double>(timeoutSeconds), [this] { return closed || pendingFrames > 0; });
+    return pendingFrames > 0;
+}
+
+void FrameCoalescer::close() {
+    {
+        lock_guard<mutex> lock(stateMutex);
+        closed = true;
+    }
+    frameArrived.notify_all();
+}
+
+string FrameCoalescer::vehicleId(size_t vehicle) const {
+    lock_guard<mutex> lock(stateMutex);
+    if (vehicle >= slots.size()) throw out_of_range("FrameCoalescer: unknown vehicle index");
+    return slots[vehicle].id;
+}
+
+size_t FrameCoalescer::vehicles() const {
+    lock_guard<mutex> lock(stateMutex);
+    return slots.size();
+}
+
+size_t FrameCoalescer::pending() const {
+    lock_guard<mutex> lock(stateMutex);
+    return pendingFrames;
+}
+
+CoalescerStats FrameCoalescer::stats() const {
+    lock_guard<mutex> lock(stateMutex);
+    return counters;
+}
@@ -0,0 +1,399 @@
+/**
+ * @file GarageGraph.cpp
+ * @brief Implementation of the contraction-hierarchy garage graph
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ *
+ * Nodes are contracted greedily by edge difference plus the number of
+ * already contracted neighbours, with lazy priority updates. Shortcuts are
+ * skipped when a bounded witness search finds an equally short path that
+ * avoids the contracted node. Query searches keep their state in small
+ * hash maps, so concurrent queries need no locking.
+ */
+
+#include "../include/GarageGraph.h"
+#include "../include/LotIndex.h"
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+using namespace std;
+
+namespace {
+
+const double kInfinity = numeric_limits<double>::infinity();
+const int kWitnessSettleLimit = 200;  ///< Nodes a witness search may settle before giving up
+
+typedef pair<double, int> QueueItem;  // (distance, node)
+typedef priority_queue<QueueItem, vector<QueueItem>, greater<QueueItem>> MinQueue;
+
+/**
+ * @brief Search state of one side of a bidirectional query
+ */
+struct SearchSide {
+    unordered_map<int, double> distance;
+    unordered_map<int, pair<int, int>> parent;  // node -> (previous node, middle)
+    MinQueue queue;
+
+    double get(int node) const {
+        auto it = distance.find(node);
+        return it == distance.end() ? kInfinity : it->second;
+    }
+    double top() const { return queue.empty() ? kInfinity : queue.top().first; }
+};
+
+} // namespace
+
+void GarageGraph::checkNode(int index) const {
+    if (index < 0 || index >= static_cast<int>(nodes.size()))
+        throw out_of_range("GarageGraph: unknown node " + to_string(index));
+}
+
+int GarageGraph::addNode(GarageNodeKind kind, Vec2 position, int level, int bayId) {
+    if (contracted()) throw logic_error("GarageGraph: cannot add nodes after contract()");
+    if (kind == GarageNodeKind::Bay) {
+        if (bayId < 0) throw invalid_argument("GarageGraph: bay nodes need a bay id");
+        if (bayNodes.count(bayId)) throw invalid_argument("GarageGraph: bay " + to_string(bayId) + " added twice");
+        bayNodes[bayId] = static_cast<int>(nodes.size());
+    } else {
+        bayId = -1;
+    }
+    nodes.push_back(GarageNode{kind, position, level, bayId});
+    original.emplace_back();
+    return static_cast<int>(nodes.size()) - 1;
+}
+
+void GarageGraph::addEdge(int from, int to, double length, bool oneWay) {
+    if (contracted()) throw logic_error("GarageGraph: cannot add edges after contract()");
+    checkNode(from);
+    checkNode(to);
+    if (!(length >= 0)) throw invalid_argument("GarageGraph: edge length must be non-negative");
+    original[from].push_back(Arc{to, length, -1});
+    if (!oneWay) original[to].push_back(Arc{from, length, -1});
+}
+
+int GarageGraph::bayNode(int bayId) const {
+    auto it = bayNodes.find(bayId);
+    return it == bayNodes.end() ? -1 : it->second;
+}
+
+/**
+ * @brief Adds an arc to the working graph, keeping only the shorter of parallel arcs
+ */
+void GarageGraph::addArc(int from, int to, double weight, int middle) {
+    for (Arc& arc : outArcs[from]) {
+        if (arc.node != to) continue;
+        if (weight < arc.weight) {
+            arc.weight = weight;
+            arc.middle = middle;
+            for (Arc& back : inArcs[to])
+                if (back.node == from) {
+                    back.weight = weight;
+                    back.middle = middle;
+                }
+        }
+        return;
+    }
+    outArcs[from].push_back(Arc{to, weight, middle});
+    inArcs[to].push_back(Arc{from, weight, middle});
+}
+
+/**
+ * @brief Counts (and optionally collects) the shortcuts contracting v would need
+ *
+ * For every uncontracted predecessor u, a Dijkstra search that avoids v
+ * looks for witness paths to the successors; successors it cannot reach
+ * within the u -> v -> x length need a shortcut.
+ */
+int GarageGraph::contractionCost(int v, vector<Shortcut>* created) {
+    int count = 0;
+    for (const Arc& in : inArcs[v]) {
+        int u = in.node;
+        if (rank[u] >= 0 || u == v) continue;
+        double maxLength = 0.0;
+        for (const Arc& out : outArcs[v])
+            if (rank[out.node] < 0 && out.node != u && out.node != v) maxLength = max(maxLength, in.weight + out.weight);
+
+        MinQueue queue;
+        witnessDistance[u] = 0.0;
+        witnessTouched.push_back(u);
+        queue.push(QueueItem(0.0, u));
+        int settled = 0;
+        while (!queue.empty() && settled < kWitnessSettleLimit) {
+            QueueItem item = queue.top();
+            queue.pop();
+            if (item.first > witnessDistance[item.second]) continue;
+            if (item.first > maxLength) break;
+            settled++;
+            for (const Arc& arc : outArcs[item.second]) {
+                if (arc.node == v || rank[arc.node] >= 0) continue;
+                double d = item.first + arc.weight;
+                if (d < witnessDistance[arc.node]) {
+                    if (witnessDistance[arc.node] == kInfinity) witnessTouched.push_back(arc.node);
+                    witnessDistance[arc.node] = d;
+                    queue.push(QueueItem(d, arc.node));
+                }
+            }
+        }
+
+        for (const Arc& out : outArcs[v]) {
+            int x = out.node;
+            if (rank[x] >= 0 || x == u || x == v) continue;
+            double through = in.weight + out.weight;
+            if (witnessDistance[x] <= through) continue;
+            count++;
+            if (created) created->push_back(Shortcut{u, x, through});
+        }
+        for (int touched : witnessTouched) witnessDistance[touched] = kInfinity;
+        witnessTouched.clear();
+    }
+    return count;
+}
+
+void GarageGraph::contract() {
+    if (contracted()) return;
+    const int n = static_cast<int>(nodes.size());
+    outArcs.assign(n, vector<Arc>());
+    inArcs.assign(n, vector<Arc>());
+    for (int u = 0; u < n; ++u)
+        for (const Arc& arc : original[u])
+            if (arc.node != u) addArc(u, arc.node, arc.weight, -1);
+    witnessDistance.assign(n, kInfinity);
+    rank.assign(n, -1);
+    vector<int> contractedNeighbours(n, 0);
+
+    auto priority = [&](int v) {
+        int degree = 0;
+        for (const Arc& a : outArcs[v]) degree += rank[a.node] < 0;
+        for (const Arc& a : inArcs[v]) degree += rank[a.node] < 0;
+        return contractionCost(v, nullptr) - degree + contractedNeighbours[v];
+    };
+
+    typedef pair<int, int> Candidate;  // (priority, node)
+    priority_queue<Candidate, vector<Candidate>, greater<Candidate>> order;
+    for (int v = 0; v < n; ++v) order.push(Candidate(priority(v), v));
+
+    int next = 0;
+    vector<Shortcut> created;
+    while (!order.empty()) {
+        int v = order.top().second;
+        order.pop();
+        if (rank[v] >= 0) continue;
+        int current = priority(v);
+        if (!order.empty() && current > order.top().first) {   // lazy update
+            order.push(Candidate(current, v));
+            continue;
+        }
+
+        created.clear();
+        contractionCost(v, &created);
+        rank[v] = next++;
+        for (const Shortcut& s : created) {
+            addArc(s.from, s.to, s.weight, v);
+            shortcuts++;
+        }
+        for (const Arc& a : outArcs[v]) contractedNeighbours[a.node]++;
+        for (const Arc& a : inArcs[v]) contractedNeighbours[a.node]++;
+    }
+
+    // Split every arc into the upward graph of its tail or the downward graph of its head
+    upward.assign(n, vector<Arc>());
+    downward.assign(n, vector<Arc>());
+    for (int u = 0; u < n; ++u)
+        for (const Arc& arc : outArcs[u]) {
+            if (rank[arc.node] > rank[u])
+                upward[u].push_back(arc);
+            else
+                downward[arc.node].push_back(Arc{u, arc.weight, arc.middle});
+        }
+    outArcs.clear();
+    inArcs.clear();
+    witnessDistance.clear();
+    witnessTouched.clear();
+
+    // Bay buckets: the full backward upward search space of every bay
+    buckets.assign(n, vector<BucketEntry>());
+    for (const auto& bay : bayNodes) {
+        unordered_map<int, double> distance;
+        MinQueue queue;
+        distance[bay.second] = 0.0;
+        queue.push(QueueItem(0.0, bay.second));
+        while (!queue.empty()) {
+            QueueItem item = queue.top();
+            queue.pop();
+            if (item.first > distance[item.second]) continue;
+            buckets[item.second].push_back(BucketEntry{bay.second, item.first});
+            for (const Arc& arc : downward[item.second]) {
+                double d = item.first + arc.weight;
+                auto it = distance.find(arc.node);
+                if (it == distance.end() || d < it->second) {
+                    distance[arc.node] = d;
+                    queue.push(QueueItem(d, arc.node));
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Returns the middle node of the hierarchy arc from -> to
+ */
+int GarageGraph::findMiddle(int from, int to) const {
+    if (rank[to] > rank[from]) {
+        for (const Arc& arc : upward[from])
+            if (arc.node == to) return arc.middle;
+    } else {
+        for (const Arc& arc : downward[to])
+            if (arc.node == from) return arc.middle;
+    }
+    throw logic_error("GarageGraph: missing hierarchy arc");
+}
+
+/**
+ * @brief Appends the original nodes of arc from -> to (excluding from) to out
+ */
+void GarageGraph::unpack(int from, int to, int middle, vector<int>& out) const {
+    if (middle < 0) {
+        out.push_back(to);
+        return;
+    }
+    unpack(from, middle, findMiddle(from, middle), out);
+    unpack(middle, to, findMiddle(middle, to), out);
+}
+
+GarageRoute GarageGraph::route(int from, int to) const {
+    if (!contracted()) throw logic_error("GarageGraph: contract() must be called before queries");
+    checkNode(from);
+    checkNode(to);
+
+    SearchSide forward, backward;
+    forward.distance[from] = 0.0;
+    forward.queue.push(QueueItem(0.0, from));
+    backward.distance[to] = 0.0;
+    backward.queue.push(QueueItem(0.0, to));
+    double best = kInfinity;
+    int meet = -1;
+    if (from == to) {
+        best = 0.0;
+        meet = from;
+    }
+
+    while (min(forward.top(), backward.top()) < best) {
+        bool forwardTurn = forward.top() <= backward.top();
+        SearchSide& side = forwardTurn ? forward : backward;
+        const SearchSide& other = forwardTurn ? backward : forward;
+        const vector<vector<Arc>>& arcs = forwardTurn ? upward : downward;
+
+        QueueItem item = side.queue.top();
+        side.queue.pop();
+        if (item.first > side.get(item.second)) continue;
+        double total = item.first + other.get(item.second);
+        if (total < best) {
+            best = total;
+            meet = item.second;
+        }
+        for (const Arc& arc : arcs[item.second]) {
+            double d = item.first + arc.weight;
+            if (d < side.get(arc.node)) {
+                side.distance[arc.node] = d;
+                side.parent[arc.node] = make_pair(item.second, arc.middle);
+                side.queue.push(QueueItem(d, arc.node));
+            }
+        }
+    }
+
+    GarageRoute result = {kInfinity, vector<int>()};
+    if (meet < 0) return result;
+    result.distance = best;
+
+    // Forward half: walk parents back from the meeting node, then expand shortcuts in order
+    vector<pair<int, pair<int, int>>> halfArcs;   // (tail, (head, middle))
+    for (int v = meet; v != from;) {
+        const pair<int, int>& p = forward.parent.at(v);
+        halfArcs.push_back(make_pair(p.first, make_pair(v, p.second)));
+        v = p.first;
+    }
+    result.nodes.push_back(from);
+    for (auto it = halfArcs.rbegin(); it != halfArcs.rend(); ++it) unpack(it->first, it->second.first, it->second.second, result.nodes);
+    for (int v = meet; v != to;) {
+        const pair<int, int>& p = backward.parent.at(v);
+        unpack(v, p.first, p.second, result.nodes);
+        v = p.first;
+    }
+    return result;
+}
+
+void GarageGraph::bindLot(const LotSnapshot& lot) {
+    unordered_map<int, int> position;
+    for (size_t i = 0; i < lot.bays.size(); ++i) position[lot.bays[i].id] = static_cast<int>(i);
+    vector<int> bound(nodes.size(), -1);
+    for (const auto& bay : bayNodes) {
+        auto it = position.find(bay.first);
+        if (it == position.end())
+            throw invalid_argument("GarageGraph: bay " + to_string(bay.first) + " is not in the lot");
+        bound[bay.second] = it->second;
+    }
+    lotPosition.swap(bound);
+    boundBayCount = lot.bays.size();
+}
+
+BayChoice GarageGraph::nearestFreeBay(int from, const LotSnapshot& lot, double requiredSize) const {
+    if (!contracted()) throw logic_error("GarageGraph: contract() must be called before queries");
+    if (lotPosition.empty() && !bayNodes.empty()) throw logic_error("GarageGraph: bindLot() must be called first");
+    if (lot.bays.size() != boundBayCount) throw logic_error("GarageGraph: snapshot belongs to another lot");
+    checkNode(from);
+
+    BayChoice best = {-1, -1, kInfinity};
+    unordered_map<int, double> distance;
+    MinQueue queue;
+    distance[from] = 0.0;
+    queue.push(QueueItem(0.0, from));
+    while (!queue.empty() && queue.top().first < best.distance) {
+        QueueItem item = queue.top();
+        queue.pop();
+        if (item.first > distance[item.second]) continue;
+        for (const BucketEntry& entry : buckets[item.second]) {
+            double total = item.first + entry.distance;
+            if (total >= best.distance) continue;
+            const ParkingBay& bay = lot.bays[lotPosition[entry.bay]];
+            if (bay.id != nodes[entry.bay].bayId) throw logic_error("GarageGraph: snapshot belongs to another lot");
+            if (bay.occupied || bay.size < requiredSize) continue;
+            best = BayChoice{bay.id, entry.bay, total};
+        }
+        for (const Arc& arc : upward[item.second]) {
+            double d = item.first + arc.weight;
+            auto it = distance.find(arc.node);
+            if (it == distance.end() || d < it->second) {
+                distance[arc.node] = d;
+                queue.push(QueueItem(d, arc.node));
+            }
+        }
+    }
+    return best;
+}
+
+vector<double> GarageGraph::distancesFrom(int from) const {
+    checkNode(from);
+    vector<double> distance(nodes.size(), kInfinity);
+    MinQueue queue;
+    distance[from] = 0.0;
+    queue.push(QueueItem(0.0, from));
+    while (!queue.empty()) {
+        QueueItem item = queue.top();
+        queue.pop();
+        if (item.first > distance[item.second]) continue;
+        for (const Arc& arc : original[item.second]) {
+            double d = item.first + arc.weight;
+            if (d < distance[arc.node]) {
+                distance[arc.node] = d;
+                queue.push(QueueItem(d, arc.node));
+            }
+        }
+    }
+    return distance;
+}
@@ -0,0 +1,336 @@
+/**
+ * @file GridReplanner.cpp
+ * @brief Implementation of the D* Lite grid replanner
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ *
+ * Follows the D* Lite formulation of Koenig and Likhachev (2002) with an
+ * indexed binary heap, so keys can be changed and cells removed in
+ * O(log n). Obstacle edits only record which cells flipped; replan()
+ * then updates the cells around each flip before resuming the search.
+ */
+
+#include "../include/GridReplanner.h"
+#include "../include/ClearanceMap.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+using namespace std;
+
+namespace {
+
+const double kInfinity = numeric_limits<double>::infinity();
+const double kSqrt2 = 1.41421356237309504880;
+const int kNeighbourCols[8] = {1, 1, 0, -1, -1, -1, 0, 1};
+const int kNeighbourRows[8] = {0, 1, 1, 1, 0, -1, -1, -1};
+
+/**
+ * @brief Lexicographic comparison of D* Lite keys (a1, a2) < (b1, b2)
+ */
+bool keyLess(double a1, double a2, double b1, double b2) {
+    return a1 < b1 || (a1 == b1 && a2 < b2);
+}
+
+} // namespace
+
+GridReplanner::GridReplanner(Vec2 origin, double resolution, int numCols, int numRows)
+    : gridOrigin(origin), cellSize(resolution), gridCols(numCols), gridRows(numRows) {
+    if (!(resolution > 0) || numCols <= 0 || numRows <= 0)
+        throw invalid_argument("GridReplanner: resolution and grid size must be positive");
+    size_t cells = static_cast<size_t>(numCols) * numRows;
+    blockCount.assign(cells, 0);
+    changedFlag.assign(cells, 0);
+    g.assign(cells, kInfinity);
+    rhs.assign(cells, kInfinity);
+    heapPos.assign(cells, -1);
+    heapKey.resize(cells);
+}
+
+GridReplanner GridReplanner::fromClearanceMap(const ClearanceMap& map, double inflation) {
+    GridReplanner planner(map.origin(), map.resolution(), map.cols(), map.rows());
+    for (int row = 0; row < map.rows(); ++row)
+        for (int col = 0; col < map.cols(); ++col)
+            if (map.isObstacle(col, row) || map.clearanceAt(col, row) < inflation)
+                planner.blockCount[planner.index(col, row)] = 1;
+    return planner;
+}
+
+int GridReplanner::cellOf(Vec2 p) const {
+    int col = static_cast<int>(floor((p.x - gridOrigin.x) / cellSize));
+    int row = static_cast<int>(floor((p.y - gridOrigin.y) / cellSize));
+    if (col < 0 || row < 0 || col >= gridCols || row >= gridRows)
+        throw out_of_range("GridReplanner: point outside the grid");
+    return index(col, row);
+}
+
+/**
+ * @brief Adds delta to every cell whose center lies in the inflated box
+ *
+ * Uses the same cell-center rule as ClearanceMap, including marking the
+ * containing cell for boxes too small to cover any cell center.
+ */
+void GridReplanner::markBox(const OrientedBox& box, double inflation, int delta) {
+    OrientedBox grown = {box.center, box.halfLength + inflation, box.halfWidth + inflation, box.heading};
+    Vec2 c[4];
+    boxCorners(grown, c);
+    double minX = c[0].x, maxX = c[0].x, minY = c[0].y, maxY = c[0].y;
+    for (int i = 1; i < 4; ++i) {
+        minX = min(minX, c[i].x);
+        maxX = max(maxX, c[i].x);
+        minY = min(minY, c[i].y);
+        maxY = max(maxY, c[i].y);
+    }
+    int col0 = max(0, static_cast<int>(floor((minX - gridOrigin.x) / cellSize)));
+    int row0 = max(0, static_cast<int>(floor((minY - gridOrigin.y) / cellSize)));
+    int col1 = min(gridCols - 1, static_cast<int>(floor((maxX - gridOrigin.x) / cellSize)));
+    int row1 = min(gridRows - 1, static_cast<int>(floor((maxY - gridOrigin.y) / cellSize)));
+
+    Vec2 axisU = {cos(grown.heading), sin(grown.heading)};
+    Vec2 axisV = {-axisU.y, axisU.x};
+    bool marked = false;
+    for (int row = row0; row <= row1; ++row) {
+        for (int col = col0; col <= col1; ++col) {
+            Vec2 d = Vec2{gridOrigin.x + (col + 0.5) * cellSize, gridOrigin.y + (row + 0.5) * cellSize} - grown.center;
+            if (fabs(dot(d, axisU)) <= grown.halfLength && fabs(dot(d, axisV)) <= grown.halfWidth) {
+                int cell = index(col, row);
+                setBlockCount(cell, blockCount[cell] + delta);
+                marked = true;
+            }
+        }
+    }
+    if (!marked) {
+        int col = static_cast<int>(floor((box.center.x - gridOrigin.x) / cellSize));
+        int row = static_cast<int>(floor((box.center.y - gridOrigin.y) / cellSize));
+        if (col >= 0 && row >= 0 && col < gridCols && row < gridRows)
+            setBlockCount(index(col, row), blockCount[index(col, row)] + delta);
+    }
+}
+
+void GridReplanner::setBlockCount(int cell, int count) {
+    if (count < 0) throw logic_error("GridReplanner: obstacle removed more often than added");
+    bool wasBlocked = blockCount[cell] != 0;
+    blockCount[cell] = static_cast<uint16_t>(count);
+    if (wasBlocked != (count != 0) && !changedFlag[cell]) {
+        changedFlag[cell] = 1;
+        changedCells.push_back(cell);
+    }
+}
+
+void GridReplanner::addObstacle(const OrientedBox& box, double inflation) {
+    markBox(box, inflation, 1);
+}
+
+void GridReplanner::removeObstacle(const OrientedBox& box, double inflation) {
+    markBox(box, inflation, -1);
+}
+
+void GridReplanner::setGoal(Vec2 point) {
+    goal = cellOf(point);
+    fill(g.begin(), g.end(), kInfinity);
+    fill(rhs.begin(), rhs.end(), kInfinity);
+    for (int cell : heap) heapPos[cell] = -1;
+    heap.clear();
+    for (int cell : changedCells) changedFlag[cell] = 0;
+    changedCells.clear();
+    km = 0.0;
+    lastStart = start;
+    rhs[goal] = 0.0;
+    if (start >= 0) heapPush(goal, calculateKey(goal));
+}
+
+void GridReplanner::setStart(Vec2 point) {
+    int cell = cellOf(point);
+    if (start < 0) {
+        start = cell;
+        lastStart = cell;
+        if (goal >= 0 && heap.empty() && g[goal] == kInfinity) heapPush(goal, calculateKey(goal));
+        return;
+    }
+    start = cell;
+    km += heuristic(lastStart, start);
+    lastStart = start;
+}
+
+double GridReplanner::heuristic(int a, int b) const {
+    double dx = abs(a % gridCols - b % gridCols);
+    double dy = abs(a / gridCols - b / gridCols);
+    return max(dx, dy) + (kSqrt2 - 1.0) * min(dx, dy);
+}
+
+/**
+ * @brief Cost of moving between two neighbouring cells, infinite if blocked
+ */
+double GridReplanner::cost(int from, int to) const {
+    if (blockCount[from] || blockCount[to]) return kInfinity;
+    int fromCol = from % gridCols, fromRow = from / gridCols;
+    int toCol = to % gridCols, toRow = to / gridCols;
+    if (fromCol == toCol || fromRow == toRow) return 1.0;
+    if (blockCount[index(toCol, fromRow)] || blockCount[index(fromCol, toRow)]) return kInfinity;
+    return kSqrt2;
+}
+
+GridReplanner::Key GridReplanner::calculateKey(int cell) const {
+    double m = min(g[cell], rhs[cell]);
+    return Key{m + heuristic(start, cell) + km, m};
+}
+
+/**
+ * @brief Recomputes rhs of a cell from its neighbours and fixes its heap membership
+ */
+void GridReplanner::updateVertex(int cell) {
+    if (cell != goal) {
+        int col = cell % gridCols, row = cell / gridCols;
+        double best = kInfinity;
+        for (int k = 0; k < 8; ++k) {
+            int c = col + kNeighbourCols[k], r = row + kNeighbourRows[k];
+            if (c < 0 || r < 0 || c >= gridCols || r >= gridRows) continue;
+            int next = index(c, r);
+            best = min(best, cost(cell, next) + g[next]);
+        }
+        rhs[cell] = best;
+    }
+    if (g[cell] != rhs[cell]) {
+        if (heapPos[cell] >= 0)
+            heapUpdate(cell, calculateKey(cell));
+        else
+            heapPush(cell, calculateKey(cell));
+    } else if (heapPos[cell] >= 0) {
+        heapRemove(cell);
+    }
+}
+
+void GridReplanner::computeShortestPath() {
+    while (!heap.empty()) {
+        int top = heap[0];
+        Key oldKey = heapKey[top];
+        Key startKey = calculateKey(start);
+        if (!keyLess(oldKey.primary, oldKey.secondary, startKey.primary, startKey.secondary) &&
+            rhs[start] == g[start])
+            break;
+
+        expansions++;
+        Key newKey = calculateKey(top);
+        if (keyLess(oldKey.primary, oldKey.secondary, newKey.primary, newKey.secondary)) {
+            heapUpdate(top, newKey);
+            continue;
+        }
+
+        int col = top % gridCols, row = top / gridCols;
+        if (g[top] > rhs[top]) {
+            g[top] = rhs[top];
+            heapRemove(top);
+        } else {
+            g[top] = kInfinity;
+            updateVertex(top);
+        }
+        for (int k = 0; k < 8; ++k) {
+            int c = col + kNeighbourCols[k], r = row + kNeighbourRows[k];
+            if (c >= 0 && r >= 0 && c < gridCols && r < gridRows) updateVertex(index(c, r));
+        }
+    }
+}
+
+bool GridReplanner::replan() {
+    if (start < 0 || goal < 0) throw logic_error("GridReplanner: start and goal must be set before replanning");
+    expansions = 0;
+    for (int cell : changedCells) {
+        changedFlag[cell] = 0;
+        int col = cell % gridCols, row = cell / gridCols;
+        for (int r = max(0, row - 1); r <= min(gridRows - 1, row + 1); ++r)
+            for (int c = max(0, col - 1); c <= min(gridCols - 1, col + 1); ++c) updateVertex(index(c, r));
+    }
+    changedCells.clear();
+    computeShortestPath();
+    return g[start] < kInfinity;
+}
+
+vector<Vec2> GridReplanner::path() const {
+    vector<Vec2> points;
+    if (start < 0 || goal < 0 || g[start] == kInfinity) return points;
+    int cell = start;
+    size_t limit = g.size();
+    while (true) {
+        points.push_back(Vec2{gridOrigin.x + (cell % gridCols + 0.5) * cellSize,
+                              gridOrigin.y + (cell / gridCols + 0.5) * cellSize});
+        if (cell == goal || points.size() > limit) break;
+        int col = cell % gridCols, row = cell / gridCols;
+        int next = -1;
+        double best = kInfinity;
+        for (int k = 0; k < 8; ++k) {
+            int c = col + kNeighbourCols[k], r = row + kNeighbourRows[k];
+            if (c < 0 || r < 0 || c >= gridCols || r >= gridRows) continue;
+            double through = cost(cell, index(c, r)) + g[index(c, r)];
+            if (through < best) {
+                best = through;
+                next = index(c, r);
+            }
+        }
+        if (next < 0) return vector<Vec2>();
+        cell = next;
+    }
+    return points;
+}
+
+double GridReplanner::pathLength() const {
+    if (start < 0 || goal < 0) return kInfinity;
+    return g[start] * cellSize;
+}
+
+void GridReplanner::heapPush(int cell, Key key) {
+    heapKey[cell] = key;
+    heapPos[cell] = static_cast<int>(heap.size());
+    heap.push_back(cell);
+    siftUp(heap.size() - 1);
+}
+
+void GridReplanner::heapRemove(int cell) {
+    size_t pos = static_cast<size_t>(heapPos[cell]);
+    heapSwap(pos, heap.size() - 1);
+    heap.pop_back();
+    heapPos[cell] = -1;
+    if (pos < heap.size()) {
+        siftUp(pos);
+        siftDown(pos);
+    }
+}
+
+void GridReplanner::heapUpdate(int cell, Key key) {
+    heapKey[cell] = key;
+    size_t pos = static_cast<size_t>(heapPos[cell]);
+    siftUp(pos);
+    siftDown(pos);
+}
+
+void GridReplanner::siftUp(size_t pos) {
+    while (pos > 0) {
+        size_t parent = (pos - 1) / 2;
+        const Key& a = heapKey[heap[pos]];
+        const Key& b = heapKey[heap[parent]];
+        if (!keyLess(a.primary, a.secondary, b.primary, b.secondary)) break;
+        heapSwap(pos, parent);
+        pos = parent;
+    }
+}
+
+void GridReplanner::siftDown(size_t pos) {
+    while (true) {
+        size_t smallest = pos;
+        for (size_t child = 2 * pos + 1; child <= 2 * pos + 2 && child < heap.size(); ++child) {
+            const Key& a = heapKey[heap[child]];
+            const Key& b = heapKey[heap[smallest]];
+            if (keyLess(a.primary, a.secondary, b.primary, b.secondary)) smallest = child;
+        }
+        if (smallest == pos) break;
+        heapSwap(pos, smallest);
+        pos = smallest;
+    }
+}
+
+void GridReplanner::heapSwap(size_t a, size_t b) {
+    swap(heap[a], heap[b]);
+    heapPos[heap[a]] = static_cast<int>(a);
+    heapPos[heap[b]] = static_cast<int>(b);
+}
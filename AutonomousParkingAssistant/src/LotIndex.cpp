@@ -0,0 +1,188 @@
+/**
+ * @file LotIndex.cpp
+ * @brief Implementation of the copy-on-write parking lot bay index
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ *
+ * This file implements the snapshot publication and epoch-based
+ * reclamation protocol declared in LotIndex.h.
+ *
+ * Protocol summary (all epoch and pointer operations are sequentially
+ * consistent):
+ * - Reader: announce E = globalEpoch in its slot, then load `current`.
+ * - Writer: store the new snapshot into `current`, then retire the old
+ *   one tagged with R = globalEpoch++.
+ * - A retired snapshot tagged R is freed once every slot is idle or
+ *   announces an epoch greater than R. Any reader that announced such an
+ *   epoch loaded `current` after the swap and therefore cannot hold it.
+ */
+
+#include "../include/LotIndex.h"
+#include "../include/BayChangeFeed.h"
+#include "../include/ParkingUtils.h"
+#include <stdexcept>
+#include <string>
+
+using namespace std;
+
+const size_t ParkingLotIndex::kMaxReaders;
+const uint64_t ParkingLotIndex::kIdle;
+
+const ParkingBay* LotSnapshot::findFreeBay(double required) const {
+    for (size_t i = 0; i < bays.size(); ++i) {
+        if (!bays[i].occupied && bays[i].size >= required)
+            return &bays[i];
+    }
+    return nullptr;
+}
+
+const ParkingBay* LotSnapshot::findFreeBay(bool parallel, double carLength, double carWidth) const {
+    return findFreeBay(requiredSpace(parallel, carLength, carWidth));
+}
+
+/**
+ * @brief Builds the index and publishes the initial snapshot (version 1)
+ * @param bays Initial bay list
+ * @throws std::invalid_argument on duplicate bay ids
+ */
+ParkingLotIndex::ParkingLotIndex(const vector<ParkingBay>& bays)
+    : current(nullptr), globalEpoch(1), changeFeed(nullptr) {
+    for (size_t i = 0; i < kMaxReaders; ++i) {
+        slots[i].epoch.store(kIdle);
+        slots[i].inUse.store(false);
+    }
+
+    LotSnapshot* initial = new LotSnapshot();
+    initial->version = 1;
+    initial->bays = bays;
+    initial->freeCount = 0;
+    for (size_t i = 0; i < bays.size(); ++i) {
+        if (!idToIndex.emplace(bays[i].id, i).second) {
+            delete initial;
+            throw invalid_argument("Duplicate bay id " + to_string(bays[i].id));
+        }
+        if (!bays[i].occupied) initial->freeCount++;
+    }
+    current.store(initial);
+}
+
+ParkingLotIndex::~ParkingLotIndex() {
+    delete current.load();
+    for (size_t i = 0; i < retired.size(); ++i)
+        delete retired[i].second;
+}
+
+bool ParkingLotIndex::setOccupied(int bayId, bool occupied) {
+    return applyUpdates(vector<BayUpdate>(1, BayUpdate{bayId, occupied})) > 0;
+}
+
+/**
+ * @brief Copies the current snapshot, applies the updates and publishes it
+ * @param updates Changes to apply
+ * @return Number of bays whose state changed
+ *
+ * Unknown bay ids and no-op updates are ignored. When nothing changes no
+ * new snapshot is published, so readers keep their cache-warm copy.
+ */
+size_t ParkingLotIndex::applyUpdates(const vector<BayUpdate>& updates) {
+    lock_guard<mutex> lock(writerMutex);
+
+    const LotSnapshot* old = current.load();
+    LotSnapshot* next = nullptr;
+    vector<BayUpdate> changedBays;
+
+    for (size_t i = 0; i < updates.size(); ++i) {
+        unordered_map<int, size_t>::const_iterator it = idToIndex.find(updates[i].bayId);
+        if (it == idToIndex.end()) continue;
+
+        const ParkingBay& bay = next ? next->bays[it->second] : old->bays[it->second];
+        if (bay.occupied == updates[i].occupied) continue;
+
+        // Copy lazily so no-op batches do not pay for a snapshot
+        if (!next) next = new LotSnapshot(*old);
+        next->bays[it->second].occupied = updates[i].occupied;
+        if (updates[i].occupied) next->freeCount--;
+        else next->freeCount++;
+        changedBays.push_back(updates[i]);
+    }
+
+    if (next) {
+        next->version = old->version + 1;
+        publishLocked(next);
+        // Announce changes only once the snapshot reflecting them is visible
+        if (changeFeed) {
+            for (size_t i = 0; i < changedBays.size(); ++i)
+                changeFeed->publish(changedBays[i].bayId, changedBays[i].occupied);
+        }
+    }
+    return changedBays.size();
+}
+
+void ParkingLotIndex::setChangeFeed(BayChangeFeed* feed) {
+    lock_guard<mutex> lock(writerMutex);
+    changeFeed = feed;
+}
+
+size_t ParkingLotIndex::pendingReclaim() const {
+    lock_guard<mutex> lock(writerMutex);
+    return retired.size();
+}
+
+/**
+ * @brief Swaps in a new snapshot and retires the previous one
+ * @param next Fully built snapshot; ownership passes to the index
+ */
+void ParkingLotIndex::publishLocked(LotSnapshot* next) {
+    const LotSnapshot* old = current.exchange(next);
+    uint64_t retireEpoch = globalEpoch.fetch_add(1);
+    retired.push_back(make_pair(retireEpoch, old));
+    reclaimLocked();
+}
+
+/**
+ * @brief Frees retired snapshots that no reader can still observe
+ *
+ * Scans the reader slots once (O(kMaxReaders)) to find the oldest
+ * announced epoch and frees everything retired before it.
+ */
+void ParkingLotIndex::reclaimLocked() {
+    uint64_t oldest = kIdle;
+    for (size_t i = 0; i < kMaxReaders; ++i) {
+        uint64_t e = slots[i].epoch.load();
+        if (e < oldest) oldest = e;
+    }
+
+    size_t kept = 0;
+    for (size_t i = 0; i < retired.size(); ++i) {
+        if (retired[i].first < oldest)
+            delete retired[i].second;
+        else
+            retired[kept++] = retired[i];
+    }
+    retired.resize(kept);
+}
+
+LotReader::LotReader(ParkingLotIndex& idx)
+    : index(idx), slot([&idx]() -> ParkingLotIndex::ReaderSlot& {
+          for (size_t i = 0; i < ParkingLotIndex::kMaxReaders; ++i) {
+              bool expected = false;
+              if (idx.slots[i].inUse.compare_exchange_strong(expected, true))
+                  return idx.slots[i];
+          }
+          throw runtime_error("ParkingLotIndex: too many concurrent readers");
+      }()) {}
+
+LotReader::~LotReader() {
+    slot.epoch.store(ParkingLotIndex::kIdle);
+    slot.inUse.store(false);
+}
+
+LotReadGuard::LotReadGuard(LotReader& r) : reader(r), pinned(nullptr) {
+    reader.slot.epoch.store(reader.index.globalEpoch.load());
+    pinned = reader.index.current.load();
+}
+
+LotReadGuard::~LotReadGuard() {
+    reader.slot.epoch.store(ParkingLotIndex::kIdle, memory_order_release);
+}
@@ -0,0 +1,324 @@
+/**
+ * @file MetricsRegistry.cpp
+ * @brief Implementation of the shared-memory metrics registry
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ *
+ * Memory layout (identical in process memory and shared memory, 64-byte
+ * aligned):
+ *
+ *   [Header][CounterSlot x kMaxCounters][HistogramSlot x kMaxHistograms]
+ *
+ * A metric's name is written before the header count that covers it is
+ * published with release semantics, so readers only see named slots.
+ */
+
+#include "../include/MetricsRegistry.h"
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <new>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define PARKING_HAVE_SHM 1
+#endif
+
+using namespace std;
+
+const size_t MetricsRegistry::kMaxCounters;
+const size_t MetricsRegistry::kMaxHistograms;
+const size_t MetricsRegistry::kMaxNameLength;
+const int MetricHistogram::kBuckets;
+
+namespace {
+
+const uint32_t kMetricsMagic = 0x4D455452;  // "METR"
+const uint32_t kMetricsLayoutVersion = 1;
+const size_t kCacheLine = 64;
+
+} // namespace
+
+/**
+ * @brief Registry metadata, one cache line
+ */
+struct MetricsRegistry::Header {
+    uint32_t magic;                        ///< kMetricsMagic once initialized
+    uint32_t layoutVersion;                ///< kMetricsLayoutVersion
+    uint32_t maxCounters;                  ///< kMaxCounters of the writer
+    uint32_t maxHistograms;                ///< kMaxHistograms of the writer
+    atomic<uint32_t> counterCount;         ///< Published counters
+    atomic<uint32_t> histogramCount;       ///< Published histograms
+    uint8_t reserved[40];                  ///< Pads the header to 64 bytes
+};
+
+/**
+ * @brief One counter and its name on a cache line of their own
+ */
+struct MetricsRegistry::CounterSlot {
+    atomic<uint64_t> value;
+    char name[kMaxNameLength + 1];
+};
+
+/**
+ * @brief One histogram: name line, then count, sum and buckets
+ */
+struct MetricsRegistry::HistogramSlot {
+    char name[kCacheLine];
+    atomic<uint64_t> cells[2 + MetricHistogram::kBuckets];   ///< count, sum, buckets
+    uint8_t padding[kCacheLine - (2 + MetricHistogram::kBuckets) * 8 % kCacheLine];
+};
+
+void MetricHistogram::record(uint64_t nanoseconds) const {
+    if (!cells) return;
+    cells[0].fetch_add(1, memory_order_relaxed);
+    cells[1].fetch_add(nanoseconds, memory_order_relaxed);
+    cells[2 + bucketOf(nanoseconds)].fetch_add(1, memory_order_relaxed);
+}
+
+int MetricHistogram::bucketOf(uint64_t nanoseconds) {
+    if (nanoseconds < 4) return static_cast<int>(nanoseconds);
+#if defined(__GNUC__) || defined(__clang__)
+    const int msb = 63 - __builtin_clzll(nanoseconds);
+#else
+    int msb = 63;
+    while (!(nanoseconds >> msb)) --msb;
+#endif
+    const int sub = static_cast<int>((nanoseconds >> (msb - 2)) & 3);
+    return min(4 * (msb - 1) + sub, kBuckets - 1);
+}
+
+uint64_t MetricHistogram::bucketUpperBound(int bucket) {
+    if (bucket < 4) return static_cast<uint64_t>(bucket);
+    const int msb = bucket / 4 + 1;
+    const uint64_t sub = static_cast<uint64_t>(bucket % 4);
+    return ((5 + sub) << (msb - 2)) - 1;
+}
+
+double HistogramSample::percentile(double q) const {
+    uint64_t total = 0;
+    for (uint64_t b : buckets) total += b;
+    if (total == 0) return 0.0;
+    const uint64_t rank = max<uint64_t>(1, static_cast<uint64_t>(ceil(min(max(q, 0.0), 1.0) * total)));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < buckets.size(); ++i) {
+        seen += buckets[i];
+        if (seen >= rank) return static_cast<double>(MetricHistogram::bucketUpperBound(static_cast<int>(i)));
+    }
+    return static_cast<double>(MetricHistogram::bucketUpperBound(MetricHistogram::kBuckets - 1));
+}
+
+void MetricsSnapshot::writePrometheus(ostream& out) const {
+    ios::fmtflags flags = out.flags();
+    streamsize precision = out.precision();
+    for (const CounterSample& c : counters) {
+        out << "# TYPE " << c.name << " counter\n";
+        out << c.name << " " << c.value << "\n";
+    }
+    out << setprecision(9);
+    for (const HistogramSample& h : histograms) {
+        out << "# TYPE " << h.name << " histogram\n";
+        int last = -1;
+        for (int i = 0; i < static_cast<int>(h.buckets.size()); ++i)
+            if (h.buckets[i] > 0) last = i;
+        uint64_t cumulative = 0;
+        for (int i = 0; i <= last; ++i) {
+            cumulative += h.buckets[i];
+            out << h.name << "_bucket{le=\"" << MetricHistogram::bucketUpperBound(i) * 1e-9 << "\"} " << cumulative
+                << "\n";
+        }
+        out << h.name << "_bucket{le=\"+Inf\"} " << cumulative << "\n";
+        out << h.name << "_sum " << h.sumNs * 1e-9 << "\n";
+        out << h.name << "_count " << cumulative << "\n";
+    }
+    out.flags(flags);
+    out.precision(precision);
+}
+
+size_t MetricsRegistry::regionSize() {
+    return sizeof(Header) + kMaxCounters * sizeof(CounterSlot) + kMaxHistograms * sizeof(HistogramSlot);
+}
+
+MetricsRegistry::MetricsRegistry() : header(nullptr), allocation(nullptr), shared(false), readOnly(false) {
+    static_assert(sizeof(Header) == kCacheLine, "The header must fill one cache line");
+    static_assert(sizeof(CounterSlot) == kCacheLine, "Counters must fill one cache line");
+    static_assert(sizeof(HistogramSlot) % kCacheLine == 0, "Histograms must fill whole cache lines");
+
+    // Heap blocks are only 16-byte aligned in C++14, so align the region by hand
+    const size_t bytes = regionSize();
+    allocation = ::operator new(bytes + kCacheLine);
+    uintptr_t aligned = (reinterpret_cast<uintptr_t>(allocation) + kCacheLine - 1) & ~(kCacheLine - 1);
+    memset(reinterpret_cast<void*>(aligned), 0, bytes);
+    header = new (reinterpret_cast<void*>(aligned)) Header();
+    header->magic = kMetricsMagic;
+    header->layoutVersion = kMetricsLayoutVersion;
+    header->maxCounters = kMaxCounters;
+    header->maxHistograms = kMaxHistograms;
+    header->counterCount.store(0);
+    header->histogramCount.store(0);
+}
+
+MetricsRegistry::MetricsRegistry(void* region, void* block, bool isShared, bool isReadOnly)
+    : header(static_cast<Header*>(region)), allocation(block), shared(isShared), readOnly(isReadOnly) {}
+
+MetricsRegistry::MetricsRegistry(MetricsRegistry&& other)
+    : header(other.header), allocation(other.allocation), shared(other.shared), readOnly(other.readOnly) {
+    other.header = nullptr;
+    other.allocation = nullptr;
+}
+
+MetricsRegistry::~MetricsRegistry() {
+    if (!header) return;
+#ifdef PARKING_HAVE_SHM
+    if (shared) {
+        munmap(header, regionSize());
+        return;
+    }
+#endif
+    ::operator delete(allocation);
+}
+
+MetricsRegistry MetricsRegistry::createShared(const string& name) {
+#ifdef PARKING_HAVE_SHM
+    const size_t bytes = regionSize();
+    shm_unlink(name.c_str());
+    int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0) throw runtime_error("MetricsRegistry: cannot create shared segment " + name);
+    if (ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+        close(fd);
+        shm_unlink(name.c_str());
+        throw runtime_error("MetricsRegistry: cannot size shared segment " + name);
+    }
+    void* region = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (region == MAP_FAILED) {
+        shm_unlink(name.c_str());
+        throw runtime_error("MetricsRegistry: cannot map shared segment " + name);
+    }
+
+    // ftruncate zero-fills the segment; the magic is written last so
+    // readers never see a half-built header
+    Header* h = new (region) Header();
+    h->layoutVersion = kMetricsLayoutVersion;
+    h->maxCounters = kMaxCounters;
+    h->maxHistograms = kMaxHistograms;
+    h->counterCount.store(0);
+    h->histogramCount.store(0);
+    if (!h->counterCount.is_lock_free() || !atomic<uint64_t>().is_lock_free()) {
+        munmap(region, bytes);
+        shm_unlink(name.c_str());
+        throw runtime_error("MetricsRegistry: atomics are not lock-free on this platform");
+    }
+    atomic_thread_fence(memory_order_release);
+    h->magic = kMetricsMagic;
+    return MetricsRegistry(region, nullptr, true, false);
+#else
+    (void)name;
+    throw runtime_error("MetricsRegistry: shared memory registries are not supported on this platform");
+#endif
+}
+
+MetricsRegistry MetricsRegistry::attachShared(const string& name) {
+#ifdef PARKING_HAVE_SHM
+    int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0) throw runtime_error("MetricsRegistry: no shared segment named " + name);
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) != regionSize()) {
+        close(fd);
+        throw runtime_error("MetricsRegistry: segment " + name + " is not a metrics registry");
+    }
+    void* region = mmap(nullptr, regionSize(), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (region == MAP_FAILED) throw runtime_error("MetricsRegistry: cannot map shared segment " + name);
+
+    const Header* h = static_cast<const Header*>(region);
+    if (h->magic != kMetricsMagic || h->layoutVersion != kMetricsLayoutVersion || h->maxCounters != kMaxCounters ||
+        h->maxHistograms != kMaxHistograms) {
+        munmap(region, regionSize());
+        throw runtime_error("MetricsRegistry: segment " + name + " is not a metrics registry");
+    }
+    return MetricsRegistry(region, nullptr, true, true);
+#else
+    (void)name;
+    throw runtime_error("MetricsRegistry: shared memory registries are not supported on this platform");
+#endif
+}
+
+void MetricsRegistry::unlinkShared(const string& name) {
+#ifdef PARKING_HAVE_SHM
+    shm_unlink(name.c_str());
+#else
+    (void)name;
+#endif
+}
+
+MetricsRegistry::CounterSlot* MetricsRegistry::counterSlots() const {
+    return reinterpret_cast<CounterSlot*>(reinterpret_cast<char*>(header) + sizeof(Header));
+}
+
+MetricsRegistry::HistogramSlot* MetricsRegistry::histogramSlots() const {
+    return reinterpret_cast<HistogramSlot*>(reinterpret_cast<char*>(counterSlots()) +
+                                            kMaxCounters * sizeof(CounterSlot));
+}
+
+void MetricsRegistry::validateName(const string& name) {
+    bool valid = !name.empty() && name.size() <= kMaxNameLength && !isdigit(static_cast<unsigned char>(name[0]));
+    for (char c : name) valid = valid && (isalnum(static_cast<unsigned char>(c)) || c == '_' || c == ':');
+    if (!valid)
+        throw invalid_argument("Metric names must match [a-zA-Z_:][a-zA-Z0-9_:]* and have at most 55 characters");
+}
+
+MetricCounter MetricsRegistry::counter(const string& name) {
+    validateName(name);
+    lock_guard<mutex> lock(registration);
+    if (readOnly) throw runtime_error("MetricsRegistry: cannot register metrics in a read-only mapping");
+    CounterSlot* slots = counterSlots();
+    const uint32_t count = header->counterCount.load(memory_order_relaxed);
+    for (uint32_t i = 0; i < count; ++i)
+        if (name == slots[i].name) return MetricCounter(&slots[i].value);
+    if (count == kMaxCounters) throw runtime_error("MetricsRegistry: no room for counter " + name);
+    memcpy(slots[count].name, name.c_str(), name.size() + 1);
+    header->counterCount.store(count + 1, memory_order_release);
+    return MetricCounter(&slots[count].value);
+}
+
+MetricHistogram MetricsRegistry::histogram(const string& name) {
+    validateName(name);
+    lock_guard<mutex> lock(registration);
+    if (readOnly) throw runtime_error("MetricsRegistry: cannot register metrics in a read-only mapping");
+    HistogramSlot* slots = histogramSlots();
+    const uint32_t count = header->histogramCount.load(memory_order_relaxed);
+    for (uint32_t i = 0; i < count; ++i)
+        if (name == slots[i].name) return MetricHistogram(slots[i].cells);
+    if (count == kMaxHistograms) throw runtime_error("MetricsRegistry: no room for histogram " + name);
+    memcpy(slots[count].name, name.c_str(), name.size() + 1);
+    header->histogramCount.store(count + 1, memory_order_release);
+    return MetricHistogram(slots[count].cells);
+}
+
+MetricsSnapshot MetricsRegistry::snapshot() const {
+    MetricsSnapshot result;
+    const uint32_t counters = min<uint32_t>(header->counterCount.load(memory_order_acquire), kMaxCounters);
+    const CounterSlot* cs = counterSlots();
+    for (uint32_t i = 0; i < counters; ++i)
+        result.counters.push_back(CounterSample{string(cs[i].name), cs[i].value.load(memory_order_relaxed)});
+
+    const uint32_t histograms = min<uint32_t>(header->histogramCount.load(memory_order_acquire), kMaxHistograms);
+    const HistogramSlot* hs = histogramSlots();
+    for (uint32_t i = 0; i < histograms; ++i) {
+        HistogramSample h;
+        h.name = hs[i].name;
+        h.count = hs[i].cells[0].load(memory_order_relaxed);
+        h.sumNs = hs[i].cells[1].load(memory_order_relaxed);
+        h.buckets.resize(MetricHistogram::kBuckets);
+        for (int b = 0; b < MetricHistogram::kBuckets; ++b) h.buckets[b] = hs[i].cells[2 + b].load(memory_order_relaxed);
+        result.histograms.push_back(h);
+    }
+    return result;
+}
@@ -11,12 +11,15 @@
  */
 
 #include "../include/ParkingUtils.h"
+#include "../include/Tracer.h"
 #include <iostream>
 #include <vector>
 #include <limits>
 #include <string>
 #include <stdexcept>
 #include <iomanip>
+#include <chrono>
+#include <memory>
 
 using namespace std;
 
@@ -127,6 +130,24 @@ string checkSafety(const SensorData& s) {
     return "SAFE";
 }
 
+namespace {
+
+/**
+ * @brief Plays the beeps of a proximity level
+ * @param level 0 (silent), 1 (single beep) or 2 (double beep)
+ */
+void playBeep(int level) {
+    // Check if any sensor is within proximity range
+    if (level > 0) {
+        cout << "🔊 BEEP! ";
+        // Additional urgent beep for very close objects
+        if (level > 1) cout << "BEEP! ";
+        cout << "\n";
+    }
+}
+
+} // namespace
+
 /**
  * @brief Provides intelligent audio feedback based on sensor proximity levels
  * @param s The SensorData structure containing distance readings
@@ -156,13 +177,76 @@ string checkSafety(const SensorData& s) {
  * beepAlert(sensors2); // Outputs: "🔊 BEEP! BEEP!"
  */
 void beepAlert(const SensorData& s) {
-    // Check if any sensor is within proximity range
-    if (s.center < 0.5 || s.left < 0.5 || s.right < 0.5) {
-        cout << "🔊 BEEP! ";
-        // Additional urgent beep for very close objects
-        if (s.center < 0.3 || s.left < 0.3 || s.right < 0.3) cout << "BEEP! ";
-        cout << "\n";
+    playBeep(beepLevel(s));
+}
+
+/**
+ * @brief Proximity beep level of a reading
+ * @param s The SensorData structure containing distance readings
+ * @return 0 (silent), 1 (any sensor < 0.5m) or 2 (any sensor < 0.3m)
+ */
+int beepLevel(const SensorData& s) {
+    if (s.center < 0.3 || s.left < 0.3 || s.right < 0.3) return 2;
+    if (s.center < 0.5 || s.left < 0.5 || s.right < 0.5) return 1;
+    return 0;
+}
+
+/**
+ * @brief Steering guidance based on side comparisons
+ * @param s The SensorData structure containing distance readings
+ * @param tolerance Side difference still treated as centered (meters)
+ * @return Direction that moves away from the closer side
+ */
+SteeringAdvice steeringAdvice(const SensorData& s, double tolerance) {
+    if (s.left < s.right - tolerance) return SteeringAdvice::SteerRight;
+    if (s.right < s.left - tolerance) return SteeringAdvice::SteerLeft;
+    return SteeringAdvice::KeepCentered;
+}
+
+/**
+ * @brief Decides one reading exactly as the parking loop does
+ * @param s The SensorData structure containing distance readings
+ * @param reverseMode Whether the vehicle is in reverse mode (true) or forward mode (false)
+ * @param classifier Status classifier of a change-only session, or null for checkSafety()
+ * @return Beep level, status, steering advice and summary zone of the reading
+ *
+ * The parking loop only prints and records what this returns, so the
+ * differential runner (decideFrame()) replays the same decisions.
+ */
+FrameDecision decideParkingFrame(const SensorData& s, bool reverseMode, StatusClassifier* classifier) {
+    FrameDecision decision;
+    decision.beep = beepLevel(s);
+
+    // Check for opposite movement condition (all sensors too close); the
+    // reading is neither classified nor checked for a collision, so it
+    // counts as a too-close frame
+    if (s.left < 0.3 && s.center < 0.3 && s.right < 0.3) {
+        decision.oppositeMovement = true;
+        decision.status = reverseMode ? "Opposite Movement: REVERSE mode sensors close → Move FORWARD"
+                                      : "Opposite Movement: FORWARD mode sensors close → Move BACKWARD";
+        decision.zone = ParkingStatus::TooClose;
+        return decision;
+    }
+
+    // Analyze safety; change-only sessions report a status only when it changes
+    if (classifier) {
+        StatusEvent event;
+        if (classifier->update(s, &event)) decision.status = event.label;
+        decision.zone = classifier->current();
+    } else {
+        try {
+            decision.status = checkSafety(s);
+        } catch (const UnsafeParkingException& e) {
+            decision.status = e.what();
+        }
+        decision.zone = plainStatus(s);
     }
+
+    // Steering guidance; change-only sessions treat sides within the
+    // hysteresis band as equal
+    if (decision.zone != ParkingStatus::Collision)
+        decision.steering = steeringAdvice(s, classifier ? classifier->config().hysteresis : 0.0);
+    return decision;
 }
 
 /**
@@ -195,6 +279,66 @@ double requiredSpace(bool parallel, double carLength, double carWidth) {
     return parallel ? carLength + 1.0 : carWidth + 0.5;
 }
 
+/**
+ * @brief Calculates parking space requirements from a kinematic vehicle model
+ * @param parallel Whether the parking is parallel (true) or perpendicular (false)
+ * @param vehicle Kinematic vehicle model
+ * @param moves Number of moves allowed for parallel parking
+ * @return The minimum required parking space in meters
+ *
+ * Parallel parking delegates to minParallelSlotLength(); perpendicular
+ * parking keeps the width + 0.5m rule since bay depth, not manoeuvring
+ * length, is the limiting dimension there.
+ */
+double requiredSpace(bool parallel, const VehicleModel& vehicle, int moves) {
+    if (parallel) return minParallelSlotLength(vehicle, moves);
+    rearAxleTurningRadius(vehicle);  // validates the model
+    return vehicle.width + 0.5;
+}
+
+namespace {
+
+/**
+ * @brief Prompts for the available spaces and checks them against a requirement
+ * @param required Minimum space needed by the vehicle in meters
+ * @return true if a space of at least required meters was entered
+ */
+bool scanParkingSpaces(double required) {
+    int numSpaces;
+    cout << "\nEnter number of parking spaces to scan: ";
+    
+    // Validate number of spaces input
+    while (!(cin >> numSpaces)) {
+        cout << "❌ Enter a valid integer.\n";
+        cin.clear();
+        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+    }
+
+    // Handle edge cases
+    if (numSpaces == 0) {
+        cout << "🚫 Parking space not available. Please wait for some time.\n";
+        return false; // Exit program gracefully
+    }
+    if (numSpaces < 0) {
+        cout << "❌ Number of spaces cannot be negative.\n";
+        return false;
+    }
+
+    // Check each available space against the required size
+    for (int i = 1; i <= numSpaces; i++) {
+        double space = getDoubleInput("Enter size of space " + to_string(i) + " (m): ");
+        if (space >= required) {
+            cout << "✅ Space found! (" << space << " m) is enough for your car.\n";
+            return true;
+        } else {
+            cout << "❌ Space too small (" << space << " m), skipping...\n";
+        }
+    }
+    return false;
+}
+
+} // namespace
+
 /**
  * @brief Scans available parking spaces and identifies suitable options with detailed feedback
  * @param parallel Whether the parking is parallel (true) or perpendicular (false)
@@ -227,40 +371,247 @@ double requiredSpace(bool parallel, double carLength, double carWidth) {
  * // Returns true if space >= 5.5m is found
  */
 bool findParkingSpace(bool parallel, double carLength, double carWidth) {
-    int numSpaces;
-    cout << "\nEnter number of parking spaces to scan: ";
-    
-    // Validate number of spaces input
-    while (!(cin >> numSpaces)) {
-        cout << "❌ Enter a valid integer.\n";
-        cin.clear();
-        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+    PARKING_TRACE_SCOPE("findParkingSpace");
+    return scanParkingSpaces(requiredSpace(parallel, carLength, carWidth));
+}
+
+/**
+ * @brief Scans available parking spaces for a modelled vehicle
+ * @param parallel Whether the parking is parallel (true) or perpendicular (false)
+ * @param vehicle Kinematic vehicle model, e.g. from the vehicle catalogue
+ * @return true if a suitable space is found, false otherwise
+ *
+ * Same interaction as the dimension-based overload, but the required
+ * space comes from requiredSpace(parallel, vehicle).
+ */
+bool findParkingSpace(bool parallel, const VehicleModel& vehicle) {
+    PARKING_TRACE_SCOPE("findParkingSpace");
+    return scanParkingSpaces(requiredSpace(parallel, vehicle));
+}
+
+/**
+ * @brief Registers the session metrics in a registry
+ * @param registry Registry to find or create the metrics in
+ */
+SessionMetrics::SessionMetrics(MetricsRegistry& registry)
+    : frames(registry.counter("parking_frames_total")),
+      frameLatency(registry.histogram("parking_frame_latency_seconds")),
+      deadlineOverruns(registry.counter("parking_deadline_overruns_total")),
+      watchdogStops(registry.counter("parking_watchdog_stops_total")),
+      collisions(registry.counter("parking_collisions_total")) {
+    statuses[static_cast<int>(ParkingStatus::Unknown)] = registry.counter("parking_status_unknown_total");
+    statuses[static_cast<int>(ParkingStatus::Safe)] = registry.counter("parking_status_safe_total");
+    statuses[static_cast<int>(ParkingStatus::TooClose)] = registry.counter("parking_status_too_close_total");
+    statuses[static_cast<int>(ParkingStatus::PerfectlyParked)] =
+        registry.counter("parking_status_perfectly_parked_total");
+    statuses[static_cast<int>(ParkingStatus::Collision)] = registry.counter("parking_status_collision_total");
+}
+
+namespace {
+
+/**
+ * @brief Times and traces one loop frame until the end of the loop iteration
+ *
+ * Without a watchdog the frame is still timed for the metrics, and the
+ * frame and its stages are still recorded as trace spans.
+ */
+class FrameTimer {
+public:
+    FrameTimer(DeadlineWatchdog* watchdog, const SessionMetrics& metrics, LoopStage first)
+        : watchdog(watchdog), metrics(metrics), started(chrono::steady_clock::now()), current(first) {
+        if (watchdog) watchdog->beginFrame(first);
+        PARKING_TRACE_BEGIN("frame");
+        PARKING_TRACE_BEGIN(stageName(first));
     }
 
-    // Handle edge cases
-    if (numSpaces == 0) {
-        cout << "🚫 Parking space not available. Please wait for some time.\n";
-        return false; // Exit program gracefully
+    void stage(LoopStage next) {
+        PARKING_TRACE_END(stageName(current));
+        PARKING_TRACE_BEGIN(stageName(next));
+        current = next;
+        if (watchdog) watchdog->stage(next);
     }
-    if (numSpaces < 0) {
-        cout << "❌ Number of spaces cannot be negative.\n";
-        return false;
+
+    ~FrameTimer() {
+        PARKING_TRACE_END(stageName(current));
+        PARKING_TRACE_END("frame");
+        metrics.frames.add();
+        if (!watchdog) {
+            const chrono::nanoseconds elapsed = chrono::steady_clock::now() - started;
+            metrics.frameLatency.record(static_cast<uint64_t>(elapsed.count()));
+            return;
+        }
+        const bool overrun = watchdog->endFrame();
+        metrics.frameLatency.record(static_cast<uint64_t>(watchdog->lastFrameNs()));
+        if (overrun) metrics.deadlineOverruns.add();
+        if (watchdog->stalled()) metrics.watchdogStops.add();
     }
 
-    // Calculate required space and check each available space
-    double required = requiredSpace(parallel, carLength, carWidth);
-    for (int i = 1; i <= numSpaces; i++) {
-        double space = getDoubleInput("Enter size of space " + to_string(i) + " (m): ");
-        if (space >= required) {
-            cout << "✅ Space found! (" << space << " m) is enough for your car.\n";
-            return true;
-        } else {
-            cout << "❌ Space too small (" << space << " m), skipping...\n";
+private:
+    DeadlineWatchdog* watchdog;
+    const SessionMetrics& metrics;
+    chrono::steady_clock::time_point started;
+    LoopStage current;
+};
+
+/**
+ * @brief Runs one parking session
+ * @param classifier Status classifier reporting changes only, or null to
+ *        classify every reading with checkSafety() and report it
+ * @param report Whether to keep the step history for the summary table
+ * @param watchdogConfig Per-frame deadline and stall limit, or null for
+ *        no watchdog
+ * @param metrics Live metrics updated after every reading
+ */
+void runParkingSession(bool reverseMode, bool parallel, StatusClassifier* classifier, SessionReport report,
+                       const WatchdogConfig* watchdogConfig, const SessionMetrics& metrics) {
+    PARKING_TRACE_SCOPE("parking session");
+
+    // Time the processing of each reading if a deadline was requested; a
+    // stalled frame forces a STOP
+    unique_ptr<DeadlineWatchdog> watchdog;
+    if (watchdogConfig)
+        watchdog.reset(new DeadlineWatchdog(*watchdogConfig, [](LoopStage stage, double seconds) {
+            cout << "🛑 WATCHDOG: " << stageName(stage) << " stage stalled for " << seconds * 1e3
+                 << " ms → STOP VEHICLE!\n";
+        }));
+
+    // Initialize history tracking vectors; summary-only sessions leave them empty
+    vector<SensorData> history;
+    vector<string> statusHistory;
+    vector<int> stepHistory;
+    string lastAdvice;
+    const bool keepHistory = report == SessionReport::FullHistory;
+    auto record = [&](const SensorData& s, const string& status, int step) {
+        if (!keepHistory) return;
+        history.push_back(s);
+        statusHistory.push_back(status);
+        stepHistory.push_back(step);
+    };
+
+    // Streaming aggregates are kept in both modes, in constant memory
+    SessionSummary summary;
+    const chrono::steady_clock::time_point started = chrono::steady_clock::now();
+    auto elapsed = [&started]() {
+        return chrono::duration<double>(chrono::steady_clock::now() - started).count();
+    };
+    auto addToSummary = [&](const SensorData& s, ParkingStatus status) {
+        summary.add(s, status, elapsed());
+        metrics.statuses[static_cast<int>(status)].add();
+    };
+
+    // Display parking rules and guidelines
+    cout << "\n=== Parking Process Started ===\n";
+    cout << "Rules:\n";
+    cout << "  • Collision <= 0.10 m (STOP immediately)\n";
+    cout << "  • Danger    <= 0.50 m (adjust carefully)\n";
+    cout << "  • Perfect park when all distances are 0.3 - 0.5 m\n";
+
+    int step = 0;
+    bool collisionOccurred = false; // Flag to track collision events
+
+    // Main parking loop
+    while (!(watchdog && watchdog->stalled())) {
+        // Collect sensor data from user
+        PARKING_TRACE_BEGIN("input");
+        SensorData s;
+        s.left   = getDoubleInput("Enter LEFT sensor distance (m): ");
+        s.center = getDoubleInput(reverseMode ? "Enter REAR sensor distance (m): " : "Enter FRONT sensor distance (m): ");
+        s.right  = getDoubleInput("Enter RIGHT sensor distance (m): ");
+        PARKING_TRACE_END("input");
+
+        step++;
+        FrameTimer frame(watchdog.get(), metrics, LoopStage::Classify);
+        const FrameDecision decision = decideParkingFrame(s, reverseMode, classifier);
+        frame.stage(LoopStage::Alert);
+        playBeep(decision.beep); // Provide audio feedback
+
+        // All sensors too close: ask for the opposite movement
+        if (decision.oppositeMovement) {
+            cout << "⚠️ " << decision.status << " and re-enter data.\n";
+            frame.stage(LoopStage::Record);
+            record(s, decision.status, step);
+            addToSummary(s, decision.zone);
+            lastAdvice.clear();
+            continue; // Skip to next iteration for new data
+        }
+
+        // Handle collision emergency
+        if (decision.zone == ParkingStatus::Collision) {
+            cout << decision.status << "\n";
+            frame.stage(LoopStage::Record);
+            record(s, "COLLISION!", step);
+            addToSummary(s, ParkingStatus::Collision);
+            metrics.collisions.add();
+            collisionOccurred = true;
+            break; // Stop the loop immediately on collision
+        }
+
+        frame.stage(LoopStage::Record);
+        addToSummary(s, decision.zone);
+
+        // Change-only sessions report no status for a frame without news
+        const bool changed = !decision.status.empty();
+        if (changed) {
+            cout << "Status: " << decision.status << "\n";
+            record(s, decision.status, step);
+
+            // Check for perfect parking completion
+            if (decision.zone == ParkingStatus::PerfectlyParked)
+                break;
         }
+
+        // Provide steering guidance based on side comparisons
+        frame.stage(LoopStage::Guidance);
+        string advice;
+        switch (decision.steering) {
+        case SteeringAdvice::SteerRight: advice = "Left side closer → Steer RIGHT.\n"; break;
+        case SteeringAdvice::SteerLeft:  advice = "Right side closer → Steer LEFT.\n"; break;
+        default:                         advice = "Both sides equal → Keep centered.\n"; break;
+        }
+
+        // Provide movement guidance based on mode
+        if (reverseMode) advice += "Move BACKWARD.\n";
+        else advice += "Move FORWARD.\n";
+
+        // Repeat guidance only when it changes; change-only sessions
+        // print nothing at all for a frame without news
+        if (advice != lastAdvice) {
+            cout << advice;
+            lastAdvice = advice;
+        } else if (!changed) {
+            continue;
+        }
+
+        cout << "----------------------------------------\n";
     }
-    return false;
+
+    // Generate comprehensive parking summary
+    if (keepHistory) {
+        cout << "\n📊 Parking Summary:\n";
+        cout << left << setw(8) << "Step" << setw(10) << "Left(m)" << setw(10) << "Center(m)" << setw(10) << "Right(m)" << "Status\n";
+        cout << "-------------------------------------------------------------\n";
+        for (size_t i = 0; i < history.size(); i++) {
+            cout << left << setw(8) << stepHistory[i]
+                 << setw(10) << history[i].left
+                 << setw(10) << history[i].center
+                 << setw(10) << history[i].right
+                 << statusHistory[i] << "\n";
+        }
+    }
+    summary.print(cout, reverseMode ? "REAR" : "FRONT");
+    if (watchdog) watchdog->stats().print(cout, *watchdogConfig);
+
+    // Provide final status message
+    if (collisionOccurred)
+        cout << "\n⚠️ Parking simulation ended due to collision.\n";
+    else if (watchdog && watchdog->stalled())
+        cout << "\n⚠️ Parking simulation stopped by the watchdog.\n";
+    else
+        cout << "\n🏁 Parking simulation completed successfully.\n";
 }
 
+} // namespace
+
 /**
  * @brief Main parking assistant loop implementing comprehensive parking guidance system
  * @param reverseMode Whether the vehicle is in reverse mode (true) or forward mode (false)
@@ -288,7 +639,7 @@ bool findParkingSpace(bool parallel, double carLength, double carWidth) {
  * Guidance Systems:
  * - Context-aware sensor labels (FRONT/REAR based on mode)
  * - Intelligent steering suggestions based on side comparisons
- * - Mode-appropriate movement instructions
+ * - Mode-appropriate movement instructions, repeated only when they change
  * - Real-time status updates
  * 
  * Data Management:
@@ -309,93 +660,55 @@ bool findParkingSpace(bool parallel, double carLength, double carWidth) {
  * // Guides user through perpendicular parking in reverse mode
  */
 void parkingAssistantLoop(bool reverseMode, bool parallel) {
-    // Initialize history tracking vectors
-    vector<SensorData> history;
-    vector<string> statusHistory;
-
-    // Display parking rules and guidelines
-    cout << "\n=== Parking Process Started ===\n";
-    cout << "Rules:\n";
-    cout << "  • Collision <= 0.10 m (STOP immediately)\n";
-    cout << "  • Danger    <= 0.50 m (adjust carefully)\n";
-    cout << "  • Perfect park when all distances are 0.3 - 0.5 m\n";
-
-    int step = 0;
-    bool collisionOccurred = false; // Flag to track collision events
-
-    // Main parking loop
-    while (true) {
-        // Collect sensor data from user
-        SensorData s;
-        s.left   = getDoubleInput("Enter LEFT sensor distance (m): ");
-        s.center = getDoubleInput(reverseMode ? "Enter REAR sensor distance (m): " : "Enter FRONT sensor distance (m): ");
-        s.right  = getDoubleInput("Enter RIGHT sensor distance (m): ");
-
-        step++;
-        beepAlert(s); // Provide audio feedback
-
-        // Check for opposite movement condition (all sensors too close)
-        if (s.left < 0.3 && s.center < 0.3 && s.right < 0.3) {
-            string msg;
-            if (!reverseMode) {
-                msg = "Opposite Movement: FORWARD mode sensors close → Move BACKWARD";
-                cout << "⚠️ " << msg << " and re-enter data.\n";
-            } else {
-                msg = "Opposite Movement: REVERSE mode sensors close → Move FORWARD";
-                cout << "⚠️ " << msg << " and re-enter data.\n";
-            }
-            history.push_back(s);
-            statusHistory.push_back(msg);
-            continue; // Skip to next iteration for new data
-        }
-
-        // Analyze safety and provide guidance
-        try {
-            string status = checkSafety(s);
-            cout << "Status: " << status << "\n";
-            history.push_back(s);
-            statusHistory.push_back(status);
-
-            // Check for perfect parking completion
-            if (status.find("Perfectly Parked") != string::npos)
-                break;
-
-            // Provide steering guidance based on side comparisons
-            if (s.left < s.right) cout << "Left side closer → Steer RIGHT.\n";
-            else if (s.right < s.left) cout << "Right side closer → Steer LEFT.\n";
-            else cout << "Both sides equal → Keep centered.\n";
-
-            // Provide movement guidance based on mode
-            if (reverseMode) cout << "Move BACKWARD.\n";
-            else cout << "Move FORWARD.\n";
+    runParkingSession(reverseMode, parallel, nullptr, SessionReport::FullHistory, nullptr, SessionMetrics());
+}
 
-        } catch (const UnsafeParkingException& e) {
-            // Handle collision emergency
-            cout << e.what() << "\n";
-            history.push_back(s);
-            statusHistory.push_back("COLLISION!");
-            collisionOccurred = true;
-            break; // Stop the loop immediately on collision
-        }
+/**
+ * @brief Parking assistant loop with a choice of summary
+ * @param reverseMode Whether the vehicle is in reverse mode (true) or forward mode (false)
+ * @param parallel Whether the parking is parallel (true) or perpendicular (false)
+ * @param report FullHistory for the step table, SummaryOnly for constant memory
+ */
+void parkingAssistantLoop(bool reverseMode, bool parallel, SessionReport report) {
+    runParkingSession(reverseMode, parallel, nullptr, report, nullptr, SessionMetrics());
+}
 
-        cout << "----------------------------------------\n";
-    }
+/**
+ * @brief Parking assistant loop that publishes live metrics
+ * @param reverseMode Whether the vehicle is in reverse mode (true) or forward mode (false)
+ * @param parallel Whether the parking is parallel (true) or perpendicular (false)
+ * @param report FullHistory for the step table, SummaryOnly for constant memory
+ * @param metrics Live metrics updated after every reading
+ */
+void parkingAssistantLoop(bool reverseMode, bool parallel, SessionReport report, const SessionMetrics& metrics) {
+    runParkingSession(reverseMode, parallel, nullptr, report, nullptr, metrics);
+}
 
-    // Generate comprehensive parking summary
-    cout << "\n📊 Parking Summary:\n";
-    cout << left << setw(8) << "Step" << setw(10) << "Left(m)" << setw(10) << "Center(m)" << setw(10) << "Right(m)" << "Status\n";
-    cout << "-------------------------------------------------------------\n";
-    for (size_t i = 0; i < history.size(); i++) {
-        cout << left << setw(8) << i+1
-             << setw(10) << history[i].left
-             << setw(10) << history[i].center
-             << setw(10) << history[i].right
-             << statusHistory[i] << "\n";
-    }
+/**
+ * @brief Parking assistant loop with a custom frame deadline
+ * @param reverseMode Whether the vehicle is in reverse mode (true) or forward mode (false)
+ * @param parallel Whether the parking is parallel (true) or perpendicular (false)
+ * @param report FullHistory for the step table, SummaryOnly for constant memory
+ * @param watchdogConfig Per-frame deadline and stall limit
+ * @param metrics Live metrics updated after every reading
+ */
+void parkingAssistantLoop(bool reverseMode, bool parallel, SessionReport report, const WatchdogConfig& watchdogConfig,
+                          const SessionMetrics& metrics) {
+    runParkingSession(reverseMode, parallel, nullptr, report, &watchdogConfig, metrics);
+}
 
-    // Provide final status message
-    if (collisionOccurred)
-        cout << "\n⚠️ Parking simulation ended due to collision.\n";
-    else
-        cout << "\n🏁 Parking simulation completed successfully.\n";
+/**
+ * @brief Parking assistant loop that reports status changes only
+ * @param reverseMode Whether the vehicle is in reverse mode (true) or forward mode (false)
+ * @param parallel Whether the parking is parallel (true) or perpendicular (false)
+ * @param statusConfig Hysteresis and dwell time of the status classifier
+ * @param report Whether to keep the step history or streaming aggregates only
+ *
+ * The classifier is built before the session starts, so an invalid
+ * configuration is rejected without reading any input.
+ */
+void parkingAssistantLoop(bool reverseMode, bool parallel, const StatusClassifierConfig& statusConfig,
+                          SessionReport report) {
+    StatusClassifier classifier(statusConfig);
+    runParkingSession(reverseMode, parallel, &classifier, report, nullptr, SessionMetrics());
 }
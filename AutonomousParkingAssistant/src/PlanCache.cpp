@@ -0,0 +1,181 @@
+/**
+ * @file PlanCache.cpp
+ * @brief Implementation of the LRU parking trajectory cache
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ *
+ * Entries live in a list ordered from most to least recently used, with a
+ * hash index from key to list position, so lookups, promotions, inserts
+ * and evictions are all O(1). Memory is accounted per entry from the
+ * trajectory size plus fixed node overheads.
+ */
+
+#include "../include/PlanCache.h"
+#include <cmath>
+#include <stdexcept>
+
+using namespace std;
+
+const double PlanCache::kDefaultPositionStep = 0.1;
+const double PlanCache::kDefaultHeadingStep = 0.0175;  // ~1 degree
+const double PlanCache::kDefaultSizeStep = 0.05;
+
+namespace {
+
+const double kPi = 3.14159265358979323846;
+
+/**
+ * @brief Bytes charged per entry beyond its trajectory
+ *
+ * Covers the list node (links, key, vector header, size), the index node
+ * (link, key copy, iterator, cached hash) and both copies of the class string.
+ */
+size_t entryOverhead(const PlanKey& key) {
+    return 2 * sizeof(PlanKey) + sizeof(vector<Pose2D>) + 6 * sizeof(void*) + 2 * key.vehicleClass.capacity();
+}
+
+double wrapAngle(double a) {
+    a = fmod(a + kPi, 2.0 * kPi);
+    if (a < 0) a += 2.0 * kPi;
+    return a - kPi;
+}
+
+int32_t quantize(double value, double step) {
+    return static_cast<int32_t>(lround(value / step));
+}
+
+/**
+ * @brief Expresses a world pose in a bay's frame
+ */
+Pose2D toBayFrame(const OrientedBox& bay, const Pose2D& p) {
+    Vec2 local = rotate(Vec2{p.x, p.y} - bay.center, -bay.heading);
+    return Pose2D{local.x, local.y, wrapAngle(p.heading - bay.heading)};
+}
+
+/**
+ * @brief Expresses bay-frame poses in world coordinates
+ */
+void fromBayFrame(const OrientedBox& bay, const vector<Pose2D>& local, vector<Pose2D>& world) {
+    const double c = cos(bay.heading), s = sin(bay.heading);
+    world.resize(local.size());
+    for (size_t i = 0; i < local.size(); ++i) {
+        const Pose2D& p = local[i];
+        world[i] = Pose2D{bay.center.x + c * p.x - s * p.y, bay.center.y + s * p.x + c * p.y,
+                          wrapAngle(p.heading + bay.heading)};
+    }
+}
+
+} // namespace
+
+size_t PlanKeyHash::operator()(const PlanKey& key) const {
+    size_t h = hash<string>()(key.vehicleClass);
+    const int32_t fields[] = {key.bayLength, key.bayWidth, key.startX, key.startY, key.startHeading};
+    for (int32_t f : fields) h = (h ^ static_cast<uint32_t>(f)) * 1099511628211ull;
+    return h;
+}
+
+PlanCache::PlanCache(size_t budget, double position, double heading, double size)
+    : maxBytes(budget), positionStep(position), headingStep(heading), sizeStep(size) {
+    if (!(position > 0) || !(heading > 0) || !(size > 0))
+        throw invalid_argument("PlanCache: quantization steps must be positive");
+}
+
+PlanKey PlanCache::makeKey(const OrientedBox& bay, const string& vehicleClass, const Pose2D& start) const {
+    Pose2D local = toBayFrame(bay, start);
+    PlanKey key;
+    key.bayLength = quantize(2.0 * bay.halfLength, sizeStep);
+    key.bayWidth = quantize(2.0 * bay.halfWidth, sizeStep);
+    key.startX = quantize(local.x, positionStep);
+    key.startY = quantize(local.y, positionStep);
+    key.startHeading = quantize(local.heading, headingStep);
+    key.vehicleClass = vehicleClass;
+    return key;
+}
+
+bool PlanCache::lookup(const OrientedBox& bay, const string& vehicleClass, const Pose2D& start,
+                       vector<Pose2D>& out) {
+    PlanKey key = makeKey(bay, vehicleClass, start);
+    lock_guard<mutex> lock(cacheMutex);
+    auto it = index.find(key);
+    if (it == index.end()) {
+        counters.misses++;
+        return false;
+    }
+    counters.hits++;
+    entries.splice(entries.begin(), entries, it->second);
+
+    fromBayFrame(bay, it->second->trajectory, out);
+    return true;
+}
+
+void PlanCache::insert(const OrientedBox& bay, const string& vehicleClass, const Pose2D& start,
+                       const vector<Pose2D>& trajectory) {
+    Entry entry;
+    entry.key = makeKey(bay, vehicleClass, start);
+    entry.trajectory.reserve(trajectory.size());
+    for (const Pose2D& p : trajectory) entry.trajectory.push_back(toBayFrame(bay, p));
+    entry.bytes = entry.trajectory.capacity() * sizeof(Pose2D) + entryOverhead(entry.key);
+    if (entry.bytes > maxBytes) return;
+
+    lock_guard<mutex> lock(cacheMutex);
+    auto it = index.find(entry.key);
+    if (it != index.end()) {
+        bytes -= it->second->bytes;
+        entries.erase(it->second);
+        index.erase(it);
+    }
+    bytes += entry.bytes;
+    entries.push_front(move(entry));
+    index[entries.front().key] = entries.begin();
+    counters.insertions++;
+    evictLocked();
+}
+
+vector<Pose2D> PlanCache::getOrPlan(const OrientedBox& bay, const string& vehicleClass, const Pose2D& start,
+                                    const Planner& planner) {
+    chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+    vector<Pose2D> path;
+    if (lookup(bay, vehicleClass, start, path)) {
+        chrono::nanoseconds elapsed = chrono::steady_clock::now() - begin;
+        lock_guard<mutex> lock(cacheMutex);
+        hitTime += elapsed;
+        timedHits++;
+        return path;
+    }
+
+    path = planner();
+    if (!path.empty()) insert(bay, vehicleClass, start, path);
+    chrono::nanoseconds elapsed = chrono::steady_clock::now() - begin;
+    lock_guard<mutex> lock(cacheMutex);
+    missTime += elapsed;
+    timedMisses++;
+    return path;
+}
+
+void PlanCache::evictLocked() {
+    while (bytes > maxBytes && !entries.empty()) {
+        Entry& victim = entries.back();
+        bytes -= victim.bytes;
+        index.erase(victim.key);
+        entries.pop_back();
+        counters.evictions++;
+    }
+}
+
+PlanCacheStats PlanCache::stats() const {
+    lock_guard<mutex> lock(cacheMutex);
+    PlanCacheStats s = counters;
+    s.entries = entries.size();
+    s.bytes = bytes;
+    s.meanHitLatencyUs = timedHits ? chrono::duration<double, micro>(hitTime).count() / timedHits : 0.0;
+    s.meanMissLatencyUs = timedMisses ? chrono::duration<double, micro>(missTime).count() / timedMisses : 0.0;
+    return s;
+}
+
+void PlanCache::clear() {
+    lock_guard<mutex> lock(cacheMutex);
+    entries.clear();
+    index.clear();
+    bytes = 0;
+}
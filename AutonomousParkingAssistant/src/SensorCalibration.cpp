@@ -0,0 +1,148 @@
+/**
+ * @file SensorCalibration.cpp
+ * @brief Implementation of sensor calibration and the per-vehicle table
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ */
+
+#include "../include/SensorCalibration.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PARKING_CALIBRATION_SSE2 1
+#endif
+
+using namespace std;
+
+static_assert(sizeof(SensorData) == 3 * sizeof(double), "SensorData must be three packed doubles");
+
+namespace {
+
+const char kMagic[4] = {'P', 'C', 'A', 'L'};
+const uint32_t kFormatVersion = 1;
+
+/**
+ * @brief Affine coefficients a, b of the three sensors at a temperature
+ */
+void coefficients(const SensorCalibration& cal, double temperatureC, double a[3], double b[3]) {
+    const ChannelCalibration* channels[3] = {&cal.left, &cal.center, &cal.right};
+    const double dt = temperatureC - cal.referenceTemp;
+    for (int i = 0; i < 3; ++i) {
+        double k = 1.0 + channels[i]->tempCoeff * dt;
+        a[i] = channels[i]->gain * k;
+        b[i] = channels[i]->offset * k;
+    }
+}
+
+} // namespace
+
+SensorData calibrate(const SensorData& raw, const SensorCalibration& calibration, double temperatureC) {
+    double a[3], b[3];
+    coefficients(calibration, temperatureC, a, b);
+    return SensorData{raw.left * a[0] + b[0], raw.center * a[1] + b[1], raw.right * a[2] + b[2]};
+}
+
+void calibrateFrames(vector<SensorData>& frames, const SensorCalibration& calibration, double temperatureC) {
+    double a[3], b[3];
+    coefficients(calibration, temperatureC, a, b);
+    double* v = reinterpret_cast<double*>(frames.data());
+    const size_t values = frames.size() * 3;
+    size_t i = 0;
+#ifdef PARKING_CALIBRATION_SSE2
+    // Two frames are six values: the coefficient pattern repeats every three registers
+    const __m128d a0 = _mm_set_pd(a[1], a[0]), a1 = _mm_set_pd(a[0], a[2]), a2 = _mm_set_pd(a[2], a[1]);
+    const __m128d b0 = _mm_set_pd(b[1], b[0]), b1 = _mm_set_pd(b[0], b[2]), b2 = _mm_set_pd(b[2], b[1]);
+    for (; i + 6 <= values; i += 6) {
+        _mm_storeu_pd(v + i, _mm_add_pd(_mm_mul_pd(_mm_loadu_pd(v + i), a0), b0));
+        _mm_storeu_pd(v + i + 2, _mm_add_pd(_mm_mul_pd(_mm_loadu_pd(v + i + 2), a1), b1));
+        _mm_storeu_pd(v + i + 4, _mm_add_pd(_mm_mul_pd(_mm_loadu_pd(v + i + 4), a2), b2));
+    }
+#endif
+    for (; i < values; ++i) v[i] = v[i] * a[i % 3] + b[i % 3];
+}
+
+void CalibrationTable::set(const string& vehicleId, const SensorCalibration& calibration) {
+    if (vehicleId.empty() || vehicleId.size() > kMaxIdLength)
+        throw invalid_argument("Vehicle id must have 1 to 15 characters");
+    const ChannelCalibration* channels[3] = {&calibration.left, &calibration.center, &calibration.right};
+    for (const ChannelCalibration* c : channels) {
+        if (!(c->gain > 0.0f) || !std::isfinite(c->gain))
+            throw invalid_argument("Calibration gain must be positive and finite");
+        if (!std::isfinite(c->offset) || !std::isfinite(c->tempCoeff))
+            throw invalid_argument("Calibration offset and temperature coefficient must be finite");
+    }
+    if (!std::isfinite(calibration.referenceTemp))
+        throw invalid_argument("Calibration reference temperature must be finite");
+
+    auto it = lowerBound(vehicleId);
+    if (it == records.end() || vehicleId != it->id) {
+        Record r = {};
+        memcpy(r.id, vehicleId.data(), vehicleId.size());
+        it = records.insert(it, r);
+    }
+    it->calibration = calibration;
+}
+
+bool CalibrationTable::erase(const string& vehicleId) {
+    auto it = lowerBound(vehicleId);
+    if (it == records.end() || vehicleId != it->id) return false;
+    records.erase(it);
+    return true;
+}
+
+const SensorCalibration* CalibrationTable::find(const string& vehicleId) const {
+    auto it = lowerBound(vehicleId);
+    return it != records.end() && vehicleId == it->id ? &it->calibration : nullptr;
+}
+
+vector<CalibrationTable::Record>::iterator CalibrationTable::lowerBound(const string& vehicleId) {
+    return lower_bound(records.begin(), records.end(), vehicleId,
+                       [](const Record& r, const string& id) { return id.compare(r.id) > 0; });
+}
+
+vector<CalibrationTable::Record>::const_iterator CalibrationTable::lowerBound(const string& vehicleId) const {
+    return lower_bound(records.begin(), records.end(), vehicleId,
+                       [](const Record& r, const string& id) { return id.compare(r.id) > 0; });
+}
+
+void CalibrationTable::save(ostream& out) const {
+    static_assert(sizeof(Record) == 56, "Calibration records must stay 56 bytes");
+    uint32_t header[2] = {kFormatVersion, static_cast<uint32_t>(records.size())};
+    out.write(kMagic, sizeof(kMagic));
+    out.write(reinterpret_cast<const char*>(header), sizeof(header));
+    if (!records.empty())
+        out.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(Record));
+    if (!out) throw runtime_error("CalibrationTable: cannot write the table");
+}
+
+CalibrationTable CalibrationTable::load(istream& in) {
+    char magic[4];
+    uint32_t header[2];
+    if (!in.read(magic, sizeof(magic)) || memcmp(magic, kMagic, sizeof(kMagic)) != 0 ||
+        !in.read(reinterpret_cast<char*>(header), sizeof(header)) || header[0] != kFormatVersion)
+        throw runtime_error("CalibrationTable: not a calibration table");
+
+    // Records are read one by one so a corrupt count cannot force a huge allocation
+    CalibrationTable table;
+    for (uint32_t i = 0; i < header[1]; ++i) {
+        Record r;
+        if (!in.read(reinterpret_cast<char*>(&r), sizeof(r)))
+            throw runtime_error("CalibrationTable: truncated table");
+        if (r.id[0] == '\0' || r.id[kMaxIdLength] != '\0' ||
+            (!table.records.empty() && strcmp(table.records.back().id, r.id) >= 0))
+            throw runtime_error("CalibrationTable: corrupt vehicle ids");
+        // Ids arrive sorted, so set() appends; it also rejects calibrations it would never store
+        try {
+            table.set(r.id, r.calibration);
+        } catch (const invalid_argument& e) {
+            throw runtime_error("CalibrationTable: record " + to_string(i + 1) + " (" + r.id + "): " + e.what());
+        }
+    }
+    return table;
+}
@@ -0,0 +1,134 @@
+/**
+ * @file SensorHealthMonitor.cpp
+ * @brief Implementation of the rolling-statistics sensor health monitor
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ */
+
+#include "../include/SensorHealthMonitor.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+using namespace std;
+
+const char* faultName(SensorFault fault) {
+    switch (fault) {
+    case SensorFault::Stuck:   return "STUCK";
+    case SensorFault::Erratic: return "ERRATIC";
+    case SensorFault::Invalid: return "INVALID";
+    default:                   return "OK";
+    }
+}
+
+SensorHealthMonitor::SensorHealthMonitor(const SensorHealthConfig& config) : settings(config) {
+    if (config.window < 2)
+        throw invalid_argument("Health window must hold at least two frames");
+    if (config.maxJumps < 1 || !(config.maxStep >= 0.0))
+        throw invalid_argument("Jump limits must be non-negative with at least one jump allowed");
+    if (!(config.stuckVariance >= 0.0 && config.stuckVariance < config.movingVariance))
+        throw invalid_argument("Variance thresholds must satisfy 0 <= stuck < moving");
+    for (Channel& c : channels) {
+        c.samples.assign(config.window, 0.0);
+        c.jumped.assign(config.window, 0);
+    }
+}
+
+double SensorHealthMonitor::variance(const Channel& c) const {
+    return c.count ? max(0.0, c.m2) / static_cast<double>(c.count) : 0.0;
+}
+
+/**
+ * @brief Adds a valid sample, dropping the oldest once the window is full
+ *
+ * Sliding Welford update: replacing x_old by x moves the mean by
+ * (x - x_old) / n and the sum of squared deviations by
+ * (x - x_old) * (x - newMean + x_old - oldMean). Rounding errors of these
+ * updates are discarded by an exact recomputation once per window.
+ */
+void SensorHealthMonitor::addSample(Channel& c, double x) {
+    const size_t n = settings.window;
+    const bool jump = c.count > 0 && fabs(x - c.last) > settings.maxStep;
+    c.rate = c.count > 0 ? x - c.last : 0.0;
+    c.last = x;
+
+    if (c.count < n) {
+        ++c.count;
+        double delta = x - c.mean;
+        c.mean += delta / static_cast<double>(c.count);
+        c.m2 += delta * (x - c.mean);
+    } else {
+        double old = c.samples[c.next];
+        double mean = c.mean + (x - old) / static_cast<double>(n);
+        c.m2 += (x - old) * (x - mean + old - c.mean);
+        c.mean = mean;
+        c.jumps -= c.jumped[c.next];
+    }
+    c.samples[c.next] = x;
+    c.jumped[c.next] = jump ? 1 : 0;
+    c.jumps += jump ? 1 : 0;
+    if (++c.next == n) c.next = 0;
+
+    if (c.next == 0 && c.count == n) {
+        double sum = 0.0;
+        for (double v : c.samples) sum += v;
+        c.mean = sum / static_cast<double>(n);
+        c.m2 = 0.0;
+        for (double v : c.samples) c.m2 += (v - c.mean) * (v - c.mean);
+    }
+}
+
+unsigned SensorHealthMonitor::update(const SensorData& s) {
+    ++frameCount;
+    const double values[3] = {s.left, s.center, s.right};
+    for (int i = 0; i < 3; ++i) {
+        Channel& c = channels[i];
+        c.invalid = !(values[i] >= 0.0) || std::isinf(values[i]);
+        if (c.invalid) c.rate = 0.0;
+        else addSample(c, values[i]);
+    }
+
+    double var[3];
+    for (int i = 0; i < 3; ++i) var[i] = channels[i].invalid ? 0.0 : variance(channels[i]);
+
+    mask = 0;
+    for (int i = 0; i < 3; ++i) {
+        Channel& c = channels[i];
+        if (c.invalid) {
+            c.fault = SensorFault::Invalid;
+        } else if (c.jumps >= settings.maxJumps) {
+            c.fault = SensorFault::Erratic;
+        } else if (var[i] > settings.stuckVariance || c.count < settings.window) {
+            c.fault = SensorFault::None;
+        } else if (c.fault != SensorFault::Stuck) {
+            // Frozen only counts as a fault if a neighbour shows the car is moving;
+            // once flagged, the sensor stays suspect until it moves itself
+            bool othersMoving = var[(i + 1) % 3] >= settings.movingVariance ||
+                                var[(i + 2) % 3] >= settings.movingVariance;
+            c.fault = othersMoving ? SensorFault::Stuck : SensorFault::None;
+        }
+        if (c.fault != SensorFault::None) mask |= 1u << i;
+    }
+    return mask;
+}
+
+void SensorHealthMonitor::reset() {
+    for (Channel& c : channels) {
+        fill(c.samples.begin(), c.samples.end(), 0.0);
+        fill(c.jumped.begin(), c.jumped.end(), 0);
+        c.next = 0;
+        c.count = 0;
+        c.mean = c.m2 = c.last = c.rate = 0.0;
+        c.jumps = 0;
+        c.invalid = false;
+        c.fault = SensorFault::None;
+    }
+    mask = 0;
+    frameCount = 0;
+}
+
+SensorHealth SensorHealthMonitor::health(SensorChannel channel) const {
+    const Channel& c = channels[static_cast<int>(channel)];
+    return SensorHealth{c.fault, c.mean, variance(c), c.rate, c.jumps};
+}
@@ -0,0 +1,238 @@
+/**
+ * @file SensorSynthesizer.cpp
+ * @brief Implementation of the uniform-grid ray caster and sensor synthesizer
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ *
+ * The grid is stored in compressed-row form: cellStart[c]..cellStart[c+1]
+ * indexes the segments overlapping cell c in cellItems, so the whole
+ * structure is two flat arrays built in two counting passes.
+ *
+ * A segment spanning several cells is tested once per cell the ray visits.
+ * Instead of de-duplicating with per-ray mailboxes, a traversal keeps the
+ * nearest hit found so far and stops as soon as that hit lies before the
+ * exit of the current cell; hits further along remain valid candidates.
+ * This keeps castRay() const and free of per-call state.
+ */
+
+#include "../include/SensorSynthesizer.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <stdexcept>
+
+using namespace std;
+
+namespace {
+
+const size_t kMaxGridCells = 1u << 22;  ///< Upper bound on grid size; cells grow beyond it
+const double kParallelEpsilon = 1e-12;  ///< Ray/segment determinant treated as parallel
+
+} // namespace
+
+void ObstacleMap::addSegment(Vec2 a, Vec2 b) {
+    segments.push_back(Segment2D{a, b});
+    built = false;
+}
+
+void ObstacleMap::addBox(const OrientedBox& box) {
+    Vec2 c[4];
+    boxCorners(box, c);
+    for (int i = 0; i < 4; ++i) addSegment(c[i], c[(i + 1) % 4]);
+}
+
+void ObstacleMap::build(double size) {
+    if (!(size > 0)) throw invalid_argument("ObstacleMap: cell size must be positive");
+
+    double minX = 0.0, minY = 0.0, maxX = 0.0, maxY = 0.0;
+    if (!segments.empty()) {
+        minX = maxX = segments[0].a.x;
+        minY = maxY = segments[0].a.y;
+        for (const Segment2D& s : segments) {
+            minX = min(minX, min(s.a.x, s.b.x));
+            maxX = max(maxX, max(s.a.x, s.b.x));
+            minY = min(minY, min(s.a.y, s.b.y));
+            maxY = max(maxY, max(s.a.y, s.b.y));
+        }
+    }
+
+    // Grow the cells for very large sparse scenes to bound memory
+    while (((maxX - minX) / size + 1.0) * ((maxY - minY) / size + 1.0) > kMaxGridCells) size *= 2.0;
+
+    cellSize = size;
+    invCellSize = 1.0 / size;
+    gridOrigin = Vec2{minX, minY};
+    cols = static_cast<int>(floor((maxX - minX) * invCellSize)) + 1;
+    rows = static_cast<int>(floor((maxY - minY) * invCellSize)) + 1;
+
+    const size_t cells = static_cast<size_t>(cols) * rows;
+    cellStart.assign(cells + 1, 0);
+
+    // Pass 1 counts segments per cell (by bounding box), pass 2 fills them in
+    for (int pass = 0; pass < 2; ++pass) {
+        vector<unsigned> cursor;
+        if (pass == 1) {
+            for (size_t c = 0; c < cells; ++c) cellStart[c + 1] += cellStart[c];
+            cellItems.resize(cellStart[cells]);
+            cursor.assign(cellStart.begin(), cellStart.end() - 1);
+        }
+        for (size_t i = 0; i < segments.size(); ++i) {
+            const Segment2D& s = segments[i];
+            int x0 = static_cast<int>(floor((min(s.a.x, s.b.x) - minX) * invCellSize));
+            int x1 = static_cast<int>(floor((max(s.a.x, s.b.x) - minX) * invCellSize));
+            int y0 = static_cast<int>(floor((min(s.a.y, s.b.y) - minY) * invCellSize));
+            int y1 = static_cast<int>(floor((max(s.a.y, s.b.y) - minY) * invCellSize));
+            x1 = min(x1, cols - 1);
+            y1 = min(y1, rows - 1);
+            for (int y = y0; y <= y1; ++y) {
+                for (int x = x0; x <= x1; ++x) {
+                    size_t c = static_cast<size_t>(y) * cols + x;
+                    if (pass == 0) cellStart[c + 1]++;
+                    else cellItems[cursor[c]++] = static_cast<unsigned>(i);
+                }
+            }
+        }
+    }
+    built = true;
+}
+
+/**
+ * @brief Tests a ray against the segments of one cell
+ * @return min(best, nearest hit distance in this cell's segment list)
+ *
+ * Solves origin + t*direction = a + u*(b - a) with 2D cross products.
+ */
+double ObstacleMap::hitInCell(size_t cell, Vec2 origin, Vec2 direction, double best) const {
+    for (unsigned k = cellStart[cell]; k < cellStart[cell + 1]; ++k) {
+        const Segment2D& s = segments[cellItems[k]];
+        Vec2 edge = s.b - s.a;
+        double denom = cross(direction, edge);
+        if (fabs(denom) < kParallelEpsilon) continue;
+        Vec2 w = s.a - origin;
+        double t = cross(w, edge) / denom;
+        double u = cross(w, direction) / denom;
+        if (t >= 0.0 && t < best && u >= 0.0 && u <= 1.0) best = t;
+    }
+    return best;
+}
+
+double ObstacleMap::castRay(Vec2 origin, Vec2 direction, double maxRange) const {
+    if (!built) throw logic_error("ObstacleMap: build() must be called before castRay()");
+
+    const double inf = numeric_limits<double>::infinity();
+    const double maxX = gridOrigin.x + cols * cellSize;
+    const double maxY = gridOrigin.y + rows * cellSize;
+
+    // Clip the ray to the grid bounds (slab test)
+    double tEnter = 0.0, tExit = maxRange;
+    const double o[2] = {origin.x, origin.y};
+    const double d[2] = {direction.x, direction.y};
+    const double lo[2] = {gridOrigin.x, gridOrigin.y};
+    const double hi[2] = {maxX, maxY};
+    for (int axis = 0; axis < 2; ++axis) {
+        if (fabs(d[axis]) < kParallelEpsilon) {
+            if (o[axis] < lo[axis] || o[axis] > hi[axis]) return maxRange;
+            continue;
+        }
+        double ta = (lo[axis] - o[axis]) / d[axis];
+        double tb = (hi[axis] - o[axis]) / d[axis];
+        if (ta > tb) swap(ta, tb);
+        tEnter = max(tEnter, ta);
+        tExit = min(tExit, tb);
+    }
+    if (tEnter > tExit) return maxRange;
+
+    // Starting cell and per-axis traversal state
+    Vec2 p = origin + direction * tEnter;
+    int cx = min(max(static_cast<int>(floor((p.x - gridOrigin.x) * invCellSize)), 0), cols - 1);
+    int cy = min(max(static_cast<int>(floor((p.y - gridOrigin.y) * invCellSize)), 0), rows - 1);
+
+    const int stepX = direction.x > 0 ? 1 : -1;
+    const int stepY = direction.y > 0 ? 1 : -1;
+    double tMaxX = inf, tMaxY = inf, tDeltaX = inf, tDeltaY = inf;
+    if (fabs(direction.x) >= kParallelEpsilon) {
+        double boundary = gridOrigin.x + (cx + (stepX > 0 ? 1 : 0)) * cellSize;
+        tMaxX = (boundary - origin.x) / direction.x;
+        tDeltaX = cellSize / fabs(direction.x);
+    }
+    if (fabs(direction.y) >= kParallelEpsilon) {
+        double boundary = gridOrigin.y + (cy + (stepY > 0 ? 1 : 0)) * cellSize;
+        tMaxY = (boundary - origin.y) / direction.y;
+        tDeltaY = cellSize / fabs(direction.y);
+    }
+
+    double best = maxRange;
+    while (true) {
+        best = hitInCell(static_cast<size_t>(cy) * cols + cx, origin, direction, best);
+        double cellExit = min(tMaxX, tMaxY);
+        if (best <= cellExit || cellExit > tExit) break;
+        if (tMaxX < tMaxY) {
+            cx += stepX;
+            if (cx < 0 || cx >= cols) break;
+            tMaxX += tDeltaX;
+        } else {
+            cy += stepY;
+            if (cy < 0 || cy >= rows) break;
+            tMaxY += tDeltaY;
+        }
+    }
+    return best;
+}
+
+SensorSynthesizer::SensorSynthesizer(const ObstacleMap& obstacles, int raysPerSensor,
+                                     double beamHalfAngle)
+    : map(obstacles) {
+    if (raysPerSensor < 1) throw invalid_argument("SensorSynthesizer: raysPerSensor must be at least 1");
+    if (beamHalfAngle < 0) throw invalid_argument("SensorSynthesizer: beamHalfAngle must not be negative");
+
+    if (raysPerSensor == 1) {
+        fanOffsets.push_back(0.0);
+    } else {
+        for (int i = 0; i < raysPerSensor; ++i)
+            fanOffsets.push_back(-beamHalfAngle + 2.0 * beamHalfAngle * i / (raysPerSensor - 1));
+    }
+}
+
+double SensorSynthesizer::readSensor(const Pose2D& pose, const SensorMount& mount) const {
+    Vec2 origin = toWorld(pose, Vec2{mount.x, mount.y});
+    double boresight = pose.heading + mount.heading;
+    double reading = mount.maxRange;
+    for (double offset : fanOffsets) {
+        double angle = boresight + offset;
+        reading = min(reading, map.castRay(origin, Vec2{cos(angle), sin(angle)}, reading));
+    }
+    return reading;
+}
+
+SensorData SensorSynthesizer::synthesize(const Pose2D& pose, const SensorLayout& layout,
+                                         bool reverseMode) const {
+    SensorData s;
+    s.left = readSensor(pose, layout.left);
+    s.center = readSensor(pose, reverseMode ? layout.rear : layout.front);
+    s.right = readSensor(pose, layout.right);
+    return s;
+}
+
+void writeSensorFrame(ostream& out, const SensorData& s) {
+    ios::fmtflags flags = out.flags();
+    streamsize precision = out.precision();
+    // 17 significant digits read back to the same double
+    out.unsetf(ios::floatfield);
+    out << setprecision(17) << s.left << '\n' << s.center << '\n' << s.right << '\n';
+    out.flags(flags);
+    out.precision(precision);
+}
+
+vector<SensorData> readSensorFrames(istream& in) {
+    vector<SensorData> frames;
+    SensorData s;
+    while (in >> s.left) {
+        if (!(in >> s.center >> s.right))
+            throw runtime_error("Recorded session ends in the middle of a frame");
+        frames.push_back(s);
+    }
+    if (!in.eof()) throw runtime_error("Recorded session contains a non-numeric value");
+    return frames;
+}
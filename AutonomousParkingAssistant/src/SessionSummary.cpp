@@ -0,0 +1,79 @@
+/**
+ * @file SessionSummary.cpp
+ * @brief Implementation of the streaming session summary
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ */
+
+#include "../include/SessionSummary.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+
+using namespace std;
+
+void SessionSummary::add(const SensorData& s, ParkingStatus status) {
+    const double values[3] = {s.left, s.center, s.right};
+    for (int i = 0; i < 3; ++i) {
+        if (std::isnan(values[i])) continue;
+        SensorAggregate& a = sensors[i];
+        size_t n = ++samples[i];
+        if (n == 1) {
+            a.min = a.max = a.mean = values[i];
+        } else {
+            a.min = min(a.min, values[i]);
+            a.max = max(a.max, values[i]);
+            a.mean += (values[i] - a.mean) / static_cast<double>(n);
+        }
+    }
+    ++frameCount;
+    ++zoneFrames[static_cast<int>(status)];
+    if (status == ParkingStatus::PerfectlyParked && parkedStep == 0) parkedStep = frameCount;
+    lastStatus = status;
+    lastTimed = false;
+}
+
+void SessionSummary::add(const SensorData& s, ParkingStatus status, double timestampSeconds) {
+    if (lastTimed && timestampSeconds > lastTimestamp)
+        zoneSeconds[static_cast<int>(lastStatus)] += timestampSeconds - lastTimestamp;
+    add(s, status);
+    lastTimed = true;
+    lastTimestamp = max(timestampSeconds, lastTimestamp);
+}
+
+void SessionSummary::reset() {
+    *this = SessionSummary();
+}
+
+void SessionSummary::print(ostream& out, const char* centerLabel) const {
+    const char* names[3] = {"LEFT", centerLabel, "RIGHT"};
+    ios::fmtflags flags = out.flags();
+    streamsize precision = out.precision();
+
+    out << "\n📈 Session Statistics (" << frameCount << " frames):\n";
+    out << std::left << setw(10) << "Sensor" << setw(10) << "Min(m)" << setw(10) << "Mean(m)" << "Max(m)\n";
+    out << "----------------------------------------\n";
+    out << fixed << setprecision(2);
+    for (int i = 0; i < 3; ++i) {
+        out << std::left << setw(10) << names[i];
+        if (samples[i] == 0) {
+            out << "-\n";
+            continue;
+        }
+        out << setw(10) << sensors[i].min << setw(10) << sensors[i].mean << sensors[i].max << "\n";
+    }
+
+    const ParkingStatus zones[4] = {ParkingStatus::Safe, ParkingStatus::TooClose, ParkingStatus::PerfectlyParked,
+                                    ParkingStatus::Collision};
+    out << "\n" << std::left << setw(20) << "Zone" << setw(10) << "Frames" << "Time(s)\n";
+    out << "----------------------------------------\n";
+    for (ParkingStatus z : zones)
+        out << std::left << setw(20) << statusName(z) << setw(10) << framesIn(z) << secondsIn(z) << "\n";
+
+    if (parkedStep != 0) out << "Steps to park: " << parkedStep << "\n";
+    else out << "Steps to park: not parked\n";
+
+    out.flags(flags);
+    out.precision(precision);
+}
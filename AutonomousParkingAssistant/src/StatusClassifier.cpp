@@ -0,0 +1,167 @@
+/**
+ * @file StatusClassifier.cpp
+ * @brief Implementation of the hysteresis status classifier
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ */
+
+#include "../include/StatusClassifier.h"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+
+const char* statusName(ParkingStatus status) {
+    switch (status) {
+    case ParkingStatus::Safe:            return "SAFE";
+    case ParkingStatus::TooClose:        return "TOO CLOSE";
+    case ParkingStatus::PerfectlyParked: return "Perfectly Parked";
+    case ParkingStatus::Collision:       return "COLLISION!";
+    default:                             return "UNKNOWN";
+    }
+}
+
+ParkingStatus plainStatus(const SensorData& s) {
+    if (s.center <= 0.1 || s.left <= 0.1 || s.right <= 0.1) return ParkingStatus::Collision;
+    if (s.center < 0.3 || s.left < 0.3 || s.right < 0.3) return ParkingStatus::TooClose;
+    if (s.center <= 0.5 && s.left <= 0.5 && s.right <= 0.5) return ParkingStatus::PerfectlyParked;
+    return ParkingStatus::Safe;
+}
+
+StatusClassifier::StatusClassifier(const StatusClassifierConfig& config) : settings(config) {
+    if (!(config.collisionDistance >= 0.0 && config.collisionDistance < config.closeDistance &&
+          config.closeDistance < config.parkedDistance))
+        throw invalid_argument("Status thresholds must satisfy 0 <= collision < close < parked");
+    if (!(config.hysteresis >= 0.0) ||
+        2.0 * config.hysteresis >= config.closeDistance - config.collisionDistance ||
+        2.0 * config.hysteresis >= config.parkedDistance - config.closeDistance)
+        throw invalid_argument("Hysteresis must be non-negative and below half of each threshold gap");
+    if (config.minDwellFrames < 1)
+        throw invalid_argument("Dwell time must be at least one frame");
+}
+
+/**
+ * @brief Status the reading points to, given the current status
+ *
+ * Each threshold is moved away from the current status by the hysteresis
+ * band, so the reading has to cross it clearly before anything changes.
+ */
+ParkingStatus StatusClassifier::target(double nearest, double farthest) const {
+    const double h = settings.hysteresis;
+    if (nearest <= settings.collisionDistance) return ParkingStatus::Collision;
+    if (status == ParkingStatus::Collision && nearest < settings.collisionDistance + h)
+        return ParkingStatus::Collision;
+
+    double closeLimit = settings.closeDistance;
+    if (status == ParkingStatus::TooClose || status == ParkingStatus::Collision) closeLimit += h;
+    else if (status != ParkingStatus::Unknown) closeLimit -= h;
+    if (nearest < closeLimit) return ParkingStatus::TooClose;
+
+    // Parked cannot be confirmed with a sensor missing
+    if (degradedMask != 0) return ParkingStatus::Safe;
+
+    // Parked also needs every sensor inside the plain range unless already parked
+    if (status == ParkingStatus::PerfectlyParked)
+        return farthest <= settings.parkedDistance + h ? ParkingStatus::PerfectlyParked : ParkingStatus::Safe;
+    double parkedLimit = settings.parkedDistance - (status == ParkingStatus::Safe ? h : 0.0);
+    if (nearest >= settings.closeDistance && farthest <= parkedLimit) return ParkingStatus::PerfectlyParked;
+    return ParkingStatus::Safe;
+}
+
+string StatusClassifier::label(ParkingStatus to, const SensorData& s) const {
+    string text = plainLabel(to, s);
+    if (degradedMask != 0) text += " [DEGRADED]";
+    return text;
+}
+
+string StatusClassifier::plainLabel(ParkingStatus to, const SensorData& s) const {
+    switch (to) {
+    case ParkingStatus::TooClose: {
+        // Name every side still inside the widened band, like checkSafety() does
+        const double limit = settings.closeDistance + settings.hysteresis;
+        vector<string> sides;
+        // Degraded sides are named too, unless their reading is invalid
+        if (s.left < limit && (!(degradedMask & 1u) || s.left >= 0.0)) sides.push_back("LEFT");
+        if (s.center < limit && (!(degradedMask & 2u) || s.center >= 0.0)) sides.push_back("CENTER");
+        if (s.right < limit && (!(degradedMask & 4u) || s.right >= 0.0)) sides.push_back("RIGHT");
+        if (sides.empty()) return "TOO CLOSE ⚠️ (NO WORKING SENSOR)";
+        string sideList;
+        for (size_t i = 0; i < sides.size(); ++i) {
+            sideList += sides[i];
+            if (i != sides.size() - 1) sideList += " + ";
+        }
+        return "TOO CLOSE ⚠️ (" + sideList + ")";
+    }
+    case ParkingStatus::PerfectlyParked:
+        return "Perfectly Parked ✅";
+    case ParkingStatus::Collision:
+        return "🚨 COLLISION! STOP IMMEDIATELY!";
+    default:
+        return statusName(to);
+    }
+}
+
+bool StatusClassifier::update(const SensorData& s, StatusEvent* event) {
+    const size_t frame = frameCount++;
+    double nearest = min(s.left, min(s.center, s.right));
+    double farthest = max(s.left, max(s.center, s.right));
+    if (degradedMask != 0) {
+        // Fail safe: a stuck or erratic sensor may still see something close, so its valid
+        // readings count for the closest distance, but never towards a parked position.
+        // Invalid readings say nothing.
+        const double values[3] = {s.left, s.center, s.right};
+        nearest = numeric_limits<double>::infinity();
+        farthest = -nearest;
+        for (int i = 0; i < 3; ++i) {
+            if (degradedMask & (1u << i)) {
+                if (values[i] >= 0.0) nearest = min(nearest, values[i]);
+                continue;
+            }
+            nearest = min(nearest, values[i]);
+            farthest = max(farthest, values[i]);
+        }
+    }
+    ParkingStatus next = target(nearest, farthest);
+    if (degradedMask == 7u && next != ParkingStatus::Collision) next = ParkingStatus::TooClose;
+
+    if (next == status) {
+        pending = ParkingStatus::Unknown;
+        pendingFrames = 0;
+        return false;
+    }
+
+    const bool immediate = status == ParkingStatus::Unknown || next == ParkingStatus::Collision ||
+                           (next == ParkingStatus::TooClose && status != ParkingStatus::Collision);
+    if (!immediate) {
+        if (next != pending) {
+            pending = next;
+            pendingFrames = 0;
+        }
+        if (++pendingFrames < settings.minDwellFrames) return false;
+    }
+
+    if (event) {
+        event->from = status;
+        event->to = next;
+        event->frame = frame;
+        event->reading = s;
+        event->label = label(next, s);
+    }
+    status = next;
+    pending = ParkingStatus::Unknown;
+    pendingFrames = 0;
+    ++transitionCount;
+    return true;
+}
+
+void StatusClassifier::reset() {
+    status = ParkingStatus::Unknown;
+    pending = ParkingStatus::Unknown;
+    pendingFrames = 0;
+    frameCount = 0;
+    transitionCount = 0;
+    degradedMask = 0;
+}
@@ -0,0 +1,165 @@
+/**
+ * @file TelemetryCodec.cpp
+ * @brief Implementation of the delta telemetry encoder and decoder
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ */
+
+#include "../include/TelemetryCodec.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <stdexcept>
+
+using namespace std;
+
+namespace {
+
+const uint8_t kKeyframeBit = 0x80;
+const uint8_t kStatusBit = 0x08;
+const uint8_t kSensorBits = 0x07;
+
+void putVarint(vector<uint8_t>& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+uint64_t getVarint(const uint8_t* data, size_t size, size_t& pos) {
+    uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (pos >= size) throw runtime_error("Truncated telemetry frame");
+        uint8_t byte = data[pos++];
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) return value;
+    }
+    throw runtime_error("Malformed telemetry varint");
+}
+
+uint64_t zigzag(int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+int64_t unzigzag(uint64_t value) {
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+double sensorValue(const SensorData& s, int i) {
+    return i == 0 ? s.left : i == 1 ? s.center : s.right;
+}
+
+} // namespace
+
+TelemetryEncoder::TelemetryEncoder(const TelemetryConfig& config) : settings(config) {
+    if (!(config.resolution > 0.0))
+        throw invalid_argument("Telemetry resolution must be positive");
+    if (!(config.deadband >= 0.0))
+        throw invalid_argument("Telemetry dead band cannot be negative");
+    if (config.keyframeInterval == 0 || config.heartbeatInterval == 0)
+        throw invalid_argument("Telemetry intervals must be at least one frame");
+    deadbandSteps = max<int64_t>(1, llround(config.deadband / config.resolution));
+}
+
+size_t TelemetryEncoder::encode(const TelemetryFrame& frame, vector<uint8_t>& out) {
+    if (inputCount > 0 && frame.timestampMs < lastInputTimestamp)
+        throw invalid_argument("Telemetry timestamps must not go backwards");
+    int64_t steps[3];
+    for (int i = 0; i < 3; ++i) {
+        double value = sensorValue(frame.reading, i);
+        if (!std::isfinite(value)) throw invalid_argument("Telemetry readings must be finite");
+        steps[i] = llround(max(0.0, value) / settings.resolution);
+    }
+    ++inputCount;
+    lastInputTimestamp = frame.timestampMs;
+
+    const bool key = keyframeDue || ++sinceKeyframe >= settings.keyframeInterval;
+    uint8_t header = 0;
+    if (key) {
+        header = kKeyframeBit | kSensorBits | kStatusBit;
+    } else {
+        for (int i = 0; i < 3; ++i)
+            if (llabs(steps[i] - lastSteps[i]) >= deadbandSteps) header |= static_cast<uint8_t>(1 << i);
+        if (frame.status != lastStatus) header |= kStatusBit;
+        if (header == 0 && ++sinceSent < settings.heartbeatInterval) return 0;
+    }
+
+    const size_t start = out.size();
+    out.push_back(header);
+    putVarint(out, key ? frame.timestampMs : frame.timestampMs - lastTimestamp);
+    for (int i = 0; i < 3; ++i) {
+        if (!(header & (1 << i))) continue;
+        putVarint(out, key ? static_cast<uint64_t>(steps[i]) : zigzag(steps[i] - lastSteps[i]));
+        lastSteps[i] = steps[i];
+    }
+    if (header & kStatusBit) {
+        out.push_back(static_cast<uint8_t>(frame.status));
+        lastStatus = frame.status;
+    }
+
+    lastTimestamp = frame.timestampMs;
+    sinceSent = 0;
+    if (key) {
+        keyframeDue = false;
+        sinceKeyframe = 0;
+    }
+    ++sentCount;
+    byteCount += out.size() - start;
+    return out.size() - start;
+}
+
+TelemetryDecoder::TelemetryDecoder(double resolution) : resolution(resolution) {
+    if (!(resolution > 0.0))
+        throw invalid_argument("Telemetry resolution must be positive");
+}
+
+size_t TelemetryDecoder::decode(const uint8_t* data, size_t size, TelemetryFrame& frame) {
+    size_t pos = 0;
+    if (size == 0) throw runtime_error("Truncated telemetry frame");
+    const uint8_t header = data[pos++];
+    const bool key = (header & kKeyframeBit) != 0;
+    if (header & ~(kKeyframeBit | kStatusBit | kSensorBits))
+        throw runtime_error("Malformed telemetry header");
+    if (key && header != (kKeyframeBit | kStatusBit | kSensorBits))
+        throw runtime_error("Key frame must carry every field");
+    if (!key && !synced)
+        throw runtime_error("Telemetry delta frame before the first key frame");
+
+    // Decode into locals so a malformed frame leaves the stream state untouched
+    uint64_t timestamp = getVarint(data, size, pos);
+    if (!key) timestamp += current.timestampMs;
+    int64_t next[3] = {steps[0], steps[1], steps[2]};
+    for (int i = 0; i < 3; ++i) {
+        if (!(header & (1 << i))) continue;
+        uint64_t raw = getVarint(data, size, pos);
+        next[i] = key ? static_cast<int64_t>(raw) : next[i] + unzigzag(raw);
+    }
+    ParkingStatus status = current.status;
+    if (header & kStatusBit) {
+        if (pos >= size) throw runtime_error("Truncated telemetry frame");
+        if (data[pos] > static_cast<uint8_t>(ParkingStatus::Collision))
+            throw runtime_error("Unknown telemetry status");
+        status = static_cast<ParkingStatus>(data[pos++]);
+    }
+
+    copy(next, next + 3, steps);
+    current.timestampMs = timestamp;
+    current.reading = SensorData{steps[0] * resolution, steps[1] * resolution, steps[2] * resolution};
+    current.status = status;
+    synced = true;
+    frame = current;
+    return pos;
+}
+
+vector<TelemetryFrame> TelemetryDecoder::decodeAll(const vector<uint8_t>& bytes) {
+    vector<TelemetryFrame> frames;
+    size_t pos = 0;
+    while (pos < bytes.size()) {
+        TelemetryFrame frame;
+        pos += decode(bytes.data() + pos, bytes.size() - pos, frame);
+        frames.push_back(frame);
+    }
+    return frames;
+}
@@ -0,0 +1,201 @@
+/**
+ * @file Tracer.cpp
+ * @brief Implementation of the Chrome trace event recorder
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ */
+
+#include "../include/Tracer.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+
+using namespace std;
+
+namespace {
+
+int64_t nowNs() {
+    return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief Writes a string as a JSON string literal
+ */
+void writeJsonString(ostream& out, const char* text) {
+    out << '"';
+    for (const char* c = text; *c; ++c) {
+        if (*c == '"' || *c == '\\') {
+            out << '\\' << *c;
+        } else if (static_cast<unsigned char>(*c) < 0x20) {
+            char escaped[8];
+            snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(*c));
+            out << escaped;
+        } else {
+            out << *c;
+        }
+    }
+    out << '"';
+}
+
+} // namespace
+
+/**
+ * @brief Buffer and name of the calling thread; the buffer is handed back when the thread exits
+ */
+struct Tracer::ThreadState {
+    ThreadBuffer* buffer = nullptr;
+    const char* name = nullptr;
+
+    ~ThreadState() {
+        if (buffer) Tracer::instance().releaseBuffer(buffer);
+    }
+};
+
+Tracer& Tracer::instance() {
+    static Tracer tracer;
+    return tracer;
+}
+
+Tracer::Tracer() : originNs(nowNs()) {}
+
+Tracer::ThreadState& Tracer::threadState() {
+    static thread_local ThreadState state;
+    return state;
+}
+
+/**
+ * @brief atexit() handler installed by writeAtExit()
+ */
+void Tracer::writeExitTrace() {
+    Tracer& tracer = instance();
+    tracer.disable();
+    ofstream file(tracer.exitPath);
+    tracer.writeJson(file);
+    if (!file) cerr << "❌ Could not write trace file " << tracer.exitPath << "\n";
+}
+
+void Tracer::enable() {
+    active.store(true, memory_order_relaxed);
+}
+
+void Tracer::disable() {
+    active.store(false, memory_order_relaxed);
+}
+
+Tracer::ThreadBuffer* Tracer::localBuffer() {
+    ThreadState& state = threadState();
+    if (!state.buffer) {
+        lock_guard<mutex> lock(registryMutex);
+        if (freeBuffers.empty()) {
+            buffers.emplace_back(new ThreadBuffer);
+            state.buffer = buffers.back().get();
+        } else {
+            state.buffer = freeBuffers.back();
+            freeBuffers.pop_back();
+        }
+        state.buffer->tid = ++threadCount;
+        if (state.name) threadNames.emplace_back(state.buffer->tid, state.name);
+    }
+    return state.buffer;
+}
+
+void Tracer::releaseBuffer(ThreadBuffer* buffer) {
+    lock_guard<mutex> lock(registryMutex);
+    if (buffer->count.load(memory_order_relaxed) < kBufferEvents) freeBuffers.push_back(buffer);
+}
+
+void Tracer::record(const char* name, char phase) {
+    const int64_t now = nowNs();
+    ThreadBuffer* buffer = localBuffer();
+    const size_t n = buffer->count.load(memory_order_relaxed);
+    if (n == kBufferEvents) {
+        buffer->dropped.fetch_add(1, memory_order_relaxed);
+        return;
+    }
+    buffer->events[n] = TraceEvent{name, now, buffer->tid, phase};
+    buffer->count.store(n + 1, memory_order_release);
+}
+
+void Tracer::setThreadName(const char* name) {
+    ThreadState& state = threadState();
+    state.name = name;
+    if (!state.buffer) return;
+    lock_guard<mutex> lock(registryMutex);
+    for (pair<uint32_t, const char*>& row : threadNames) {
+        if (row.first == state.buffer->tid) {
+            row.second = name;
+            return;
+        }
+    }
+    threadNames.emplace_back(state.buffer->tid, name);
+}
+
+void Tracer::writeJson(ostream& out) const {
+    lock_guard<mutex> lock(registryMutex);
+    ios::fmtflags flags = out.flags();
+    streamsize precision = out.precision();
+    out << fixed << setprecision(3);
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    for (const pair<uint32_t, const char*>& row : threadNames) {
+        out << (first ? "\n" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << row.first
+            << ",\"args\":{\"name\":";
+        writeJsonString(out, row.second);
+        out << "}}";
+        first = false;
+    }
+    for (const unique_ptr<ThreadBuffer>& buffer : buffers) {
+        const size_t n = buffer->count.load(memory_order_acquire);
+        for (size_t i = 0; i < n; ++i) {
+            const TraceEvent& e = buffer->events[i];
+            out << (first ? "\n" : ",\n") << "{\"name\":";
+            writeJsonString(out, e.name);
+            out << ",\"ph\":\"" << e.phase << "\",\"ts\":" << (e.timestampNs - originNs) * 1e-3
+                << ",\"pid\":1,\"tid\":" << e.tid << "}";
+            first = false;
+        }
+    }
+    out << "\n]}\n";
+    out.flags(flags);
+    out.precision(precision);
+}
+
+void Tracer::writeAtExit(const string& path) {
+    if (!ofstream(path)) throw runtime_error("Tracer: cannot create " + path);
+    lock_guard<mutex> lock(registryMutex);
+    if (exitPath.empty()) atexit(writeExitTrace);
+    exitPath = path;
+    enable();
+}
+
+size_t Tracer::events() const {
+    lock_guard<mutex> lock(registryMutex);
+    size_t total = 0;
+    for (const unique_ptr<ThreadBuffer>& buffer : buffers) total += buffer->count.load(memory_order_acquire);
+    return total;
+}
+
+size_t Tracer::dropped() const {
+    lock_guard<mutex> lock(registryMutex);
+    size_t total = 0;
+    for (const unique_ptr<ThreadBuffer>& buffer : buffers) total += buffer->dropped.load(memory_order_relaxed);
+    return total;
+}
+
+size_t Tracer::bufferCount() const {
+    lock_guard<mutex> lock(registryMutex);
+    return buffers.size();
+}
+
+void Tracer::clear() {
+    lock_guard<mutex> lock(registryMutex);
+    for (const unique_ptr<ThreadBuffer>& buffer : buffers) {
+        buffer->count.store(0, memory_order_relaxed);
+        buffer->dropped.store(0, memory_order_relaxed);
+    }
+}
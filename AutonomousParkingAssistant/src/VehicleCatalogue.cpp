@@ -0,0 +1,160 @@
+/**
+ * @file VehicleCatalogue.cpp
+ * @brief Compile-time vehicle catalogue and perfect-hash lookup table
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ *
+ * The profile array, the hash seed and the slot table below are all
+ * constexpr, so the compiler evaluates them during the build and emits
+ * them as read-only data.
+ *
+ * Perfect hashing: for seed = 1, 2, ... the build hashes every model code
+ * with seeded FNV-1a into a power-of-two table (at least four slots per
+ * entry) and keeps the first seed that produces no collision. A lookup
+ * then hashes the query once, reads one slot and confirms the match with
+ * one string compare. Adding a profile only requires appending it to
+ * kProfiles; a static_assert fails the build if no seed is found.
+ */
+
+#include "../include/VehicleCatalogue.h"
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+using namespace std;
+
+namespace {
+
+const double kPi = 3.14159265358979323846;
+const double kSideSensorRange = 2.5;    ///< Side sensor range (meters)
+const double kCenterSensorRange = 4.0;  ///< Front/rear sensor range (meters)
+
+/**
+ * @brief Builds a catalogue entry with the standard four-sensor layout
+ *
+ * Side sensors sit at mid-wheelbase on the body sides looking sideways;
+ * center sensors sit on the bumpers looking along the vehicle axis.
+ */
+constexpr VehicleProfile makeProfile(const char* code, const char* name, double width,
+                                     double wheelbase, double frontOverhang,
+                                     double rearOverhang, double turningRadius) {
+    return VehicleProfile{
+        code, name,
+        VehicleModel{width, wheelbase, frontOverhang, rearOverhang, turningRadius},
+        SensorLayout{
+            SensorMount{wheelbase / 2.0, width / 2.0, kPi / 2.0, kSideSensorRange},
+            SensorMount{wheelbase + frontOverhang, 0.0, 0.0, kCenterSensorRange},
+            SensorMount{wheelbase / 2.0, -width / 2.0, -kPi / 2.0, kSideSensorRange},
+            SensorMount{-rearOverhang, 0.0, kPi, kCenterSensorRange}}};
+}
+
+//                                code          name                    width  wb    fo    ro    R
+constexpr VehicleProfile kProfiles[] = {
+    makeProfile("CITY-01",   "City car",                1.64, 2.40, 0.70, 0.55, 4.7),
+    makeProfile("HATCH-02",  "Compact hatchback",       1.79, 2.63, 0.88, 0.77, 5.1),
+    makeProfile("HATCH-03",  "Small hatchback",         1.73, 2.55, 0.83, 0.68, 5.0),
+    makeProfile("SEDAN-04",  "Mid-size sedan",          1.83, 2.85, 0.93, 1.05, 5.6),
+    makeProfile("SEDAN-05",  "Executive sedan",         1.90, 3.00, 0.95, 1.10, 6.0),
+    makeProfile("WAGON-06",  "Estate wagon",            1.83, 2.80, 0.92, 1.05, 5.5),
+    makeProfile("SUV-07",    "Compact SUV",             1.84, 2.68, 0.90, 0.92, 5.4),
+    makeProfile("SUV-08",    "Full-size SUV",           2.00, 3.00, 1.00, 1.10, 6.2),
+    makeProfile("MPV-09",    "Minivan",                 1.90, 3.00, 0.95, 1.05, 5.8),
+    makeProfile("VAN-10",    "Panel van (short)",       2.02, 3.25, 1.00, 1.00, 6.1),
+    makeProfile("VAN-11",    "Panel van (long)",        2.02, 3.66, 1.00, 1.27, 6.6),
+    makeProfile("PICKUP-12", "Pickup truck",            1.95, 3.10, 0.95, 1.35, 6.4),
+    makeProfile("EV-13",     "Electric crossover",      1.85, 2.90, 0.90, 0.95, 5.5),
+    makeProfile("TAXI-14",   "Taxi sedan",              1.80, 2.75, 0.90, 1.00, 5.3),
+};
+
+constexpr size_t kProfileCount = sizeof(kProfiles) / sizeof(kProfiles[0]);
+
+/**
+ * @brief Smallest power of two with at least four slots per profile
+ */
+constexpr size_t tableSizeFor(size_t entries) {
+    size_t size = 1;
+    while (size < entries * 4) size <<= 1;
+    return size;
+}
+
+constexpr size_t kTableSize = tableSizeFor(kProfileCount);
+constexpr uint8_t kEmptySlot = 0xff;
+static_assert(kProfileCount < kEmptySlot, "Catalogue too large for 8-bit slot indices");
+
+/**
+ * @brief Seeded FNV-1a hash usable at compile time and run time
+ */
+constexpr uint32_t hashCode(const char* s, uint32_t seed) {
+    uint32_t h = 2166136261u ^ (seed * 16777619u);
+    while (*s) {
+        h ^= static_cast<uint8_t>(*s++);
+        h *= 16777619u;
+    }
+    return h;
+}
+
+/**
+ * @brief Returns true if the seed maps every code to a distinct slot
+ */
+constexpr bool seedIsPerfect(uint32_t seed) {
+    bool used[kTableSize] = {};
+    for (size_t i = 0; i < kProfileCount; ++i) {
+        size_t slot = hashCode(kProfiles[i].code, seed) & (kTableSize - 1);
+        if (used[slot]) return false;
+        used[slot] = true;
+    }
+    return true;
+}
+
+/**
+ * @brief Finds the first collision-free seed (0 if none within the search bound)
+ */
+constexpr uint32_t findPerfectSeed() {
+    for (uint32_t seed = 1; seed < 100000; ++seed) {
+        if (seedIsPerfect(seed)) return seed;
+    }
+    return 0;
+}
+
+constexpr uint32_t kSeed = findPerfectSeed();
+static_assert(kSeed != 0, "No perfect hash seed found for the vehicle catalogue");
+
+/**
+ * @brief Slot table mapping hash slots to profile indices
+ */
+struct SlotTable {
+    uint8_t slot[kTableSize];
+};
+
+constexpr SlotTable buildSlotTable() {
+    SlotTable table = {};
+    for (size_t i = 0; i < kTableSize; ++i) table.slot[i] = kEmptySlot;
+    for (size_t i = 0; i < kProfileCount; ++i)
+        table.slot[hashCode(kProfiles[i].code, kSeed) & (kTableSize - 1)] = static_cast<uint8_t>(i);
+    return table;
+}
+
+constexpr SlotTable kSlotTable = buildSlotTable();
+
+} // namespace
+
+const VehicleProfile* findVehicleProfile(const char* code) {
+    uint8_t index = kSlotTable.slot[hashCode(code, kSeed) & (kTableSize - 1)];
+    if (index == kEmptySlot) return nullptr;
+    const VehicleProfile& p = kProfiles[index];
+    return strcmp(p.code, code) == 0 ? &p : nullptr;
+}
+
+const VehicleProfile* findVehicleProfile(const string& code) {
+    return findVehicleProfile(code.c_str());
+}
+
+size_t vehicleProfileCount() {
+    return kProfileCount;
+}
+
+const VehicleProfile& vehicleProfileAt(size_t index) {
+    if (index >= kProfileCount) throw out_of_range("vehicleProfileAt: index out of range");
+    return kProfiles[index];
+}
@@ -0,0 +1,147 @@
+/**
+ * @file VehicleKinematics.cpp
+ * @brief Implementation of the closed-form parallel parking computations
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ *
+ * This file implements the vehicle model helpers and the scalar and
+ * batched minimum-slot computations declared in VehicleKinematics.h.
+ * The batched loops are written without data-dependent branches so the
+ * compiler can vectorize them.
+ */
+
+#include "../include/VehicleKinematics.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+using namespace std;
+
+namespace {
+
+const size_t kFeasibilityBlock = 64;  ///< Slots evaluated per block in parallelFeasibility()
+
+} // namespace
+
+double vehicleLength(const VehicleModel& v) {
+    return v.frontOverhang + v.wheelbase + v.rearOverhang;
+}
+
+/**
+ * @brief Converts the kerb-to-kerb radius to the rear axle midpoint radius
+ * @param v Vehicle model
+ * @return Rear-axle radius in meters
+ * @throws std::invalid_argument for inconsistent models
+ *
+ * At full lock the outer front wheel lies at distance R from the turning
+ * centre; the rear axle line passes through the centre, so the outer rear
+ * wheel is at sqrt(R^2 - b^2) and the axle midpoint half a width closer.
+ */
+double rearAxleTurningRadius(const VehicleModel& v) {
+    if (v.width <= 0 || v.wheelbase <= 0 || v.frontOverhang < 0 || v.rearOverhang < 0)
+        throw invalid_argument("VehicleModel: dimensions must be positive");
+    if (v.minTurningRadius <= v.wheelbase)
+        throw invalid_argument("VehicleModel: turning radius must exceed the wheelbase");
+
+    double r = sqrt(v.minTurningRadius * v.minTurningRadius - v.wheelbase * v.wheelbase) - v.width / 2.0;
+    if (r <= v.width / 2.0)
+        throw invalid_argument("VehicleModel: turning radius too small for the vehicle width");
+    return r;
+}
+
+double minParallelSlotLength(const VehicleModel& v, int moves) {
+    if (moves < 1) throw invalid_argument("minParallelSlotLength: moves must be at least 1");
+
+    double r = rearAxleTurningRadius(v);
+    double reach = v.wheelbase + v.frontOverhang;
+    double corner = v.rearOverhang + sqrt(2.0 * r * v.width / moves + reach * reach);
+    return max(corner, vehicleLength(v) + kMinShuffleGap);
+}
+
+int minParallelMoves(const VehicleModel& v, double slotLength, int maxMoves) {
+    VehicleFleet single;
+    single.add(v);
+    vector<unsigned char> out;
+    parallelFeasibility(single, vector<double>(1, slotLength), maxMoves, out);
+    return out[0];
+}
+
+void VehicleFleet::add(const VehicleModel& v) {
+    double r = rearAxleTurningRadius(v);
+    double reach = v.wheelbase + v.frontOverhang;
+    rearOverhang.push_back(v.rearOverhang);
+    frontReachSq.push_back(reach * reach);
+    lateralTerm.push_back(2.0 * r * v.width);
+    length.push_back(vehicleLength(v));
+}
+
+void minParallelSlotLengths(const VehicleFleet& fleet, int moves, vector<double>& out) {
+    if (moves < 1) throw invalid_argument("minParallelSlotLengths: moves must be at least 1");
+
+    const size_t n = fleet.size();
+    out.resize(n);
+    const double invMoves = 1.0 / moves;
+    const double* ro = fleet.rearOverhang.data();
+    const double* reachSq = fleet.frontReachSq.data();
+    const double* lateral = fleet.lateralTerm.data();
+    const double* len = fleet.length.data();
+    double* dst = out.data();
+
+    for (size_t i = 0; i < n; ++i) {
+        double corner = ro[i] + sqrt(lateral[i] * invMoves + reachSq[i]);
+        double floorLen = len[i] + kMinShuffleGap;
+        dst[i] = corner > floorLen ? corner : floorLen;
+    }
+}
+
+/**
+ * @brief Evaluates all vehicle/slot pairs
+ *
+ * Per vehicle, the n-move thresholds L1 >= L2 >= ... >= Lmax are computed
+ * once with the closed form. A slot is feasible when it is at least Lmax,
+ * and the fewest moves needed is 1 plus the number of thresholds (other
+ * than Lmax) it falls short of. The inner loop over slots therefore only
+ * compares and adds, with no divisions or branches, and vectorizes.
+ */
+void parallelFeasibility(const VehicleFleet& fleet, const vector<double>& slotLengths,
+                         int maxMoves, vector<unsigned char>& out) {
+    if (maxMoves < 1 || maxMoves > 255)
+        throw invalid_argument("parallelFeasibility: maxMoves must be between 1 and 255");
+
+    const size_t vehicles = fleet.size();
+    const size_t slots = slotLengths.size();
+    out.resize(vehicles * slots);
+    const double* slot = slotLengths.data();
+    vector<double> thresholds(maxMoves);
+
+    for (size_t v = 0; v < vehicles; ++v) {
+        const double floorLen = fleet.length[v] + kMinShuffleGap;
+        for (int n = 1; n <= maxMoves; ++n) {
+            double corner = fleet.rearOverhang[v] +
+                            sqrt(fleet.lateralTerm[v] / n + fleet.frontReachSq[v]);
+            thresholds[n - 1] = corner > floorLen ? corner : floorLen;
+        }
+        const double minLen = thresholds[maxMoves - 1];
+        unsigned char* row = out.data() + v * slots;
+
+        // Work in fixed-size blocks held in local arrays: locals cannot alias
+        // the output row and the constant trip count lets every pass compile
+        // to a flat vectorized compare-and-add. Tail blocks are zero-padded.
+        for (size_t base = 0; base < slots; base += kFeasibilityBlock) {
+            const size_t count = min(kFeasibilityBlock, slots - base);
+            double len[kFeasibilityBlock];
+            double needed[kFeasibilityBlock];
+            for (size_t i = 0; i < count; ++i) len[i] = slot[base + i];
+            for (size_t i = count; i < kFeasibilityBlock; ++i) len[i] = 0.0;
+
+            for (size_t i = 0; i < kFeasibilityBlock; ++i) needed[i] = 1.0;
+            for (int n = 0; n < maxMoves - 1; ++n) {
+                const double t = thresholds[n];
+                for (size_t i = 0; i < kFeasibilityBlock; ++i) needed[i] += len[i] < t ? 1.0 : 0.0;
+            }
+            for (size_t i = 0; i < kFeasibilityBlock; ++i) needed[i] = len[i] >= minLen ? needed[i] : 0.0;
+            for (size_t i = 0; i < count; ++i) row[base + i] = static_cast<unsigned char>(needed[i]);
+        }
+    }
+}
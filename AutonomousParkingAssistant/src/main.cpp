@@ -11,23 +11,70 @@
  * 
  * The main function implements:
  * - Application initialization and welcome message
+ * - Vehicle selection from the built-in catalogue (--vehicle CODE)
  * - Vehicle dimension input and validation
  * - Parking type and mode selection
  * - Parking space scanning and validation
- * - Parking assistant loop execution
+ * - Parking assistant loop execution, optionally summary-only (--summary-only)
+ * - Live metrics in a shared-memory segment (--metrics NAME)
+ * - Optional per-reading deadline watchdog (--deadline MS)
  * - Comprehensive error handling
  */
 
 #include "../include/ParkingUtils.h"
+#include "../include/Tracer.h"
+#include "../include/VehicleCatalogue.h"
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
 #include <iostream>
+#include <memory>
 #include <string>
 #include <limits>
 #include <stdexcept>
 
 using namespace std;
 
+/**
+ * @brief Removes the shared metrics segment when main() returns
+ *
+ * Readers still attached keep their mapping and the final values.
+ */
+struct SharedMetricsSegment {
+    string name;
+    ~SharedMetricsSegment() {
+        if (!name.empty()) MetricsRegistry::unlinkShared(name);
+    }
+};
+
+/**
+ * @brief Prints the built-in vehicle catalogue as a table
+ */
+static void listVehicles() {
+    cout << left << setw(12) << "Code" << setw(24) << "Vehicle"
+         << setw(10) << "Length" << setw(10) << "Width" << "Turning(m)\n";
+    cout << "-------------------------------------------------------------------\n";
+    for (size_t i = 0; i < vehicleProfileCount(); ++i) {
+        const VehicleProfile& p = vehicleProfileAt(i);
+        cout << left << setw(12) << p.code << setw(24) << p.name
+             << setw(10) << vehicleLength(p.model) << setw(10) << p.model.width
+             << p.model.minTurningRadius << "\n";
+    }
+}
+
 /**
  * @brief Main entry point for the Autonomous Parking Assistant application
+ * @param argc Number of command-line arguments
+ * @param argv Command-line arguments:
+ *             --vehicle CODE    use a catalogued vehicle instead of typing dimensions
+ *             --list-vehicles   print the vehicle catalogue and exit
+ *             --summary-only    end the session with streaming statistics only, no step table
+ *             --trace FILE      write a Chrome trace of the run to FILE (tracing builds only)
+ *             --metrics NAME    publish live metrics in the shared-memory segment NAME
+ *                               (e.g. /parking_metrics), read with parkingMetrics; removed
+ *                               again when the assistant exits
+ *             --deadline MS     time each reading against an MS millisecond deadline and stop
+ *                               the session when one takes five times as long
  * @return 0 on successful execution, 1 on error
  * 
  * This function serves as the main entry point for the autonomous parking
@@ -35,7 +82,8 @@ using namespace std;
  * 
  * Application Flow:
  * 1. Display welcome message and application header
- * 2. Collect and validate vehicle dimensions (length and width)
+ * 2. Look up the vehicle profile given with --vehicle, or collect and
+ *    validate vehicle dimensions (length and width)
  * 3. Allow user to select parking type (parallel or perpendicular)
  * 4. Allow user to select driving mode (forward or reverse)
  * 5. Scan for suitable parking spaces
@@ -65,21 +113,84 @@ using namespace std;
  * @note The application exits gracefully if no suitable parking space is found
  * 
  * @example
- * int main() {
+ * ./AutonomousParkingAssistant --vehicle HATCH-02
+ * int main(int argc, char* argv[]) {
  *     // Application starts here
  *     // User is guided through configuration and parking process
  *     return 0; // Successful completion
  * }
  */
-int main() {
+int main(int argc, char* argv[]) {
+    SharedMetricsSegment metricsSegment;
     try {
+        // Parse command-line options
+        const VehicleProfile* profile = nullptr;
+        SessionReport report = SessionReport::FullHistory;
+        unique_ptr<MetricsRegistry> registry;
+        unique_ptr<WatchdogConfig> deadline;
+        for (int i = 1; i < argc; ++i) {
+            if (strcmp(argv[i], "--list-vehicles") == 0) {
+                listVehicles();
+                return 0;
+            }
+            if (strcmp(argv[i], "--vehicle") == 0 && i + 1 < argc) {
+                profile = findVehicleProfile(argv[++i]);
+                if (!profile) {
+                    cerr << "❌ Unknown vehicle code: " << argv[i]
+                         << " (use --list-vehicles to see the catalogue)\n";
+                    return 1;
+                }
+                continue;
+            }
+            if (strcmp(argv[i], "--summary-only") == 0) {
+                report = SessionReport::SummaryOnly;
+                continue;
+            }
+            if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+#ifdef PARKING_ENABLE_TRACING
+                Tracer::instance().writeAtExit(argv[++i]);
+                PARKING_TRACE_THREAD("parking loop");
+                continue;
+#else
+                cerr << "❌ Tracing is not compiled in (configure with -DPARKING_ENABLE_TRACING=ON)\n";
+                return 1;
+#endif
+            }
+            if (strcmp(argv[i], "--metrics") == 0 && i + 1 < argc) {
+                registry.reset(new MetricsRegistry(MetricsRegistry::createShared(argv[++i])));
+                metricsSegment.name = argv[i];
+                continue;
+            }
+            if (strcmp(argv[i], "--deadline") == 0 && i + 1 < argc) {
+                deadline.reset(new WatchdogConfig());
+                deadline->frameDeadline = atof(argv[++i]) * 1e-3;
+                deadline->hardLimit = 5.0 * deadline->frameDeadline;
+                if (!(deadline->frameDeadline > 0.0)) {
+                    cerr << "❌ --deadline needs a positive number of milliseconds\n";
+                    return 1;
+                }
+                continue;
+            }
+            cerr << "Usage: " << argv[0] << " [--vehicle CODE] [--list-vehicles] [--summary-only] [--trace FILE]"
+                 << " [--metrics NAME] [--deadline MS]\n";
+            return 1;
+        }
+
         // Display application header
         cout << "=== Autonomous Parking Assistant ===\n";
 
-        // Collect vehicle dimensions with validation
+        // Use the catalogued vehicle if one was selected, otherwise collect
+        // vehicle dimensions with validation
         // Car dimensions must be positive values for realistic parking calculations
-        double carLength = getDoubleInput("Enter your car length (m): ", false);
-        double carWidth  = getDoubleInput("Enter your car width (m): ", false);
+        double carLength = 0.0;
+        double carWidth = 0.0;
+        if (profile) {
+            cout << "Vehicle: " << profile->name << " (" << profile->code << "), "
+                 << vehicleLength(profile->model) << " m x " << profile->model.width << " m\n";
+        } else {
+            carLength = getDoubleInput("Enter your car length (m): ", false);
+            carWidth  = getDoubleInput("Enter your car width (m): ", false);
+        }
 
         // Allow user to select parking type
         char typeChoice;
@@ -103,14 +214,18 @@ int main() {
 
         // Scan for suitable parking spaces
         // If no suitable space is found, exit gracefully
-        if (!findParkingSpace(parallel, carLength, carWidth)) {
+        bool found = profile ? findParkingSpace(parallel, profile->model)
+                             : findParkingSpace(parallel, carLength, carWidth);
+        if (!found) {
             // No space or user entered 0 - exit program gracefully
             return 0;
         }
 
         // Execute the main parking assistant loop
         // This function handles the complete parking process
-        parkingAssistantLoop(reverseMode, parallel);
+        SessionMetrics metrics = registry ? SessionMetrics(*registry) : SessionMetrics();
+        if (deadline) parkingAssistantLoop(reverseMode, parallel, report, *deadline, metrics);
+        else parkingAssistantLoop(reverseMode, parallel, report, metrics);
 
     } catch (const std::exception& e) {
         // Handle any exceptions that occur during execution
@@ -0,0 +1,58 @@
+/**
+ * @file TestSupport.h
+ * @brief Helpers shared by the unit test suites
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ *
+ * Tolerant floating-point comparison and a fixture that runs an
+ * interactive parking session on scripted input.
+ */
+
+#ifndef TEST_SUPPORT_H
+#define TEST_SUPPORT_H
+
+#include <cmath>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+/**
+ * @brief Whether two values agree within a tolerance
+ *
+ * Infinite values only agree with the same infinity.
+ */
+inline bool near(double a, double b, double tol = 1e-9) {
+    if (std::isinf(a) || std::isinf(b)) return a == b;
+    return std::fabs(a - b) < tol;
+}
+
+/**
+ * @brief Runs a session on scripted input and returns everything it printed
+ * @param input Text read through std::cin, e.g. sensor readings one per line
+ * @param session Callable that runs the session, e.g. a parkingAssistantLoop() call
+ *
+ * std::cin and std::cout are restored even if the session throws.
+ *
+ * @example
+ * std::string output = runLoop("0.4\n0.4\n0.4\n", [] { parkingAssistantLoop(true, false); });
+ */
+template <typename Session>
+std::string runLoop(const std::string& input, Session session) {
+    std::istringstream in(input);
+    std::ostringstream out;
+    std::streambuf* originalCin = std::cin.rdbuf(in.rdbuf());
+    std::streambuf* originalCout = std::cout.rdbuf(out.rdbuf());
+    try {
+        session();
+    } catch (...) {
+        std::cin.rdbuf(originalCin);
+        std::cout.rdbuf(originalCout);
+        throw;
+    }
+    std::cin.rdbuf(originalCin);
+    std::cout.rdbuf(originalCout);
+    return out.str();
+}
+
+#endif // TEST_SUPPORT_H
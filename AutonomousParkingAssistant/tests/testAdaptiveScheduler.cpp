@@ -0,0 +1,213 @@
+/**
+ * @file testAdaptiveScheduler.cpp
+ * @brief Unit tests for the adaptive processing scheduler and session replay
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ *
+ * Test Coverage:
+ * - Stride bands and decimation far from obstacles
+ * - Every-frame processing, without delay, inside the near band
+ * - Recorded session round trip and replay statistics
+ */
+
+#include "../include/AdaptiveScheduler.h"
+#include "../include/SensorSynthesizer.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+double uniform(double lo, double hi) {
+    return lo + (hi - lo) * (std::rand() / (RAND_MAX + 1.0));
+}
+
+double nearestOf(const SensorData& s) {
+    return std::min(s.left, std::min(s.center, s.right));
+}
+
+} // namespace
+
+/**
+ * @brief Tests stride bands and decimation
+ *
+ * Test Cases:
+ * - Stride is 1 in the near band, maxStride beyond the far band, linear in between
+ * - Far readings process exactly one frame in maxStride
+ * - The first frame and the first frame after reset() are always processed
+ * - Invalid configurations are rejected
+ */
+void testStrideBands() {
+    std::cout << "Testing stride bands...\n";
+
+    AdaptiveSchedulerConfig config;   // 1 m .. 3 m, stride up to 8
+    AdaptiveScheduler scheduler(config);
+    assert(scheduler.strideFor(0.2) == 1 && scheduler.strideFor(0.999) == 1);
+    assert(scheduler.strideFor(1.0) == 1 && scheduler.strideFor(2.0) == 4);
+    assert(scheduler.strideFor(3.0) == 8 && scheduler.strideFor(40.0) == 8);
+    for (double d = 1.0; d < 3.0; d += 0.01) assert(scheduler.strideFor(d) <= scheduler.strideFor(d + 0.01));
+
+    std::vector<int> processedAt;
+    for (int frame = 0; frame < 80; ++frame)
+        if (scheduler.shouldProcess(SensorData{5.0, 4.0, 6.0})) processedAt.push_back(frame);
+    assert(processedAt.size() == 10);
+    for (std::size_t i = 0; i < processedAt.size(); ++i) assert(processedAt[i] == static_cast<int>(8 * i));
+    assert(scheduler.framesSeen() == 80 && scheduler.framesProcessed() == 10);
+
+    scheduler.reset();
+    assert(scheduler.shouldProcess(SensorData{5.0, 5.0, 5.0}));
+    assert(!scheduler.shouldProcess(SensorData{5.0, 5.0, 5.0}));
+
+    AdaptiveSchedulerConfig bad[3];
+    bad[0].nearDistance = 4.0;   // beyond the far band
+    bad[1].nearDistance = -1.0;
+    bad[2].maxStride = 0;
+    for (const AdaptiveSchedulerConfig& c : bad) {
+        bool threw = false;
+        try {
+            AdaptiveScheduler invalid(c);
+        } catch (const std::invalid_argument&) {
+            threw = true;
+        }
+        assert(threw);
+    }
+
+    std::cout << "✅ Stride band tests passed\n";
+}
+
+/**
+ * @brief Tests that close readings are processed on the frame they arrive
+ *
+ * Test Cases:
+ * - A reading dropping into the near band mid-stride is processed at once
+ * - Random sessions never skip a near frame, and never wait longer than
+ *   the stride of the frame being skipped
+ * - NaN readings count as close
+ */
+void testNearBandLatency() {
+    std::cout << "Testing near band latency...\n";
+
+    AdaptiveScheduler scheduler;
+    assert(scheduler.shouldProcess(SensorData{4.0, 4.0, 4.0}));
+    assert(!scheduler.shouldProcess(SensorData{4.0, 4.0, 4.0}));
+    assert(scheduler.shouldProcess(SensorData{4.0, 0.9, 4.0}));   // pedestrian steps in
+    assert(scheduler.shouldProcess(SensorData{4.0, 0.8, 4.0}));
+    assert(!scheduler.shouldProcess(SensorData{4.0, 3.5, 4.0}));
+    assert(scheduler.shouldProcess(SensorData{4.0, std::nan(""), 4.0}));
+
+    std::srand(64);
+    for (int trial = 0; trial < 20; ++trial) {
+        scheduler.reset();
+        double d = uniform(0.5, 6.0);
+        std::size_t skipped = 0;
+        for (int frame = 0; frame < 2000; ++frame) {
+            d = std::max(0.2, std::min(6.0, d + uniform(-0.08, 0.08)));
+            SensorData s{d + uniform(0.0, 1.0), d, d + uniform(0.0, 1.0)};
+            bool run = scheduler.shouldProcess(s);
+            if (nearestOf(s) < scheduler.config().nearDistance) assert(run);
+            if (run) {
+                skipped = 0;
+            } else {
+                ++skipped;
+                assert(skipped < scheduler.strideFor(nearestOf(s)));
+            }
+        }
+        assert(scheduler.framesProcessed() < scheduler.framesSeen());
+    }
+
+    std::cout << "✅ Near band latency tests passed\n";
+}
+
+/**
+ * @brief Tests recorded sessions and replay statistics
+ */
+void testReplay() {
+    std::cout << "Testing session replay...\n";
+
+    // Record a session: cruising far from everything, then reversing into a bay
+    std::stringstream recording;
+    std::vector<SensorData> original;
+    for (int i = 0; i < 400; ++i) {
+        double d = i < 200 ? 4.5 : std::max(0.35, 4.5 - (i - 200) * 0.03);
+        SensorData s{d + 0.25, d, d + 0.5};
+        original.push_back(s);
+        writeSensorFrame(recording, s);
+    }
+    std::vector<SensorData> frames = readSensorFrames(recording);
+    assert(frames.size() == original.size());
+    for (std::size_t i = 0; i < frames.size(); ++i)
+        assert(std::fabs(frames[i].center - original[i].center) < 1e-9);
+
+    std::size_t calls = 0;
+    auto pipeline = [&calls](const SensorData&) { ++calls; };
+    ReplayStats everyFrame = replaySession(frames, pipeline, nullptr);
+    assert(everyFrame.frames == 400 && everyFrame.processed == 400 && calls == 400);
+
+    calls = 0;
+    AdaptiveScheduler scheduler;
+    ReplayStats adaptive = replaySession(frames, pipeline, &scheduler, 3);
+    assert(adaptive.frames == 400 && calls == 3 * adaptive.processed);
+    assert(adaptive.processed < 200 && adaptive.nearSkipped == 0);
+    assert(adaptive.cpuSeconds >= 0.0);
+
+    std::istringstream partial("1.0\n2.0\n3.0\n1.0\n2.0\n");
+    bool threw = false;
+    try {
+        readSensorFrames(partial);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    std::istringstream garbage("1.0\n2.0\nabc\n");
+    threw = false;
+    try {
+        readSensorFrames(garbage);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    threw = false;
+    try {
+        replaySession(frames, pipeline, nullptr, 0);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "✅ Session replay tests passed\n";
+}
+
+/**
+ * @brief Executes all adaptive scheduler tests
+ * @return 0 on success, 1 on failure
+ */
+int runAllTests() {
+    std::cout << "=== Running Adaptive Scheduler Unit Tests ===\n\n";
+
+    try {
+        testStrideBands();
+        testNearBandLatency();
+        testReplay();
+
+        std::cout << "\n🎉 All tests passed successfully!\n";
+        std::cout << "Total tests run: 3\n";
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
+
+/**
+ * @brief Main entry point for the adaptive scheduler test suite
+ * @return 0 on success, 1 on failure
+ */
+int main() {
+    return runAllTests();
+}
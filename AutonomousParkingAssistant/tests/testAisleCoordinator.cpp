@@ -0,0 +1,322 @@
+/**
+ * @file testAisleCoordinator.cpp
+ * @brief Unit tests for multi-vehicle aisle coordination
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ *
+ * Test Coverage:
+ * - Reservation table cells, swaps, parking and hold times
+ * - Head-on vehicles resolved by prioritized planning
+ * - Conflict-based search fallback when a vehicle parks on the only way through
+ * - Dozens of vehicles in one lot, and the expansion budget
+ * - Bay allocation through the lot index
+ */
+
+#include "../include/AisleCoordinator.h"
+#include "../include/GridReplanner.h"
+#include "../include/LotIndex.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+Vec2 cellCenter(int col, int row) {
+    return Vec2{col + 0.5, row + 0.5};
+}
+
+Vec2 waypointAt(const AisleRoute& route, std::size_t t) {
+    return route.waypoints[std::min(t, route.waypoints.size() - 1)];
+}
+
+bool same(Vec2 a, Vec2 b) {
+    return std::fabs(a.x - b.x) < 1e-9 && std::fabs(a.y - b.y) < 1e-9;
+}
+
+/**
+ * @brief Asserts that planned routes never share a cell or swap cells, and move one cell per step
+ */
+void assertConflictFree(const std::vector<AisleRoute>& routes) {
+    std::size_t duration = 0;
+    for (const AisleRoute& r : routes)
+        if (r.planned) duration = std::max(duration, r.waypoints.size());
+    for (std::size_t t = 0; t <= duration; ++t) {
+        for (std::size_t i = 0; i < routes.size(); ++i) {
+            if (!routes[i].planned) continue;
+            if (t > 0) {
+                Vec2 step = waypointAt(routes[i], t) - waypointAt(routes[i], t - 1);
+                assert(std::fabs(step.x) + std::fabs(step.y) <= 1.0 + 1e-9);
+            }
+            for (std::size_t j = i + 1; j < routes.size(); ++j) {
+                if (!routes[j].planned) continue;
+                assert(!same(waypointAt(routes[i], t), waypointAt(routes[j], t)));
+                if (t > 0)
+                    assert(!(same(waypointAt(routes[i], t), waypointAt(routes[j], t - 1)) &&
+                             same(waypointAt(routes[j], t), waypointAt(routes[i], t - 1))));
+            }
+        }
+    }
+}
+
+/**
+ * @brief A one-cell-wide corridor along row 1 with a single pocket above the given column
+ */
+GridReplanner corridor(int length, int pocketCol) {
+    GridReplanner grid(Vec2{0, 0}, 1.0, length, 3);
+    for (int col = 0; col < length; ++col) {
+        grid.addObstacle(OrientedBox{cellCenter(col, 0), 0.1, 0.1, 0.0});
+        if (col != pocketCol) grid.addObstacle(OrientedBox{cellCenter(col, 2), 0.1, 0.1, 0.0});
+    }
+    return grid;
+}
+
+} // namespace
+
+/**
+ * @brief Tests the reservation table
+ */
+void testReservationTable() {
+    std::cout << "Testing reservation table...\n";
+
+    ReservationTable table;
+    assert(table.cellFree(5, 0) && table.lastReservedTime(5) == -1);
+
+    table.reserveRoute({1, 2, 3, 3, 4});
+    assert(!table.cellFree(1, 0) && table.cellFree(1, 1));
+    assert(!table.cellFree(3, 2) && !table.cellFree(3, 3) && table.cellFree(3, 4));
+    assert(!table.cellFree(4, 4) && !table.cellFree(4, 100));       // parked at the end
+    assert(table.lastReservedTime(3) == 3);
+    assert(table.lastReservedTime(4) > 1000);
+
+    // The reverse of every move is forbidden, other moves are not
+    assert(!table.moveFree(2, 1, 0));
+    assert(table.moveFree(1, 2, 0));
+    assert(!table.moveFree(4, 3, 3));
+
+    table.forbidCell(9, 7);
+    assert(!table.cellFree(9, 7) && table.lastReservedTime(9) == 7);
+    table.clear();
+    assert(table.cellFree(4, 100) && table.moveFree(2, 1, 0));
+
+    std::cout << "✅ Reservation table tests passed\n";
+}
+
+/**
+ * @brief Tests two vehicles meeting head-on in a corridor with a passing pocket
+ */
+void testHeadOnCorridor() {
+    std::cout << "Testing head-on corridor...\n";
+
+    GridReplanner grid = corridor(12, 6);
+    AisleCoordinator coordinator(grid);
+    std::vector<AisleVehicle> vehicles = {
+        {1, cellCenter(0, 1), cellCenter(11, 1)},
+        {2, cellCenter(11, 1), cellCenter(0, 1)},
+    };
+    std::vector<AisleRoute> routes = coordinator.coordinate(vehicles);
+    assert(routes.size() == 2 && routes[0].planned && routes[1].planned);
+    assert(routes[0].vehicleId == 1 && routes[1].vehicleId == 2);
+    assert(same(routes[0].waypoints.front(), cellCenter(0, 1)) && same(routes[0].waypoints.back(), cellCenter(11, 1)));
+    assert(same(routes[1].waypoints.back(), cellCenter(0, 1)));
+    assert(routes[0].waypoints.size() == 12);                       // priority vehicle drives straight through
+    assertConflictFree(routes);
+    assert(!coordinator.lastStats().usedConflictSearch);
+
+    // Without a pocket they cannot pass
+    GridReplanner closed = corridor(12, -1);
+    AisleCoordinator blocked(closed);
+    routes = blocked.coordinate(vehicles);
+    assert(!(routes[0].planned && routes[1].planned));
+    assertConflictFree(routes);
+
+    bool threw = false;
+    try {
+        coordinator.coordinate({{3, Vec2{-4.0, 1.5}, cellCenter(3, 1)}});
+    } catch (const std::out_of_range&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "✅ Head-on corridor tests passed\n";
+}
+
+/**
+ * @brief Tests the conflict-based search fallback
+ *
+ * The priority vehicle's bay lies in the corridor the second vehicle must
+ * pass through. Prioritized planning parks the first vehicle there and
+ * strands the second; conflict-based search instead sends the first one
+ * into the pocket until the second has passed.
+ */
+void testConflictSearchFallback() {
+    std::cout << "Testing conflict-based search fallback...\n";
+
+    GridReplanner grid = corridor(10, 4);
+    AisleCoordinator coordinator(grid);
+    std::vector<AisleVehicle> vehicles = {
+        {1, cellCenter(2, 1), cellCenter(3, 1)},
+        {2, cellCenter(0, 1), cellCenter(9, 1)},
+    };
+    std::vector<AisleRoute> routes = coordinator.coordinate(vehicles);
+    const CoordinatorStats& stats = coordinator.lastStats();
+    assert(stats.usedConflictSearch && stats.conflictNodes > 0);
+    assert(stats.prioritizedFailures == 0);
+    assert(routes[0].planned && routes[1].planned);
+    assert(same(routes[0].waypoints.back(), cellCenter(3, 1)) && same(routes[1].waypoints.back(), cellCenter(9, 1)));
+    bool usedPocket = false;
+    for (const Vec2& p : routes[0].waypoints) usedPocket |= same(p, cellCenter(4, 2));
+    assert(usedPocket);
+    assertConflictFree(routes);
+
+    std::cout << "✅ Conflict-based search tests passed\n";
+}
+
+/**
+ * @brief Tests many vehicles in one lot and the expansion budget
+ */
+void testManyVehicles() {
+    std::cout << "Testing many vehicles...\n";
+
+    // 40 x 24 lot: four rows of bays separated by aisles, entrance column on the left
+    GridReplanner grid(Vec2{0, 0}, 1.0, 40, 24);
+    std::vector<Vec2> bays;
+    for (int row = 0; row < 4; ++row)
+        for (int col = 3; col < 39; col += 2) {
+            int y = 1 + row * 6;
+            if ((col / 2 + row) % 3 == 0)
+                bays.push_back(cellCenter(col, y));
+            else
+                grid.addObstacle(OrientedBox{cellCenter(col, y), 0.4, 0.4, 0.0});
+        }
+    std::vector<AisleVehicle> vehicles;
+    for (int i = 0; i < 24 && i < static_cast<int>(bays.size()); ++i)
+        vehicles.push_back(AisleVehicle{i, cellCenter(i % 2, 3 + i / 2 % 20), bays[i]});
+
+    AisleCoordinator coordinator(grid);
+    std::vector<AisleRoute> routes = coordinator.coordinate(vehicles);
+    for (std::size_t i = 0; i < routes.size(); ++i) {
+        assert(routes[i].planned);
+        assert(same(routes[i].waypoints.back(), vehicles[i].goal));
+    }
+    assertConflictFree(routes);
+    assert(!coordinator.lastStats().budgetExhausted);
+
+    // A tiny budget degrades gracefully: nothing unsafe, nothing thrown
+    CoordinatorLimits tight;
+    tight.maxExpansions = 200;
+    AisleCoordinator starved(grid, tight);
+    routes = starved.coordinate(vehicles);
+    assert(starved.lastStats().budgetExhausted);
+    assert(starved.lastStats().expansions <= 200);
+    assertConflictFree(routes);
+    std::size_t planned = 0;
+    for (const AisleRoute& r : routes) planned += r.planned;
+    assert(planned < vehicles.size());
+
+    // Vehicles the prioritized pass routed before the budget ran out keep their routes
+    assert(planned > 0);
+    for (std::size_t i = 0; i < routes.size(); ++i)
+        if (routes[i].planned) assert(same(routes[i].waypoints.back(), vehicles[i].goal));
+
+    std::cout << "✅ Many vehicle tests passed\n";
+}
+
+/**
+ * @brief Tests bay allocation and routing of arrivals
+ *
+ * Test Cases:
+ * - Bays are chosen like findFreeBay(), in arrival order, and marked occupied
+ * - Arrivals without a fitting bay come back unplanned
+ * - Bays of arrivals that cannot be routed are released
+ * - Missing bay entries and off-grid starts are rejected, releasing claimed bays
+ */
+void testAdmitArrivals() {
+    std::cout << "Testing arrival admission...\n";
+
+    GridReplanner grid = corridor(12, 6);
+    ParkingLotIndex index({{10, 4.5, false}, {11, 6.0, false}, {12, 4.5, true}, {13, 6.0, false}});
+    std::unordered_map<int, Vec2> entries = {
+        {10, cellCenter(8, 1)}, {11, cellCenter(11, 1)}, {12, cellCenter(5, 1)}, {13, cellCenter(6, 2)}};
+    AisleCoordinator coordinator(grid);
+
+    std::vector<AisleArrival> arrivals = {
+        {1, cellCenter(0, 1), 5.5},   // bay 11 (first free >= 5.5)
+        {2, cellCenter(1, 1), 4.0},   // bay 10
+        {3, cellCenter(2, 1), 7.0},   // nothing fits
+    };
+    std::vector<AisleRoute> routes = coordinator.admitArrivals(index, entries, arrivals);
+    assert(routes.size() == 3);
+    assert(routes[0].planned && routes[0].bayId == 11 && routes[0].vehicleId == 1);
+    assert(routes[1].planned && routes[1].bayId == 10);
+    assert(!routes[2].planned && routes[2].bayId == -1 && routes[2].vehicleId == 3);
+    assertConflictFree(routes);
+    assert(!index.setOccupied(11, true) && !index.setOccupied(10, true));
+
+    // Bay 13 is free and fits but its entry cannot be reached in time: claim released
+    CoordinatorLimits shortHorizon;
+    shortHorizon.horizon = 3;
+    AisleCoordinator hurried(grid, shortHorizon);
+    routes = hurried.admitArrivals(index, entries, {{4, cellCenter(0, 1), 5.0}});
+    assert(!routes[0].planned && routes[0].bayId == -1);
+    assert(index.setOccupied(13, true));
+    index.setOccupied(13, false);
+
+    entries.erase(13);
+    bool threw = false;
+    try {
+        coordinator.admitArrivals(index, entries, {{5, cellCenter(0, 1), 5.0}});
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    // Both arrivals claim a bay before the second one turns out to start off the grid
+    index.setOccupied(10, false);
+    index.setOccupied(11, false);
+    threw = false;
+    try {
+        coordinator.admitArrivals(index, entries, {{6, cellCenter(0, 1), 4.0}, {7, cellCenter(-3, 1), 5.5}});
+    } catch (const std::out_of_range&) {
+        threw = true;
+    }
+    assert(threw);
+    assert(index.setOccupied(10, true) && index.setOccupied(11, true));
+
+    std::cout << "✅ Arrival admission tests passed\n";
+}
+
+/**
+ * @brief Executes all aisle coordinator tests
+ * @return 0 on success, 1 on failure
+ */
+int runAllTests() {
+    std::cout << "=== Running Aisle Coordinator Unit Tests ===\n\n";
+
+    try {
+        testReservationTable();
+        testHeadOnCorridor();
+        testConflictSearchFallback();
+        testManyVehicles();
+        testAdmitArrivals();
+
+        std::cout << "\n🎉 All tests passed successfully!\n";
+        std::cout << "Total tests run: 5\n";
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
+
+/**
+ * @brief Main entry point for the aisle coordinator test suite
+ * @return 0 on success, 1 on failure
+ */
+int main() {
+    return runAllTests();
+}
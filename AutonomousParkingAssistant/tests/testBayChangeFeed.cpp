@@ -0,0 +1,233 @@
+/**
+ * @file testBayChangeFeed.cpp
+ * @brief Unit tests for the bay change feed
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ *
+ * Test Coverage:
+ * - Publish/poll ordering and sequence numbers
+ * - Independent subscribers and late subscription
+ * - Overrun detection when a subscriber is lapped
+ * - Integration with ParkingLotIndex updates
+ * - Shared-memory create/attach (POSIX only)
+ * - Concurrent producer and subscribers
+ */
+
+#include "../include/BayChangeFeed.h"
+#include "../include/LotIndex.h"
+#include <atomic>
+#include <cassert>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Tests basic publish/poll behaviour
+ *
+ * Test Cases:
+ * - Capacity is rounded to a power of two
+ * - Events arrive in order with consecutive sequence numbers
+ * - A caught-up subscriber polls nothing
+ * - Subscribers are independent; late subscribers only see new events
+ */
+void testPublishAndPoll() {
+    std::cout << "Testing publish and poll...\n";
+
+    BayChangeFeed feed(10);
+    assert(feed.capacity() == 16);
+    assert(feed.lastSequence() == 0);
+
+    FeedSubscriber a(feed);
+    assert(feed.publish(7, true) == 1);
+    assert(feed.publish(8, false) == 2);
+    FeedSubscriber late(feed);
+    FeedSubscriber replay(feed, true);
+
+    BayEvent e;
+    assert(a.poll(e) && e.sequence == 1 && e.bayId == 7 && e.occupied);
+    assert(a.poll(e) && e.sequence == 2 && e.bayId == 8 && !e.occupied);
+    assert(!a.poll(e));
+    assert(!late.poll(e));
+    assert(replay.poll(e) && e.sequence == 1);
+
+    feed.publish(9, true);
+    assert(late.poll(e) && e.bayId == 9);
+    assert(a.poll(e) && e.sequence == 3);
+    assert(a.lost() == 0);
+
+    std::cout << "✅ Publish and poll tests passed\n";
+}
+
+/**
+ * @brief Tests that a lapped subscriber skips to the oldest retained event
+ */
+void testOverrun() {
+    std::cout << "Testing subscriber overrun...\n";
+
+    BayChangeFeed feed(8);
+    FeedSubscriber slow(feed);
+    for (int i = 0; i < 20; ++i) feed.publish(i, true);
+
+    BayEvent e;
+    assert(slow.poll(e));
+    assert(e.sequence == 13);   // 20 - 8 + 1
+    assert(e.bayId == 12);
+    assert(slow.lost() == 12);
+    int remaining = 0;
+    while (slow.poll(e)) remaining++;
+    assert(remaining == 7);
+    assert(slow.nextSequence() == 21);
+
+    std::cout << "✅ Subscriber overrun tests passed\n";
+}
+
+/**
+ * @brief Tests that lot index updates are published to an attached feed
+ *
+ * Test Cases:
+ * - One event per changed bay, none for no-op updates
+ * - Batch updates publish every changed bay
+ */
+void testLotIndexIntegration() {
+    std::cout << "Testing lot index integration...\n";
+
+    BayChangeFeed feed(64);
+    ParkingLotIndex index({{1, 5.0, false}, {2, 5.0, false}, {3, 5.0, true}});
+    index.setChangeFeed(&feed);
+    FeedSubscriber sign(feed);
+
+    index.setOccupied(1, true);
+    index.setOccupied(1, true);   // no change, no event
+    index.applyUpdates({{2, true}, {3, false}});
+
+    BayEvent e;
+    assert(sign.poll(e) && e.bayId == 1 && e.occupied);
+    assert(sign.poll(e) && e.bayId == 2 && e.occupied);
+    assert(sign.poll(e) && e.bayId == 3 && !e.occupied);
+    assert(!sign.poll(e));
+
+    index.setChangeFeed(nullptr);
+    index.setOccupied(1, false);
+    assert(!sign.poll(e));
+
+    std::cout << "✅ Lot index integration tests passed\n";
+}
+
+/**
+ * @brief Tests a shared-memory feed attached through a second mapping
+ *
+ * The second mapping stands in for a separate display process: it sees
+ * the same header and ring through a different virtual address. The
+ * view is read-only, so publishing through it is rejected.
+ */
+void testSharedMemoryFeed() {
+    std::cout << "Testing shared memory feed...\n";
+
+#if defined(__unix__) || defined(__APPLE__)
+    const std::string name = "/parking_feed_test";
+    {
+        BayChangeFeed producer = BayChangeFeed::createShared(name, 32);
+        BayChangeFeed view = BayChangeFeed::attachShared(name);
+        assert(view.capacity() == 32);
+
+        FeedSubscriber display(view);
+        producer.publish(42, true);
+        BayEvent e;
+        assert(display.poll(e) && e.bayId == 42 && e.occupied && e.sequence == 1);
+        assert(view.lastSequence() == 1);
+
+        bool rejected = false;
+        try {
+            view.publish(43, true);
+        } catch (const std::runtime_error&) {
+            rejected = true;
+        }
+        assert(rejected && view.lastSequence() == 1);
+    }
+    BayChangeFeed::unlinkShared(name);
+
+    bool threw = false;
+    try {
+        BayChangeFeed::attachShared(name);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+#else
+    std::cout << "(skipped: no shared memory support)\n";
+#endif
+
+    std::cout << "✅ Shared memory feed tests passed\n";
+}
+
+/**
+ * @brief Tests concurrent subscribers against a running producer
+ *
+ * Subscribers must see strictly increasing sequences, and every event
+ * must be either delivered or counted as lost.
+ */
+void testConcurrentSubscribers() {
+    std::cout << "Testing concurrent subscribers...\n";
+
+    const int kEvents = 200000;
+    BayChangeFeed feed(1024);
+    std::atomic<int> ready(0);
+    std::atomic<int> errors(0);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 3; ++t) {
+        threads.emplace_back([&]() {
+            FeedSubscriber sub(feed, true);
+            ready++;
+            std::uint64_t last = 0;
+            std::uint64_t delivered = 0;
+            BayEvent e;
+            while (last < static_cast<std::uint64_t>(kEvents)) {
+                if (!sub.poll(e)) continue;
+                if (e.sequence <= last || e.bayId != static_cast<int>(e.sequence % 500)) errors++;
+                last = e.sequence;
+                delivered++;
+            }
+            if (delivered + sub.lost() != static_cast<std::uint64_t>(kEvents)) errors++;
+        });
+    }
+    while (ready.load() < 3) std::this_thread::yield();
+    for (int i = 1; i <= kEvents; ++i) feed.publish(i % 500, i % 2 == 0);
+    for (std::size_t t = 0; t < threads.size(); ++t) threads[t].join();
+
+    assert(errors.load() == 0);
+    std::cout << "✅ Concurrent subscriber tests passed\n";
+}
+
+/**
+ * @brief Executes all change feed tests
+ * @return 0 on success, 1 on failure
+ */
+int runAllTests() {
+    std::cout << "=== Running Bay Change Feed Unit Tests ===\n\n";
+
+    try {
+        testPublishAndPoll();
+        testOverrun();
+        testLotIndexIntegration();
+        testSharedMemoryFeed();
+        testConcurrentSubscribers();
+
+        std::cout << "\n🎉 All tests passed successfully!\n";
+        std::cout << "Total tests run: 5\n";
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
+
+/**
+ * @brief Main entry point for the change feed test suite
+ * @return 0 on success, 1 on failure
+ */
+int main() {
+    return runAllTests();
+}
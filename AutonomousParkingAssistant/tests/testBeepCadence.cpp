@@ -0,0 +1,218 @@
+/**
+ * @file testBeepCadence.cpp
+ * @brief Unit tests for the timer-driven beep cadence engine
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ *
+ * Test Coverage:
+ * - Distance and time-to-collision mapping to beep intervals
+ * - Steady cadence while frames arrive irregularly
+ * - Speed-up on approach, silence when clear, start/stop
+ */
+
+#include "../include/BeepCadence.h"
+#include "TestSupport.h"
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief Sink that keeps every beep for inspection
+ */
+struct BeepRecorder {
+    std::mutex mutex;
+    std::vector<BeepEvent> events;
+
+    BeepCadence::Sink sink() {
+        return [this](const BeepEvent& e) {
+            std::lock_guard<std::mutex> lock(mutex);
+            events.push_back(e);
+        };
+    }
+    std::vector<BeepEvent> snapshot() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return events;
+    }
+};
+
+void sleepMs(int ms) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+/**
+ * @brief Short intervals so the timing tests finish quickly
+ */
+BeepCadenceConfig fastConfig() {
+    BeepCadenceConfig config;
+    config.minInterval = 0.02;
+    config.maxInterval = 0.2;
+    return config;
+}
+
+} // namespace
+
+/**
+ * @brief Tests the distance and time-to-collision mapping
+ */
+void testIntervalMapping() {
+    std::cout << "Testing interval mapping...\n";
+
+    BeepCadenceConfig config;   // 1.5 m .. 0.3 m, 0.8 s .. 0.08 s
+    assert(std::isinf(beepInterval(1.5, 0.0, config)) && std::isinf(beepInterval(4.0, 3.0, config)));
+    assert(std::isinf(beepInterval(std::nan(""), 0.0, config)));
+    assert(near(beepInterval(0.3, 0.0, config), 0.08) && near(beepInterval(0.05, 0.0, config), 0.08));
+    assert(near(beepInterval(0.9, 0.0, config), 0.44));
+    assert(near(beepInterval(0.9, -1.0, config), 0.44));       // moving away changes nothing
+
+    // 1 m at 2 m/s: half a second to collision caps the interval at 0.8 * 0.5 / 1.5
+    assert(near(beepInterval(1.0, 2.0, config), 0.8 * 0.5 / 1.5));
+    assert(near(beepInterval(1.0, 0.1, config), beepInterval(1.0, 0.0, config)));   // 10 s away
+    assert(near(beepInterval(0.1, 10.0, config), 0.08));       // never below the fastest cadence
+    for (double d = 0.3; d < 1.5; d += 0.01) assert(beepInterval(d, 0.0, config) <= beepInterval(d + 0.01, 0.0, config));
+
+    BeepCadenceConfig bad[4];
+    bad[0].continuousDistance = 2.0;
+    bad[1].minInterval = 0.0;
+    bad[2].maxInterval = 0.01;
+    bad[3].ttcHorizon = 0.0;
+    for (const BeepCadenceConfig& c : bad) {
+        bool threw = false;
+        try {
+            BeepCadence invalid([](const BeepEvent&) {}, c);
+        } catch (const std::invalid_argument&) {
+            threw = true;
+        }
+        assert(threw);
+    }
+    bool threw = false;
+    try {
+        BeepCadence::Sink empty;
+        BeepCadence noSink(empty);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "✅ Interval mapping tests passed\n";
+}
+
+/**
+ * @brief Tests that the cadence stays steady while frames arrive irregularly
+ *
+ * Beeps must follow their own schedule, one interval apart, no matter
+ * when the (unchanged) readings come in.
+ */
+void testSteadyCadence() {
+    std::cout << "Testing steady cadence with irregular frames...\n";
+
+    BeepRecorder recorder;
+    BeepCadenceConfig config = fastConfig();
+    BeepCadence cadence(recorder.sink(), config);
+    cadence.start();
+    assert(cadence.running());
+
+    std::srand(65);
+    const SensorData reading{0.9, 1.2, 1.3};
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now() + std::chrono::milliseconds(700);
+    while (std::chrono::steady_clock::now() < end) {
+        cadence.update(reading);
+        sleepMs(5 + std::rand() % 90);   // 5..95 ms between frames
+    }
+    cadence.stop();
+    assert(!cadence.running());
+
+    std::vector<BeepEvent> events = recorder.snapshot();
+    const double expected = beepInterval(0.9, 0.0, config);   // 0.11 s
+    assert(events.size() >= 4 && events.size() <= 8);
+    for (std::size_t i = 0; i < events.size(); ++i) {
+        assert(near(events[i].interval, expected, 1e-9) && !events[i].continuous);
+        assert(events[i].firedNs >= events[i].scheduledNs);
+        if (i > 0) assert(std::llabs(events[i].scheduledNs - events[i - 1].scheduledNs - 110000000) < 1000);
+    }
+    CadenceStats stats = cadence.stats();
+    assert(stats.beeps == events.size());
+    assert(stats.meanJitterUs >= 0.0 && stats.maxJitterUs >= stats.meanJitterUs);
+    assert(stats.meanJitterUs < 20000.0);
+
+    std::cout << "✅ Steady cadence tests passed\n";
+}
+
+/**
+ * @brief Tests speed-up on approach and silence when clear
+ */
+void testApproachAndSilence() {
+    std::cout << "Testing approach and silence...\n";
+
+    BeepRecorder recorder;
+    BeepCadence cadence(recorder.sink(), fastConfig());
+    cadence.start();
+    cadence.start();   // already running: no-op
+
+    cadence.update(SensorData{3.0, 2.0, 3.0});
+    sleepMs(150);
+    assert(recorder.snapshot().empty());
+
+    // Close in from 1.4 m to 0.2 m over about 0.6 s, one frame every 30 ms
+    for (int i = 0; i <= 20; ++i) {
+        cadence.update(SensorData{3.0, 1.4 - 0.06 * i, 3.0});
+        sleepMs(30);
+    }
+    assert(cadence.closingSpeed() > 0.5);
+    sleepMs(60);
+    std::vector<BeepEvent> approach = recorder.snapshot();
+    assert(approach.size() >= 6);
+    assert(approach.front().interval > approach.back().interval);
+    assert(approach.back().continuous && near(approach.back().interval, 0.02));
+
+    // Back off: speed turns negative and the beeps stop
+    cadence.update(SensorData{3.0, 1.0, 3.0});
+    cadence.update(SensorData{3.0, 2.5, 3.0});
+    sleepMs(20);
+    std::size_t before = recorder.snapshot().size();
+    sleepMs(150);
+    assert(recorder.snapshot().size() == before);
+
+    cadence.stop();
+    cadence.stop();
+    assert(cadence.stats().beeps == recorder.snapshot().size());
+
+    std::cout << "✅ Approach and silence tests passed\n";
+}
+
+/**
+ * @brief Executes all beep cadence tests
+ * @return 0 on success, 1 on failure
+ */
+int runAllTests() {
+    std::cout << "=== Running Beep Cadence Unit Tests ===\n\n";
+
+    try {
+        testIntervalMapping();
+        testSteadyCadence();
+        testApproachAndSilence();
+
+        std::cout << "\n🎉 All tests passed successfully!\n";
+        std::cout << "Total tests run: 3\n";
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
+
+/**
+ * @brief Main entry point for the beep cadence test suite
+ * @return 0 on success, 1 on failure
+ */
+int main() {
+    return runAllTests();
+}
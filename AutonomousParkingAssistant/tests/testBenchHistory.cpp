@@ -0,0 +1,232 @@
+/**
+ * @file testBenchHistory.cpp
+ * @brief Unit tests for the benchmark history and regression detection
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ *
+ * Test Coverage:
+ * - Student's t tail probabilities and Welch's t-test
+ * - Regression decisions for time and allocations
+ * - History file round trip and validation
+ */
+
+#include "../include/BenchHistory.h"
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::vector<BenchSample> runs(const std::string& commit, const std::string& benchmark,
+                              const std::vector<double>& nsPerOp, double allocsPerOp) {
+    std::vector<BenchSample> samples;
+    for (double ns : nsPerOp) samples.push_back(BenchSample{commit, benchmark, ns, allocsPerOp});
+    return samples;
+}
+
+} // namespace
+
+/**
+ * @brief Tests the statistics
+ *
+ * Test Cases:
+ * - Tail probabilities match closed forms for 1 and 2 degrees of freedom
+ *   and the normal distribution for many
+ * - Welch's test reproduces a published example (t = 2.46, df = 25)
+ * - Constant samples give exact results; fewer than two values are rejected
+ */
+void testWelchTest() {
+    std::cout << "Testing Welch's t-test...\n";
+
+    assert(std::fabs(studentTUpperTail(1.0, 1.0) - 0.25) < 1e-9);
+    assert(std::fabs(studentTUpperTail(-1.0, 1.0) - 0.75) < 1e-9);
+    assert(std::fabs(studentTUpperTail(2.0, 2.0) - (0.5 - 1.0 / std::sqrt(6.0))) < 1e-9);
+    assert(std::fabs(studentTUpperTail(0.0, 7.5) - 0.5) < 1e-12);
+    assert(std::fabs(studentTUpperTail(1.6448536, 1e7) - 0.05) < 1e-5);
+
+    const std::vector<double> a1 = {27.5, 21.0, 19.0, 23.6, 17.0, 17.9, 16.9, 20.1,
+                                    21.9, 22.6, 23.1, 19.6, 19.0, 21.7, 21.4};
+    const std::vector<double> a2 = {27.1, 22.0, 20.8, 23.4, 23.4, 23.5, 25.8, 22.0,
+                                    24.8, 20.2, 21.9, 22.1, 22.9, 20.5, 24.4};
+    WelchResult larger = welchTest(a1, a2);
+    assert(std::fabs(larger.t - 2.46) < 0.01 && std::fabs(larger.degreesOfFreedom - 25.0) < 0.1);
+    assert(std::fabs(larger.pValue - 0.021 / 2) < 0.001);
+    WelchResult smaller = welchTest(a2, a1);
+    assert(std::fabs(smaller.t + larger.t) < 1e-12 && std::fabs(smaller.pValue + larger.pValue - 1.0) < 1e-9);
+
+    assert(welchTest({3.0, 3.0}, {4.0, 4.0, 4.0}).pValue == 0.0);
+    assert(welchTest({3.0, 3.0}, {3.0, 3.0}).pValue == 1.0);
+    assert(welchTest({3.0, 3.0}, {2.0, 2.0}).pValue == 1.0);
+
+    bool threw = false;
+    try {
+        welchTest({1.0}, {1.0, 2.0});
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "✅ Welch's t-test tests passed\n";
+}
+
+/**
+ * @brief Tests regression decisions
+ *
+ * Test Cases:
+ * - A clear slowdown is flagged; noise and speedups are not
+ * - A slowdown below the minimum change passes even when significant
+ * - An extra allocation per operation is flagged
+ * - Benchmarks without enough runs on either side are returned as skipped
+ */
+void testFindRegressions() {
+    std::cout << "Testing regression detection...\n";
+
+    std::vector<BenchSample> base = runs("aaa", "regression/checkSafety", {80, 81, 79, 80, 82}, 1.0);
+    std::vector<BenchSample> more = runs("aaa", "regression/requiredSpace", {2.0, 2.1, 1.9, 2.0, 2.0}, 0.0);
+    base.insert(base.end(), more.begin(), more.end());
+    more = runs("aaa", "regression/replay", {500, 505, 498}, 0.0);
+    base.insert(base.end(), more.begin(), more.end());
+
+    std::vector<BenchSample> next = runs("bbb", "regression/checkSafety", {95, 96, 94, 97, 95}, 1.0);
+    more = runs("bbb", "regression/requiredSpace", {2.0, 1.9, 2.1, 2.0, 2.1}, 1.0);
+    next.insert(next.end(), more.begin(), more.end());
+    more = runs("bbb", "regression/replay", {400}, 0.0);
+    next.insert(next.end(), more.begin(), more.end());
+    more = runs("bbb", "regression/findParkingSpace", {300, 301}, 4.0);
+    next.insert(next.end(), more.begin(), more.end());
+
+    std::vector<RegressionCheck> checks = findRegressions(base, next);
+    assert(checks.size() == 6);
+    assert(checks[0].benchmark == "regression/checkSafety" && checks[0].metric == "ns/op");
+    assert(checks[0].regression && checks[0].change > 0.17 && checks[0].pValue < 1e-4);
+    assert(checks[1].metric == "allocs/op" && !checks[1].regression && checks[1].change == 0.0);
+    assert(checks[2].benchmark == "regression/requiredSpace" && !checks[2].regression);
+    assert(checks[3].regression && checks[3].baselineMean == 0.0 && std::isinf(checks[3].change));
+    for (const RegressionCheck& check : checks) assert(check.skipped.empty() == !check.metric.empty());
+    assert(checks[4].benchmark == "regression/replay" && !checks[4].regression);
+    assert(checks[4].skipped.find("1 candidate") != std::string::npos);
+    assert(checks[5].benchmark == "regression/findParkingSpace" && checks[5].skipped == "no baseline runs");
+
+    RegressionConfig strict;
+    strict.minChange = 0.25;
+    assert(!findRegressions(base, next, strict)[0].regression);
+
+    std::vector<RegressionCheck> reversed = findRegressions(next, base);
+    for (const RegressionCheck& check : reversed) assert(!check.regression);
+    assert(reversed.size() == 6 && reversed[5].benchmark == "regression/findParkingSpace");
+    assert(reversed[5].skipped == "no candidate runs");
+    assert(findRegressions(more, base).size() == 4);   // nothing comparable: every benchmark skipped
+    for (const RegressionCheck& check : findRegressions(more, base)) assert(!check.skipped.empty());
+
+    RegressionConfig invalid;
+    invalid.alpha = 0.0;
+    bool threw = false;
+    try {
+        findRegressions(base, next, invalid);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "✅ Regression detection tests passed\n";
+}
+
+/**
+ * @brief Tests the history file
+ *
+ * Test Cases:
+ * - Appended runs read back in order, across several appends, with comments skipped
+ * - A missing file is an empty history
+ * - Names with spaces and malformed lines are rejected
+ * - Runs of a commit are found by its recorded name, an abbreviation or a longer hash
+ */
+void testHistoryFile() {
+    std::cout << "Testing history file...\n";
+
+    const std::string path = "testBenchHistory.tmp";
+    std::remove(path.c_str());
+    assert(loadBenchHistory(path).empty());
+
+    appendBenchHistory(path, runs("abc123", "regression/checkSafety", {80.5, 81.25}, 1.0));
+    {
+        std::ofstream file(path, std::ios::app);
+        file << "# rebuilt with -O3\n\n";
+    }
+    appendBenchHistory(path, runs("def456", "regression/checkSafety", {79.125}, 0.5));
+    std::vector<BenchSample> history = loadBenchHistory(path);
+    assert(history.size() == 3);
+    assert(history[0].commit == "abc123" && history[0].benchmark == "regression/checkSafety");
+    assert(history[1].nsPerOp == 81.25 && history[1].allocsPerOp == 1.0);
+    assert(history[2].commit == "def456" && history[2].nsPerOp == 79.125 && history[2].allocsPerOp == 0.5);
+
+    assert(commitRuns(history, "abc123").size() == 2 && commitRuns(history, "abc").size() == 2);
+    assert(commitRuns(history, "def456789abcdef").size() == 1);
+    assert(commitRuns(history, "def456-dirty").empty() && commitRuns(history, "fed").empty());
+    history.push_back(BenchSample{"abc123-dirty", "regression/checkSafety", 90.0, 1.0});
+    assert(commitRuns(history, "abc123").size() == 2 && commitRuns(history, "abc123-dirty").size() == 1);
+    bool threw = false;
+    try {
+        commitRuns(history, "abc1");
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    threw = false;
+    try {
+        appendBenchHistory(path, runs("has space", "regression/checkSafety", {1.0}, 0.0));
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw && loadBenchHistory(path).size() == 3);
+
+    {
+        std::ofstream file(path, std::ios::app);
+        file << "ghi789 regression/checkSafety fast 0\n";
+    }
+    threw = false;
+    try {
+        loadBenchHistory(path);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    std::remove(path.c_str());
+
+    std::cout << "✅ History file tests passed\n";
+}
+
+/**
+ * @brief Executes all benchmark history tests
+ * @return 0 on success, 1 on failure
+ */
+int runAllTests() {
+    std::cout << "=== Running Benchmark History Unit Tests ===\n\n";
+
+    try {
+        testWelchTest();
+        testFindRegressions();
+        testHistoryFile();
+
+        std::cout << "\n🎉 All tests passed successfully!\n";
+        std::cout << "Total tests run: 3\n";
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
+
+/**
+ * @brief Main entry point for the benchmark history test suite
+ * @return 0 on success, 1 on failure
+ */
+int main() {
+    return runAllTests();
+}
@@ -0,0 +1,270 @@
+/**
+ * @file testClearanceMap.cpp
+ * @brief Unit tests for the distance-transform clearance map
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ *
+ * Test Coverage:
+ * - Clearances around a single obstacle, the distance cap and out-of-map queries
+ * - Exact agreement with a brute-force distance transform
+ * - Incremental bay updates agreeing with a full recomputation
+ * - Save/load round trip including registered bays
+ */
+
+#include "../include/ClearanceMap.h"
+#include "TestSupport.h"
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief Brute-force capped clearance of a cell (reference)
+ */
+double bruteClearance(const ClearanceMap& map, int col, int row) {
+    double best = 1e300;
+    for (int r = 0; r < map.rows(); ++r)
+        for (int c = 0; c < map.cols(); ++c)
+            if (map.isObstacle(c, r)) best = std::min(best, std::hypot(c - col, r - row) * map.resolution());
+    return std::min(best, map.maxDistance());
+}
+
+/**
+ * @brief Asserts that every cell of two maps matches
+ */
+void assertSameField(const ClearanceMap& a, const ClearanceMap& b) {
+    assert(a.cols() == b.cols() && a.rows() == b.rows());
+    for (int r = 0; r < a.rows(); ++r)
+        for (int c = 0; c < a.cols(); ++c) {
+            assert(a.isObstacle(c, r) == b.isObstacle(c, r));
+            assert(near(a.clearanceAt(c, r), b.clearanceAt(c, r), 1e-5));
+        }
+}
+
+/**
+ * @brief Builds a lot with two rows of bays and a wall, half of the bays occupied
+ */
+void buildLot(ClearanceMap& map, int bays, unsigned seed) {
+    std::srand(seed);
+    map.addObstacle(OrientedBox{Vec2{15.0, 0.15}, 15.0, 0.15, 0.0});   // wall along the bottom
+    for (int i = 0; i < bays; ++i) {
+        double x = 1.5 + 2.7 * (i % 10);
+        double y = i < 10 ? 3.0 : 11.0;
+        map.addBay(i, OrientedBox{Vec2{x, y}, 1.1, 2.3, 0.0}, std::rand() % 2 == 0);
+    }
+}
+
+} // namespace
+
+/**
+ * @brief Tests clearances around a single obstacle
+ *
+ * Test Cases:
+ * - Obstacle cells read 0, neighbours read one cell size
+ * - Distances are Euclidean, not city-block
+ * - Clearances saturate at maxDistance
+ * - Queries outside the map read 0
+ */
+void testSingleObstacle() {
+    std::cout << "Testing single obstacle clearances...\n";
+
+    ClearanceMap map(Vec2{0, 0}, 0.5, 40, 30, 5.0);
+    map.addObstacle(OrientedBox{Vec2{5.25, 5.25}, 0.1, 0.1, 0.0});   // cell (10, 10)
+    map.compute();
+
+    assert(map.isObstacle(10, 10));
+    assert(near(map.clearanceAt(10, 10), 0.0, 1e-5));
+    assert(near(map.clearanceAt(11, 10), 0.5, 1e-5));
+    assert(near(map.clearanceAt(13, 14), 2.5, 1e-5));                  // 3-4-5 triangle
+    assert(near(map.clearance(Vec2{5.3, 7.3}), 2.0, 1e-5));             // cell (10, 14)
+    assert(near(map.clearanceAt(39, 29), 5.0, 1e-5));                  // capped
+    assert(map.clearance(Vec2{-0.1, 3.0}) == 0.0);
+    assert(map.clearance(Vec2{3.0, 15.1}) == 0.0);
+
+    bool threw = false;
+    try {
+        ClearanceMap bad(Vec2{0, 0}, 0.0, 10, 10);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "✅ Single obstacle tests passed\n";
+}
+
+/**
+ * @brief Tests the transform against brute force on random obstacles
+ */
+void testMatchesBruteForce() {
+    std::cout << "Testing distance transform against brute force...\n";
+
+    std::srand(3);
+    for (int trial = 0; trial < 5; ++trial) {
+        ClearanceMap map(Vec2{0, 0}, 0.25, 61, 37, 4.0);
+        int obstacles = trial == 0 ? 0 : 1 + std::rand() % 12;
+        for (int i = 0; i < obstacles; ++i) {
+            map.addObstacle(OrientedBox{Vec2{(std::rand() % 1500) / 100.0, (std::rand() % 900) / 100.0},
+                                        (std::rand() % 100) / 100.0, (std::rand() % 50) / 100.0,
+                                        (std::rand() % 628) / 100.0});
+        }
+        map.compute();
+        for (int r = 0; r < map.rows(); ++r)
+            for (int c = 0; c < map.cols(); ++c) assert(near(map.clearanceAt(c, r), bruteClearance(map, c, r), 1e-5));
+    }
+
+    std::cout << "✅ Brute force comparison tests passed\n";
+}
+
+/**
+ * @brief Tests incremental bay updates against full recomputation
+ *
+ * Test Cases:
+ * - Toggling bays updates only what a full compute() would change
+ * - Setting the current state reports no change
+ * - Unknown and duplicate bays are rejected
+ */
+void testIncrementalUpdates() {
+    std::cout << "Testing incremental bay updates...\n";
+
+    ClearanceMap live(Vec2{0, 0}, 0.1, 300, 160, 3.0);
+    buildLot(live, 20, 11);
+    live.compute();
+
+    std::vector<bool> occupied(20);
+    std::srand(11);
+    for (int i = 0; i < 20; ++i) occupied[i] = std::rand() % 2 == 0;
+
+    std::srand(99);
+    for (int step = 0; step < 15; ++step) {
+        int bay = std::rand() % 20;
+        occupied[bay] = !occupied[bay];
+        assert(live.setBayOccupied(bay, occupied[bay]));
+        assert(!live.setBayOccupied(bay, occupied[bay]));
+
+        ClearanceMap fresh(Vec2{0, 0}, 0.1, 300, 160, 3.0);
+        fresh.addObstacle(OrientedBox{Vec2{15.0, 0.15}, 15.0, 0.15, 0.0});
+        for (int i = 0; i < 20; ++i) {
+            double x = 1.5 + 2.7 * (i % 10);
+            double y = i < 10 ? 3.0 : 11.0;
+            fresh.addBay(i, OrientedBox{Vec2{x, y}, 1.1, 2.3, 0.0}, occupied[i]);
+        }
+        fresh.compute();
+        assertSameField(live, fresh);
+    }
+
+    bool threw = false;
+    try {
+        live.setBayOccupied(500, true);
+    } catch (const std::out_of_range&) {
+        threw = true;
+    }
+    assert(threw);
+
+    threw = false;
+    try {
+        live.addBay(3, OrientedBox{Vec2{1, 1}, 1, 1, 0}, false);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "✅ Incremental update tests passed\n";
+}
+
+/**
+ * @brief Tests saving and memory-mapping a map back
+ *
+ * Test Cases:
+ * - Loaded fields, geometry and bays match the original
+ * - Updates on the loaded map work and leave the file unchanged
+ * - Missing and malformed files are rejected
+ */
+void testSaveLoad() {
+    std::cout << "Testing save and load...\n";
+
+    const std::string path = "testClearanceMap.bin";
+    ClearanceMap original(Vec2{-5.0, 2.0}, 0.1, 300, 160, 3.0);
+    buildLot(original, 20, 5);
+    original.compute();
+    original.save(path);
+
+    {
+        ClearanceMap loaded = ClearanceMap::load(path);
+        assert(near(loaded.origin().x, -5.0, 1e-5) && near(loaded.origin().y, 2.0, 1e-5));
+        assert(near(loaded.resolution(), 0.1, 1e-5) && near(loaded.maxDistance(), 3.0, 1e-5));
+        assertSameField(original, loaded);
+
+        // Updating both maps the same way keeps them identical
+        for (int bay = 0; bay < 20; bay += 3) {
+            original.setBayOccupied(bay, true);
+            loaded.setBayOccupied(bay, true);
+        }
+        assertSameField(original, loaded);
+    }
+
+    // The copy-on-write mapping never wrote back to the file
+    ClearanceMap reloaded = ClearanceMap::load(path);
+    ClearanceMap reference(Vec2{-5.0, 2.0}, 0.1, 300, 160, 3.0);
+    buildLot(reference, 20, 5);
+    reference.compute();
+    assertSameField(reference, reloaded);
+
+    bool threw = false;
+    try {
+        ClearanceMap::load("does-not-exist.bin");
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+
+    FILE* junk = std::fopen(path.c_str(), "wb");
+    std::fputs("this is not a clearance map, just some text padding it out past a header", junk);
+    std::fclose(junk);
+    threw = false;
+    try {
+        ClearanceMap::load(path);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    std::remove(path.c_str());
+
+    std::cout << "✅ Save and load tests passed\n";
+}
+
+/**
+ * @brief Executes all clearance map tests
+ * @return 0 on success, 1 on failure
+ */
+int runAllTests() {
+    std::cout << "=== Running Clearance Map Unit Tests ===\n\n";
+
+    try {
+        testSingleObstacle();
+        testMatchesBruteForce();
+        testIncrementalUpdates();
+        testSaveLoad();
+
+        std::cout << "\n🎉 All tests passed successfully!\n";
+        std::cout << "Total tests run: 4\n";
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
+
+/**
+ * @brief Main entry point for the clearance map test suite
+ * @return 0 on success, 1 on failure
+ */
+int main() {
+    return runAllTests();
+}
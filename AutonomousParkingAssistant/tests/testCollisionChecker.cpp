@@ -0,0 +1,220 @@
+/**
+ * @file testCollisionChecker.cpp
+ * @brief Unit tests for the separating-axis collision checks
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ *
+ * Test Coverage:
+ * - Vehicle footprint placement relative to the rear axle
+ * - Exact overlap test on axis-aligned, rotated and touching boxes
+ * - Batched world queries agreeing with the exact test on random scenes
+ * - First colliding pose along a path, with and without margin
+ */
+
+#include "../include/CollisionChecker.h"
+#include "../include/VehicleCatalogue.h"
+#include "TestSupport.h"
+#include <cassert>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+const double kPi = 3.14159265358979323846;
+
+double randomIn(double lo, double hi) {
+    return lo + (hi - lo) * (std::rand() / static_cast<double>(RAND_MAX));
+}
+
+/**
+ * @brief Exact overlap computed from corners on all four axes (reference)
+ */
+bool cornerOverlap(const OrientedBox& a, const OrientedBox& b, double& gap) {
+    Vec2 ca[4], cb[4];
+    boxCorners(a, ca);
+    boxCorners(b, cb);
+    const double headings[] = {a.heading, a.heading + kPi / 2, b.heading, b.heading + kPi / 2};
+    gap = -1e300;
+    for (double h : headings) {
+        Vec2 axis = {std::cos(h), std::sin(h)};
+        double minA = 1e300, maxA = -1e300, minB = 1e300, maxB = -1e300;
+        for (int i = 0; i < 4; ++i) {
+            minA = std::min(minA, dot(ca[i], axis));
+            maxA = std::max(maxA, dot(ca[i], axis));
+            minB = std::min(minB, dot(cb[i], axis));
+            maxB = std::max(maxB, dot(cb[i], axis));
+        }
+        gap = std::max(gap, std::max(minB - maxA, minA - maxB));
+    }
+    return gap <= 0;
+}
+
+} // namespace
+
+/**
+ * @brief Tests the vehicle footprint rectangle
+ */
+void testFootprint() {
+    std::cout << "Testing vehicle footprint...\n";
+
+    VehicleModel v = {1.8, 2.7, 0.9, 1.0, 5.5};   // 4.6 m long
+    OrientedBox f = vehicleFootprint(v, Pose2D{10.0, 5.0, 0.0});
+    assert(near(f.center.x, 10.0 + (3.6 - 1.0) / 2.0));
+    assert(near(f.center.y, 5.0));
+    assert(near(f.halfLength, 2.3) && near(f.halfWidth, 0.9));
+
+    OrientedBox turned = vehicleFootprint(v, Pose2D{0.0, 0.0, kPi / 2}, 0.2);
+    assert(near(turned.center.x, 0.0) && near(turned.center.y, 1.3));
+    assert(near(turned.halfLength, 2.5) && near(turned.halfWidth, 1.1));
+
+    std::cout << "✅ Footprint tests passed\n";
+}
+
+/**
+ * @brief Tests the exact pairwise overlap test
+ *
+ * Test Cases:
+ * - Overlapping and separated axis-aligned boxes
+ * - Touching boxes count as overlapping
+ * - Rotated box whose AABB overlaps but the box does not
+ */
+void testBoxesOverlap() {
+    std::cout << "Testing pairwise overlap...\n";
+
+    OrientedBox a = {Vec2{0, 0}, 2.0, 1.0, 0.0};
+    assert(boxesOverlap(a, OrientedBox{Vec2{3.5, 0}, 2.0, 1.0, 0.0}));
+    assert(!boxesOverlap(a, OrientedBox{Vec2{4.5, 0}, 2.0, 1.0, 0.0}));
+    assert(boxesOverlap(a, OrientedBox{Vec2{4.0, 0}, 2.0, 1.0, 0.0}));   // touching
+    assert(!boxesOverlap(a, OrientedBox{Vec2{0, 2.5}, 2.0, 1.0, 0.0}));
+
+    // Diamond near the corner: AABBs overlap, boxes do not
+    OrientedBox diamond = {Vec2{2.9, 1.9}, 0.7, 0.7, kPi / 4};
+    assert(!boxesOverlap(a, diamond));
+    diamond.center = Vec2{2.4, 1.4};
+    assert(boxesOverlap(a, diamond));
+
+    std::cout << "✅ Pairwise overlap tests passed\n";
+}
+
+/**
+ * @brief Tests batched world queries against the corner-projection reference
+ *
+ * Pairs closer than 1 mm to touching are skipped because the batched
+ * path works in single precision.
+ */
+void testWorldMatchesReference() {
+    std::cout << "Testing batched queries against reference...\n";
+
+    std::srand(7);
+    for (int trial = 0; trial < 50; ++trial) {
+        CollisionWorld world;
+        std::vector<OrientedBox> obstacles;
+        int n = 1 + std::rand() % 23;   // exercises padding of every remainder
+        for (int i = 0; i < n; ++i) {
+            OrientedBox b = {Vec2{randomIn(0, 40), randomIn(0, 20)}, randomIn(0.2, 3.0),
+                             randomIn(0.2, 1.5), randomIn(-kPi, kPi)};
+            obstacles.push_back(b);
+            world.addObstacle(b);
+        }
+        assert(world.obstacleCount() == static_cast<std::size_t>(n));
+
+        for (int q = 0; q < 200; ++q) {
+            OrientedBox probe = {Vec2{randomIn(-5, 45), randomIn(-5, 25)}, randomIn(1.5, 2.8),
+                                 randomIn(0.7, 1.1), randomIn(-kPi, kPi)};
+            bool expected = false;
+            bool ambiguous = false;
+            for (const OrientedBox& b : obstacles) {
+                double gap;
+                bool hit = cornerOverlap(probe, b, gap);
+                assert(std::fabs(gap) < 1e-9 || hit == boxesOverlap(probe, b));
+                expected |= hit;
+                ambiguous |= std::fabs(gap) < 1e-3;
+            }
+            if (!ambiguous) assert(world.collides(probe) == expected);
+        }
+    }
+
+    bool threw = false;
+    try {
+        CollisionWorld world;
+        world.addObstacle(OrientedBox{Vec2{0, 0}, -1.0, 1.0, 0.0});
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "✅ Batched query tests passed\n";
+}
+
+/**
+ * @brief Tests path checks in a row of parked cars
+ *
+ * Test Cases:
+ * - A path down the aisle is free
+ * - A path swinging into the parked row reports its first colliding pose
+ * - A large margin makes the aisle path collide
+ * - Empty worlds and empty paths never collide
+ */
+void testPathCollision() {
+    std::cout << "Testing path collision...\n";
+
+    const VehicleModel& car = findVehicleProfile("SEDAN-04")->model;
+    CollisionWorld world;
+    for (int i = 0; i < 20; ++i) world.addObstacle(OrientedBox{Vec2{2.5 + 5.0 * i, 0.0}, 2.3, 0.9, 0.0});
+
+    std::vector<Pose2D> aisle;
+    for (int i = 0; i < 300; ++i) aisle.push_back(Pose2D{-10.0 + 0.3 * i, 3.5, 0.0});
+    assert(firstPathCollision(world, car, aisle) == -1);
+    assert(firstPathCollision(world, car, aisle, 1.8) >= 0);
+
+    std::vector<Pose2D> swing;
+    for (int i = 0; i < 300; ++i) {
+        double y = 3.5 - 0.02 * i;   // drifts toward the parked row
+        swing.push_back(Pose2D{-10.0 + 0.3 * i, y, -0.05});
+    }
+    int hit = firstPathCollision(world, car, swing);
+    assert(hit > 0);
+    for (int i = 0; i < hit; ++i)
+        assert(!world.collides(vehicleFootprint(car, swing[i])));
+    assert(world.collides(vehicleFootprint(car, swing[hit])));
+
+    CollisionWorld empty;
+    assert(firstPathCollision(empty, car, swing) == -1);
+    assert(firstPathCollision(world, car, std::vector<Pose2D>()) == -1);
+
+    std::cout << "✅ Path collision tests passed\n";
+}
+
+/**
+ * @brief Executes all collision checker tests
+ * @return 0 on success, 1 on failure
+ */
+int runAllTests() {
+    std::cout << "=== Running Collision Checker Unit Tests ===\n\n";
+
+    try {
+        testFootprint();
+        testBoxesOverlap();
+        testWorldMatchesReference();
+        testPathCollision();
+
+        std::cout << "\n🎉 All tests passed successfully!\n";
+        std::cout << "Total tests run: 4\n";
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
+
+/**
+ * @brief Main entry point for the collision checker test suite
+ * @return 0 on success, 1 on failure
+ */
+int main() {
+    return runAllTests();
+}
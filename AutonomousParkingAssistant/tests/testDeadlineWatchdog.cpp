@@ -0,0 +1,241 @@
+/**
+ * @file testDeadlineWatchdog.cpp
+ * @brief Unit tests for the control loop deadline watchdog
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ *
+ * Test Coverage:
+ * - Overrun counting and attribution to the slowest stage
+ * - Stall fallback while the frame is still running
+ * - Deadline accounting in parking sessions
+ */
+
+#include "../include/DeadlineWatchdog.h"
+#include "../include/ParkingUtils.h"
+#include "TestSupport.h"
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace {
+
+/**
+ * @brief Manually advanced time source shared with the watchdog thread
+ */
+struct ManualClock {
+    std::atomic<std::int64_t> now{0};
+
+    DeadlineWatchdog::Clock source() {
+        return [this] { return now.load(); };
+    }
+    void advanceMs(int ms) { now += static_cast<std::int64_t>(ms) * 1000000; }
+};
+
+void sleepMs(int ms) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+} // namespace
+
+/**
+ * @brief Tests deadline overrun accounting
+ *
+ * Test Cases:
+ * - Frames within the deadline are not counted
+ * - Slow frames are counted once, under the stage that took longest
+ * - Worst and mean frame times cover every frame
+ * - Deadlines that are not positive or exceed the hard limit are rejected
+ */
+void testOverruns() {
+    std::cout << "Testing deadline overruns...\n";
+
+    WatchdogConfig config;
+    config.frameDeadline = 0.005;
+    config.hardLimit = 1.0;
+    ManualClock clock;
+    DeadlineWatchdog watchdog(config, DeadlineWatchdog::StallAction(), clock.source());
+
+    for (int i = 0; i < 10; ++i) {
+        watchdog.beginFrame(LoopStage::Alert);
+        watchdog.stage(LoopStage::Classify);
+        clock.advanceMs(1);
+        watchdog.stage(LoopStage::Record);
+        assert(!watchdog.endFrame());
+        assert(watchdog.lastFrameNs() == 1000000);
+    }
+
+    watchdog.beginFrame(LoopStage::Alert);
+    watchdog.stage(LoopStage::Classify);
+    clock.advanceMs(12);
+    watchdog.stage(LoopStage::Record);
+    assert(watchdog.endFrame());
+
+    watchdog.beginFrame(LoopStage::Alert);
+    clock.advanceMs(2);
+    watchdog.stage(LoopStage::Guidance);
+    clock.advanceMs(10);
+    assert(watchdog.endFrame());
+    assert(!watchdog.stalled());
+
+    WatchdogStats stats = watchdog.stats();
+    assert(stats.frames == 12 && stats.overruns == 2 && stats.stalls == 0);
+    assert(stats.overrunsByStage[static_cast<int>(LoopStage::Classify)] == 1);
+    assert(stats.overrunsByStage[static_cast<int>(LoopStage::Guidance)] == 1);
+    assert(stats.overrunsByStage[static_cast<int>(LoopStage::Alert)] == 0);
+    assert(near(stats.worstFrameMs, 12.0) && near(stats.meanFrameUs, 34000.0 / 12));
+
+    std::ostringstream out;
+    stats.print(out, config);
+    assert(out.str().find("Deadline overruns: 2 of 12 frames (deadline 5.00 ms, worst 12.00 ms") != std::string::npos);
+    assert(out.str().find("Slowest stage: classify 1 guidance 1") != std::string::npos);
+    assert(out.str().find("Watchdog stops") == std::string::npos);
+
+    WatchdogConfig zero;
+    zero.frameDeadline = 0.0;
+    WatchdogConfig inverted;
+    inverted.frameDeadline = 0.2;
+    inverted.hardLimit = 0.1;
+    bool threw[2] = {false, false};
+    try { DeadlineWatchdog w(zero); } catch (const std::invalid_argument&) { threw[0] = true; }
+    try { DeadlineWatchdog w(inverted); } catch (const std::invalid_argument&) { threw[1] = true; }
+    assert(threw[0] && threw[1]);
+
+    std::cout << "✅ Deadline overrun tests passed\n";
+}
+
+/**
+ * @brief Tests the stall fallback
+ *
+ * Test Cases:
+ * - The fallback runs while the stalled stage still holds the frame
+ * - It reports the stage the frame stalled in and runs once per frame
+ * - stalled() is set for the stalled frame and cleared by the next one
+ * - A frame that begins after a long idle period is still watched
+ */
+void testStallFallback() {
+    std::cout << "Testing stall fallback...\n";
+
+    WatchdogConfig config;
+    config.frameDeadline = 0.005;
+    config.hardLimit = 0.02;
+    ManualClock clock;
+    std::atomic<int> calls{0};
+    std::atomic<int> stalledIn{-1};
+    DeadlineWatchdog watchdog(config, [&](LoopStage stage, double seconds) {
+        stalledIn = static_cast<int>(stage);
+        assert(seconds >= 0.02);
+        ++calls;
+    }, clock.source());
+
+    auto waitForCalls = [&calls](int expected) {
+        for (int i = 0; i < 1000 && calls.load() < expected; ++i) sleepMs(5);
+        return calls.load() == expected;
+    };
+
+    watchdog.beginFrame(LoopStage::Alert);
+    watchdog.stage(LoopStage::Guidance);
+    clock.advanceMs(25);
+    assert(waitForCalls(1));
+    assert(stalledIn.load() == static_cast<int>(LoopStage::Guidance));
+    clock.advanceMs(30);
+    assert(watchdog.endFrame());
+    assert(watchdog.stalled() && calls.load() == 1);
+
+    watchdog.beginFrame(LoopStage::Alert);
+    assert(!watchdog.endFrame());
+    assert(!watchdog.stalled());
+
+    // The thread sleeps between frames until the next one begins
+    sleepMs(50);
+    watchdog.beginFrame(LoopStage::Classify);
+    clock.advanceMs(25);
+    assert(waitForCalls(2));
+    assert(stalledIn.load() == static_cast<int>(LoopStage::Classify));
+    assert(watchdog.endFrame() && watchdog.stalled());
+
+    WatchdogStats stats = watchdog.stats();
+    assert(stats.frames == 3 && stats.overruns == 2 && stats.stalls == 2);
+    std::ostringstream out;
+    stats.print(out, config);
+    assert(out.str().find("Watchdog stops: 2") != std::string::npos);
+
+    std::cout << "✅ Stall fallback tests passed\n";
+}
+
+/**
+ * @brief Tests deadline accounting in parking sessions
+ *
+ * Test Cases:
+ * - Sessions without a watchdog print no deadline report
+ * - Every frame of a session with a watchdog is counted
+ * - Invalid deadlines are rejected before any input is read
+ */
+void testSessionDeadlines() {
+    std::cout << "Testing session deadlines...\n";
+
+    const std::string input = "0.6\n0.6\n0.6\n0.8\n0.7\n0.8\n0.4\n0.4\n0.4\n";
+    std::string output = runLoop(input, [] { parkingAssistantLoop(true, false, SessionReport::SummaryOnly); });
+    assert(output.find("Deadline overruns") == std::string::npos);
+    assert(output.find("Parking simulation completed successfully") != std::string::npos);
+
+    WatchdogConfig lenient;
+    lenient.hardLimit = 60.0;
+    output = runLoop(input, [&lenient] { parkingAssistantLoop(true, false, SessionReport::SummaryOnly, lenient); });
+    const std::size_t report = output.find("⏱️ Deadline overruns: ");
+    assert(report != std::string::npos);
+    assert(output.find(" of 3 frames (deadline 20.00 ms, worst ", report) != std::string::npos);
+    assert(output.find("WATCHDOG") == std::string::npos);
+    assert(output.find("Parking simulation completed successfully") != std::string::npos);
+
+    WatchdogConfig strict;
+    strict.frameDeadline = 1e-9;
+    strict.hardLimit = 60.0;
+    output = runLoop("0.6\n0.6\n0.6\n0.4\n0.4\n0.4\n", [&strict] {
+        parkingAssistantLoop(true, false, SessionReport::SummaryOnly, strict);
+    });
+    assert(output.find("Deadline overruns: 2 of 2 frames") != std::string::npos);
+
+    WatchdogConfig invalid;
+    invalid.hardLimit = -1.0;
+    bool threw = false;
+    try { parkingAssistantLoop(true, false, SessionReport::SummaryOnly, invalid); } catch (const std::invalid_argument&) { threw = true; }
+    assert(threw);
+
+    std::cout << "✅ Session deadline tests passed\n";
+}
+
+/**
+ * @brief Executes all deadline watchdog tests
+ * @return 0 on success, 1 on failure
+ */
+int runAllTests() {
+    std::cout << "=== Running Deadline Watchdog Unit Tests ===\n\n";
+
+    try {
+        testOverruns();
+        testStallFallback();
+        testSessionDeadlines();
+
+        std::cout << "\n🎉 All tests passed successfully!\n";
+        std::cout << "Total tests run: 3\n";
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
+
+/**
+ * @brief Main entry point for the deadline watchdog test suite
+ * @return 0 on success, 1 on failure
+ */
+int main() {
+    return runAllTests();
+}
@@ -0,0 +1,267 @@
+/**
+ * @file testDecisionDiff.cpp
+ * @brief Unit tests for the differential decision runner
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ *
+ * Test Coverage:
+ * - Per-frame decisions, beep levels and steering advice
+ * - Parallel decision runs and decision logs
+ * - Recorded sessions decided as the parking loop decides them
+ * - Frame-by-frame comparison of two builds
+ */
+
+#include "../include/DecisionDiff.h"
+#include "../include/SensorSynthesizer.h"
+#include "TestSupport.h"
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief Corpus of sessions approaching an obstacle from different sides
+ */
+std::vector<RecordedSession> makeCorpus() {
+    std::vector<RecordedSession> corpus;
+    for (int n = 0; n < 6; ++n) {
+        RecordedSession session;
+        session.name = "session " + std::to_string(n);
+        for (int i = 0; i < 100 + 20 * n; ++i) {
+            const double d = 2.0 - i * 0.015;
+            session.frames.push_back(SensorData{d + 0.02 * (n % 3), d, d + 0.02 * (n % 2)});
+        }
+        corpus.push_back(session);
+    }
+    return corpus;
+}
+
+} // namespace
+
+/**
+ * @brief Tests the decisions of one reading
+ *
+ * Test Cases:
+ * - Status text, beep level and steering match checkSafety(), beepAlert() and the loop
+ * - A collision is a decision, not an exception
+ * - Steering tolerance treats small side differences as centered
+ */
+void testFrameDecisions() {
+    std::cout << "Testing frame decisions...\n";
+
+    assert(beepLevel(SensorData{0.6, 0.6, 0.6}) == 0);
+    assert(beepLevel(SensorData{0.6, 0.45, 0.6}) == 1);
+    assert(beepLevel(SensorData{0.29, 0.6, 0.6}) == 2);
+    assert(steeringAdvice(SensorData{0.4, 0.6, 0.5}) == SteeringAdvice::SteerRight);
+    assert(steeringAdvice(SensorData{0.5, 0.6, 0.4}) == SteeringAdvice::SteerLeft);
+    assert(steeringAdvice(SensorData{0.5, 0.6, 0.5}) == SteeringAdvice::KeepCentered);
+    assert(steeringAdvice(SensorData{0.48, 0.6, 0.5}, 0.05) == SteeringAdvice::KeepCentered);
+
+    FrameDecision parked = decideFrame(SensorData{0.4, 0.4, 0.45});
+    assert(parked.status == checkSafety(SensorData{0.4, 0.4, 0.45}));
+    assert(parked.beep == 1 && parked.steering == SteeringAdvice::SteerRight);
+
+    FrameDecision collision = decideFrame(SensorData{0.05, 0.5, 0.5});
+    assert(collision.status.find("COLLISION") != std::string::npos && collision.beep == 2);
+    assert(collision.zone == ParkingStatus::Collision && collision.steering == SteeringAdvice::None);
+    assert(collision != parked && collision == decideFrame(SensorData{0.05, 0.5, 0.5}));
+    assert(std::string(steeringName(SteeringAdvice::SteerLeft)) == "LEFT");
+
+    FrameDecision opposite = decideFrame(SensorData{0.05, 0.2, 0.25});
+    assert(opposite.oppositeMovement && opposite.zone == ParkingStatus::TooClose);
+    assert(opposite.status == "Opposite Movement: FORWARD mode sensors close → Move BACKWARD");
+    assert(opposite.beep == 2 && opposite.steering == SteeringAdvice::None);
+    assert(decideParkingFrame(SensorData{0.05, 0.2, 0.25}, true).status.find("REVERSE mode") != std::string::npos);
+
+    std::cout << "✅ Frame decision tests passed\n";
+}
+
+/**
+ * @brief Tests decision runs and their logs
+ *
+ * Test Cases:
+ * - Runs on one and on four threads decide every frame identically, in corpus order
+ * - A log round-trips every decision, session name and the run time
+ *   and leaves the stream's precision alone
+ * - Malformed logs and a zero thread count are rejected
+ * - A missing session file is reported
+ * - A recorded session through the opposite-movement branch gets the
+ *   prompts, statuses and advice the parking loop prints for it, with
+ *   and without the status classifier
+ */
+void testDecisionRuns() {
+    std::cout << "Testing decision runs...\n";
+
+    std::vector<RecordedSession> corpus = makeCorpus();
+    DecisionRun single = runDecisions(corpus, decideFrame, "single", 1);
+    DecisionRun parallel = runDecisions(corpus, decideFrame, "parallel", 4);
+    assert(single.frames == 6 * 100 + 20 * 15 && parallel.frames == single.frames);
+    assert(single.sessions == parallel.sessions && single.sessions[5] == "session 5");
+    assert(compareDecisions(single, parallel).empty());
+    assert(parallel.decisions[2][10] == decideFrame(corpus[2].frames[10]));
+    assert(parallel.framesPerSecond() > 0.0);
+
+    std::stringstream log;
+    const std::streamsize precision = log.precision();
+    writeDecisionLog(log, parallel);
+    assert(log.precision() == precision);
+    DecisionRun restored = readDecisionLog(log);
+    assert(restored.build == "parallel" && restored.frames == parallel.frames);
+    assert(restored.sessions == parallel.sessions && restored.decisions.size() == 6);
+    assert(compareDecisions(parallel, restored).empty());
+    assert(restored.seconds > 0.0);
+
+    const char* malformed[] = {"", "# parking decision log v1\nbuild x\nframes 1 seconds 0.1\nsession 2 a\n1 LEFT s\n",
+                               "# parking decision log v1\nbuild x\nframes 1 seconds 0.1\nsession 1 a\n1 UP s\n"};
+    for (const char* bad : malformed) {
+        std::istringstream in(bad);
+        bool threw = false;
+        try {
+            readDecisionLog(in);
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        assert(threw);
+    }
+
+    bool threw = false;
+    try {
+        runDecisions(corpus, decideFrame, "none", 0);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    threw = false;
+    try {
+        loadRecordedSession("/nonexistent-directory/session.txt");
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+
+    const std::string path = "testDecisionDiff.tmp";
+    {
+        std::ofstream file(path);
+        const SensorData frames[] = {{0.9, 1.2, 0.7}, {0.2, 0.25, 0.05}, {0.9, 1.2, 0.7}, {0.4, 0.45, 0.4}};
+        for (const SensorData& s : frames) writeSensorFrame(file, s);
+    }
+    std::vector<RecordedSession> recorded = {loadRecordedSession(path)};
+    std::ifstream file(path);
+    const std::string input((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    std::remove(path.c_str());
+
+    DecisionRun forward = runDecisions(recorded, loopPipeline(false), "forward", 1);
+    const std::vector<FrameDecision>& d = forward.decisions[0];
+    assert(d.size() == 4 && d[1].oppositeMovement && !d[0].oppositeMovement);
+    assert(d[0].status == "SAFE" && d[0].steering == SteeringAdvice::SteerLeft);
+    assert(d[3].zone == ParkingStatus::PerfectlyParked);
+    assert(compareDecisions(forward, runDecisions(recorded, decideFrame, "forward", 1)).empty());
+    std::string output = runLoop(input, [] { parkingAssistantLoop(false, true); });
+    assert(output.find("⚠️ " + d[1].status + " and re-enter data.") != std::string::npos);
+    assert(output.find("Status: " + d[0].status) < output.find(d[1].status));
+    assert(output.find("Right side closer → Steer LEFT", output.find(d[1].status)) != std::string::npos);
+    assert(output.find("Parking simulation completed successfully") != std::string::npos);
+    assert(output.find("Status: " + d[3].status) != std::string::npos);
+
+    StatusClassifierConfig statusConfig;
+    statusConfig.minDwellFrames = 1;
+    DecisionRun changeOnly = runDecisions(recorded, loopPipeline(true, &statusConfig), "change-only", 1);
+    const std::vector<FrameDecision>& c = changeOnly.decisions[0];
+    assert(c[1].oppositeMovement && c[1].status.find("REVERSE mode") != std::string::npos);
+    assert(!c[0].status.empty() && c[2].status.empty() && c[2].zone == c[0].zone);
+    output = runLoop(input, [&statusConfig] { parkingAssistantLoop(true, true, statusConfig); });
+    assert(output.find("⚠️ " + c[1].status + " and re-enter data.") != std::string::npos);
+    assert(output.find("Status: " + c[0].status) != std::string::npos);
+    assert(output.find("Status: " + c[3].status) != std::string::npos);
+
+    std::stringstream changeOnlyLog;
+    writeDecisionLog(changeOnlyLog, changeOnly);
+    assert(compareDecisions(changeOnly, readDecisionLog(changeOnlyLog)).empty());
+
+    std::cout << "✅ Decision run tests passed\n";
+}
+
+/**
+ * @brief Tests the comparison of two builds
+ *
+ * Test Cases:
+ * - A candidate with a moved double-beep threshold diverges exactly on the affected frames
+ * - Runs over different corpora cannot be compared
+ */
+void testCompareBuilds() {
+    std::cout << "Testing build comparison...\n";
+
+    std::vector<RecordedSession> corpus = makeCorpus();
+    DecisionRun baseline = runDecisions(corpus, decideFrame, "v2.0", 2);
+    DecisionPipeline candidatePipeline = [](const SensorData& s) {
+        FrameDecision d = decideFrame(s);
+        if (d.beep == 1 && (s.left < 0.32 || s.center < 0.32 || s.right < 0.32)) d.beep = 2;
+        return d;
+    };
+    DecisionRun candidate = runDecisions(corpus, candidatePipeline, "v2.1", 3);
+
+    std::vector<Divergence> divergences = compareDecisions(baseline, candidate);
+    std::size_t expected = 0;
+    for (const RecordedSession& session : corpus)
+        for (const SensorData& s : session.frames)
+            if (decideFrame(s) != candidatePipeline(s)) ++expected;
+    assert(expected > 0 && divergences.size() == expected);
+    for (std::size_t i = 0; i < divergences.size(); ++i) {
+        const Divergence& d = divergences[i];
+        assert(d.baseline.beep == 1 && d.candidate.beep == 2 && d.baseline.status == d.candidate.status);
+        assert(d.baseline == decideFrame(corpus[d.session].frames[d.frame]));
+        if (i > 0) {
+            const Divergence& p = divergences[i - 1];
+            assert(p.session < d.session || (p.session == d.session && p.frame < d.frame));
+        }
+    }
+
+    corpus.pop_back();
+    DecisionRun shorter = runDecisions(corpus, decideFrame, "v2.1", 1);
+    bool threw = false;
+    try {
+        compareDecisions(baseline, shorter);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "✅ Build comparison tests passed\n";
+}
+
+/**
+ * @brief Executes all decision diff tests
+ * @return 0 on success, 1 on failure
+ */
+int runAllTests() {
+    std::cout << "=== Running Decision Diff Unit Tests ===\n\n";
+
+    try {
+        testFrameDecisions();
+        testDecisionRuns();
+        testCompareBuilds();
+
+        std::cout << "\n🎉 All tests passed successfully!\n";
+        std::cout << "Total tests run: 3\n";
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
+
+/**
+ * @brief Main entry point for the decision diff test suite
+ * @return 0 on success, 1 on failure
+ */
+int main() {
+    return runAllTests();
+}
@@ -0,0 +1,220 @@
+/**
+ * @file testFrameCoalescer.cpp
+ * @brief Unit tests for newest-frame-wins sensor ingest
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ *
+ * Test Coverage:
+ * - Newest frame per vehicle, drain order and counters
+ * - Collision frames surviving coalescing
+ * - Concurrent producers against a draining decision loop
+ */
+
+#include "../include/FrameCoalescer.h"
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Tests coalescing of ordinary frames
+ *
+ * Test Cases:
+ * - Each vehicle delivers only its newest frame, in order of first arrival
+ * - Dropped frames are counted per frame and in total
+ * - A drain empties the buffer and vehicle indices stay stable
+ * - Invalid collision distances and unknown indices are rejected
+ */
+void testNewestFrameWins() {
+    std::cout << "Testing newest-frame-wins coalescing...\n";
+
+    FrameCoalescer ingest;
+    std::vector<CoalescedFrame> frames;
+    assert(ingest.drain(frames) == 0 && frames.empty());
+
+    for (int i = 1; i <= 5; ++i) {
+        ingest.push("VAN-12", SensorData{1.0, 2.0 + i, 1.0});
+        if (i <= 3) ingest.push("CAR-7", SensorData{0.8, 1.0 * i, 0.8});
+    }
+    ingest.push("BUS-1", SensorData{3.0, 3.0, 3.0});
+    assert(ingest.vehicles() == 3 && ingest.pending() == 3);
+
+    assert(ingest.drain(frames) == 3);
+    assert(ingest.vehicleId(frames[0].vehicle) == "VAN-12" && frames[0].data.center == 7.0);
+    assert(frames[0].superseded == 4 && !frames[0].collision);
+    assert(ingest.vehicleId(frames[1].vehicle) == "CAR-7" && frames[1].data.center == 3.0 && frames[1].superseded == 2);
+    assert(ingest.vehicleId(frames[2].vehicle) == "BUS-1" && frames[2].superseded == 0);
+    assert(frames[1].receivedNs <= frames[0].receivedNs && frames[0].receivedNs <= frames[2].receivedNs);
+    const std::size_t bus = frames[2].vehicle;
+
+    CoalescerStats stats = ingest.stats();
+    assert(stats.received == 9 && stats.delivered == 3 && stats.coalesced == 6 && stats.collisionsKept == 0);
+    assert(ingest.pending() == 0 && ingest.drain(frames) == 0 && frames.empty());
+
+    ingest.push("BUS-1", SensorData{2.5, 2.5, 2.5});
+    assert(ingest.drain(frames) == 1 && frames[0].vehicle == bus && frames[0].superseded == 0);
+
+    bool threw[3] = {false, false, false};
+    try { FrameCoalescer bad(0.0); } catch (const std::invalid_argument&) { threw[0] = true; }
+    try { FrameCoalescer bad(std::numeric_limits<double>::infinity()); } catch (const std::invalid_argument&) { threw[1] = true; }
+    try { ingest.vehicleId(3); } catch (const std::out_of_range&) { threw[2] = true; }
+    assert(threw[0] && threw[1] && threw[2]);
+
+    std::cout << "✅ Newest-frame-wins tests passed\n";
+}
+
+/**
+ * @brief Tests that collision frames are never dropped
+ *
+ * Test Cases:
+ * - Superseded collision frames are delivered, oldest first, before the newest frame
+ * - Ordinary frames between them are still dropped and counted
+ * - A newest frame that is itself a collision is flagged
+ * - The threshold is inclusive and configurable
+ * - Failed readings (NaN, infinite or negative) count as collisions
+ * - Without drains, only the first kept collision frames stay pending and the rest are counted
+ */
+void testCollisionsKept() {
+    std::cout << "Testing collision frames...\n";
+
+    FrameCoalescer ingest;
+    ingest.push("CAR-7", SensorData{0.5, 0.5, 0.5});
+    ingest.push("CAR-7", SensorData{0.5, 0.05, 0.5});
+    ingest.push("CAR-7", SensorData{0.3, 0.3, 0.3});
+    ingest.push("VAN-12", SensorData{2.0, 2.0, 2.0});
+    ingest.push("CAR-7", SensorData{0.08, 0.4, 0.4});
+    ingest.push("CAR-7", SensorData{0.6, 0.6, 0.6});
+    assert(ingest.pending() == 4);
+
+    std::vector<CoalescedFrame> frames;
+    assert(ingest.drain(frames) == 4);
+    assert(frames[0].collision && frames[0].data.center == 0.05 && frames[0].superseded == 1);
+    assert(frames[1].collision && frames[1].data.left == 0.08 && frames[1].superseded == 1);
+    assert(!frames[2].collision && frames[2].data.left == 0.6 && frames[2].superseded == 0);
+    assert(ingest.vehicleId(frames[3].vehicle) == "VAN-12");
+    CoalescerStats stats = ingest.stats();
+    assert(stats.received == 6 && stats.delivered == 4 && stats.coalesced == 2 && stats.collisionsKept == 2);
+    assert(stats.delivered + stats.coalesced == stats.received);
+
+    ingest.push("CAR-7", SensorData{0.6, 0.6, 0.6});
+    ingest.push("CAR-7", SensorData{0.1, 0.6, 0.6});
+    assert(ingest.drain(frames) == 1 && frames[0].collision && frames[0].superseded == 1);
+
+    FrameCoalescer wide(0.3);
+    wide.push("CAR-7", SensorData{0.25, 1.0, 1.0});
+    wide.push("CAR-7", SensorData{1.0, 1.0, 1.0});
+    assert(wide.drain(frames) == 2 && frames[0].collision && !frames[1].collision);
+
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    const double inf = std::numeric_limits<double>::infinity();
+    wide.push("CAR-7", SensorData{1.0, nan, 1.0});
+    wide.push("CAR-7", SensorData{inf, 1.0, 1.0});
+    wide.push("CAR-7", SensorData{1.0, 1.0, -1.0});
+    wide.push("CAR-7", SensorData{1.0, 1.0, 1.0});
+    assert(wide.drain(frames) == 4 && frames[0].collision && frames[1].collision && frames[2].collision);
+    assert(std::isnan(frames[0].data.center) && frames[2].data.right == -1.0 && !frames[3].collision);
+
+    FrameCoalescer capped(0.1, 4);
+    const int burst = 100000;
+    for (int i = 1; i <= burst; ++i) capped.push("CAR-7", SensorData{0.05, 0.5, 0.5 + i});
+    assert(capped.pending() == 5);
+    assert(capped.drain(frames) == 5);
+    for (int i = 0; i < 4; ++i) assert(frames[i].data.right == 1.5 + i && frames[i].superseded == 0);
+    assert(frames[4].collision && frames[4].data.right == 0.5 + burst && frames[4].superseded == burst - 5);
+    stats = capped.stats();
+    assert(stats.collisionsKept == 4 && stats.collisionsDropped == static_cast<std::size_t>(burst - 5));
+    assert(stats.delivered + stats.coalesced == stats.received);
+    capped.push("CAR-7", SensorData{0.6, 0.05, 0.6});
+    capped.push("CAR-7", SensorData{0.6, 0.6, 0.6});
+    assert(capped.drain(frames) == 2 && frames[0].collision);
+
+    bool threw = false;
+    try { FrameCoalescer bad(0.1, 0); } catch (const std::invalid_argument&) { threw = true; }
+    assert(threw);
+
+    std::cout << "✅ Collision frame tests passed\n";
+}
+
+/**
+ * @brief Tests concurrent ingest
+ *
+ * Test Cases:
+ * - Every vehicle's frames come out in push order and end with its last frame
+ * - Delivered and dropped frames add up to the frames pushed
+ * - close() releases a waiting decision loop once the buffer is empty
+ */
+void testConcurrentIngest() {
+    std::cout << "Testing concurrent ingest...\n";
+
+    const int producers = 4;
+    const int framesEach = 20000;
+    FrameCoalescer ingest;
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&ingest, p, framesEach] {
+            const std::string id = "CAR-" + std::to_string(p);
+            for (int i = 1; i <= framesEach; ++i) ingest.push(id, SensorData{1.0, static_cast<double>(i), 1.0});
+        });
+    }
+    std::thread closer([&] {
+        for (std::thread& t : threads) t.join();
+        ingest.close();
+    });
+
+    std::vector<double> last(producers, 0.0);
+    std::vector<CoalescedFrame> frames;
+    std::size_t delivered = 0;
+    while (ingest.waitForFrames(1.0)) {
+        delivered += ingest.drain(frames);
+        for (const CoalescedFrame& f : frames) {
+            int p = ingest.vehicleId(f.vehicle).back() - '0';
+            assert(f.data.center > last[p]);
+            assert(f.superseded == static_cast<std::size_t>(f.data.center - last[p]) - 1);
+            last[p] = f.data.center;
+        }
+    }
+    closer.join();
+    assert(ingest.drain(frames) == 0);
+
+    for (int p = 0; p < producers; ++p) assert(last[p] == framesEach);
+    CoalescerStats stats = ingest.stats();
+    assert(stats.received == static_cast<std::size_t>(producers * framesEach));
+    assert(stats.delivered == delivered && stats.delivered + stats.coalesced == stats.received);
+    assert(!ingest.waitForFrames(10.0));
+
+    std::cout << "✅ Concurrent ingest tests passed\n";
+}
+
+/**
+ * @brief Executes all frame coalescer tests
+ * @return 0 on success, 1 on failure
+ */
+int runAllTests() {
+    std::cout << "=== Running Frame Coalescer Unit Tests ===\n\n";
+
+    try {
+        testNewestFrameWins();
+        testCollisionsKept();
+        testConcurrentIngest();
+
+        std::cout << "\n🎉 All tests passed successfully!\n";
+        std::cout << "Total tests run: 3\n";
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
+
+/**
+ * @brief Main entry point for the frame coalescer test suite
+ * @return 0 on success, 1 on failure
+ */
+int main() {
+    return runAllTests();
+}
@@ -0,0 +1,304 @@
+/**
+ * @file testGarageGraph.cpp
+ * @brief Unit tests for the contraction-hierarchy garage graph
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ *
+ * Test Coverage:
+ * - Routes, one-way ramps, unreachable nodes and misuse on a small garage
+ * - Agreement with Dijkstra on random graphs, including unpacked routes
+ * - Nearest free bay by driving distance on a multi-level garage
+ */
+
+#include "../include/GarageGraph.h"
+#include "../include/LotIndex.h"
+#include "TestSupport.h"
+#include <cassert>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief Random directed graph with the edge lengths kept for route checks
+ */
+struct RandomGraph {
+    GarageGraph graph;
+    std::vector<std::vector<std::pair<int, double>>> edges;   // from -> (to, length)
+};
+
+void addTracked(RandomGraph& g, int from, int to, double length, bool oneWay) {
+    g.graph.addEdge(from, to, length, oneWay);
+    g.edges[from].push_back(std::make_pair(to, length));
+    if (!oneWay) g.edges[to].push_back(std::make_pair(from, length));
+}
+
+/**
+ * @brief Asserts that a route only uses existing edges and adds up to its distance
+ */
+void assertValidRoute(const RandomGraph& g, const GarageRoute& route, int from, int to) {
+    assert(route.nodes.front() == from && route.nodes.back() == to);
+    double total = 0.0;
+    for (std::size_t i = 1; i < route.nodes.size(); ++i) {
+        double best = std::numeric_limits<double>::infinity();
+        for (const auto& e : g.edges[route.nodes[i - 1]])
+            if (e.first == route.nodes[i]) best = std::min(best, e.second);
+        assert(!std::isinf(best));
+        total += best;
+    }
+    assert(near(total, route.distance, 1e-6));
+}
+
+/**
+ * @brief Builds a garage: levels of aisle rows with bays, one-way ramps up and down
+ * @param bayIds Receives the bay ids in creation order
+ * @return Gate node
+ */
+int buildGarage(GarageGraph& garage, int levels, int rows, int cols, std::vector<int>& bayIds) {
+    int gate = garage.addNode(GarageNodeKind::Gate, Vec2{-10.0, 0.0}, 0);
+    std::vector<int> upStart(levels), downEnd(levels);
+    int nextBay = 100;
+    for (int level = 0; level < levels; ++level) {
+        std::vector<int> junction(rows * cols);
+        for (int r = 0; r < rows; ++r)
+            for (int c = 0; c < cols; ++c) {
+                junction[r * cols + c] = garage.addNode(GarageNodeKind::Junction, Vec2{c * 6.0, r * 12.0}, level);
+                if (c > 0) garage.addEdge(junction[r * cols + c - 1], junction[r * cols + c], 6.0);
+                if (r > 0 && (c == 0 || c == cols - 1)) garage.addEdge(junction[(r - 1) * cols + c], junction[r * cols + c], 12.0);
+                for (int side = -1; side <= 1; side += 2) {
+                    int bay = garage.addNode(GarageNodeKind::Bay, Vec2{c * 6.0, r * 12.0 + side * 4.0}, level, nextBay);
+                    bayIds.push_back(nextBay++);
+                    garage.addEdge(junction[r * cols + c], bay, 4.0 + 0.01 * c);
+                }
+            }
+        upStart[level] = junction[cols - 1];
+        downEnd[level] = junction[(rows - 1) * cols];
+        if (level == 0) garage.addEdge(gate, junction[0], 10.0);
+    }
+    for (int level = 0; level + 1 < levels; ++level) {
+        int up = garage.addNode(GarageNodeKind::Ramp, Vec2{cols * 6.0, 0.0}, level);
+        garage.addEdge(upStart[level], up, 5.0, true);
+        garage.addEdge(up, upStart[level + 1], 25.0, true);            // up ramp
+        garage.addEdge(downEnd[level + 1], downEnd[level], 30.0, true); // down ramp
+    }
+    return gate;
+}
+
+} // namespace
+
+/**
+ * @brief Tests routes on a small hand-built garage
+ *
+ * Test Cases:
+ * - Shortest route and its node sequence
+ * - One-way edges are only driven forwards
+ * - Unreachable nodes and same-node queries
+ * - Misuse is rejected
+ */
+void testSmallGarage() {
+    std::cout << "Testing small garage routes...\n";
+
+    GarageGraph garage;
+    int gate = garage.addNode(GarageNodeKind::Gate, Vec2{0, 0}, 0);
+    int a = garage.addNode(GarageNodeKind::Junction, Vec2{10, 0}, 0);
+    int b = garage.addNode(GarageNodeKind::Junction, Vec2{20, 0}, 0);
+    int rampTop = garage.addNode(GarageNodeKind::Ramp, Vec2{20, 0}, 1);
+    int bay = garage.addNode(GarageNodeKind::Bay, Vec2{20, 3}, 1, 7);
+    int island = garage.addNode(GarageNodeKind::Junction, Vec2{50, 50}, 0);
+    garage.addEdge(gate, a, 10.0);
+    garage.addEdge(a, b, 10.0);
+    garage.addEdge(gate, b, 25.0);
+    garage.addEdge(b, rampTop, 15.0, true);    // up only
+    garage.addEdge(rampTop, a, 40.0, true);    // long way down
+    garage.addEdge(rampTop, bay, 3.0);
+
+    bool threw = false;
+    try {
+        garage.route(gate, bay);
+    } catch (const std::logic_error&) {
+        threw = true;
+    }
+    assert(threw);
+
+    threw = false;
+    try {
+        garage.addEdge(gate, 99, 1.0);
+    } catch (const std::out_of_range&) {
+        threw = true;
+    }
+    assert(threw);
+
+    threw = false;
+    try {
+        garage.addNode(GarageNodeKind::Bay, Vec2{0, 0}, 0, 7);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    garage.contract();
+    assert(garage.bayNode(7) == bay && garage.bayNode(8) == -1);
+
+    GarageRoute up = garage.route(gate, bay);
+    assert(near(up.distance, 38.0));
+    assert((up.nodes == std::vector<int>{gate, a, b, rampTop, bay}));
+
+    GarageRoute down = garage.route(bay, gate);
+    assert(near(down.distance, 53.0));
+    assert((down.nodes == std::vector<int>{bay, rampTop, a, gate}));
+
+    GarageRoute none = garage.route(gate, island);
+    assert(!none.found() && std::isinf(none.distance));
+
+    GarageRoute self = garage.route(b, b);
+    assert(self.found() && self.distance == 0.0 && self.nodes.size() == 1);
+
+    threw = false;
+    try {
+        garage.addNode(GarageNodeKind::Junction, Vec2{0, 0}, 0);
+    } catch (const std::logic_error&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "✅ Small garage tests passed\n";
+}
+
+/**
+ * @brief Tests all-pairs distances and routes against Dijkstra on random graphs
+ */
+void testMatchesDijkstra() {
+    std::cout << "Testing against Dijkstra...\n";
+
+    std::srand(21);
+    for (int trial = 0; trial < 6; ++trial) {
+        RandomGraph g;
+        const int n = 40 + trial * 10;
+        g.edges.resize(n);
+        for (int i = 0; i < n; ++i) g.graph.addNode(GarageNodeKind::Junction, Vec2{0, 0}, 0);
+        for (int i = 1; i < n; ++i)   // a spanning tree keeps most pairs connected
+            addTracked(g, std::rand() % i, i, 1 + std::rand() % 50, std::rand() % 5 == 0);
+        for (int e = 0; e < n; ++e)
+            addTracked(g, std::rand() % n, std::rand() % n, 1 + std::rand() % 100, std::rand() % 3 == 0);
+        g.graph.contract();
+
+        for (int from = 0; from < n; ++from) {
+            std::vector<double> reference = g.graph.distancesFrom(from);
+            for (int to = 0; to < n; ++to) {
+                GarageRoute route = g.graph.route(from, to);
+                assert(near(route.distance, reference[to], 1e-6));
+                if (route.found()) assertValidRoute(g, route, from, to);
+            }
+        }
+    }
+
+    std::cout << "✅ Dijkstra comparison tests passed\n";
+}
+
+/**
+ * @brief Tests nearest-free-bay queries on a multi-level garage
+ *
+ * Test Cases:
+ * - The chosen bay is the closest free, large enough bay by driving distance
+ * - Occupancy changes in later snapshots are honoured
+ * - No bay is returned when nothing fits
+ * - Unbound graphs and foreign snapshots are rejected
+ */
+void testNearestFreeBay() {
+    std::cout << "Testing nearest free bay...\n";
+
+    GarageGraph garage;
+    std::vector<int> bayIds;
+    int gate = buildGarage(garage, 3, 4, 8, bayIds);
+    garage.contract();
+
+    std::vector<ParkingBay> bays;
+    std::srand(5);
+    for (int id : bayIds) bays.push_back(ParkingBay{id, (id % 5 == 0) ? 6.0 : 4.8, std::rand() % 10 < 8});
+    ParkingLotIndex index(bays);
+    LotReader reader(index);
+
+    bool threw = false;
+    try {
+        LotReadGuard guard(reader);
+        garage.nearestFreeBay(gate, guard.snapshot(), 5.0);
+    } catch (const std::logic_error&) {
+        threw = true;
+    }
+    assert(threw);
+    {
+        LotReadGuard guard(reader);
+        garage.bindLot(guard.snapshot());
+    }
+
+    std::vector<double> fromGate = garage.distancesFrom(gate);
+    for (int step = 0; step < 40; ++step) {
+        double required = step % 2 ? 5.5 : 4.5;
+        LotReadGuard guard(reader);
+        const LotSnapshot& lot = guard.snapshot();
+        BayChoice choice = garage.nearestFreeBay(gate, lot, required);
+
+        double best = std::numeric_limits<double>::infinity();
+        for (const ParkingBay& bay : lot.bays)
+            if (!bay.occupied && bay.size >= required) best = std::min(best, fromGate[garage.bayNode(bay.id)]);
+        assert(near(choice.distance, best, 1e-6));
+        if (choice.bayId >= 0) {
+            assert(garage.bayNode(choice.bayId) == choice.node);
+            assert(near(garage.route(gate, choice.node).distance, best, 1e-6));
+            index.setOccupied(choice.bayId, true);   // take it; the next query must pick another
+        }
+    }
+
+    {
+        LotReadGuard guard(reader);
+        BayChoice none = garage.nearestFreeBay(gate, guard.snapshot(), 10.0);
+        assert(none.bayId == -1 && none.node == -1 && std::isinf(none.distance));
+    }
+
+    ParkingLotIndex other({{1, 5.0, false}});
+    LotReader otherReader(other);
+    threw = false;
+    try {
+        LotReadGuard guard(otherReader);
+        garage.nearestFreeBay(gate, guard.snapshot(), 4.0);
+    } catch (const std::logic_error&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "✅ Nearest free bay tests passed\n";
+}
+
+/**
+ * @brief Executes all garage graph tests
+ * @return 0 on success, 1 on failure
+ */
+int runAllTests() {
+    std::cout << "=== Running Garage Graph Unit Tests ===\n\n";
+
+    try {
+        testSmallGarage();
+        testMatchesDijkstra();
+        testNearestFreeBay();
+
+        std::cout << "\n🎉 All tests passed successfully!\n";
+        std::cout << "Total tests run: 3\n";
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
+
+/**
+ * @brief Main entry point for the garage graph test suite
+ * @return 0 on success, 1 on failure
+ */
+int main() {
+    return runAllTests();
+}
@@ -0,0 +1,254 @@
+/**
+ * @file testGridReplanner.cpp
+ * @brief Unit tests for the D* Lite grid replanner
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ *
+ * Test Coverage:
+ * - Optimal paths on open grids, unreachable goals and misuse
+ * - Agreement with a Dijkstra reference around obstacles
+ * - Incremental repair while obstacles change and the start moves
+ * - Grids derived from a clearance map
+ */
+
+#include "../include/ClearanceMap.h"
+#include "../include/GridReplanner.h"
+#include "TestSupport.h"
+#include <cassert>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <queue>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief Shortest path length by Dijkstra with the planner's move rules (reference)
+ */
+double dijkstraLength(const GridReplanner& grid, int startCol, int startRow, int goalCol, int goalRow) {
+    const double inf = std::numeric_limits<double>::infinity();
+    int cols = grid.cols(), rows = grid.rows();
+    std::vector<double> dist(static_cast<std::size_t>(cols) * rows, inf);
+    typedef std::pair<double, int> Item;
+    std::priority_queue<Item, std::vector<Item>, std::greater<Item>> open;
+    if (grid.isBlocked(startCol, startRow)) return inf;
+    dist[startRow * cols + startCol] = 0.0;
+    open.push(Item(0.0, startRow * cols + startCol));
+    while (!open.empty()) {
+        Item top = open.top();
+        open.pop();
+        if (top.first > dist[top.second]) continue;
+        int col = top.second % cols, row = top.second / cols;
+        if (col == goalCol && row == goalRow) return top.first * grid.resolution();
+        for (int dr = -1; dr <= 1; ++dr)
+            for (int dc = -1; dc <= 1; ++dc) {
+                int c = col + dc, r = row + dr;
+                if ((dc == 0 && dr == 0) || c < 0 || r < 0 || c >= cols || r >= rows) continue;
+                if (grid.isBlocked(c, r)) continue;
+                if (dc != 0 && dr != 0 && (grid.isBlocked(c, row) || grid.isBlocked(col, r))) continue;
+                double next = top.first + (dc != 0 && dr != 0 ? std::sqrt(2.0) : 1.0);
+                if (next < dist[r * cols + c]) {
+                    dist[r * cols + c] = next;
+                    open.push(Item(next, r * cols + c));
+                }
+            }
+    }
+    return inf;
+}
+
+Vec2 cellCenter(int col, int row) {
+    return Vec2{col + 0.5, row + 0.5};
+}
+
+} // namespace
+
+/**
+ * @brief Tests planning on simple grids
+ *
+ * Test Cases:
+ * - Open grid: octile distance, path starts and ends at the right cells
+ * - Walled-off goal: no path
+ * - replan() before start/goal and out-of-grid points throw
+ */
+void testOpenGrid() {
+    std::cout << "Testing planning on open grids...\n";
+
+    GridReplanner planner(Vec2{0, 0}, 1.0, 30, 20);
+    bool threw = false;
+    try {
+        planner.replan();
+    } catch (const std::logic_error&) {
+        threw = true;
+    }
+    assert(threw);
+
+    planner.setGoal(cellCenter(25, 15));
+    planner.setStart(cellCenter(2, 3));
+    assert(planner.replan());
+    assert(near(planner.pathLength(), 12.0 * std::sqrt(2.0) + 11.0));
+    std::vector<Vec2> path = planner.path();
+    assert(near(path.front().x, 2.5) && near(path.front().y, 3.5));
+    assert(near(path.back().x, 25.5) && near(path.back().y, 15.5));
+    assert(path.size() == 24);
+
+    // Wall the goal off, then open the wall again
+    OrientedBox wall = {Vec2{20.5, 10.0}, 0.5, 10.0, 0.0};
+    planner.addObstacle(wall);
+    assert(!planner.replan());
+    assert(planner.path().empty());
+    assert(std::isinf(planner.pathLength()));
+    planner.removeObstacle(wall);
+    assert(planner.replan());
+    assert(near(planner.pathLength(), 12.0 * std::sqrt(2.0) + 11.0));
+    planner.addObstacle(wall);
+    assert(!planner.replan());
+    assert(planner.path().empty());
+    assert(std::isinf(planner.pathLength()));
+
+    threw = false;
+    try {
+        planner.setStart(Vec2{-1.0, 3.0});
+    } catch (const std::out_of_range&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "✅ Open grid tests passed\n";
+}
+
+/**
+ * @brief Tests path lengths against Dijkstra on random obstacle fields
+ */
+void testMatchesDijkstra() {
+    std::cout << "Testing against Dijkstra...\n";
+
+    std::srand(7);
+    for (int trial = 0; trial < 20; ++trial) {
+        GridReplanner planner(Vec2{0, 0}, 0.5, 40, 30);
+        int obstacles = std::rand() % 25;
+        for (int i = 0; i < obstacles; ++i)
+            planner.addObstacle(OrientedBox{Vec2{(std::rand() % 2000) / 100.0, (std::rand() % 1500) / 100.0},
+                                            (std::rand() % 200) / 100.0, (std::rand() % 60) / 100.0,
+                                            (std::rand() % 628) / 100.0});
+        int sc = std::rand() % 40, sr = std::rand() % 30, gc = std::rand() % 40, gr = std::rand() % 30;
+        planner.setGoal(Vec2{(gc + 0.5) * 0.5, (gr + 0.5) * 0.5});
+        planner.setStart(Vec2{(sc + 0.5) * 0.5, (sr + 0.5) * 0.5});
+        bool found = planner.replan();
+        double expected = dijkstraLength(planner, sc, sr, gc, gr);
+        assert(found == !std::isinf(expected));
+        assert(near(planner.pathLength(), expected, 1e-6));
+        if (found) {
+            // The extracted path only uses free cells
+            for (const Vec2& p : planner.path())
+                assert(!planner.isBlocked(static_cast<int>(p.x / 0.5), static_cast<int>(p.y / 0.5)));
+        }
+    }
+
+    std::cout << "✅ Dijkstra comparison tests passed\n";
+}
+
+/**
+ * @brief Tests incremental repair against fresh searches
+ *
+ * A vehicle advances along its path while an obstacle walks across the
+ * grid. After every frame the repaired path must be as short as a search
+ * from scratch, and the repairs together must expand fewer cells.
+ */
+void testIncrementalRepair() {
+    std::cout << "Testing incremental repair...\n";
+
+    GridReplanner live(Vec2{0, 0}, 1.0, 60, 40);
+    live.addObstacle(OrientedBox{Vec2{30, 15}, 0.5, 15, 0.0});   // wall with a gap above y = 30
+    live.setGoal(cellCenter(55, 5));
+    Vec2 start = cellCenter(3, 5);
+    live.setStart(start);
+    assert(live.replan());
+
+    std::size_t incremental = 0, full = 0;
+    OrientedBox walker = {Vec2{36.0, 0.0}, 0.8, 0.8, 0.0};
+    live.addObstacle(walker);
+    for (int frame = 0; frame < 30; ++frame) {
+        live.removeObstacle(walker);
+        walker.center.y = 1.0 + frame;
+        live.addObstacle(walker);
+
+        std::vector<Vec2> current = live.path();
+        if (current.size() > 2) start = current[2];
+        live.setStart(start);
+        bool found = live.replan();
+        incremental += live.lastExpansions();
+
+        GridReplanner fresh(Vec2{0, 0}, 1.0, 60, 40);
+        fresh.addObstacle(OrientedBox{Vec2{30, 15}, 0.5, 15, 0.0});
+        fresh.addObstacle(walker);
+        fresh.setGoal(cellCenter(55, 5));
+        fresh.setStart(start);
+        assert(fresh.replan() == found);
+        full += fresh.lastExpansions();
+        assert(near(live.pathLength(), fresh.pathLength(), 1e-6));
+    }
+    assert(incremental < full);
+
+    std::cout << "✅ Incremental repair tests passed\n";
+}
+
+/**
+ * @brief Tests grids built from a clearance map
+ */
+void testFromClearanceMap() {
+    std::cout << "Testing clearance map grids...\n";
+
+    ClearanceMap map(Vec2{0, 0}, 0.25, 120, 80);
+    map.addObstacle(OrientedBox{Vec2{15.0, 8.0}, 1.0, 6.0, 0.0});
+    map.compute();
+
+    GridReplanner planner = GridReplanner::fromClearanceMap(map, 1.0);
+    assert(planner.cols() == 120 && planner.rows() == 80);
+    for (int row = 0; row < 80; ++row)
+        for (int col = 0; col < 120; ++col)
+            assert(planner.isBlocked(col, row) == (map.clearanceAt(col, row) < 1.0));
+
+    planner.setGoal(Vec2{28.0, 5.0});
+    planner.setStart(Vec2{2.0, 5.0});
+    assert(planner.replan());
+    for (const Vec2& p : planner.path()) assert(map.clearance(p) >= 1.0);
+    assert(planner.pathLength() > 26.0);
+
+    std::cout << "✅ Clearance map grid tests passed\n";
+}
+
+/**
+ * @brief Executes all grid replanner tests
+ * @return 0 on success, 1 on failure
+ */
+int runAllTests() {
+    std::cout << "=== Running Grid Replanner Unit Tests ===\n\n";
+
+    try {
+        testOpenGrid();
+        testMatchesDijkstra();
+        testIncrementalRepair();
+        testFromClearanceMap();
+
+        std::cout << "\n🎉 All tests passed successfully!\n";
+        std::cout << "Total tests run: 4\n";
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
+
+/**
+ * @brief Main entry point for the grid replanner test suite
+ * @return 0 on success, 1 on failure
+ */
+int main() {
+    return runAllTests();
+}
@@ -0,0 +1,222 @@
+/**
+ * @file testLotIndex.cpp
+ * @brief Unit tests for the concurrent parking lot bay index
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ *
+ * Test Coverage:
+ * - Snapshot construction and free bay search
+ * - Copy-on-write updates and batch publication
+ * - Snapshot isolation while a read guard is held
+ * - Epoch-based reclamation of retired snapshots
+ * - Concurrent readers and a writer (consistency of freeCount)
+ */
+
+#include "../include/LotIndex.h"
+#include <atomic>
+#include <cassert>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Tests snapshot construction and the free bay search
+ *
+ * Test Cases:
+ * - Initial free count
+ * - First fitting free bay is returned
+ * - Occupied bays are skipped
+ * - requiredSpace()-based overload
+ * - Duplicate bay ids are rejected
+ */
+void testSnapshotSearch() {
+    std::cout << "Testing snapshot search...\n";
+
+    ParkingLotIndex index({{1, 4.0, false}, {2, 6.0, true}, {3, 5.5, false}});
+    LotReader reader(index);
+    {
+        LotReadGuard guard(reader);
+        const LotSnapshot& s = guard.snapshot();
+        assert(s.version == 1);
+        assert(s.freeCount == 2);
+        assert(s.findFreeBay(3.5)->id == 1);
+        assert(s.findFreeBay(5.0)->id == 3);   // bay 2 is occupied
+        assert(s.findFreeBay(7.0) == nullptr);
+        assert(s.findFreeBay(true, 4.5, 1.8)->id == 3);  // requires 5.5 m
+    }
+
+    bool threw = false;
+    try {
+        ParkingLotIndex dup({{1, 4.0, false}, {1, 5.0, false}});
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "✅ Snapshot search tests passed\n";
+}
+
+/**
+ * @brief Tests copy-on-write updates and snapshot isolation
+ *
+ * Test Cases:
+ * - A held guard keeps observing the old version
+ * - A new guard observes the update
+ * - No-op and unknown-bay updates do not publish
+ * - Batches publish exactly one new version
+ */
+void testCopyOnWriteUpdates() {
+    std::cout << "Testing copy-on-write updates...\n";
+
+    ParkingLotIndex index({{1, 5.0, false}, {2, 5.0, false}, {3, 5.0, false}});
+    LotReader reader(index);
+
+    {
+        LotReadGuard oldGuard(reader);
+        assert(index.setOccupied(1, true));
+        // The pinned snapshot must be unaffected by the writer
+        assert(oldGuard.snapshot().version == 1);
+        assert(!oldGuard.snapshot().bays[0].occupied);
+        assert(oldGuard.snapshot().freeCount == 3);
+        // ... and cannot be reclaimed while pinned
+        assert(index.pendingReclaim() == 1);
+    }
+    {
+        LotReadGuard guard(reader);
+        assert(guard.snapshot().version == 2);
+        assert(guard.snapshot().bays[0].occupied);
+        assert(guard.snapshot().freeCount == 2);
+    }
+
+    assert(!index.setOccupied(1, true));   // no change
+    assert(!index.setOccupied(99, true));  // unknown bay
+
+    std::vector<BayUpdate> batch = {{2, true}, {3, true}, {99, false}, {2, true}};
+    assert(index.applyUpdates(batch) == 2);
+    {
+        LotReadGuard guard(reader);
+        assert(guard.snapshot().version == 3);
+        assert(guard.snapshot().freeCount == 0);
+        assert(guard.snapshot().findFreeBay(1.0) == nullptr);
+    }
+
+    std::cout << "✅ Copy-on-write update tests passed\n";
+}
+
+/**
+ * @brief Tests that retired snapshots are freed once unobservable
+ *
+ * Test Cases:
+ * - Retired snapshots accumulate while a guard is pinned
+ * - They are reclaimed on the next publish after the guard is released
+ * - Reader slots are reusable after a LotReader is destroyed
+ */
+void testReclamation() {
+    std::cout << "Testing epoch-based reclamation...\n";
+
+    ParkingLotIndex index({{1, 5.0, false}});
+    {
+        LotReader reader(index);
+        LotReadGuard guard(reader);
+        for (int i = 0; i < 10; ++i) index.setOccupied(1, i % 2 == 0);
+        assert(index.pendingReclaim() == 10);
+    }
+    index.setOccupied(1, true);   // next publish reclaims everything
+    assert(index.pendingReclaim() == 0);
+
+    // Every slot can be claimed again after readers are released
+    std::vector<LotReader*> readers;
+    for (std::size_t i = 0; i < ParkingLotIndex::kMaxReaders; ++i)
+        readers.push_back(new LotReader(index));
+    bool threw = false;
+    try {
+        LotReader extra(index);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    for (std::size_t i = 0; i < readers.size(); ++i) delete readers[i];
+    LotReader again(index);
+
+    std::cout << "✅ Reclamation tests passed\n";
+}
+
+/**
+ * @brief Tests concurrent readers against a continuously writing thread
+ *
+ * Every snapshot a reader observes must be internally consistent: the
+ * stored freeCount must match the number of free bays in the snapshot,
+ * and versions must never go backwards for a given reader.
+ */
+void testConcurrentReaders() {
+    std::cout << "Testing concurrent readers...\n";
+
+    std::vector<ParkingBay> bays;
+    for (int i = 0; i < 64; ++i) bays.push_back({i, 5.0, false});
+    ParkingLotIndex index(bays);
+
+    std::atomic<bool> stop(false);
+    std::atomic<int> inconsistencies(0);
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 3; ++t) {
+        readers.emplace_back([&]() {
+            LotReader reader(index);
+            std::uint64_t lastVersion = 0;
+            while (!stop.load()) {
+                LotReadGuard guard(reader);
+                const LotSnapshot& s = guard.snapshot();
+                std::size_t freeBays = 0;
+                for (std::size_t i = 0; i < s.bays.size(); ++i)
+                    if (!s.bays[i].occupied) freeBays++;
+                if (freeBays != s.freeCount || s.version < lastVersion)
+                    inconsistencies++;
+                lastVersion = s.version;
+            }
+        });
+    }
+
+    for (int i = 0; i < 5000; ++i)
+        index.setOccupied(i % 64, (i / 64) % 2 == 0);
+    stop.store(true);
+    for (std::size_t t = 0; t < readers.size(); ++t) readers[t].join();
+
+    assert(inconsistencies.load() == 0);
+    // Toggle a bay twice so at least one publish happens with no readers left
+    index.setOccupied(0, false);
+    index.setOccupied(0, true);
+    assert(index.pendingReclaim() == 0);
+
+    std::cout << "✅ Concurrent reader tests passed\n";
+}
+
+/**
+ * @brief Executes all lot index tests
+ * @return Number of failed test groups (0 on success)
+ */
+int runAllTests() {
+    std::cout << "=== Running Lot Index Unit Tests ===\n\n";
+
+    try {
+        testSnapshotSearch();
+        testCopyOnWriteUpdates();
+        testReclamation();
+        testConcurrentReaders();
+
+        std::cout << "\n🎉 All tests passed successfully!\n";
+        std::cout << "Total tests run: 4\n";
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
+
+/**
+ * @brief Main entry point for the lot index test suite
+ * @return 0 on success, 1 on failure
+ */
+int main() {
+    return runAllTests();
+}
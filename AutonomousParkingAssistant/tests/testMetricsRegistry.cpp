@@ -0,0 +1,245 @@
+/**
+ * @file testMetricsRegistry.cpp
+ * @brief Unit tests for the shared-memory metrics registry
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ *
+ * Test Coverage:
+ * - Counters, histogram buckets and percentiles, name rules and capacity
+ * - Shared-memory create/attach (POSIX only) and Prometheus output
+ * - Concurrent updates and the metrics of a parking session
+ */
+
+#include "../include/MetricsRegistry.h"
+#include "../include/ParkingUtils.h"
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+std::uint64_t counterValue(const MetricsSnapshot& snapshot, const std::string& name) {
+    for (const CounterSample& c : snapshot.counters)
+        if (c.name == name) return c.value;
+    throw std::runtime_error("missing counter " + name);
+}
+
+} // namespace
+
+/**
+ * @brief Tests in-process counters and histograms
+ *
+ * Test Cases:
+ * - Registering a name twice returns the same counter; unused handles ignore updates
+ * - Every duration lands in the bucket whose bounds enclose it, at most 25 % wide
+ * - Percentiles of a known distribution and of an empty histogram
+ * - Invalid names and a full registry are rejected
+ */
+void testCountersAndHistograms() {
+    std::cout << "Testing counters and histograms...\n";
+
+    MetricsRegistry registry;
+    MetricCounter frames = registry.counter("parking_frames_total");
+    frames.add();
+    frames.add(4);
+    assert(registry.counter("parking_frames_total").value() == 5);
+    MetricCounter unused;
+    unused.add();
+    assert(unused.value() == 0);
+
+    for (std::uint64_t v = 0; v < 100000; v = v * 9 / 8 + 1) {
+        const int bucket = MetricHistogram::bucketOf(v);
+        assert(MetricHistogram::bucketUpperBound(bucket) >= v);
+        assert(bucket == 0 || MetricHistogram::bucketUpperBound(bucket - 1) < v);
+        assert(MetricHistogram::bucketUpperBound(bucket) <= v + v / 4);
+    }
+    assert(MetricHistogram::bucketOf(~std::uint64_t(0)) == MetricHistogram::kBuckets - 1);
+
+    MetricHistogram latency = registry.histogram("parking_frame_latency_seconds");
+    assert(registry.snapshot().histograms[0].percentile(0.5) == 0.0);
+    for (std::uint64_t us = 1; us <= 1000; ++us) latency.record(us * 1000);
+    MetricsSnapshot snapshot = registry.snapshot();
+    assert(snapshot.histograms.size() == 1 && snapshot.histograms[0].count == 1000);
+    assert(snapshot.histograms[0].sumNs == 500500000);
+    const double p50 = snapshot.histograms[0].percentile(0.5);
+    const double p99 = snapshot.histograms[0].percentile(0.99);
+    assert(p50 >= 500000 && p50 <= 625000);
+    assert(p99 >= 990000 && p99 <= 1237500);
+
+    const char* invalid[] = {"", "9lives", "has space", "dash-name",
+                             "a_name_that_is_much_longer_than_the_fifty_five_characters_allowed"};
+    for (const char* name : invalid) {
+        bool threw = false;
+        try {
+            registry.counter(name);
+        } catch (const std::invalid_argument&) {
+            threw = true;
+        }
+        assert(threw);
+    }
+
+    for (std::size_t i = registry.snapshot().counters.size(); i < MetricsRegistry::kMaxCounters; ++i)
+        registry.counter("filler_" + std::to_string(i));
+    bool threw = false;
+    try {
+        registry.counter("one_too_many");
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw && registry.counter("parking_frames_total").value() == 5);
+
+    std::cout << "✅ Counter and histogram tests passed\n";
+}
+
+/**
+ * @brief Tests sampling a registry from a second mapping
+ *
+ * Test Cases:
+ * - A reader attached read-only sees every metric and later updates
+ * - The reader cannot register metrics
+ * - Prometheus text has cumulative buckets, sum and count
+ * - A missing segment is reported
+ *
+ * The second mapping stands in for the parkingMetrics tool.
+ */
+void testSharedRegistry() {
+    std::cout << "Testing shared registry...\n";
+
+#if defined(__unix__) || defined(__APPLE__)
+    const std::string name = "/parking_metrics_test";
+    {
+        MetricsRegistry writer = MetricsRegistry::createShared(name);
+        MetricCounter collisions = writer.counter("parking_collisions_total");
+        MetricHistogram latency = writer.histogram("parking_frame_latency_seconds");
+        collisions.add(2);
+        latency.record(1000);
+        latency.record(3000);
+
+        MetricsRegistry reader = MetricsRegistry::attachShared(name);
+        MetricsSnapshot snapshot = reader.snapshot();
+        assert(snapshot.counters.size() == 1 && counterValue(snapshot, "parking_collisions_total") == 2);
+        assert(snapshot.histograms.size() == 1 && snapshot.histograms[0].count == 2);
+        collisions.add();
+        assert(counterValue(reader.snapshot(), "parking_collisions_total") == 3);
+
+        bool threw = false;
+        try {
+            reader.counter("parking_frames_total");
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        assert(threw);
+
+        std::ostringstream text;
+        reader.snapshot().writePrometheus(text);
+        const std::string out = text.str();
+        assert(out.find("# TYPE parking_collisions_total counter\nparking_collisions_total 3\n") == 0);
+        assert(out.find("# TYPE parking_frame_latency_seconds histogram\n") != std::string::npos);
+        assert(out.find("parking_frame_latency_seconds_bucket{le=\"+Inf\"} 2\n") != std::string::npos);
+        assert(out.find("parking_frame_latency_seconds_sum 4e-06\n") != std::string::npos);
+        assert(out.find("parking_frame_latency_seconds_count 2\n") != std::string::npos);
+        const std::size_t first = out.find("_bucket{le=\"");
+        assert(out.find("} 1\n", first) < out.find("} 2\n", first));
+    }
+    MetricsRegistry::unlinkShared(name);
+
+    bool threw = false;
+    try {
+        MetricsRegistry::attachShared(name);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+#else
+    std::cout << "(skipped: no shared memory support)\n";
+#endif
+
+    std::cout << "✅ Shared registry tests passed\n";
+}
+
+/**
+ * @brief Tests updates from several threads and from a parking session
+ *
+ * Test Cases:
+ * - Concurrent adds and records are all counted
+ * - A session counts frames, their latencies, statuses and the collision
+ */
+void testLiveUpdates() {
+    std::cout << "Testing live updates...\n";
+
+    MetricsRegistry registry;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&registry] {
+            MetricCounter counter = registry.counter("worker_updates_total");
+            MetricHistogram histogram = registry.histogram("worker_latency_seconds");
+            for (int i = 0; i < 10000; ++i) {
+                counter.add();
+                histogram.record(static_cast<std::uint64_t>(i));
+            }
+        });
+    }
+    for (std::thread& t : threads) t.join();
+    MetricsSnapshot snapshot = registry.snapshot();
+    assert(counterValue(snapshot, "worker_updates_total") == 40000);
+    std::uint64_t inBuckets = 0;
+    for (std::uint64_t b : snapshot.histograms[0].buckets) inBuckets += b;
+    assert(snapshot.histograms[0].count == 40000 && inBuckets == 40000);
+
+    MetricsRegistry sessionRegistry;
+    SessionMetrics metrics(sessionRegistry);
+    std::istringstream in("0.6\n0.6\n0.6\n0.25\n0.6\n0.6\n0.05\n0.6\n0.6\n");
+    std::ostringstream out;
+    std::streambuf* originalCin = std::cin.rdbuf(in.rdbuf());
+    std::streambuf* originalCout = std::cout.rdbuf(out.rdbuf());
+    parkingAssistantLoop(true, false, SessionReport::SummaryOnly, WatchdogConfig(), metrics);
+    std::cin.rdbuf(originalCin);
+    std::cout.rdbuf(originalCout);
+
+    snapshot = sessionRegistry.snapshot();
+    assert(counterValue(snapshot, "parking_frames_total") == 3);
+    assert(counterValue(snapshot, "parking_status_safe_total") == 1);
+    assert(counterValue(snapshot, "parking_status_too_close_total") == 1);
+    assert(counterValue(snapshot, "parking_status_collision_total") == 1);
+    assert(counterValue(snapshot, "parking_collisions_total") == 1);
+    assert(counterValue(snapshot, "parking_watchdog_stops_total") == 0);
+    assert(snapshot.histograms.size() == 1 && snapshot.histograms[0].count == 3);
+    assert(out.str().find("Parking simulation ended due to collision") != std::string::npos);
+
+    std::cout << "✅ Live update tests passed\n";
+}
+
+/**
+ * @brief Executes all metrics registry tests
+ * @return 0 on success, 1 on failure
+ */
+int runAllTests() {
+    std::cout << "=== Running Metrics Registry Unit Tests ===\n\n";
+
+    try {
+        testCountersAndHistograms();
+        testSharedRegistry();
+        testLiveUpdates();
+
+        std::cout << "\n🎉 All tests passed successfully!\n";
+        std::cout << "Total tests run: 3\n";
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
+
+/**
+ * @brief Main entry point for the metrics registry test suite
+ * @return 0 on success, 1 on failure
+ */
+int main() {
+    return runAllTests();
+}
@@ -489,6 +489,7 @@ void testFindParkingSpace() {
  * - Perfect parking in one step
  * - Collision detection and emergency stop
  * - Opposite movement with subsequent perfect parking
+ * - Unchanged guidance printed only once
  * - Output message verification
  */
 void testParkingAssistantLoop() {
@@ -519,6 +520,16 @@ void testParkingAssistantLoop() {
     assert(output.find("Opposite Movement") != std::string::npos);
     assert(output.find("Perfectly Parked") != std::string::npos);
     
+    // Test that unchanged guidance is printed once
+    TestUtils::clearOutput();
+    TestUtils::provideInput("0.6\n0.9\n0.8\n0.6\n0.7\n0.9\n0.9\n0.6\n0.7\n0.4\n0.4\n0.4\n");
+    parkingAssistantLoop(false, true);
+    output = TestUtils::getOutput();
+    assert(output.find("Steer RIGHT") != std::string::npos);
+    assert(output.find("Steer RIGHT", output.find("Steer RIGHT") + 1) == std::string::npos);
+    assert(output.find("Steer LEFT") != std::string::npos);
+    assert(output.find("Move FORWARD", output.find("Move FORWARD") + 1) != std::string::npos);
+    
     TestUtils::restoreIO();
     std::cout << "✅ parkingAssistantLoop tests passed\n";
 }
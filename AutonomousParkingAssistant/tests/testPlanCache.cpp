@@ -0,0 +1,228 @@
+/**
+ * @file testPlanCache.cpp
+ * @brief Unit tests for the parking trajectory cache
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ *
+ * Test Coverage:
+ * - Hits for nearby start poses, misses across quantization steps and classes
+ * - Trajectories reused across identical bays in other positions/orientations
+ * - LRU eviction within the byte budget
+ * - getOrPlan() statistics and failure handling
+ */
+
+#include "../include/PlanCache.h"
+#include "TestSupport.h"
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+const double kPi = 3.14159265358979323846;
+
+/**
+ * @brief Straight-line trajectory from a start pose to the bay center
+ */
+std::vector<Pose2D> straightPlan(const Pose2D& start, const OrientedBox& bay, int points = 50) {
+    std::vector<Pose2D> path;
+    for (int i = 0; i < points; ++i) {
+        double t = i / static_cast<double>(points - 1);
+        path.push_back(Pose2D{start.x + t * (bay.center.x - start.x), start.y + t * (bay.center.y - start.y),
+                              start.heading + t * (bay.heading - start.heading)});
+    }
+    return path;
+}
+
+} // namespace
+
+/**
+ * @brief Tests key quantization and basic lookups
+ */
+void testLookup() {
+    std::cout << "Testing lookups...\n";
+
+    PlanCache cache(1 << 20);
+    OrientedBox bay = {Vec2{10.0, 5.0}, 2.5, 1.25, 0.0};
+    Pose2D start = {2.0, 9.0, 0.1};
+    std::vector<Pose2D> out;
+
+    assert(!cache.lookup(bay, "SEDAN-04", start, out));
+    cache.insert(bay, "SEDAN-04", start, straightPlan(start, bay));
+
+    assert(cache.lookup(bay, "SEDAN-04", start, out));
+    assert(out.size() == 50);
+    assert(near(out.back().x, 10.0) && near(out.back().y, 5.0));
+
+    // Within a quantization step: same key; across a step or other class: miss
+    assert(cache.lookup(bay, "SEDAN-04", Pose2D{2.02, 8.98, 0.1}, out));
+    assert(!cache.lookup(bay, "SEDAN-04", Pose2D{2.2, 9.0, 0.1}, out));
+    assert(!cache.lookup(bay, "SEDAN-04", Pose2D{2.0, 9.0, 0.2}, out));
+    assert(!cache.lookup(bay, "VAN-10", start, out));
+    assert(!cache.lookup(OrientedBox{Vec2{10.0, 5.0}, 3.0, 1.25, 0.0}, "SEDAN-04", start, out));
+
+    assert(cache.makeKey(bay, "SEDAN-04", start) == cache.makeKey(bay, "SEDAN-04", Pose2D{2.01, 9.0, 0.1}));
+
+    PlanCacheStats s = cache.stats();
+    assert(s.hits == 2 && s.misses == 5 && s.insertions == 1 && s.entries == 1);
+
+    bool threw = false;
+    try {
+        PlanCache bad(1024, 0.0);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "✅ Lookup tests passed\n";
+}
+
+/**
+ * @brief Tests reuse across identical bays elsewhere in the lot
+ *
+ * A plan stored for one bay is returned for a bay of the same size that is
+ * translated and rotated, when approached from the same relative pose,
+ * and comes back transformed into the new bay's position.
+ */
+void testBayFrameReuse() {
+    std::cout << "Testing reuse across identical bays...\n";
+
+    PlanCache cache(1 << 20);
+    OrientedBox bayA = {Vec2{10.0, 5.0}, 2.5, 1.25, 0.0};
+    Pose2D startA = {4.0, 8.0, 0.0};
+    std::vector<Pose2D> planA = straightPlan(startA, bayA);
+    cache.insert(bayA, "HATCH-02", startA, planA);
+
+    // Same bay shape rotated by 90 degrees and moved
+    const double turn = kPi / 2;
+    OrientedBox bayB = {Vec2{50.0, -20.0}, 2.5, 1.25, turn};
+    Vec2 offset = rotate(Vec2{startA.x, startA.y} - bayA.center, turn);
+    Pose2D startB = {bayB.center.x + offset.x, bayB.center.y + offset.y, startA.heading + turn};
+
+    std::vector<Pose2D> planB;
+    assert(cache.lookup(bayB, "HATCH-02", startB, planB));
+    assert(planB.size() == planA.size());
+    assert(near(planB.front().x, startB.x, 1e-9) && near(planB.front().y, startB.y, 1e-9));
+    assert(near(planB.back().x, bayB.center.x, 1e-9) && near(planB.back().y, bayB.center.y, 1e-9));
+    assert(near(planB.back().heading, turn, 1e-9));
+
+    std::cout << "✅ Bay frame reuse tests passed\n";
+}
+
+/**
+ * @brief Tests LRU eviction under a byte budget
+ *
+ * Test Cases:
+ * - Bytes never exceed the budget
+ * - Recently used entries survive, the oldest unused ones are evicted
+ * - Oversized trajectories are not stored
+ * - Re-inserting a key replaces it without double counting
+ */
+void testEviction() {
+    std::cout << "Testing LRU eviction...\n";
+
+    OrientedBox bay = {Vec2{0, 0}, 2.5, 1.25, 0.0};
+    PlanCache probe(1 << 20);
+    probe.insert(bay, "CITY-01", Pose2D{0, 10, 0}, straightPlan(Pose2D{0, 10, 0}, bay, 100));
+    const std::size_t entryBytes = probe.stats().bytes;
+    probe.insert(bay, "CITY-01", Pose2D{0, 10, 0}, straightPlan(Pose2D{0, 10, 0}, bay, 100));
+    assert(probe.stats().bytes == entryBytes && probe.stats().entries == 1);
+
+    PlanCache cache(entryBytes * 4 + entryBytes / 2);   // room for four entries
+    std::vector<Pose2D> out;
+    for (int i = 0; i < 4; ++i) {
+        Pose2D start = {static_cast<double>(i), 10.0, 0.0};
+        cache.insert(bay, "CITY-01", start, straightPlan(start, bay, 100));
+    }
+    assert(cache.stats().entries == 4);
+
+    // Touch entry 0 so entry 1 becomes the least recently used
+    assert(cache.lookup(bay, "CITY-01", Pose2D{0, 10, 0}, out));
+    Pose2D fifth = {4.0, 10.0, 0.0};
+    cache.insert(bay, "CITY-01", fifth, straightPlan(fifth, bay, 100));
+
+    PlanCacheStats s = cache.stats();
+    assert(s.entries == 4 && s.evictions == 1);
+    assert(s.bytes <= entryBytes * 4 + entryBytes / 2);
+    assert(cache.lookup(bay, "CITY-01", Pose2D{0, 10, 0}, out));
+    assert(!cache.lookup(bay, "CITY-01", Pose2D{1, 10, 0}, out));
+    assert(cache.lookup(bay, "CITY-01", Pose2D{2, 10, 0}, out));
+    assert(cache.lookup(bay, "CITY-01", fifth, out));
+
+    cache.insert(bay, "CITY-01", Pose2D{9, 9, 0}, straightPlan(Pose2D{9, 9, 0}, bay, 100000));
+    assert(!cache.lookup(bay, "CITY-01", Pose2D{9, 9, 0}, out));
+
+    cache.clear();
+    assert(cache.stats().entries == 0 && cache.stats().bytes == 0);
+
+    std::cout << "✅ Eviction tests passed\n";
+}
+
+/**
+ * @brief Tests getOrPlan() and its statistics
+ */
+void testGetOrPlan() {
+    std::cout << "Testing getOrPlan...\n";
+
+    PlanCache cache(1 << 20);
+    OrientedBox bay = {Vec2{10.0, 5.0}, 2.5, 1.25, 0.0};
+    Pose2D start = {2.0, 9.0, 0.0};
+    int plannerCalls = 0;
+    PlanCache::Planner planner = [&]() {
+        plannerCalls++;
+        return straightPlan(start, bay);
+    };
+
+    for (int i = 0; i < 10; ++i) assert(cache.getOrPlan(bay, "SUV-07", start, planner).size() == 50);
+    assert(plannerCalls == 1);
+
+    // Failed plans are returned but never cached
+    int failures = 0;
+    PlanCache::Planner failing = [&]() {
+        failures++;
+        return std::vector<Pose2D>();
+    };
+    assert(cache.getOrPlan(bay, "SUV-08", start, failing).empty());
+    assert(cache.getOrPlan(bay, "SUV-08", start, failing).empty());
+    assert(failures == 2);
+
+    PlanCacheStats s = cache.stats();
+    assert(s.hits == 9 && s.misses == 3);
+    assert(near(s.hitRate(), 0.75));
+    assert(s.meanHitLatencyUs > 0 && s.meanMissLatencyUs > 0);
+
+    std::cout << "✅ getOrPlan tests passed\n";
+}
+
+/**
+ * @brief Executes all plan cache tests
+ * @return 0 on success, 1 on failure
+ */
+int runAllTests() {
+    std::cout << "=== Running Plan Cache Unit Tests ===\n\n";
+
+    try {
+        testLookup();
+        testBayFrameReuse();
+        testEviction();
+        testGetOrPlan();
+
+        std::cout << "\n🎉 All tests passed successfully!\n";
+        std::cout << "Total tests run: 4\n";
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
+
+/**
+ * @brief Main entry point for the plan cache test suite
+ * @return 0 on success, 1 on failure
+ */
+int main() {
+    return runAllTests();
+}
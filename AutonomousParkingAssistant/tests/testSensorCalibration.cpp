@@ -0,0 +1,206 @@
+/**
+ * @file testSensorCalibration.cpp
+ * @brief Unit tests for sensor calibration and the per-vehicle table
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ *
+ * Test Coverage:
+ * - Offset, gain and temperature corrections and their effect on checkSafety()
+ * - Batch calibration against the per-frame path
+ * - Table lookup, replacement, binary round trip and corrupt input
+ */
+
+#include "../include/SensorCalibration.h"
+#include "../include/ParkingUtils.h"
+#include "TestSupport.h"
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+double uniform(double lo, double hi) {
+    return lo + (hi - lo) * (std::rand() / (RAND_MAX + 1.0));
+}
+
+SensorCalibration sampleCalibration() {
+    SensorCalibration cal;
+    cal.left.offset = -0.04f;
+    cal.center.gain = 1.05f;
+    cal.center.tempCoeff = 0.0017f;
+    cal.right.offset = 0.02f;
+    cal.right.gain = 0.98f;
+    return cal;
+}
+
+} // namespace
+
+/**
+ * @brief Tests single-reading calibration
+ *
+ * Test Cases:
+ * - The default calibration changes nothing
+ * - Offsets and gains are applied per sensor
+ * - Temperature compensation scales around the reference temperature
+ * - A unit reading 4 cm long no longer looks parked once calibrated
+ */
+void testCalibrate() {
+    std::cout << "Testing reading calibration...\n";
+
+    SensorData raw{0.42, 0.8, 1.5};
+    SensorData same = calibrate(raw, SensorCalibration(), 35.0);
+    assert(same.left == raw.left && same.center == raw.center && same.right == raw.right);
+
+    SensorCalibration cal = sampleCalibration();
+    SensorData s = calibrate(raw, cal, 20.0);
+    assert(near(s.left, 0.42 - 0.04, 1e-7));
+    assert(near(s.center, 0.8 * 1.05, 1e-7));
+    assert(near(s.right, 1.5 * 0.98 + 0.02, 1e-7));
+
+    // 10 °C colder than the reference: the center reading shrinks by 1.7 %
+    SensorData cold = calibrate(raw, cal, 10.0);
+    assert(near(cold.center, 0.8 * 1.05 * (1.0 - 0.017), 1e-6));
+    assert(near(cold.left, s.left, 1e-12));
+
+    SensorCalibration longUnit;
+    longUnit.left.offset = longUnit.center.offset = longUnit.right.offset = -0.04f;
+    SensorData parkedRaw{0.33, 0.31, 0.36};
+    assert(checkSafety(parkedRaw) == "Perfectly Parked ✅");
+    assert(checkSafety(calibrate(parkedRaw, longUnit, 20.0)).find("TOO CLOSE") != std::string::npos);
+
+    std::cout << "✅ Reading calibration tests passed\n";
+}
+
+/**
+ * @brief Tests batch calibration of recorded sessions
+ *
+ * Test Cases:
+ * - Every frame matches calibrate() exactly, for odd and even session lengths
+ * - Empty sessions are accepted
+ */
+void testCalibrateFrames() {
+    std::cout << "Testing batch calibration...\n";
+
+    SensorCalibration cal = sampleCalibration();
+    std::srand(67);
+    for (std::size_t n : {0u, 1u, 2u, 3u, 7u, 1000u}) {
+        std::vector<SensorData> frames(n);
+        for (SensorData& s : frames) s = SensorData{uniform(0.0, 4.0), uniform(0.0, 4.0), uniform(0.0, 4.0)};
+        std::vector<SensorData> batch = frames;
+        calibrateFrames(batch, cal, -5.0);
+        for (std::size_t i = 0; i < n; ++i) {
+            SensorData expected = calibrate(frames[i], cal, -5.0);
+            assert(batch[i].left == expected.left && batch[i].center == expected.center &&
+                   batch[i].right == expected.right);
+        }
+    }
+
+    std::cout << "✅ Batch calibration tests passed\n";
+}
+
+/**
+ * @brief Tests the per-vehicle calibration table
+ *
+ * Test Cases:
+ * - Lookup of present and missing vehicles, replacement and removal
+ * - Binary round trip keeps every entry and its order
+ * - Invalid entries, foreign and truncated streams are rejected
+ * - A stored record with an invalid calibration is rejected by number and id
+ */
+void testCalibrationTable() {
+    std::cout << "Testing calibration table...\n";
+
+    CalibrationTable table;
+    assert(table.find("FLEET-0001") == nullptr);
+    const char* ids[] = {"FLEET-0042", "FLEET-0007", "VAN-12", "FLEET-0100"};
+    for (int i = 0; i < 4; ++i) {
+        SensorCalibration cal;
+        cal.left.offset = 0.01f * i;
+        table.set(ids[i], cal);
+    }
+    assert(table.size() == 4);
+    assert(table.find("FLEET-0042") && near(table.find("FLEET-0042")->left.offset, 0.0));
+    assert(table.find("VAN-12") && near(table.find("VAN-12")->left.offset, 0.02, 1e-7));
+    assert(table.find("FLEET-004") == nullptr && table.find("") == nullptr);
+
+    table.set("VAN-12", sampleCalibration());
+    assert(table.size() == 4 && near(table.find("VAN-12")->center.gain, 1.05, 1e-7));
+    assert(table.erase("FLEET-0007") && !table.erase("FLEET-0007") && table.size() == 3);
+
+    std::stringstream file;
+    table.save(file);
+    assert(file.str().size() == 12 + 3 * 56);
+    CalibrationTable loaded = CalibrationTable::load(file);
+    assert(loaded.size() == 3);
+    const SensorCalibration* van = loaded.find("VAN-12");
+    assert(van && van->right.gain == 0.98f && van->center.tempCoeff == 0.0017f && van->referenceTemp == 20.0f);
+    assert(loaded.find("FLEET-0100") && loaded.find("FLEET-0042") && !loaded.find("FLEET-0007"));
+
+    SensorCalibration badGain;
+    badGain.center.gain = 0.0f;
+    SensorCalibration badOffset;
+    badOffset.right.offset = std::nanf("");
+    const std::string longId(16, 'X');
+    bool threw[4] = {false, false, false, false};
+    try { table.set("", SensorCalibration()); } catch (const std::invalid_argument&) { threw[0] = true; }
+    try { table.set(longId, SensorCalibration()); } catch (const std::invalid_argument&) { threw[1] = true; }
+    try { table.set("CAR", badGain); } catch (const std::invalid_argument&) { threw[2] = true; }
+    try { table.set("CAR", badOffset); } catch (const std::invalid_argument&) { threw[3] = true; }
+    assert(threw[0] && threw[1] && threw[2] && threw[3] && table.size() == 3);
+
+    std::string bytes = file.str();
+    std::istringstream foreign("PNG" + bytes.substr(3));
+    std::istringstream truncated(bytes.substr(0, bytes.size() - 10));
+    bool rejected[2] = {false, false};
+    try { CalibrationTable::load(foreign); } catch (const std::runtime_error&) { rejected[0] = true; }
+    try { CalibrationTable::load(truncated); } catch (const std::runtime_error&) { rejected[1] = true; }
+    assert(rejected[0] && rejected[1]);
+
+    // Zero the center gain of the second record, FLEET-0100
+    std::string corrupt = bytes;
+    const std::size_t gainAt = 12 + 56 + 16 + offsetof(SensorCalibration, center) + offsetof(ChannelCalibration, gain);
+    const float zero = 0.0f;
+    corrupt.replace(gainAt, sizeof(zero), reinterpret_cast<const char*>(&zero), sizeof(zero));
+    std::istringstream invalid(corrupt);
+    std::string message;
+    try { CalibrationTable::load(invalid); } catch (const std::runtime_error& e) { message = e.what(); }
+    assert(message.find("record 2 (FLEET-0100)") != std::string::npos && message.find("gain") != std::string::npos);
+
+    std::cout << "✅ Calibration table tests passed\n";
+}
+
+/**
+ * @brief Executes all sensor calibration tests
+ * @return 0 on success, 1 on failure
+ */
+int runAllTests() {
+    std::cout << "=== Running Sensor Calibration Unit Tests ===\n\n";
+
+    try {
+        testCalibrate();
+        testCalibrateFrames();
+        testCalibrationTable();
+
+        std::cout << "\n🎉 All tests passed successfully!\n";
+        std::cout << "Total tests run: 3\n";
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
+
+/**
+ * @brief Main entry point for the sensor calibration test suite
+ * @return 0 on success, 1 on failure
+ */
+int main() {
+    return runAllTests();
+}
@@ -0,0 +1,284 @@
+/**
+ * @file testSensorHealthMonitor.cpp
+ * @brief Unit tests for the sensor health monitor and degraded classification
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ *
+ * Test Coverage:
+ * - Rolling mean and variance against an exact recomputation
+ * - Stuck, erratic and invalid sensors, recovery, and no false alarms
+ * - Degraded mode of the status classifier
+ */
+
+#include "../include/SensorHealthMonitor.h"
+#include "../include/StatusClassifier.h"
+#include <cassert>
+#include <cmath>
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+double uniform(double lo, double hi) {
+    return lo + (hi - lo) * (std::rand() / (RAND_MAX + 1.0));
+}
+
+/**
+ * @brief Reading of a car reversing slowly with a little sensor noise
+ */
+SensorData reversing(int frame) {
+    double d = 2.0 - 0.02 * frame;
+    return SensorData{d + 0.3 + uniform(-0.005, 0.005), d + uniform(-0.005, 0.005), d + 0.6 + uniform(-0.005, 0.005)};
+}
+
+} // namespace
+
+/**
+ * @brief Tests the rolling statistics
+ *
+ * Test Cases:
+ * - Mean and variance match a direct computation over the last window
+ *   frames throughout a long stream with a large offset
+ * - The rate is the change since the previous frame
+ * - Invalid configurations are rejected
+ */
+void testRollingStatistics() {
+    std::cout << "Testing rolling statistics...\n";
+
+    SensorHealthConfig config;
+    config.window = 10;
+    SensorHealthMonitor monitor(config);
+    std::deque<double> window;
+    std::srand(66);
+    double previous = 0.0;
+    for (int frame = 0; frame < 5000; ++frame) {
+        double x = 1000.0 + uniform(-0.5, 0.5);   // offset makes naive sums lose precision
+        monitor.update(SensorData{x, 1.0, 1.0});
+        window.push_back(x);
+        if (window.size() > config.window) window.pop_front();
+
+        double mean = 0.0, var = 0.0;
+        for (double v : window) mean += v;
+        mean /= window.size();
+        for (double v : window) var += (v - mean) * (v - mean);
+        var /= window.size();
+
+        SensorHealth h = monitor.health(SensorChannel::Left);
+        assert(std::fabs(h.mean - mean) < 1e-9);
+        assert(std::fabs(h.variance - var) < 1e-9);
+        if (frame > 0) assert(std::fabs(h.rate - (x - previous)) < 1e-12);
+        previous = x;
+    }
+    assert(monitor.frames() == 5000);
+    monitor.reset();
+    assert(monitor.frames() == 0 && monitor.health(SensorChannel::Left).variance == 0.0);
+
+    SensorHealthConfig bad[4];
+    bad[0].window = 1;
+    bad[1].maxJumps = 0;
+    bad[2].maxStep = -0.1;
+    bad[3].stuckVariance = 1.0;   // above movingVariance
+    for (const SensorHealthConfig& c : bad) {
+        bool threw = false;
+        try {
+            SensorHealthMonitor invalid(c);
+        } catch (const std::invalid_argument&) {
+            threw = true;
+        }
+        assert(threw);
+    }
+
+    std::cout << "✅ Rolling statistics tests passed\n";
+}
+
+/**
+ * @brief Tests fault detection
+ *
+ * Test Cases:
+ * - A healthy reversing session raises nothing
+ * - A sensor frozen while the others move is flagged once the window is full
+ * - A car standing still is not flagged
+ * - Repeated implausible jumps are flagged, a single jump is not
+ * - NaN and negative readings are flagged at once and do not poison the statistics
+ * - A stuck sensor stays flagged when the car stops; faults clear once
+ *   the readings look normal again
+ */
+void testFaultDetection() {
+    std::cout << "Testing fault detection...\n";
+
+    SensorHealthMonitor monitor;   // 16 frame window
+    std::srand(67);
+    for (int frame = 0; frame < 60; ++frame) assert(monitor.update(reversing(frame)) == 0);
+
+    // Center sensor freezes at 0.45 m while the car keeps reversing
+    monitor.reset();
+    unsigned mask = 0;
+    int flaggedAt = -1;
+    for (int frame = 0; frame < 40; ++frame) {
+        SensorData s = reversing(frame);
+        s.center = 0.45;
+        mask = monitor.update(s);
+        if (mask != 0 && flaggedAt < 0) flaggedAt = frame;
+    }
+    assert(flaggedAt == 15 && mask == sensorBit(SensorChannel::Center));
+    assert(monitor.health(SensorChannel::Center).fault == SensorFault::Stuck && monitor.degraded());
+    for (int frame = 0; frame < 20; ++frame) mask = monitor.update(SensorData{0.4, 0.45, 0.5});   // car stops
+    assert(mask == sensorBit(SensorChannel::Center));
+    mask = monitor.update(reversing(40));
+    assert(mask == 0);
+
+    // Standing still: every sensor is frozen, nothing is wrong
+    monitor.reset();
+    for (int frame = 0; frame < 40; ++frame) assert(monitor.update(SensorData{0.4, 0.45, 0.4}) == 0);
+
+    // One obstacle appearing is a single jump
+    monitor.reset();
+    for (int frame = 0; frame < 20; ++frame) {
+        SensorData s = reversing(frame);
+        if (frame >= 10) s.right = 0.8;
+        assert(monitor.update(s) == 0);
+    }
+    assert(monitor.health(SensorChannel::Right).jumps == 1);
+
+    // Left sensor flickering between near and far
+    monitor.reset();
+    for (int frame = 0; frame < 16; ++frame) {
+        SensorData s = reversing(frame);
+        s.left = frame % 4 == 0 ? 3.5 : 0.6;
+        mask = monitor.update(s);
+    }
+    assert(mask == sensorBit(SensorChannel::Left));
+    assert(monitor.health(SensorChannel::Left).fault == SensorFault::Erratic);
+
+    // Invalid readings
+    monitor.reset();
+    for (int frame = 0; frame < 5; ++frame) monitor.update(SensorData{1.0, 1.2, 1.4});
+    mask = monitor.update(SensorData{std::nan(""), 1.2, -0.2});
+    assert(mask == (sensorBit(SensorChannel::Left) | sensorBit(SensorChannel::Right)));
+    assert(monitor.health(SensorChannel::Left).fault == SensorFault::Invalid);
+    assert(std::fabs(monitor.health(SensorChannel::Left).mean - 1.0) < 1e-12);
+    assert(monitor.update(SensorData{1.0, 1.2, 1.4}) == 0);
+    assert(std::string(faultName(SensorFault::Stuck)) == "STUCK" && std::string(faultName(SensorFault::None)) == "OK");
+
+    std::cout << "✅ Fault detection tests passed\n";
+}
+
+/**
+ * @brief Tests the degraded mode of the status classifier
+ *
+ * Test Cases:
+ * - A stuck sensor at a parked distance no longer produces "Perfectly Parked",
+ *   even after the car has stopped
+ * - A steady side sensor beside a wall is flagged stuck while reversing,
+ *   and its 0.2 m reading still keeps TooClose
+ * - A degraded sensor reading close or a collision still reports it, with
+ *   hysteresis; invalid readings do not
+ * - With every sensor degraded the status is TooClose unless one shows a collision
+ * - Leaving degraded mode restores normal classification
+ */
+void testDegradedClassification() {
+    std::cout << "Testing degraded classification...\n";
+
+    // Sides close in on a parked position while the center sensor is frozen at 0.45 m
+    StatusClassifier trusting;
+    StatusClassifier classifier;
+    SensorHealthMonitor monitor;
+    StatusEvent event;
+    std::srand(68);
+    bool trustingParked = false, monitoredParked = false;
+    for (int frame = 0; frame < 140; ++frame) {
+        double d = 2.0 - 0.02 * frame;
+        SensorData s{std::max(0.4, d + 0.3) + uniform(0.0, 0.005), 0.45, std::max(0.45, d + 0.6) + uniform(0.0, 0.005)};
+        classifier.setDegradedSensors(monitor.update(s));
+        if (classifier.update(s, &event) && event.to == ParkingStatus::PerfectlyParked) monitoredParked = true;
+        if (trusting.update(s) && trusting.current() == ParkingStatus::PerfectlyParked) trustingParked = true;
+    }
+    // The car has stopped, but the frozen sensor stays flagged
+    assert(trustingParked && !monitoredParked);
+    assert(classifier.degradedSensors() == sensorBit(SensorChannel::Center));
+    assert(classifier.current() == ParkingStatus::Safe);
+
+    // A real obstacle on a working sensor is still reported at once
+    assert(classifier.update(SensorData{0.2, 0.45, 0.6}, &event));
+    assert(event.to == ParkingStatus::TooClose && event.label.find("LEFT") != std::string::npos);
+
+    // Reversing alongside a wall: the left sensor reads a steady 0.2 m while the rear one moves
+    classifier.reset();
+    monitor.reset();
+    bool safeBesideWall = false;
+    for (int frame = 0; frame < 60; ++frame) {
+        SensorData s{0.2, 2.5 - 0.02 * frame + uniform(-0.005, 0.005), 1.5 + uniform(-0.005, 0.005)};
+        classifier.setDegradedSensors(monitor.update(s));
+        classifier.update(s, &event);
+        if (classifier.current() != ParkingStatus::TooClose) safeBesideWall = true;
+    }
+    assert(monitor.health(SensorChannel::Left).fault == SensorFault::Stuck);
+    assert(classifier.degradedSensors() == sensorBit(SensorChannel::Left) && !safeBesideWall);
+
+    // A broken sensor reading close raises a warning, but invalid readings do not
+    classifier.reset();
+    classifier.setDegradedSensors(sensorBit(SensorChannel::Right));
+    assert(classifier.update(SensorData{1.0, 1.0, 0.2}, &event) && event.to == ParkingStatus::TooClose);
+    assert(event.label == "TOO CLOSE ⚠️ (RIGHT) [DEGRADED]");
+    for (int frame = 0; frame < 3; ++frame) classifier.update(SensorData{1.0, 1.0, -0.2});
+    for (int frame = 0; frame < 3; ++frame) classifier.update(SensorData{1.0, 1.0, std::nan("")});
+    assert(classifier.current() == ParkingStatus::Safe);
+
+    // ... and a collision on it is reported at once, and left only past the hysteresis band
+    assert(classifier.update(SensorData{1.0, 1.0, 0.05}, &event) && event.to == ParkingStatus::Collision);
+    assert(event.label == "🚨 COLLISION! STOP IMMEDIATELY! [DEGRADED]");
+    for (int frame = 0; frame < 3; ++frame) assert(!classifier.update(SensorData{1.0, 1.0, 0.12}));
+    for (int frame = 0; frame < 3; ++frame) classifier.update(SensorData{1.0, 1.0, 0.2}, &event);
+    assert(classifier.current() == ParkingStatus::TooClose);
+    for (int frame = 0; frame < 3; ++frame) classifier.update(SensorData{1.0, 1.0, 0.4}, &event);
+    assert(classifier.current() == ParkingStatus::Safe);
+
+    classifier.setDegradedSensors(7u);
+    for (int frame = 0; frame < 3; ++frame) classifier.update(SensorData{1.0, 1.0, 1.0}, &event);
+    assert(classifier.current() == ParkingStatus::TooClose);
+    assert(event.label == "TOO CLOSE ⚠️ (NO WORKING SENSOR) [DEGRADED]");
+    assert(classifier.update(SensorData{1.0, 0.08, 1.0}, &event) && event.to == ParkingStatus::Collision);
+    for (int frame = 0; frame < 3; ++frame) classifier.update(SensorData{1.0, 1.0, 1.0});
+    assert(classifier.current() == ParkingStatus::TooClose);
+
+    classifier.setDegradedSensors(0);
+    for (int frame = 0; frame < 3; ++frame) classifier.update(SensorData{0.4, 0.4, 0.4}, &event);
+    assert(classifier.current() == ParkingStatus::PerfectlyParked && event.label == "Perfectly Parked ✅");
+    classifier.reset();
+    assert(classifier.degradedSensors() == 0);
+
+    std::cout << "✅ Degraded classification tests passed\n";
+}
+
+/**
+ * @brief Executes all sensor health monitor tests
+ * @return 0 on success, 1 on failure
+ */
+int runAllTests() {
+    std::cout << "=== Running Sensor Health Monitor Unit Tests ===\n\n";
+
+    try {
+        testRollingStatistics();
+        testFaultDetection();
+        testDegradedClassification();
+
+        std::cout << "\n🎉 All tests passed successfully!\n";
+        std::cout << "Total tests run: 3\n";
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
+
+/**
+ * @brief Main entry point for the sensor health monitor test suite
+ * @return 0 on success, 1 on failure
+ */
+int main() {
+    return runAllTests();
+}
@@ -0,0 +1,191 @@
+/**
+ * @file testSessionSummary.cpp
+ * @brief Unit tests for the streaming session summary
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ *
+ * Test Coverage:
+ * - Per-sensor minimum, mean and maximum against a direct computation
+ * - Frames and time per zone, steps to park
+ * - Summary-only parking sessions
+ */
+
+#include "../include/SessionSummary.h"
+#include "../include/ParkingUtils.h"
+#include "TestSupport.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+double uniform(double lo, double hi) {
+    return lo + (hi - lo) * (std::rand() / (RAND_MAX + 1.0));
+}
+
+} // namespace
+
+/**
+ * @brief Tests the per-sensor aggregates
+ *
+ * Test Cases:
+ * - Minimum, mean and maximum match a direct computation over a long stream
+ * - NaN readings are counted as frames but left out of the statistics
+ * - reset() forgets everything
+ */
+void testSensorAggregates() {
+    std::cout << "Testing sensor aggregates...\n";
+
+    SessionSummary summary;
+    std::vector<SensorData> frames;
+    std::srand(68);
+    for (int i = 0; i < 100000; ++i) {
+        SensorData s{uniform(0.2, 3.0), uniform(0.1, 5.0), uniform(0.3, 2.0)};
+        frames.push_back(s);
+        summary.add(s, plainStatus(s));
+    }
+    double lo = 1e9, hi = -1e9, sum = 0.0;
+    for (const SensorData& s : frames) {
+        lo = std::min(lo, s.center);
+        hi = std::max(hi, s.center);
+        sum += s.center;
+    }
+    assert(summary.frames() == frames.size());
+    assert(summary.center().min == lo && summary.center().max == hi);
+    assert(near(summary.center().mean, sum / frames.size(), 1e-9));
+    assert(summary.left().min >= 0.2 && summary.right().max < 2.0);
+
+    summary.reset();
+    summary.add(SensorData{0.8, std::nan(""), 1.2}, ParkingStatus::Safe);
+    summary.add(SensorData{0.6, 0.9, 1.0}, ParkingStatus::Safe);
+    assert(summary.frames() == 2 && summary.framesIn(ParkingStatus::Safe) == 2);
+    assert(near(summary.left().mean, 0.7) && near(summary.center().mean, 0.9) && summary.center().min == 0.9);
+
+    summary.reset();
+    assert(summary.frames() == 0 && summary.framesIn(ParkingStatus::Safe) == 0 && summary.stepsToPark() == 0);
+
+    std::cout << "✅ Sensor aggregate tests passed\n";
+}
+
+/**
+ * @brief Tests zone counts, zone timing and steps to park
+ *
+ * Test Cases:
+ * - Time between frames is credited to the zone of the earlier frame
+ * - Frames without timestamps add no time
+ * - Steps to park is the first parked frame
+ * - The printed tables name every zone
+ */
+void testZones() {
+    std::cout << "Testing zone statistics...\n";
+
+    SessionSummary summary;
+    summary.add(SensorData{1.0, 1.0, 1.0}, ParkingStatus::Safe, 10.0);
+    summary.add(SensorData{0.2, 0.6, 1.0}, ParkingStatus::TooClose, 12.5);
+    summary.add(SensorData{0.35, 0.6, 0.7}, ParkingStatus::Safe, 13.0);
+    summary.add(SensorData{0.4, 0.4, 0.4}, ParkingStatus::PerfectlyParked, 14.0);
+    summary.add(SensorData{0.4, 0.4, 0.4}, ParkingStatus::PerfectlyParked, 20.0);
+    summary.add(SensorData{0.4, 0.38, 0.4}, ParkingStatus::PerfectlyParked);   // untimed
+    summary.add(SensorData{0.4, 0.38, 0.4}, ParkingStatus::PerfectlyParked, 30.0);
+
+    assert(summary.framesIn(ParkingStatus::Safe) == 2 && summary.framesIn(ParkingStatus::TooClose) == 1);
+    assert(summary.framesIn(ParkingStatus::PerfectlyParked) == 4 && summary.framesIn(ParkingStatus::Collision) == 0);
+    assert(near(summary.secondsIn(ParkingStatus::Safe), 3.5));
+    assert(near(summary.secondsIn(ParkingStatus::TooClose), 0.5));
+    assert(near(summary.secondsIn(ParkingStatus::PerfectlyParked), 6.0));
+    assert(summary.stepsToPark() == 4);
+    assert(summary.left().min == 0.2 && summary.left().max == 1.0);
+
+    std::ostringstream out;
+    summary.print(out, "REAR");
+    std::string text = out.str();
+    assert(text.find("Session Statistics (7 frames)") != std::string::npos);
+    assert(text.find("REAR") != std::string::npos && text.find("TOO CLOSE") != std::string::npos);
+    assert(text.find("Steps to park: 4") != std::string::npos);
+
+    SessionSummary empty;
+    std::ostringstream none;
+    empty.print(none);
+    assert(none.str().find("not parked") != std::string::npos);
+
+    std::cout << "✅ Zone statistics tests passed\n";
+}
+
+/**
+ * @brief Tests summary-only parking sessions
+ *
+ * Test Cases:
+ * - A long session prints the aggregates but no step table
+ * - The full-history mode still prints the step table, followed by the aggregates
+ * - Collisions end summary-only sessions too
+ * - Opposite-movement frames count as too close, never as collisions
+ */
+void testSummaryOnlyLoop() {
+    std::cout << "Testing summary-only sessions...\n";
+
+    std::string input;
+    for (int i = 0; i < 500; ++i) input += i % 2 ? "0.8\n1.2\n0.9\n" : "0.9\n1.1\n0.8\n";
+    input += "0.45\n0.4\n0.45\n";
+    std::string output = runLoop(input, [] { parkingAssistantLoop(true, false, SessionReport::SummaryOnly); });
+    assert(output.find("📊 Parking Summary:") == std::string::npos);
+    assert(output.find("Session Statistics (501 frames)") != std::string::npos);
+    assert(output.find("Steps to park: 501") != std::string::npos);
+    assert(output.find("REAR") != std::string::npos);
+    assert(output.find("Parking simulation completed successfully") != std::string::npos);
+
+    output = runLoop("0.6\n0.6\n0.6\n0.4\n0.4\n0.4\n", [] { parkingAssistantLoop(true, false); });
+    assert(output.find("📊 Parking Summary:") != std::string::npos);
+    assert(output.find("📊 Parking Summary:") < output.find("Session Statistics (2 frames)"));
+
+    output = runLoop("0.6\n0.6\n0.6\n0.05\n0.6\n0.6\n", [] {
+        parkingAssistantLoop(true, false, SessionReport::SummaryOnly);
+    });
+    assert(output.find("Parking simulation ended due to collision") != std::string::npos);
+    assert(output.find("Steps to park: not parked") != std::string::npos);
+
+    output = runLoop("0.05\n0.05\n0.05\n0.4\n0.4\n0.4\n", [] {
+        parkingAssistantLoop(true, false, SessionReport::SummaryOnly);
+    });
+    assert(output.find("Opposite Movement") != std::string::npos);
+    assert(output.find("TOO CLOSE           1 ") != std::string::npos);
+    assert(output.find("COLLISION!          0 ") != std::string::npos);
+    assert(output.find("Steps to park: 2") != std::string::npos);
+    assert(output.find("Parking simulation completed successfully") != std::string::npos);
+
+    std::cout << "✅ Summary-only session tests passed\n";
+}
+
+/**
+ * @brief Executes all session summary tests
+ * @return 0 on success, 1 on failure
+ */
+int runAllTests() {
+    std::cout << "=== Running Session Summary Unit Tests ===\n\n";
+
+    try {
+        testSensorAggregates();
+        testZones();
+        testSummaryOnlyLoop();
+
+        std::cout << "\n🎉 All tests passed successfully!\n";
+        std::cout << "Total tests run: 3\n";
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
+
+/**
+ * @brief Main entry point for the session summary test suite
+ * @return 0 on success, 1 on failure
+ */
+int main() {
+    return runAllTests();
+}
@@ -0,0 +1,280 @@
+/**
+ * @file testStatusClassifier.cpp
+ * @brief Unit tests for the hysteresis status classifier
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ *
+ * Test Coverage:
+ * - Agreement with checkSafety() away from the thresholds
+ * - Hysteresis bands and dwell time on noisy readings
+ * - Collision handling, reset and configuration checks
+ * - Change-only parking assistant loop
+ */
+
+#include "../include/StatusClassifier.h"
+#include "../include/ParkingUtils.h"
+#include "TestSupport.h"
+#include <cassert>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+double uniform(double lo, double hi) {
+    return lo + (hi - lo) * (std::rand() / (RAND_MAX + 1.0));
+}
+
+/**
+ * @brief Status checkSafety() reports for a reading
+ */
+ParkingStatus statelessStatus(const SensorData& s) {
+    try {
+        std::string status = checkSafety(s);
+        if (status.find("TOO CLOSE") != std::string::npos) return ParkingStatus::TooClose;
+        if (status.find("Perfectly Parked") != std::string::npos) return ParkingStatus::PerfectlyParked;
+        return ParkingStatus::Safe;
+    } catch (const UnsafeParkingException&) {
+        return ParkingStatus::Collision;
+    }
+}
+
+/**
+ * @brief True if no sensor lies within margin of a threshold
+ */
+bool clearOfThresholds(const SensorData& s, double margin) {
+    const double thresholds[] = {0.1, 0.3, 0.5};
+    const double readings[] = {s.left, s.center, s.right};
+    for (double r : readings)
+        for (double t : thresholds)
+            if (std::fabs(r - t) <= margin) return false;
+    return true;
+}
+
+std::size_t countOccurrences(const std::string& text, const std::string& word) {
+    std::size_t count = 0;
+    for (std::size_t pos = text.find(word); pos != std::string::npos; pos = text.find(word, pos + 1)) ++count;
+    return count;
+}
+
+} // namespace
+
+/**
+ * @brief Tests that settled statuses match checkSafety()
+ *
+ * Once a reading clear of all bands has been held for the dwell time, the
+ * classifier must agree with the stateless check.
+ */
+void testMatchesCheckSafety() {
+    std::cout << "Testing agreement with checkSafety...\n";
+
+    StatusClassifierConfig config;
+    StatusClassifier classifier(config);
+    StatusEvent event;
+
+    // The first reading is reported at once, with the plain thresholds
+    assert(classifier.update(SensorData{0.4, 0.4, 0.4}, &event));
+    assert(event.from == ParkingStatus::Unknown && event.to == ParkingStatus::PerfectlyParked);
+    assert(event.frame == 0 && event.label == "Perfectly Parked ✅");
+
+    std::srand(62);
+    int checked = 0;
+    while (checked < 500) {
+        SensorData s{uniform(0.15, 0.8), uniform(0.15, 0.8), uniform(0.15, 0.8)};
+        if (!clearOfThresholds(s, config.hysteresis)) continue;
+        for (std::size_t i = 0; i < config.minDwellFrames; ++i) classifier.update(s);
+        assert(classifier.current() == statelessStatus(s));
+        ++checked;
+    }
+    assert(classifier.frames() == 1 + 500 * config.minDwellFrames);
+    assert(std::string(statusName(ParkingStatus::TooClose)) == "TOO CLOSE");
+
+    std::cout << "✅ checkSafety agreement tests passed\n";
+}
+
+/**
+ * @brief Tests hysteresis bands and dwell time
+ *
+ * Test Cases:
+ * - Noise around 0.3 m and 0.5 m, smaller than the band, causes no changes
+ * - Warnings rise at once, but clear only after the dwell time
+ * - An interrupted dwell starts over
+ * - Parked has to hold for the dwell time
+ */
+void testHysteresisAndDwell() {
+    std::cout << "Testing hysteresis and dwell time...\n";
+
+    StatusClassifierConfig config;   // 0.03 m band, 3 frames
+    StatusClassifier classifier(config);
+    StatusEvent event;
+
+    // Center sensor hovering around 0.3 m: checkSafety flickers, the classifier does not
+    std::srand(7);
+    classifier.update(SensorData{0.8, 0.32, 0.8});
+    assert(classifier.current() == ParkingStatus::Safe);
+    std::size_t flips = 0;
+    ParkingStatus previous = ParkingStatus::Safe;
+    for (int i = 0; i < 1000; ++i) {
+        SensorData s{0.8, 0.3 + uniform(-0.025, 0.025), 0.8};
+        ParkingStatus stateless = statelessStatus(s);
+        flips += stateless != previous;
+        previous = stateless;
+        assert(!classifier.update(s));
+    }
+    assert(flips > 100 && classifier.transitions() == 1);
+
+    // A clear dip is reported on its first frame
+    assert(classifier.update(SensorData{0.8, 0.25, 0.8}, &event));
+    assert(event.to == ParkingStatus::TooClose && event.label == "TOO CLOSE ⚠️ (CENTER)");
+
+    // Leaving TooClose: inside the band nothing happens; beyond it, three frames are needed
+    assert(!classifier.update(SensorData{0.8, 0.32, 0.8}));
+    assert(!classifier.update(SensorData{0.8, 0.34, 0.8}));
+    assert(!classifier.update(SensorData{0.8, 0.34, 0.8}));
+    assert(!classifier.update(SensorData{0.8, 0.32, 0.8}));   // interrupted
+    assert(!classifier.update(SensorData{0.8, 0.34, 0.8}));
+    assert(!classifier.update(SensorData{0.8, 0.34, 0.8}));
+    assert(classifier.update(SensorData{0.8, 0.34, 0.8}, &event));
+    assert(event.from == ParkingStatus::TooClose && event.to == ParkingStatus::Safe && event.label == "SAFE");
+
+    // Around 0.5 m: Safe -> Parked needs every sensor at or below 0.47 m for three frames
+    for (int i = 0; i < 200; ++i)
+        assert(!classifier.update(SensorData{0.4, 0.4, 0.5 + uniform(-0.025, 0.025)}));
+    for (int i = 0; i < 2; ++i) assert(!classifier.update(SensorData{0.4, 0.4, 0.45}));
+    assert(classifier.update(SensorData{0.4, 0.4, 0.45}, &event));
+    assert(event.to == ParkingStatus::PerfectlyParked);
+    for (int i = 0; i < 200; ++i)
+        assert(!classifier.update(SensorData{0.4, 0.4, 0.5 + uniform(-0.025, 0.025)}));
+    assert(classifier.current() == ParkingStatus::PerfectlyParked);
+
+    // Without hysteresis or dwell the classifier is stateless
+    StatusClassifierConfig plain;
+    plain.hysteresis = 0.0;
+    plain.minDwellFrames = 1;
+    StatusClassifier stateless(plain);
+    for (int i = 0; i < 300; ++i) {
+        SensorData s{uniform(0.15, 0.8), uniform(0.15, 0.8), uniform(0.15, 0.8)};
+        stateless.update(s);
+        assert(stateless.current() == statelessStatus(s));
+    }
+
+    std::cout << "✅ Hysteresis and dwell tests passed\n";
+}
+
+/**
+ * @brief Tests collisions, reset and configuration checks
+ */
+void testCollisionAndMisuse() {
+    std::cout << "Testing collisions and misuse...\n";
+
+    StatusClassifier classifier;
+    StatusEvent event;
+    classifier.update(SensorData{0.4, 0.4, 0.4});
+    assert(classifier.update(SensorData{0.4, 0.1, 0.4}, &event));
+    assert(event.to == ParkingStatus::Collision && event.frame == 1);
+    assert(event.label == "🚨 COLLISION! STOP IMMEDIATELY!");
+
+    // Recovery needs 0.13 m and the dwell time, and goes through TooClose
+    assert(!classifier.update(SensorData{0.4, 0.12, 0.4}));
+    for (int i = 0; i < 2; ++i) assert(!classifier.update(SensorData{0.4, 0.2, 0.4}));
+    assert(classifier.update(SensorData{0.4, 0.2, 0.4}, &event));
+    assert(event.from == ParkingStatus::Collision && event.to == ParkingStatus::TooClose);
+    assert(classifier.transitions() == 3);
+
+    classifier.reset();
+    assert(classifier.current() == ParkingStatus::Unknown);
+    assert(classifier.frames() == 0 && classifier.transitions() == 0);
+    assert(classifier.update(SensorData{0.8, 0.8, 0.8}, &event) && event.to == ParkingStatus::Safe);
+
+    StatusClassifierConfig bad[4];
+    bad[0].closeDistance = 0.6;          // above the parked distance
+    bad[1].hysteresis = 0.1;             // wider than half the 0.1 - 0.3 gap
+    bad[2].hysteresis = -0.01;
+    bad[3].minDwellFrames = 0;
+    for (const StatusClassifierConfig& config : bad) {
+        bool threw = false;
+        try {
+            StatusClassifier invalid(config);
+        } catch (const std::invalid_argument&) {
+            threw = true;
+        }
+        assert(threw);
+    }
+
+    std::cout << "✅ Collision and misuse tests passed\n";
+}
+
+/**
+ * @brief Tests the change-only parking assistant loop
+ *
+ * Test Cases:
+ * - Noisy readings print and record each status once
+ * - Parking completes only after the dwell time
+ * - Collisions still end the session at once
+ */
+void testChangeOnlyLoop() {
+    std::cout << "Testing change-only parking loop...\n";
+
+    StatusClassifierConfig config;
+    std::string input;
+    for (int i = 0; i < 20; ++i) input += (i % 2 ? "0.7\n0.29\n0.6\n" : "0.7\n0.31\n0.6\n");
+    input += "0.4\n0.4\n0.4\n0.4\n0.41\n0.4\n0.4\n0.4\n0.4\n";
+    auto session = [&config] { parkingAssistantLoop(true, false, config); };
+    std::string output = runLoop(input, session);
+    assert(countOccurrences(output, "Status:") == 2);
+    assert(output.find("Status: SAFE") != std::string::npos);
+    assert(output.find("Status: Perfectly Parked") != std::string::npos);
+    assert(countOccurrences(output, "Steer LEFT") == 1);
+    assert(output.find("\n23      0.4") != std::string::npos);   // parked on step 23, recorded as such
+    assert(output.find("Parking simulation completed successfully") != std::string::npos);
+
+    output = runLoop("0.6\n0.6\n0.6\n0.6\n0.08\n0.6\n", session);
+    assert(output.find("COLLISION! STOP IMMEDIATELY") != std::string::npos);
+    assert(output.find("Parking simulation ended due to collision") != std::string::npos);
+
+    StatusClassifierConfig invalid;
+    invalid.minDwellFrames = 0;
+    bool threw = false;
+    try {
+        parkingAssistantLoop(false, true, invalid);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "✅ Change-only loop tests passed\n";
+}
+
+/**
+ * @brief Executes all status classifier tests
+ * @return 0 on success, 1 on failure
+ */
+int runAllTests() {
+    std::cout << "=== Running Status Classifier Unit Tests ===\n\n";
+
+    try {
+        testMatchesCheckSafety();
+        testHysteresisAndDwell();
+        testCollisionAndMisuse();
+        testChangeOnlyLoop();
+
+        std::cout << "\n🎉 All tests passed successfully!\n";
+        std::cout << "Total tests run: 4\n";
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
+
+/**
+ * @brief Main entry point for the status classifier test suite
+ * @return 0 on success, 1 on failure
+ */
+int main() {
+    return runAllTests();
+}
@@ -0,0 +1,248 @@
+/**
+ * @file testTelemetryCodec.cpp
+ * @brief Unit tests for the delta telemetry encoder and decoder
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ *
+ * Test Coverage:
+ * - Round trips within the dead band on a noisy approach
+ * - Suppressed frames, heartbeats and key frame pacing
+ * - Joining mid-stream and malformed input
+ */
+
+#include "../include/TelemetryCodec.h"
+#include <cassert>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+double uniform(double lo, double hi) {
+    return lo + (hi - lo) * (std::rand() / (RAND_MAX + 1.0));
+}
+
+/**
+ * @brief 50 Hz approach from 1.5 m to 0.4 m with sensor noise
+ */
+std::vector<TelemetryFrame> approach(int frames, double noise) {
+    std::vector<TelemetryFrame> out;
+    for (int i = 0; i < frames; ++i) {
+        double d = std::max(0.4, 1.5 - 1.1 * i / (frames * 0.8));
+        ParkingStatus status = d > 0.5 ? ParkingStatus::Safe : ParkingStatus::PerfectlyParked;
+        out.push_back(TelemetryFrame{1000000u + 20u * i,
+                                     SensorData{d + 0.1 + uniform(-noise, noise), d + uniform(-noise, noise),
+                                                d + 0.2 + uniform(-noise, noise)},
+                                     status});
+    }
+    return out;
+}
+
+bool throwsRuntime(TelemetryDecoder& decoder, const std::vector<std::uint8_t>& bytes) {
+    try {
+        decoder.decodeAll(bytes);
+    } catch (const std::runtime_error&) {
+        return true;
+    }
+    return false;
+}
+
+} // namespace
+
+/**
+ * @brief Tests that the receiver tracks the vehicle within the dead band
+ *
+ * Every input frame is checked against the latest decoded frame, which is
+ * what a receiver would display at that time.
+ */
+void testRoundTrip() {
+    std::cout << "Testing round trip...\n";
+
+    std::srand(63);
+    TelemetryConfig config;
+    TelemetryEncoder encoder(config);
+    TelemetryDecoder decoder(config.resolution);
+    std::vector<TelemetryFrame> frames = approach(1500, 0.004);
+
+    std::size_t rawBytes = 0;
+    TelemetryFrame shown = TelemetryFrame();
+    for (const TelemetryFrame& frame : frames) {
+        std::vector<std::uint8_t> packet;
+        std::size_t bytes = encoder.encode(frame, packet);
+        assert(bytes == packet.size());
+        rawBytes += sizeof(frame.timestampMs) + 3 * sizeof(double) + 1;
+        if (bytes > 0) {
+            std::size_t used = decoder.decode(packet.data(), packet.size(), shown);
+            assert(used == packet.size());
+            assert(shown.timestampMs == frame.timestampMs);
+        }
+        const double tolerance = config.deadband + config.resolution;
+        assert(std::fabs(shown.reading.left - frame.reading.left) < tolerance);
+        assert(std::fabs(shown.reading.center - frame.reading.center) < tolerance);
+        assert(std::fabs(shown.reading.right - frame.reading.right) < tolerance);
+        assert(shown.status == frame.status);   // status changes are never suppressed
+    }
+    assert(encoder.framesIn() == frames.size());
+    assert(encoder.framesSent() < frames.size() / 2);
+    assert(encoder.bytesSent() * 10 < rawBytes);
+
+    // Without a dead band every millimetre arrives
+    TelemetryConfig exact;
+    exact.deadband = 0.0;
+    TelemetryEncoder lossless(exact);
+    std::vector<std::uint8_t> stream;
+    for (const TelemetryFrame& frame : frames) lossless.encode(frame, stream);
+    std::vector<TelemetryFrame> decoded = TelemetryDecoder().decodeAll(stream);
+    assert(decoded.size() == lossless.framesSent());
+    const TelemetryFrame& last = decoded.back();
+    assert(std::fabs(last.reading.right - frames.back().reading.right) <= exact.resolution / 2 + 1e-12);
+
+    std::cout << "✅ Round trip tests passed\n";
+}
+
+/**
+ * @brief Tests suppression, heartbeats and key frames
+ *
+ * Test Cases:
+ * - A parked, motionless vehicle sends only heartbeats and key frames
+ * - Key frames carry every field and keep their pace
+ * - forceKeyframe() makes the next frame a key frame
+ */
+void testPacing() {
+    std::cout << "Testing frame pacing...\n";
+
+    TelemetryConfig config;
+    config.keyframeInterval = 50;
+    config.heartbeatInterval = 10;
+    TelemetryEncoder encoder(config);
+    TelemetryFrame still{0, SensorData{0.4, 0.4, 0.4}, ParkingStatus::PerfectlyParked};
+
+    std::vector<std::size_t> sizes;
+    for (int i = 0; i < 100; ++i) {
+        std::vector<std::uint8_t> packet;
+        still.timestampMs = 20u * i;
+        sizes.push_back(encoder.encode(still, packet));
+        if (!packet.empty()) assert(((packet[0] & 0x80) != 0) == (i % 50 == 0));
+    }
+    // Key frames at 0 and 50, heartbeats 10 frames after each sent frame
+    assert(encoder.framesSent() == 10);
+    for (int i = 0; i < 100; ++i) assert((sizes[i] > 0) == (i % 10 == 0));
+    assert(sizes[10] == 3);   // header and a two-byte timestamp delta only
+
+    encoder.forceKeyframe();
+    std::vector<std::uint8_t> packet;
+    still.timestampMs += 20;
+    assert(encoder.encode(still, packet) > 0 && (packet[0] & 0x80));
+
+    // A status change is sent at once, even with the sensors unchanged
+    packet.clear();
+    still.timestampMs += 20;
+    still.status = ParkingStatus::Safe;
+    assert(encoder.encode(still, packet) > 0 && packet[0] == 0x08);
+
+    std::cout << "✅ Pacing tests passed\n";
+}
+
+/**
+ * @brief Tests joining a stream mid-way and rejecting bad input
+ */
+void testSyncAndErrors() {
+    std::cout << "Testing synchronisation and errors...\n";
+
+    std::srand(5);
+    TelemetryEncoder encoder;
+    std::vector<std::vector<std::uint8_t>> packets;
+    for (const TelemetryFrame& frame : approach(300, 0.02)) {
+        std::vector<std::uint8_t> packet;
+        if (encoder.encode(frame, packet) > 0) packets.push_back(packet);
+    }
+
+    // A receiver that joins late rejects deltas until the next key frame
+    TelemetryDecoder late;
+    std::size_t rejected = 0, accepted = 0;
+    for (std::size_t i = 3; i < packets.size(); ++i) {
+        TelemetryFrame frame;
+        try {
+            late.decode(packets[i].data(), packets[i].size(), frame);
+            ++accepted;
+        } catch (const std::runtime_error&) {
+            assert(accepted == 0);
+            ++rejected;
+        }
+    }
+    assert(rejected > 0 && accepted > 0);
+
+    TelemetryDecoder decoder;
+    decoder.decodeAll(packets[0]);
+    std::vector<std::uint8_t> truncated(packets[1].begin(), packets[1].end() - 1);
+    assert(throwsRuntime(decoder, truncated));
+    assert(throwsRuntime(decoder, std::vector<std::uint8_t>{0x40, 0x01}));          // reserved bit
+    assert(throwsRuntime(decoder, std::vector<std::uint8_t>{0x81, 0x01, 0x05}));    // partial key frame
+    assert(throwsRuntime(decoder, std::vector<std::uint8_t>{0x08, 0x01, 0x09}));    // unknown status
+    decoder.reset();
+    assert(throwsRuntime(decoder, packets[1]));
+
+    TelemetryEncoder strict;
+    std::vector<std::uint8_t> out;
+    strict.encode(TelemetryFrame{100, SensorData{1, 1, 1}, ParkingStatus::Safe}, out);
+    bool threw = false;
+    try {
+        strict.encode(TelemetryFrame{99, SensorData{1, 1, 1}, ParkingStatus::Safe}, out);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+    threw = false;
+    try {
+        strict.encode(TelemetryFrame{120, SensorData{1, std::numeric_limits<double>::quiet_NaN(), 1},
+                                     ParkingStatus::Safe}, out);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    TelemetryConfig bad;
+    bad.keyframeInterval = 0;
+    threw = false;
+    try {
+        TelemetryEncoder invalid(bad);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "✅ Synchronisation and error tests passed\n";
+}
+
+/**
+ * @brief Executes all telemetry codec tests
+ * @return 0 on success, 1 on failure
+ */
+int runAllTests() {
+    std::cout << "=== Running Telemetry Codec Unit Tests ===\n\n";
+
+    try {
+        testRoundTrip();
+        testPacing();
+        testSyncAndErrors();
+
+        std::cout << "\n🎉 All tests passed successfully!\n";
+        std::cout << "Total tests run: 3\n";
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
+
+/**
+ * @brief Main entry point for the telemetry codec test suite
+ * @return 0 on success, 1 on failure
+ */
+int main() {
+    return runAllTests();
+}
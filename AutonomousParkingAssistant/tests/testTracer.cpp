@@ -0,0 +1,237 @@
+/**
+ * @file testTracer.cpp
+ * @brief Unit tests for the Chrome trace event recorder
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ *
+ * Test Coverage:
+ * - Recording only while enabled, span nesting and JSON output
+ * - Per-thread buffers, thread names and overflow accounting
+ * - Trace file setup
+ *
+ * The trace macros are enabled for this file only; the core sources are
+ * compiled as configured.
+ */
+
+#define PARKING_ENABLE_TRACING 1
+#include "../include/Tracer.h"
+#include <atomic>
+#include <cassert>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+std::size_t countOf(const std::string& text, const std::string& pattern) {
+    std::size_t count = 0;
+    for (std::size_t pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + 1)) ++count;
+    return count;
+}
+
+std::string traceJson() {
+    std::ostringstream out;
+    Tracer::instance().writeJson(out);
+    return out.str();
+}
+
+} // namespace
+
+/**
+ * @brief Tests span recording on one thread
+ *
+ * Test Cases:
+ * - Nothing is recorded while disabled
+ * - Scopes produce nested begin/end pairs in order, with increasing times
+ * - Names are escaped in the JSON output and clear() forgets everything
+ */
+void testSpans() {
+    std::cout << "Testing span recording...\n";
+
+    Tracer& tracer = Tracer::instance();
+    tracer.clear();
+    {
+        PARKING_TRACE_SCOPE("ignored");
+    }
+    assert(tracer.events() == 0);
+
+    tracer.enable();
+    {
+        PARKING_TRACE_SCOPE("frame");
+        PARKING_TRACE_BEGIN("classify");
+        PARKING_TRACE_END("classify");
+        PARKING_TRACE_SCOPE("say \"hi\"\\");
+    }
+    tracer.disable();
+    PARKING_TRACE_BEGIN("after");
+    assert(tracer.events() == 6 && tracer.dropped() == 0);
+
+    std::string json = traceJson();
+    assert(json.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[") == 0);
+    assert(json.rfind("]}") != std::string::npos);
+    std::size_t frameBegin = json.find("{\"name\":\"frame\",\"ph\":\"B\"");
+    std::size_t classifyBegin = json.find("{\"name\":\"classify\",\"ph\":\"B\"");
+    std::size_t classifyEnd = json.find("{\"name\":\"classify\",\"ph\":\"E\"");
+    std::size_t quoted = json.find("{\"name\":\"say \\\"hi\\\"\\\\\",\"ph\":\"B\"");
+    std::size_t frameEnd = json.find("{\"name\":\"frame\",\"ph\":\"E\"");
+    assert(frameBegin < classifyBegin && classifyBegin < classifyEnd && classifyEnd < quoted && quoted < frameEnd);
+    assert(frameEnd != std::string::npos && json.find("after") == std::string::npos);
+
+    double previous = -1.0;
+    for (std::size_t pos = json.find("\"ts\":"); pos != std::string::npos; pos = json.find("\"ts\":", pos + 1)) {
+        double ts = std::stod(json.substr(pos + 5));
+        assert(ts >= previous);
+        previous = ts;
+    }
+
+    tracer.clear();
+    assert(tracer.events() == 0 && countOf(traceJson(), "\"ph\":") == 0);
+
+    std::cout << "✅ Span recording tests passed\n";
+}
+
+/**
+ * @brief Tests recording from several threads
+ *
+ * Test Cases:
+ * - Every thread gets its own row with its name
+ * - No event is lost while threads record concurrently
+ * - A full buffer drops and counts further events
+ * - Naming a thread while disabled allocates no buffer
+ * - Buffers of exited threads are reused, keeping their events, under new rows
+ */
+void testThreads() {
+    std::cout << "Testing per-thread buffers...\n";
+
+    Tracer& tracer = Tracer::instance();
+    tracer.clear();
+    const std::size_t buffersBefore = tracer.bufferCount();
+    std::thread idle([] { PARKING_TRACE_THREAD("idle"); PARKING_TRACE_SCOPE("ignored"); });
+    idle.join();
+    assert(tracer.bufferCount() == buffersBefore);
+
+    tracer.enable();
+    const char* names[4] = {"worker 0", "worker 1", "worker 2", "worker 3"};
+    // Workers stay alive until all of them have recorded, so none can take over another's buffer
+    std::atomic<int> finished(0);
+    auto awaitPool = [&finished] {
+        ++finished;
+        while (finished.load() % 4 != 0) std::this_thread::yield();
+    };
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&names, &awaitPool, t] {
+            PARKING_TRACE_THREAD(names[t]);
+            for (int i = 0; i < 5000; ++i) {
+                PARKING_TRACE_SCOPE("work");
+            }
+            awaitPool();
+        });
+    }
+    std::string whileRunning = traceJson();
+    for (std::thread& t : threads) t.join();
+    assert(whileRunning.rfind("]}") != std::string::npos);
+    assert(tracer.events() == 4 * 10000);
+
+    std::string json = traceJson();
+    std::set<std::string> tids;
+    for (std::size_t pos = json.find("\"name\":\"work\""); pos != std::string::npos;
+         pos = json.find("\"name\":\"work\"", pos + 1)) {
+        std::size_t tid = json.find("\"tid\":", pos);
+        tids.insert(json.substr(tid, json.find('}', tid) - tid));
+    }
+    assert(tids.size() == 4);
+    for (const char* name : names) assert(countOf(json, std::string("\"args\":{\"name\":\"") + name + "\"}") == 1);
+    assert(json.find("idle") == std::string::npos);
+
+    // A second pool takes over the buffers of the first one
+    assert(tracer.bufferCount() == buffersBefore + 4);
+    threads.clear();
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&awaitPool] {
+            PARKING_TRACE_THREAD("second pool");
+            for (int i = 0; i < 100; ++i) {
+                PARKING_TRACE_SCOPE("rework");
+            }
+            awaitPool();
+        });
+    }
+    for (std::thread& t : threads) t.join();
+    assert(tracer.bufferCount() == buffersBefore + 4 && tracer.events() == 4 * 10000 + 4 * 200);
+    json = traceJson();
+    std::set<std::string> reworkTids;
+    for (std::size_t pos = json.find("\"name\":\"rework\""); pos != std::string::npos;
+         pos = json.find("\"name\":\"rework\"", pos + 1)) {
+        std::size_t tid = json.find("\"tid\":", pos);
+        reworkTids.insert(json.substr(tid, json.find('}', tid) - tid));
+    }
+    assert(reworkTids.size() == 4 && countOf(json, "\"name\":\"work\"") == 4 * 10000);
+    for (const std::string& tid : reworkTids) assert(tids.count(tid) == 0);
+    assert(countOf(json, "\"args\":{\"name\":\"second pool\"}") == 4);
+
+    std::thread flood([] {
+        for (std::size_t i = 0; i < Tracer::kBufferEvents + 10; ++i) PARKING_TRACE_BEGIN("flood");
+    });
+    flood.join();
+    tracer.disable();
+    // The flood thread took over a buffer already holding 10200 events
+    assert(tracer.dropped() == 10 + 10200 && tracer.events() == 4 * 10000 + 4 * 200 + Tracer::kBufferEvents - 10200);
+    tracer.clear();
+
+    std::cout << "✅ Per-thread buffer tests passed\n";
+}
+
+/**
+ * @brief Tests trace file setup
+ *
+ * Test Cases:
+ * - An unwritable path is rejected without enabling the tracer
+ */
+void testTraceFile() {
+    std::cout << "Testing trace file setup...\n";
+
+    Tracer& tracer = Tracer::instance();
+    bool threw = false;
+    try {
+        tracer.writeAtExit("/nonexistent-directory/trace.json");
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw && !tracer.enabled());
+
+    std::cout << "✅ Trace file tests passed\n";
+}
+
+/**
+ * @brief Executes all tracer tests
+ * @return 0 on success, 1 on failure
+ */
+int runAllTests() {
+    std::cout << "=== Running Tracer Unit Tests ===\n\n";
+
+    try {
+        testSpans();
+        testThreads();
+        testTraceFile();
+
+        std::cout << "\n🎉 All tests passed successfully!\n";
+        std::cout << "Total tests run: 3\n";
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
+
+/**
+ * @brief Main entry point for the tracer test suite
+ * @return 0 on success, 1 on failure
+ */
+int main() {
+    return runAllTests();
+}
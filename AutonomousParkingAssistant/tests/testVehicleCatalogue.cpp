@@ -0,0 +1,146 @@
+/**
+ * @file testVehicleCatalogue.cpp
+ * @brief Unit tests for the built-in vehicle profile catalogue
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ *
+ * Test Coverage:
+ * - Every catalogued code is found by its own key
+ * - Unknown and near-miss codes are rejected
+ * - Profiles hold physically consistent models and sensor layouts
+ * - Catalogue models work with requiredSpace()
+ */
+
+#include "../include/ParkingUtils.h"
+#include "../include/VehicleCatalogue.h"
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+/**
+ * @brief Tests that every profile is reachable through the hash table
+ */
+void testLookupAll() {
+    std::cout << "Testing lookup of all profiles...\n";
+
+    assert(vehicleProfileCount() > 0);
+    for (std::size_t i = 0; i < vehicleProfileCount(); ++i) {
+        const VehicleProfile& p = vehicleProfileAt(i);
+        assert(findVehicleProfile(p.code) == &p);
+        assert(findVehicleProfile(std::string(p.code)) == &p);
+    }
+
+    bool threw = false;
+    try {
+        vehicleProfileAt(vehicleProfileCount());
+    } catch (const std::out_of_range&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "✅ Lookup tests passed\n";
+}
+
+/**
+ * @brief Tests that unknown codes are rejected
+ *
+ * Test Cases:
+ * - Empty string
+ * - Lower-case variant of a valid code
+ * - Valid code with a suffix or prefix
+ * - Completely unknown codes
+ */
+void testUnknownCodes() {
+    std::cout << "Testing unknown codes...\n";
+
+    assert(findVehicleProfile("") == nullptr);
+    assert(findVehicleProfile("sedan-04") == nullptr);
+    assert(findVehicleProfile("SEDAN-04X") == nullptr);
+    assert(findVehicleProfile("XSEDAN-04") == nullptr);
+    assert(findVehicleProfile("TRUCK-99") == nullptr);
+    for (int i = 0; i < 1000; ++i)
+        assert(findVehicleProfile("UNKNOWN-" + std::to_string(i)) == nullptr);
+
+    std::cout << "✅ Unknown code tests passed\n";
+}
+
+/**
+ * @brief Tests profile contents
+ *
+ * Test Cases:
+ * - Codes are unique
+ * - Every model passes kinematic validation
+ * - Sensors sit on the vehicle body and face the expected directions
+ */
+void testProfileContents() {
+    std::cout << "Testing profile contents...\n";
+
+    for (std::size_t i = 0; i < vehicleProfileCount(); ++i) {
+        const VehicleProfile& p = vehicleProfileAt(i);
+        for (std::size_t j = i + 1; j < vehicleProfileCount(); ++j)
+            assert(std::strcmp(p.code, vehicleProfileAt(j).code) != 0);
+
+        assert(rearAxleTurningRadius(p.model) > 0);
+        assert(vehicleLength(p.model) > 3.0 && vehicleLength(p.model) < 7.0);
+
+        const SensorLayout& s = p.sensors;
+        assert(s.left.y > 0 && s.right.y < 0);
+        assert(s.front.x > s.rear.x);
+        assert(std::fabs(s.front.x - (p.model.wheelbase + p.model.frontOverhang)) < 1e-9);
+        assert(std::fabs(s.rear.x + p.model.rearOverhang) < 1e-9);
+        assert(std::fabs(s.front.heading) < 1e-9);
+        assert(s.left.maxRange > 0 && s.front.maxRange > 0 &&
+               s.right.maxRange > 0 && s.rear.maxRange > 0);
+    }
+
+    std::cout << "✅ Profile content tests passed\n";
+}
+
+/**
+ * @brief Tests catalogue models with requiredSpace()
+ */
+void testRequiredSpaceFromCatalogue() {
+    std::cout << "Testing requiredSpace with catalogue profiles...\n";
+
+    const VehicleProfile* city = findVehicleProfile("CITY-01");
+    const VehicleProfile* van = findVehicleProfile("VAN-11");
+    assert(city && van);
+    assert(requiredSpace(true, city->model) < requiredSpace(true, van->model));
+    assert(std::fabs(requiredSpace(false, van->model) - (van->model.width + 0.5)) < 1e-9);
+
+    std::cout << "✅ Catalogue requiredSpace tests passed\n";
+}
+
+/**
+ * @brief Executes all vehicle catalogue tests
+ * @return 0 on success, 1 on failure
+ */
+int runAllTests() {
+    std::cout << "=== Running Vehicle Catalogue Unit Tests ===\n\n";
+
+    try {
+        testLookupAll();
+        testUnknownCodes();
+        testProfileContents();
+        testRequiredSpaceFromCatalogue();
+
+        std::cout << "\n🎉 All tests passed successfully!\n";
+        std::cout << "Total tests run: 4\n";
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
+
+/**
+ * @brief Main entry point for the vehicle catalogue test suite
+ * @return 0 on success, 1 on failure
+ */
+int main() {
+    return runAllTests();
+}
@@ -0,0 +1,227 @@
+/**
+ * @file testVehicleKinematics.cpp
+ * @brief Unit tests for the vehicle model and parallel parking feasibility
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ *
+ * Test Coverage:
+ * - Vehicle model validation and derived radii
+ * - Single- and multi-move minimum slot lengths
+ * - Inverse computation of the minimum number of moves
+ * - Batched fleet evaluation agreeing with the scalar functions
+ * - requiredSpace() overload using the vehicle model
+ */
+
+#include "../include/ParkingUtils.h"
+#include "../include/VehicleKinematics.h"
+#include "TestSupport.h"
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+const VehicleModel kHatchback = {1.75, 2.55, 0.85, 0.65, 5.2};  // 4.05 m, tight turning
+const VehicleModel kVan = {2.0, 3.66, 1.0, 1.2, 6.6};           // 5.86 m, long wheelbase
+
+} // namespace
+
+/**
+ * @brief Tests the vehicle model helpers and validation
+ *
+ * Test Cases:
+ * - Length is the sum of overhangs and wheelbase
+ * - Rear-axle radius matches the closed form
+ * - Inconsistent models are rejected
+ */
+void testVehicleModel() {
+    std::cout << "Testing vehicle model...\n";
+
+    assert(near(vehicleLength(kHatchback), 4.05, 1e-6));
+    double r = rearAxleTurningRadius(kHatchback);
+    assert(near(r, std::sqrt(5.2 * 5.2 - 2.55 * 2.55) - 0.875, 1e-6));
+
+    VehicleModel bad = kHatchback;
+    bad.minTurningRadius = 2.0;   // smaller than the wheelbase
+    bool threw = false;
+    try {
+        rearAxleTurningRadius(bad);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    bad = kHatchback;
+    bad.width = 0.0;
+    threw = false;
+    try {
+        minParallelSlotLength(bad);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "✅ Vehicle model tests passed\n";
+}
+
+/**
+ * @brief Tests the closed-form minimum slot lengths
+ *
+ * Test Cases:
+ * - Single move matches rearOverhang + sqrt(2 r w + reach^2)
+ * - More moves never need a longer slot
+ * - Many moves converge to length + kMinShuffleGap
+ * - A tight-turning car fits where the van does not
+ */
+void testMinSlotLength() {
+    std::cout << "Testing minimum slot length...\n";
+
+    double r = rearAxleTurningRadius(kHatchback);
+    double reach = 2.55 + 0.85;
+    double expected = 0.65 + std::sqrt(2.0 * r * 1.75 + reach * reach);
+    assert(near(minParallelSlotLength(kHatchback), expected, 1e-6));
+
+    double previous = minParallelSlotLength(kHatchback, 1);
+    for (int moves = 2; moves <= 10; ++moves) {
+        double current = minParallelSlotLength(kHatchback, moves);
+        assert(current <= previous);
+        previous = current;
+    }
+    assert(near(minParallelSlotLength(kHatchback, 1000), 4.05 + kMinShuffleGap, 1e-6));
+
+    // The van is longer and turns wider, so it always needs more room
+    assert(minParallelSlotLength(kVan) > minParallelSlotLength(kHatchback));
+    assert(minParallelSlotLength(kVan) > vehicleLength(kVan) + 1.0);
+
+    bool threw = false;
+    try {
+        minParallelSlotLength(kHatchback, 0);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "✅ Minimum slot length tests passed\n";
+}
+
+/**
+ * @brief Tests the inverse computation of the fewest moves for a slot
+ *
+ * Test Cases:
+ * - Slot exactly at the n-move minimum needs at most n moves
+ * - Slot slightly shorter than the n-move minimum needs more than n
+ * - Slots shorter than length + gap are infeasible
+ */
+void testMinMoves() {
+    std::cout << "Testing minimum moves...\n";
+
+    for (int n = 1; n <= 5; ++n) {
+        double slot = minParallelSlotLength(kHatchback, n);
+        int moves = minParallelMoves(kHatchback, slot + 1e-9, 10);
+        assert(moves >= 1 && moves <= n);
+        int fewer = minParallelMoves(kHatchback, slot - 1e-3, 10);
+        assert(fewer == 0 || fewer > n);
+    }
+    assert(minParallelMoves(kHatchback, 4.1, 50) == 0);     // below length + gap
+    assert(minParallelMoves(kHatchback, 10.0, 1) == 1);
+    assert(minParallelMoves(kVan, minParallelSlotLength(kVan, 3) + 1e-6, 2) == 0);
+
+    std::cout << "✅ Minimum moves tests passed\n";
+}
+
+/**
+ * @brief Tests batched fleet evaluation against the scalar functions
+ *
+ * Test Cases:
+ * - Batched slot lengths and move counts match the scalar functions
+ * - A move limit that does not fit a byte is rejected, not clamped
+ */
+void testFleetBatch() {
+    std::cout << "Testing fleet batch evaluation...\n";
+
+    VehicleFleet fleet;
+    fleet.add(kHatchback);
+    fleet.add(kVan);
+    assert(fleet.size() == 2);
+
+    std::vector<double> lengths;
+    minParallelSlotLengths(fleet, 2, lengths);
+    assert(near(lengths[0], minParallelSlotLength(kHatchback, 2), 1e-6));
+    assert(near(lengths[1], minParallelSlotLength(kVan, 2), 1e-6));
+
+    std::vector<double> slots;
+    for (double s = 3.5; s <= 9.0; s += 0.25) slots.push_back(s);
+    std::vector<unsigned char> moves;
+    parallelFeasibility(fleet, slots, 4, moves);
+    assert(moves.size() == 2 * slots.size());
+    for (std::size_t i = 0; i < slots.size(); ++i) {
+        assert(moves[i] == minParallelMoves(kHatchback, slots[i], 4));
+        assert(moves[slots.size() + i] == minParallelMoves(kVan, slots[i], 4));
+    }
+
+    parallelFeasibility(fleet, slots, 255, moves);
+    assert(moves.back() == minParallelMoves(kVan, slots.back(), 255));
+    const int outOfRange[] = {0, 256};
+    for (int limit : outOfRange) {
+        bool threw = false;
+        try {
+            parallelFeasibility(fleet, slots, limit, moves);
+        } catch (const std::invalid_argument&) {
+            threw = true;
+        }
+        assert(threw);
+    }
+
+    std::cout << "✅ Fleet batch tests passed\n";
+}
+
+/**
+ * @brief Tests the requiredSpace() overload for vehicle models
+ *
+ * Test Cases:
+ * - Parallel parking uses the kinematic slot length
+ * - Perpendicular parking keeps width + 0.5m
+ */
+void testRequiredSpaceModel() {
+    std::cout << "Testing requiredSpace with vehicle model...\n";
+
+    assert(near(requiredSpace(true, kHatchback), minParallelSlotLength(kHatchback), 1e-6));
+    assert(near(requiredSpace(true, kHatchback, 3), minParallelSlotLength(kHatchback, 3), 1e-6));
+    assert(near(requiredSpace(false, kVan), 2.5, 1e-6));
+
+    std::cout << "✅ requiredSpace vehicle model tests passed\n";
+}
+
+/**
+ * @brief Executes all vehicle kinematics tests
+ * @return 0 on success, 1 on failure
+ */
+int runAllTests() {
+    std::cout << "=== Running Vehicle Kinematics Unit Tests ===\n\n";
+
+    try {
+        testVehicleModel();
+        testMinSlotLength();
+        testMinMoves();
+        testFleetBatch();
+        testRequiredSpaceModel();
+
+        std::cout << "\n🎉 All tests passed successfully!\n";
+        std::cout << "Total tests run: 5\n";
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
+
+/**
+ * @brief Main entry point for the vehicle kinematics test suite
+ * @return 0 on success, 1 on failure
+ */
+int main() {
+    return runAllTests();
+}
@@ -0,0 +1,129 @@
+/**
+ * @file parkingDiff.cpp
+ * @brief Compares the decisions of two builds over recorded sessions
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ *
+ * Run "record" with the build in service to keep its decisions and
+ * throughput in a log, then "compare" with the candidate build on the
+ * same corpus and machine. Every frame where the status, beep level or
+ * steering differs is listed, followed by the throughput of both builds.
+ *
+ * Usage:
+ *   parkingDiff record LOG SESSION... [--threads N] [--build LABEL] [--reverse] [--change-only]
+ *   parkingDiff compare LOG SESSION... [--threads N] [--build LABEL] [--reverse] [--change-only]
+ *
+ * Sessions are files written with writeSensorFrame(), e.g. archived
+ * inputs of parkingAssistantLoop(). They must be given in the same order
+ * both times. Every frame is decided by decideParkingFrame(), as in the
+ * loop: forward mode unless --reverse, with every reading classified by
+ * checkSafety() unless --change-only selects the default status
+ * classifier.
+ *
+ * Exit status: 0 if the decisions are identical, 1 if any frame
+ * diverges, 2 for usage errors and unreadable input.
+ */
+
+#include "../include/DecisionDiff.h"
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+int usage(const char* program) {
+    cerr << "Usage: " << program
+         << " record|compare LOG SESSION... [--threads N] [--build LABEL] [--reverse] [--change-only]\n";
+    return 2;
+}
+
+void printDecision(const FrameDecision& d) {
+    cout << d.status << " | beep " << d.beep << " | steer " << steeringName(d.steering);
+}
+
+void printThroughput(const DecisionRun& run) {
+    cout << left << setw(20) << run.build << right << fixed << setprecision(0) << setw(14) << run.framesPerSecond()
+         << " frames/s (" << run.frames << " frames in " << setprecision(3) << run.seconds * 1e3 << " ms)\n";
+}
+
+} // namespace
+
+/**
+ * @brief Entry point of the differential runner
+ */
+int main(int argc, char* argv[]) {
+    if (argc < 4) return usage(argv[0]);
+    const string mode = argv[1];
+    if (mode != "record" && mode != "compare") return usage(argv[0]);
+    const string logPath = argv[2];
+    unsigned threads = max(1u, thread::hardware_concurrency());
+    string build = "current";
+    bool reverseMode = false;
+    bool changeOnly = false;
+    vector<string> paths;
+    for (int i = 3; i < argc; ++i) {
+        if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            const int n = atoi(argv[++i]);
+            if (n < 1) return usage(argv[0]);
+            threads = static_cast<unsigned>(n);
+        } else if (strcmp(argv[i], "--build") == 0 && i + 1 < argc) {
+            build = argv[++i];
+        } else if (strcmp(argv[i], "--reverse") == 0) {
+            reverseMode = true;
+        } else if (strcmp(argv[i], "--change-only") == 0) {
+            changeOnly = true;
+        } else {
+            paths.push_back(argv[i]);
+        }
+    }
+    if (paths.empty()) return usage(argv[0]);
+
+    try {
+        vector<RecordedSession> corpus;
+        for (const string& path : paths) corpus.push_back(loadRecordedSession(path));
+        const StatusClassifierConfig statusConfig;
+        DecisionRun candidate =
+            runDecisions(corpus, loopPipeline(reverseMode, changeOnly ? &statusConfig : nullptr), build, threads);
+
+        if (mode == "record") {
+            ofstream log(logPath);
+            writeDecisionLog(log, candidate);
+            if (!log) throw runtime_error("Cannot write decision log " + logPath);
+            cout << "Recorded " << candidate.frames << " decisions of " << corpus.size() << " sessions\n";
+            printThroughput(candidate);
+            return 0;
+        }
+
+        ifstream log(logPath);
+        if (!log) throw runtime_error("Cannot open decision log " + logPath);
+        DecisionRun baseline = readDecisionLog(log);
+        vector<Divergence> divergences = compareDecisions(baseline, candidate);
+
+        for (const Divergence& d : divergences) {
+            const SensorData& s = corpus[d.session].frames[d.frame];
+            cout << corpus[d.session].name << " frame " << d.frame << " (L " << s.left << ", C " << s.center
+                 << ", R " << s.right << ")\n  " << baseline.build << ": ";
+            printDecision(d.baseline);
+            cout << "\n  " << candidate.build << ": ";
+            printDecision(d.candidate);
+            cout << "\n";
+        }
+        cout << divergences.size() << " of " << candidate.frames << " frames diverge across " << corpus.size()
+             << " sessions\n";
+        printThroughput(baseline);
+        printThroughput(candidate);
+        return divergences.empty() ? 0 : 1;
+    } catch (const exception& e) {
+        cerr << "❌ " << e.what() << "\n";
+        return 2;
+    }
+}
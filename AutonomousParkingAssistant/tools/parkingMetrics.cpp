@@ -0,0 +1,112 @@
+/**
+ * @file parkingMetrics.cpp
+ * @brief Reads the live metrics of a running parking assistant
+ * @author Autonomous Parking Assistant Team
+ * @version 2.0
+ * @date 2024
+ *
+ * Maps the shared-memory registry published with
+ * AutonomousParkingAssistant --metrics NAME read-only and prints it. The
+ * assistant is never paused or signalled; sampling only reads its
+ * counters.
+ *
+ * Usage:
+ *   parkingMetrics NAME                  counters and latency percentiles
+ *   parkingMetrics NAME --prometheus     Prometheus text exposition format
+ *   parkingMetrics NAME --watch SECONDS  resample every SECONDS with rates
+ *   parkingMetrics NAME --unlink         remove the segment of a killed run
+ *
+ * The Prometheus output can be written to the directory of a node
+ * exporter textfile collector, e.g. from cron or a --watch loop.
+ */
+
+#include "../include/MetricsRegistry.h"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+using namespace std;
+
+namespace {
+
+/**
+ * @brief Prints counters and latency histograms as a table
+ * @param previous Counter values of the last sample (rates are printed when not empty)
+ * @param interval Seconds since the last sample
+ */
+void printSnapshot(const MetricsSnapshot& snapshot, const map<string, uint64_t>& previous, double interval) {
+    cout << fixed << setprecision(3);
+    for (const CounterSample& c : snapshot.counters) {
+        cout << left << setw(42) << c.name << right << setw(12) << c.value;
+        if (!previous.empty()) {
+            map<string, uint64_t>::const_iterator last = previous.find(c.name);
+            const uint64_t before = last == previous.end() ? 0 : last->second;
+            cout << setw(12) << (c.value - before) / interval << " /s";
+        }
+        cout << "\n";
+    }
+    for (const HistogramSample& h : snapshot.histograms) {
+        cout << h.name << ": " << h.count << " recorded";
+        if (h.count > 0) {
+            cout << ", mean " << h.sumNs * 1e-3 / h.count << " us, p50 " << h.percentile(0.5) * 1e-3 << " us, p90 "
+                 << h.percentile(0.9) * 1e-3 << " us, p99 " << h.percentile(0.99) * 1e-3 << " us";
+        }
+        cout << "\n";
+    }
+}
+
+int usage(const char* program) {
+    cerr << "Usage: " << program << " NAME [--prometheus] [--watch SECONDS] [--unlink]\n";
+    return 1;
+}
+
+} // namespace
+
+/**
+ * @brief Entry point of the metrics reader
+ * @return 0 on success, 1 on a usage error or a missing segment
+ */
+int main(int argc, char* argv[]) {
+    if (argc < 2 || argv[1][0] == '-') return usage(argv[0]);
+    const string name = argv[1];
+    bool prometheus = false;
+    double watch = 0.0;
+    for (int i = 2; i < argc; ++i) {
+        if (strcmp(argv[i], "--prometheus") == 0) {
+            prometheus = true;
+        } else if (strcmp(argv[i], "--watch") == 0 && i + 1 < argc) {
+            watch = atof(argv[++i]);
+            if (watch <= 0.0) return usage(argv[0]);
+        } else if (strcmp(argv[i], "--unlink") == 0) {
+            MetricsRegistry::unlinkShared(name);
+            return 0;
+        } else {
+            return usage(argv[0]);
+        }
+    }
+
+    try {
+        MetricsRegistry registry = MetricsRegistry::attachShared(name);
+        map<string, uint64_t> previous;
+        while (true) {
+            MetricsSnapshot snapshot = registry.snapshot();
+            if (prometheus) snapshot.writePrometheus(cout);
+            else printSnapshot(snapshot, previous, watch);
+            cout.flush();
+            if (watch <= 0.0) return 0;
+
+            for (const CounterSample& c : snapshot.counters) previous[c.name] = c.value;
+            this_thread::sleep_for(chrono::duration<double>(watch));
+            if (!prometheus) cout << "----------------------------------------\n";
+        }
+    } catch (const exception& e) {
+        cerr << "❌ " << e.what() << "\n";
+        return 1;
+    }
+}